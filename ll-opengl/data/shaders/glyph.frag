@@ -9,11 +9,12 @@ const uint SuperSampling8Rooks   = 5u;
 const uint SuperSampling3x3      = 6u;
 const uint SuperSampling4x4      = 7u;
 
-uniform sampler2D glyphs;
+uniform sampler2DArray glyphs;
 
 in vec2 g_uv;
 in vec4 g_fontColor;
 flat in uint g_superSampling;
+flat in uint g_page;
 
 layout (location = 0) out vec4 out_color;
 
@@ -28,7 +29,7 @@ float aastep(float t, float value)
 
 float tex(float t, vec2 uv)
 {
-    return aastep(0.5, texture(glyphs, uv)[channel]);
+    return aastep(0.5, texture(glyphs, vec3(uv, g_page))[channel]);
 }
 
 float aastep1x3(float t, vec2 uv)
@@ -168,7 +169,7 @@ void main()
 {
     // requires blend: glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    float s = texture(glyphs, g_uv).r;
+    float s = texture(glyphs, vec3(g_uv, g_page)).r;
     if(s < 0.3)
         discard;
 
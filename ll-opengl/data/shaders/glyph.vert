@@ -6,6 +6,7 @@ layout (location = 2) in vec3 in_vbitan;
 layout (location = 3) in vec4 in_uvRect;  // vec2 lowerLeft and vec2 upperRight in glyph texture (uv)
 layout (location = 4) in vec4 in_fontColor;
 layout (location = 5) in uint in_superSampling;
+layout (location = 6) in uint in_page;    // layer of the glyph texture array
 
 //uniform mat4 viewProjection;
 
@@ -14,6 +15,7 @@ out vec4 v_bitangent;
 out vec4 v_uvRect;
 out vec4 v_fontColor;
 out uint v_superSampling;
+out uint v_page;
 
 void main()
 {
@@ -27,4 +29,5 @@ void main()
     v_uvRect        = in_uvRect;
     v_fontColor     = in_fontColor;
     v_superSampling = in_superSampling;
+    v_page          = in_page;
 }
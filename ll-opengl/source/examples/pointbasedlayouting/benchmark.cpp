@@ -4,7 +4,8 @@
 #include <map>
 
 #include <openll/layout/LabelArea.h>
-#include <openll/Typesetter.h>
+#include <openll/layout/LabelAreaBlock.h>
+#include <openll/GlyphSequence.h>
 
 namespace
 {
@@ -16,37 +17,44 @@ std::vector<gloperate_text::LabelArea> computeLabelAreas(const std::vector<glope
     {
         if (!label.placement.display) continue;
         auto origin = label.pointLocation + label.placement.offset;
-        auto extent = gloperate_text::Typesetter::extent(label.sequence);
+        const auto & extent = label.sequence.extent();
         areas.push_back({origin, extent});
     }
     return areas;
 }
 
+gloperate_text::layout::LabelAreaBlock computeLabelAreaBlock(const std::vector<gloperate_text::LabelArea> & areas, const glm::vec2 & relativePadding)
+{
+    gloperate_text::layout::LabelAreaBlock block(relativePadding);
+    block.reserve(areas.size());
+    for (const auto & area : areas)
+        block.push_back(area);
+    return block;
+}
+
 }
 
 int labelOverlaps(const std::vector<gloperate_text::Label> & labels, const glm::vec2 & relativePadding)
 {
-    auto areas = computeLabelAreas(labels);
+    const auto areas = computeLabelAreas(labels);
+    const auto block = computeLabelAreaBlock(areas, relativePadding);
     int counter = 0;
     for (size_t i = 0; i < areas.size(); ++i) {
-        for (size_t j = i + 1; j < areas.size(); ++j) {
-            if (areas[i].paddedOverlaps(areas[j], relativePadding))
-            {
-                ++counter;
-            }
-        }
+        int overlapCount = 0;
+        block.overlapArea(areas[i], overlapCount, i + 1);
+        counter += overlapCount;
     }
     return counter;
 }
 
 float labelOverlapArea(const std::vector<gloperate_text::Label> & labels, const glm::vec2 & relativePadding)
 {
-    auto areas = computeLabelAreas(labels);
+    const auto areas = computeLabelAreas(labels);
+    const auto block = computeLabelAreaBlock(areas, relativePadding);
     float area = 0;
     for (size_t i = 0; i < areas.size(); ++i) {
-        for (size_t j = i + 1; j < areas.size(); ++j) {
-            area += areas[i].paddedOverlapArea(areas[j], relativePadding);
-        }
+        int overlapCount = 0;
+        area += block.overlapArea(areas[i], overlapCount, i + 1);
     }
     return area;
 }
@@ -71,7 +79,7 @@ std::map<gloperate_text::RelativeLabelPosition, unsigned int> labelPositionDesir
     for (const auto & label : labels)
     {
         if (!label.placement.display) continue;
-        const auto extent = gloperate_text::Typesetter::extent(label.sequence);
+        const auto & extent = label.sequence.extent();
         const auto position = gloperate_text::relativeLabelPosition(label.placement.offset, extent);
         ++result[position];
     }
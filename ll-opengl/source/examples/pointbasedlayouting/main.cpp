@@ -24,6 +24,8 @@
 #include <openll/SuperSampling.h>
 #include <openll/layout/layoutbase.h>
 #include <openll/layout/algorithm.h>
+#include <openll/layout/ObstacleIndex.h>
+#include <openll/layout/OccupancyGrid.h>
 
 #include <cpplocate/cpplocate.h>
 #include <cpplocate/ModuleInfo.h>
@@ -40,6 +42,9 @@ size_t g_algorithmID = 0;
 bool g_frames_visible = true;
 long int g_seed = 0;
 int g_numLabels = 64;
+std::vector<gloperate_text::LabelPlacement> g_previousPlacements;
+// covers the label points in [-1, 1] and labels reaching beyond
+gloperate_text::layout::OccupancyGrid g_occupancy{{-1.5f, -1.5f}, {1.5f, 1.5f}, {512, 512}};
 
 struct Algorithm
 {
@@ -53,13 +58,26 @@ std::vector<Algorithm> layoutAlgorithms
 {
     {"constant",                          gloperate_text::layout::constant},
     {"random",                            gloperate_text::layout::random},
-    {"greedy with area",                  std::bind(gloperate_text::layout::greedy, _1, gloperate_text::layout::overlapArea)},
-    {"discreteGradientDescent with area", std::bind(gloperate_text::layout::discreteGradientDescent, _1, gloperate_text::layout::overlapArea)},
-    {"simulatedAnnealing with area",      std::bind(gloperate_text::layout::simulatedAnnealing, _1, gloperate_text::layout::overlapArea, false, glm::vec2(0.f))},
-    {"simulatedAnnealing",                std::bind(gloperate_text::layout::simulatedAnnealing, _1, gloperate_text::layout::standard, false, glm::vec2(0.f))},
-    {"simulatedAnnealing with padding",   std::bind(gloperate_text::layout::simulatedAnnealing, _1, gloperate_text::layout::standard, false, glm::vec2(0.2f))},
-    {"simulatedAnnealing with selection", std::bind(gloperate_text::layout::simulatedAnnealing, _1, gloperate_text::layout::standard, true, glm::vec2(0.f))},
-    {"simulatedAnnealing (everything)",   std::bind(gloperate_text::layout::simulatedAnnealing, _1, gloperate_text::layout::standard, true, glm::vec2(0.2f))},
+    {"greedy with area",                  std::bind(gloperate_text::layout::greedy, _1, gloperate_text::layout::overlapArea, nullptr)},
+    {"discreteGradientDescent with area", std::bind(gloperate_text::layout::discreteGradientDescent, _1, gloperate_text::layout::overlapArea, gloperate_text::layout::LayoutBudget())},
+    {"simulatedAnnealing with area",      std::bind(gloperate_text::layout::simulatedAnnealing, _1, gloperate_text::layout::overlapArea, false, glm::vec2(0.f), gloperate_text::layout::LayoutBudget(), nullptr)},
+    {"simulatedAnnealing",                std::bind(gloperate_text::layout::simulatedAnnealing, _1, gloperate_text::layout::standard, false, glm::vec2(0.f), gloperate_text::layout::LayoutBudget(), nullptr)},
+    {"simulatedAnnealing with padding",   std::bind(gloperate_text::layout::simulatedAnnealing, _1, gloperate_text::layout::standard, false, glm::vec2(0.2f), gloperate_text::layout::LayoutBudget(), nullptr)},
+    {"simulatedAnnealing with selection", std::bind(gloperate_text::layout::simulatedAnnealing, _1, gloperate_text::layout::standard, true, glm::vec2(0.f), gloperate_text::layout::LayoutBudget(), nullptr)},
+    {"simulatedAnnealing (everything)",   std::bind(gloperate_text::layout::simulatedAnnealing, _1, gloperate_text::layout::standard, true, glm::vec2(0.2f), gloperate_text::layout::LayoutBudget(), nullptr)},
+    {"coherentAnnealing (everything)",    [](std::vector<gloperate_text::Label> & labels) {
+        gloperate_text::layout::coherentAnnealing(labels, g_previousPlacements, gloperate_text::layout::standard, true, glm::vec2(0.2f)); }},
+    {"greedy with occupancy grid",        [](std::vector<gloperate_text::Label> & labels) {
+        g_occupancy.clear();
+        gloperate_text::layout::greedy(labels, gloperate_text::layout::overlapArea, &g_occupancy); }},
+    {"priorityPlacement",                 [](std::vector<gloperate_text::Label> & labels) {
+        g_occupancy.clear();
+        gloperate_text::layout::priorityPlacement(labels, gloperate_text::layout::standard, g_occupancy); }},
+    {"slidingPlacement",                  std::bind(gloperate_text::layout::slidingPlacement, _1, gloperate_text::layout::standard, 2u, true, glm::vec2(0.2f), 0.3f, gloperate_text::layout::LayoutBudget(), nullptr)},
+    {"simulatedAnnealing avoiding points", [](std::vector<gloperate_text::Label> & labels) {
+        // the points are drawn with a size of about 4 pixels of 640
+        const gloperate_text::layout::ObstacleIndex obstacles(gloperate_text::layout::pointObstacles(labels, glm::vec2(0.0125f)));
+        gloperate_text::layout::simulatedAnnealing(labels, gloperate_text::layout::standard, true, glm::vec2(0.2f), gloperate_text::layout::LayoutBudget(), &obstacles); }},
 };
 
 void onResize(GLFWwindow*, int width, int height)
@@ -98,6 +116,16 @@ void onKeyPress(GLFWwindow * window, int key, int, int action, int mods)
         g_algorithmID = std::min(static_cast<size_t>(key - '1'), layoutAlgorithms.size() - 1);
         g_config_changed = true;
     }
+    else if (key == '0' && action == GLFW_PRESS)
+    {
+        g_algorithmID = std::min(static_cast<size_t>(9), layoutAlgorithms.size() - 1);
+        g_config_changed = true;
+    }
+    else if (key == 'N' && action == GLFW_PRESS)
+    {
+        g_algorithmID = (g_algorithmID + 1) % layoutAlgorithms.size();
+        g_config_changed = true;
+    }
 }
 
 void glInitialize()
@@ -282,6 +310,9 @@ int main()
             glViewport(0, 0, g_viewport.x, g_viewport.y);
             labels = prepareLabels(font, g_viewport);
             runAndBenchmark(labels, layoutAlgorithms[g_algorithmID]);
+            g_previousPlacements.clear();
+            for (const auto & label : labels)
+                g_previousPlacements.push_back(label.placement);
             cloud = prepareCloud(labels);
             preparePointDrawable(labels, pointDrawable);
             prepareRectangleDrawable(labels, rectangleDrawable);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+// marks the non-feature cells for squaredDistanceTransform
+OPENLL_API float distanceTransformInfinity();
+
+/**
+*  @brief
+*   Exact squared euclidean distance transform in linear time (Felzenszwalb
+*   and Huttenlocher, "Distance Transforms of Sampled Functions").
+*
+*   Transforms the width x height row-major grid in place. On input, feature
+*   cells are 0 and all other cells distanceTransformInfinity(); on output,
+*   each cell holds the squared distance in cells to the nearest feature cell.
+*   A grid without feature cells stays at infinity.
+*/
+OPENLL_API void squaredDistanceTransform(std::vector<float> & grid, int width, int height);
+
+
+} // namespace gloperate_text
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFaceGenerator.h>
+#include <openll/GlyphRasterizer.h>
+#include <openll/ShelfPacker.h>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+class FontFace;
+class RenderBackend;
+class TrueTypeFont;
+
+
+/**
+*  @brief
+*   Glyph atlas of fixed size that is filled on demand from a TrueType font
+*   (dynamic glyphs, in contrast to the static atlases of FontLoader).
+*
+*   request adds the glyphs of the text to the font face right away with
+*   their advance and kerning, so that typesetting does not change once the
+*   images arrive; the distance fields are rasterized on a worker thread.
+*   update, called once per frame, places the finished glyphs into free
+*   atlas space (see ShelfPacker), copies them into the glyph image and
+*   updates only their rectangles of the glyph texture. If the atlas is
+*   full, the glyphs least recently requested before the current frame are
+*   evicted; they stay in the font face as non-depictable glyphs and are
+*   rasterized again when requested.
+*
+*   Glyphs are requested per frame: typeset vertex clouds that are kept
+*   across frames have to request their text each frame and be typeset
+*   again whenever evictions() changed, as their texture coordinates may
+*   refer to reused atlas space.
+*
+*   All methods are called from one thread, e.g., the render thread.
+*/
+class OPENLL_API DynamicGlyphAtlas
+{
+public:
+    // extent of the glyph texture; the glyph texture is created through backend if given
+    DynamicGlyphAtlas(std::shared_ptr<const TrueTypeFont> font, const glm::ivec2 & extent
+        , const FontFaceGenerator & generator = FontFaceGenerator(), RenderBackend * backend = nullptr);
+    virtual ~DynamicGlyphAtlas();
+
+    DynamicGlyphAtlas(const DynamicGlyphAtlas &) = delete;
+    DynamicGlyphAtlas & operator=(const DynamicGlyphAtlas &) = delete;
+
+    // the font face to typeset and render with
+    FontFace * fontFace() const;
+    const TrueTypeFont & font() const;
+
+    // marks the glyphs as used in the current frame and queues missing ones for rasterization
+    void request(GlyphIndex codepoint);
+    void request(const std::u32string & string);
+
+    // places the glyphs rasterized so far and starts the next frame; returns the number of glyphs placed
+    size_t update();
+    // blocks until the worker has rasterized all requested glyphs, e.g., before the first frame
+    void wait();
+
+    // the glyph's image is in the atlas
+    bool resident(GlyphIndex codepoint) const;
+    // requested glyphs that are not placed yet
+    size_t pending() const;
+    // the number of glyphs evicted so far
+    unsigned long long evictions() const;
+    unsigned long long frame() const;
+
+protected:
+    enum class State
+    {
+        Unmapped,   // not in the font
+        Pending,    // queued or rasterized, not placed
+        Resident,
+        Empty,      // no image, e.g., white space
+        Evicted     // or did not fit
+    };
+
+    struct Entry
+    {
+        State state;
+        glm::ivec2 position;
+        glm::ivec2 size;
+        unsigned long long lastUse;
+    };
+
+    using Result = std::pair<GlyphIndex, GlyphRasterizer::DistanceField>;
+
+    void addGlyph(GlyphIndex codepoint);
+    // evicts glyphs from the back of candidates until size fits; candidates are collected on the first call
+    bool allocate(const glm::ivec2 & size, glm::ivec2 & position, std::vector<GlyphIndex> & candidates, bool & collected);
+    // the resident glyphs not requested in the current frame, the least recently used last
+    std::vector<GlyphIndex> evictionCandidates() const;
+    void evict(GlyphIndex codepoint, Entry & entry);
+    // zeroes the rectangle in the glyph image and texture, so that free atlas space never holds stale texels
+    void clear(const glm::ivec2 & position, const glm::ivec2 & size);
+    void enqueue(GlyphIndex codepoint);
+
+    void work();
+
+protected:
+    std::shared_ptr<const TrueTypeFont> m_font;
+    FontFaceGenerator m_generator;
+    globjects::ref_ptr<RenderBackend> m_backend;
+    globjects::ref_ptr<FontFace> m_fontFace;
+
+    ShelfPacker m_packer;
+    std::unordered_map<GlyphIndex, Entry> m_entries;
+    // the requested code points of each glyph id of the font, for the kerning of added glyphs
+    std::unordered_map<std::uint32_t, std::vector<GlyphIndex>> m_codepoints;
+    // indices of the kerning pairs of the font (sorted by left glyph) sorted by right glyph
+    std::vector<std::uint32_t> m_kerningByRight;
+    size_t m_pending;
+    unsigned long long m_frame;
+    unsigned long long m_evictions;
+
+    // shared with the worker
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::deque<GlyphIndex> m_queue;
+    std::vector<Result> m_results;
+    bool m_busy;
+    bool m_stop;
+
+    std::thread m_worker;
+};
+
+
+} // namespace gloperate_text
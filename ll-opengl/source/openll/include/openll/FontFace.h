@@ -253,6 +253,28 @@ public:
     */
     void setGlyphTextureExtent(const glm::uvec2 & extent);
 
+    /**
+    * @brief
+    *   The number of pages (layers) of the glyph texture atlas.
+    *
+    *   All pages share the glyph texture extent. Each glyph refers to
+    *   one page (see Glyph::page) and the glyph texture is a texture
+    *   array with one layer per page.
+    *
+    * @return
+    *   The number of pages, at least one.
+    */
+    unsigned int glyphTexturePages() const;
+
+    /**
+    * @brief
+    *   Sets the number of pages (layers) of the glyph texture atlas.
+    *
+    * @param[in] pages
+    *   The number of pages, at least one
+    */
+    void setGlyphTexturePages(unsigned int pages);
+
     /**
     * @brief
     *   The padding applied to every glyph in px.
@@ -279,7 +301,8 @@ public:
     * @brief
     *   The font face's associated glyph atlas.
     *
-    *   All glyph data is associated to this texture atlas.
+    *   All glyph data is associated to this texture atlas, a texture
+    *   array with one layer per page.
     *
     * @return
     *   The texture object containing the texture atlas.
@@ -295,6 +318,42 @@ public:
     */
     void setGlyphTexture(globjects::Texture * texture);
 
+    /**
+    * @brief
+    *   The glyph texture atlas in main memory.
+    *
+    *   Single channel, 8 bit per texel, rows from bottom to top as
+    *   uploaded to the glyph texture, the pages one after another. Used
+    *   for rendering without an OpenGL context (see SoftwareGlyphRenderer).
+    *
+    * @return
+    *   The texels of the atlas, empty if no atlas was loaded or if it was
+    *   released after the upload (see FontLoader::setKeepGlyphImage).
+    */
+    const std::vector<unsigned char> & glyphImage() const;
+
+    /**
+    * @brief
+    *   The glyph texture atlas in main memory for in-place updates.
+    *
+    *   The glyph texture is not updated; see
+    *   RenderBackend::updateGlyphTexture.
+    *
+    * @return
+    *   The texels of the atlas, empty if no atlas was loaded.
+    */
+    std::vector<unsigned char> & glyphImage();
+
+    /**
+    * @brief
+    *   Sets/updates the glyph texture atlas in main memory.
+    *
+    * @param[in] image
+    *   The texels of the atlas, glyphTextureExtent().x * glyphTextureExtent().y
+    *   bytes per page
+    */
+    void setGlyphImage(std::vector<unsigned char> image);
+
     /**
     * @brief
     *   Check if a glyph of a specific index is available.
@@ -345,6 +404,21 @@ public:
     */
     void addGlyph(const Glyph & glyph);
 
+    /**
+    * @brief
+    *   Counter of the changes affecting typesetting.
+    *
+    *   The revision is incremented by the setters of the font
+    *   metrics, by adding glyphs, setting kerning, and by mutable
+    *   access to a glyph, e.g., when a DynamicGlyphAtlas adds glyphs.
+    *   Results derived from the font face, e.g., the cached extent of
+    *   a GlyphSequence, are valid as long as the revision is unchanged.
+    *
+    * @return
+    *   The current revision of the font face.
+    */
+    unsigned long long revision() const;
+
     /**
     * @brief
     *   Generates a vector of all comprised glyph indices.
@@ -417,11 +491,15 @@ protected:
     float m_linegap;
 
     glm::uvec2 m_glyphTextureExtent;
+    unsigned int m_glyphTexturePages;
     glm::vec4  m_glyphTexturePadding;
 
     globjects::ref_ptr<globjects::Texture> m_glyphTexture;
+    std::vector<unsigned char> m_glyphImage;
 
     std::unordered_map<GlyphIndex, Glyph> m_glyphs;
+
+    unsigned long long m_revision;
 };
 
 
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/Glyph.h>
+#include <openll/GlyphRasterizer.h>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+class FontFace;
+class TaskPool;
+class TrueTypeFont;
+
+
+/**
+*  @brief
+*   Generates font faces with distance field glyph atlases from TrueType
+*   fonts, e.g., to bake atlases in a build pipeline (see openll-fontgen and
+*   FontWriter).
+*
+*   The glyphs are rasterized by GlyphRasterizer, optionally in parallel on
+*   a task pool, and packed into the smallest power of two atlas that fits
+*   them by SkylinePacker. Glyphs that exceed the maximum page extent are
+*   spread over several pages of that extent (see FontFace::glyphTexturePages).
+*   The result does not depend on the number of threads. No texture is
+*   created; see RenderBackend::createGlyphTexture.
+*/
+class OPENLL_API FontFaceGenerator
+{
+public:
+    // size is ascent - descent in pixels (see FontFace::size); padding and oversampling as in GlyphRasterizer
+    explicit FontFaceGenerator(float size = 72.f, int padding = 8, int oversampling = 4, int maximumPageExtent = 16384);
+
+    float size() const;
+    int padding() const;
+    int oversampling() const;
+    int maximumPageExtent() const;
+
+    // code points not mapped by the font are skipped; nullptr if the font is invalid or a glyph exceeds a page
+    FontFace * generate(const TrueTypeFont & font, const std::vector<GlyphIndex> & codepoints, TaskPool * pool = nullptr) const;
+
+    // building blocks of generate, also used by DynamicGlyphAtlas
+
+    // pixels per font unit
+    float scale(const TrueTypeFont & font) const;
+    // sets the vertical metrics and the glyph texture padding of fontFace
+    void initialize(FontFace & fontFace, const TrueTypeFont & font) const;
+    // may be called concurrently
+    GlyphRasterizer::DistanceField rasterize(const TrueTypeFont & font, GlyphIndex codepoint) const;
+    // the glyph with advance and, for non-empty fields, bearing and extent; the sub texture is set by place
+    Glyph glyph(const TrueTypeFont & font, GlyphIndex codepoint, const GlyphRasterizer::DistanceField & field) const;
+    // the sub texture of glyph at position (lower left texel) on the glyph's page of fontFace; copies the field into the glyph image
+    static void place(FontFace & fontFace, Glyph & glyph, const GlyphRasterizer::DistanceField & field, const glm::ivec2 & position);
+
+protected:
+    float m_size;
+    int m_padding;
+    int m_oversampling;
+    int m_maximumPageExtent;
+};
+
+
+} // namespace gloperate_text
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontLoader.h>
+#include <openll/Glyph.h>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+class FontFace;
+
+
+/**
+*  @brief
+*   Process-wide cache of loaded font faces, so that modules loading the
+*   same font share one font face and one glyph texture.
+*
+*   Font faces are keyed by the canonical path of the font file and the
+*   options of the loader: its subset, whether the subset is repacked,
+*   whether the glyph image is kept, and its render backend instance (none
+*   if the glyph texture is not created), as the glyph texture belongs to
+*   the backend. Shared font faces must not be modified.
+*
+*   The registry holds a reference to each font face. As
+*   globjects::Referenced has no weak references, font faces referenced by
+*   the registry only are released on the next load or collect, in the
+*   calling thread; with glyph textures, that thread requires the context.
+*
+*   All methods are thread safe. Font faces are loaded outside the lock, so
+*   that different font faces load concurrently; a font face requested by
+*   several threads at once is loaded only once, the other threads wait.
+*/
+class OPENLL_API FontFaceRegistry
+{
+public:
+    // the registry of the process
+    static FontFaceRegistry & instance();
+
+    FontFaceRegistry();
+    virtual ~FontFaceRegistry();
+
+    FontFaceRegistry(const FontFaceRegistry &) = delete;
+    FontFaceRegistry & operator=(const FontFaceRegistry &) = delete;
+
+    // the shared font face of the file for the options of loader, loaded on first use; nullptr if loading failed
+    globjects::ref_ptr<FontFace> load(const std::string & filename, const FontLoader & loader = FontLoader());
+
+    // releases the font faces not referenced outside the registry; returns the number of font faces released
+    size_t collect();
+
+    // the number of font faces held, including the ones not collected yet
+    size_t size() const;
+    // the number of loads served from the registry, for profiling
+    unsigned long long hits() const;
+
+protected:
+    // canonical path, backend, repacked, subset, glyph image kept
+    using Key = std::tuple<std::string, const RenderBackend *, bool, std::set<GlyphIndex>, bool>;
+
+    struct Entry
+    {
+        // nullptr while the font face is loaded
+        globjects::ref_ptr<FontFace> fontFace;
+        // keeps the address of the backend in the key from being reused
+        globjects::ref_ptr<RenderBackend> backend;
+    };
+
+    size_t collectUnlocked();
+
+protected:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_loaded;
+    std::map<Key, Entry> m_fontFaces;
+    unsigned long long m_hits;
+};
+
+
+} // namespace gloperate_text
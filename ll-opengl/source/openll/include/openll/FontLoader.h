@@ -4,6 +4,13 @@
 #include <string>
 #include <iosfwd>
 #include <map>
+#include <set>
+#include <vector>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/Glyph.h>
+#include <openll/RenderBackend.h>
 
 #include <openll/openll_api.h>
 
@@ -13,23 +20,51 @@ namespace gloperate_text
 
 
 class FontFace;
-
+class GlyphSequence;
 
 
 class OPENLL_API FontLoader
 {
 public:
-    FontLoader();
+    // without uploadGlyphTexture the glyph atlas is read but no texture is created, so that no OpenGL context is required
+    explicit FontLoader(bool uploadGlyphTexture = true);
+    // creates the glyph textures through backend, none if backend is nullptr
+    explicit FontLoader(RenderBackend * backend);
 
     FontFace * load(const std::string & filename) const;
 
+    // the backend creating the glyph textures, nullptr if none are created
+    RenderBackend * backend() const;
+
+    // loads only the glyphs of these code points and the kerning pairs among them; all glyphs if empty.
+    // Without setRepackSubset the whole pages are still read, the subset only saves glyphs and kerning pairs.
+    void setSubset(std::set<GlyphIndex> codepoints);
+    // the code points of the strings of a corpus, e.g., the labels of a data set; no glyphs if the corpus is empty
+    void setSubset(const std::vector<GlyphSequence> & corpus);
+    const std::set<GlyphIndex> & subset() const;
+
+    // copies the glyphs of the subset into the smallest glyph texture that fits them instead of keeping the whole atlas
+    void setRepackSubset(bool repack);
+    bool repackSubset() const;
+
+    // keeps the glyph image in main memory after the glyph texture is created, e.g., for SoftwareGlyphRenderer or
+    // TilePipeline; otherwise it is released after the upload. Without backend the glyph image is always kept.
+    void setKeepGlyphImage(bool keep);
+    bool keepGlyphImage() const;
+
 protected:
+    bool inSubset(GlyphIndex index) const;
+    // reads the glyphs of the subset from the page files into the smallest glyph image that fits them;
+    // returns false if that does not save texels, the whole pages have to be read then
+    bool repack(FontFace & fontFace, const std::vector<std::string> & pageFiles) const;
+    void readPages(FontFace & fontFace, const std::vector<std::string> & pageFiles) const;
 
     void handleInfo    (std::stringstream & stream, FontFace & fontFace) const;
     void handleCommon  (std::stringstream & stream, FontFace & fontFace) const;
-    void handlePage    (std::stringstream & stream, FontFace & fontFace
-        , const std::string & filename) const;
-    void handleChar    (std::stringstream & stream, FontFace & fontFace) const;
+    bool handlePage    (std::stringstream & stream, FontFace & fontFace
+        , const std::string & filename, std::vector<std::string> & pageFiles) const;
+    void handleChar    (std::stringstream & stream, FontFace & fontFace
+        , const std::vector<std::string> & pageFiles) const;
     void handleKerning (std::stringstream & stream, FontFace & fontFace) const;
 
     using StringPairs = std::map<std::string, std::string>;
@@ -37,6 +72,13 @@ protected:
         std::stringstream & stream
     ,   const std::initializer_list<const char *> & mandatoryKeys);
 
+protected:
+    globjects::ref_ptr<RenderBackend> m_backend;
+
+    std::set<GlyphIndex> m_subset;
+    bool m_restrictToSubset; // an empty subset of a corpus loads no glyphs
+    bool m_repackSubset;
+    bool m_keepGlyphImage;
 };
 
 
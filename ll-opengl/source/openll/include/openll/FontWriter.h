@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+class FontFace;
+
+
+/**
+*  @brief
+*   Writes a font face in the format read by FontLoader: a text .fnt file
+*   and the glyph image as <name>.<width>.<height>.r.ub.raw next to it, or
+*   one <name>_<page>.<width>.<height>.r.ub.raw per page of multi-page faces.
+*/
+class OPENLL_API FontWriter
+{
+public:
+    FontWriter();
+
+    // faceName defaults to the file name without extension; spaces are removed as the .fnt format cannot represent them
+    bool save(const FontFace & fontFace, const std::string & filename, const std::string & faceName = "") const;
+};
+
+
+} // namespace gloperate_text
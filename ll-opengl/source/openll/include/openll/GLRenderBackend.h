@@ -0,0 +1,36 @@
+#pragma once
+
+#include <openll/RenderBackend.h>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+class Drawable;
+
+
+// OpenGL backend based on globjects, requires a current context for all calls
+class OPENLL_API GLRenderBackend : public RenderBackend
+{
+public:
+    // the backend of FontLoader(true) and of vertex clouds without backend, shared so that FontFaceRegistry
+    // shares the font faces loaded with it and vertex clouds do not create a backend each
+    static GLRenderBackend * instance();
+
+    GLRenderBackend();
+    virtual ~GLRenderBackend();
+
+    virtual void createGlyphTexture(FontFace & fontFace) override;
+    virtual void updateGlyphTexture(FontFace & fontFace, const glm::ivec2 & offset, const glm::ivec2 & extent, unsigned int page) override;
+    virtual void uploadVertices(GlyphVertexCloud & vertexCloud, const GlyphVertexCloud::Vertices & vertices) override;
+    virtual void draw(const GlyphVertexCloud & vertexCloud, globjects::Program * program, const glm::mat4 & viewProjection) override;
+
+protected:
+    static Drawable * createDrawable();
+};
+
+
+} // namespace gloperate_text
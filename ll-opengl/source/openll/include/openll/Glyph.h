@@ -89,6 +89,27 @@ public:
     */
     void setSubTextureExtent(const glm::vec2 & extent);
 
+    /**
+    * @brief
+    *   The page of the glyph-texture that contains the glyph.
+    *
+    *   The page is the layer of the font face's glyph texture array
+    *   the sub-texture refers to (see FontFace::glyphTexturePages).
+    *
+    * @return
+    *   The page index, 0 for single page font faces.
+    */
+    unsigned int page() const;
+
+    /**
+    * @brief
+    *   Sets the page of the glyph-texture that contains the glyph.
+    *
+    * @param[in] page
+    *   The page index, less than the font face's number of pages.
+    */
+    void setPage(unsigned int page);
+
     /**
     * @brief
     *   Check if a glyph is depictable/renderable
@@ -246,12 +267,23 @@ public:
     */
     void setKerning(GlyphIndex subsequentIndex, float kerning);
 
+    /**
+    * @brief
+    *   All kerning values of the glyph by subsequent glyph index in pt,
+    *   e.g., to write a font face back to file.
+    *
+    * @return
+    *   The kerning values w.r.t. to the subsequent glyphs in pt.
+    */
+    const std::unordered_map<GlyphIndex, float> & kernings() const;
+
 protected:
 
     GlyphIndex m_index;
 
     glm::vec2 m_subtextureOrigin;
     glm::vec2 m_subtextureExtent;
+    unsigned int m_page;
 
     glm::vec2 m_bearing;
     float     m_advance;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/TrueTypeFont.h>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+/**
+*  @brief
+*   Converts glyph outlines into signed distance fields as used by the glyph
+*   shaders: 0.5 on the outline, increasing inwards.
+*
+*   The outline is filled with the nonzero winding rule on a grid with
+*   oversampling x oversampling samples per pixel. The exact euclidean
+*   distances of all samples to the nearest sample of the opposite side (see
+*   squaredDistanceTransform) are averaged per pixel and mapped linearly from
+*   [padding, -padding] pixels to [0, 1], i.e., a texel at padding pixels
+*   outside of the outline is 0.
+*
+*   Instances are immutable and may be used from several threads.
+*/
+class OPENLL_API GlyphRasterizer
+{
+public:
+    struct DistanceField
+    {
+        // pixel bounds of the outline relative to the glyph origin
+        glm::ivec2 lowerLeft;
+        glm::ivec2 upperRight;
+        // upperRight - lowerLeft + 2 * padding; zero for empty outlines
+        glm::ivec2 extent;
+        // extent.x * extent.y texels, rows from bottom to top
+        std::vector<unsigned char> texels;
+    };
+
+public:
+    explicit GlyphRasterizer(int padding = 8, int oversampling = 4);
+
+    int padding() const;
+    int oversampling() const;
+
+    // outline in pixels, e.g., TrueTypeFont::outline with a scale of pixels per font unit
+    DistanceField rasterize(const TrueTypeFont::Outline & outline) const;
+
+protected:
+    int m_padding;
+    int m_oversampling;
+};
+
+
+} // namespace gloperate_text
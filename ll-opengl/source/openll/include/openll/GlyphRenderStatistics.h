@@ -0,0 +1,111 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include <globjects/base/ref_ptr.h>
+#include <globjects/Query.h>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+/**
+*  @brief
+*   Per-frame cost of the glyph rendering (see GlyphRenderer::setStatistics).
+*
+*   Counts draw calls, submitted glyphs and the bytes uploaded by the rendered
+*   vertex clouds. Optionally, the GPU time of each draw call is measured by
+*   GL_TIME_ELAPSED queries (OpenGL 3.3 or ARB_timer_query, also provided by
+*   llvmpipe). Query results are only read once available, i.e., usually one
+*   frame later, so that the pipeline never stalls; the queries of pending
+*   frames are double-buffered and only grow beyond that if the GPU lags behind.
+*
+*   A current context is required if GPU timing is enabled.
+*/
+class OPENLL_API GlyphRenderStatistics
+{
+public:
+    struct Frame
+    {
+        unsigned long long index;
+        unsigned int drawCalls;
+        size_t glyphs;
+        size_t uploadedBytes;
+        // GPU time per draw call in milliseconds, negative until the query result is available;
+        // empty without GPU timing
+        std::vector<double> gpuTimes;
+        // number of negative gpuTimes
+        unsigned int pendingTimings;
+
+        // total GPU time in milliseconds, negative while query results are pending
+        double gpuTime() const;
+    };
+
+    // aggregated over all complete frames
+    struct Summary
+    {
+        unsigned long long frames;
+        unsigned long long drawCalls;
+        unsigned long long glyphs;
+        unsigned long long uploadedBytes;
+        // over frames with at least one draw call, 0 without GPU timing
+        double meanGpuTime;
+        double maxGpuTime;
+    };
+
+public:
+    // history is the number of frames kept for frames()
+    explicit GlyphRenderStatistics(bool gpuTiming = true, size_t history = 120);
+    virtual ~GlyphRenderStatistics();
+
+    bool gpuTiming() const;
+
+    // closes the current frame, reads the available query results and starts the next frame
+    void beginFrame();
+
+    const Frame & currentFrame() const;
+    // the latest frame with all GPU times available, nullptr if there is none
+    const Frame * lastCompleteFrame() const;
+    // oldest first, including the current frame
+    const std::deque<Frame> & frames() const;
+    const Summary & summary() const;
+
+    void reset();
+
+    // called by GlyphRenderer around each draw call
+    void beginDraw();
+    void endDraw(size_t glyphs, size_t uploadedBytes);
+
+protected:
+    struct PendingQuery
+    {
+        globjects::ref_ptr<globjects::Query> query;
+        unsigned long long frame;
+        unsigned int drawCall;
+    };
+
+    void collectQueries();
+    void complete(const Frame & frame);
+    Frame * frame(unsigned long long index);
+
+protected:
+    bool m_gpuTiming;
+    size_t m_history;
+
+    std::deque<Frame> m_frames;
+    Summary m_summary;
+    unsigned long long m_timedFrames;
+    // the frames are complete up to this index (exclusive)
+    unsigned long long m_completeFrames;
+
+    std::vector<PendingQuery> m_pendingQueries;
+    std::vector<globjects::ref_ptr<globjects::Query>> m_freeQueries;
+    globjects::ref_ptr<globjects::Query> m_activeQuery;
+};
+
+
+} // namespace gloperate_text
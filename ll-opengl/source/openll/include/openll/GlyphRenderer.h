@@ -5,6 +5,8 @@
 #include <globjects/Shader.h>
 #include <globjects/Program.h>
 
+#include <openll/RenderBackend.h>
+
 #include <openll/openll_api.h>
 
 
@@ -13,6 +15,8 @@ namespace gloperate_text
 
 
 class GlyphVertexCloud;
+class GlyphRenderStatistics;
+class RenderBackend;
 
 
 class OPENLL_API GlyphRenderer
@@ -23,17 +27,31 @@ public:
     GlyphRenderer();
     GlyphRenderer(globjects::Shader * fragmentShader);
     GlyphRenderer(globjects::Program * program);
+    // draws through backend, e.g., NullRenderBackend; program may be nullptr for backends without shaders
+    explicit GlyphRenderer(RenderBackend * backend, globjects::Program * program = nullptr);
     virtual ~GlyphRenderer();
 
     globjects::Program * program();
     const globjects::Program * program() const;
 
+    RenderBackend * backend() const;
+
     void render(const GlyphVertexCloud & vertexCloud) const;
     void renderInWorld(const GlyphVertexCloud & vertexCloud, const glm::mat4 & viewProjection) const;
 
+    // records the draw calls into the statistics, which are not owned; nullptr disables the statistics
+    GlyphRenderStatistics * statistics() const;
+    void setStatistics(GlyphRenderStatistics * statistics);
+
+protected:
+
+    void draw(const GlyphVertexCloud & vertexCloud, const glm::mat4 & viewProjection) const;
+
 protected:
 
+    globjects::ref_ptr<RenderBackend> m_backend;
     globjects::ref_ptr<globjects::Program> m_program;
+    GlyphRenderStatistics * m_statistics;
 };
 
 
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include <glm/fwd.hpp>
+#include <glm/vec2.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec4.hpp>
 
@@ -72,10 +73,26 @@ public:
 
     const glm::mat4 & transform() const;
 
+    /**
+    * @brief
+    *   Width and height of the typeset sequence (see Typesetter::extent).
+    *
+    *   The extent is computed by a dry-run typesetting on first access
+    *   and cached afterwards. The cache is invalidated by all setters
+    *   affecting the layout, i.e., string, word wrap, line width, font
+    *   face, font size, and the additional transform, as well as by changes
+    *   of the font face itself (see FontFace::revision).
+    *
+    * @return
+    *   The transformed extent of the sequence.
+    */
+    const glm::vec2 & extent() const;
+
 	void setFromConfig(const GlyphSequenceConfig config);
 
 protected:
     void computeTransform() const;
+    void invalidateExtent();
 
 protected:
     std::u32string m_string;
@@ -94,6 +111,11 @@ protected:
     glm::mat4 m_additionalTransform;
     mutable bool m_transformValid;
     mutable glm::mat4 m_transform;
+
+    mutable bool m_extentValid;
+    mutable glm::vec2 m_extent;
+    // the font face revision the extent was computed for
+    mutable unsigned long long m_extentRevision;
 };
 
 
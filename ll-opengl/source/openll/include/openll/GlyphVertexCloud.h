@@ -19,6 +19,7 @@ namespace gloperate_text
 
 class FontFace;
 class GlyphSequence;
+class RenderBackend;
 
 
 class OPENLL_API GlyphVertexCloud
@@ -33,19 +34,32 @@ public:
         glm::vec4 uvRect;
         glm::vec4 fontColor;
         unsigned int superSampling;
+        // layer of the glyph texture array (see Glyph::page)
+        unsigned int page;
     };
 
     using Vertices = std::vector<Vertex>;
 
 public:
-    GlyphVertexCloud();
+    // uploads through backend; without backend, the shared OpenGL backend is used from the first update (see GLRenderBackend::instance)
+    explicit GlyphVertexCloud(RenderBackend * backend = nullptr);
     virtual ~GlyphVertexCloud();
 
+    // defined where RenderBackend is complete
+    GlyphVertexCloud(const GlyphVertexCloud & other);
+    GlyphVertexCloud(GlyphVertexCloud && other);
+    GlyphVertexCloud & operator=(const GlyphVertexCloud & other);
+    GlyphVertexCloud & operator=(GlyphVertexCloud && other);
+
+    RenderBackend * backend() const;
+
     const globjects::Texture * texture() const;
     void setTexture(globjects::Texture * texture);
 
+    // the vertex buffer of the OpenGL backend
     gloperate_text::Drawable * drawable();
     const gloperate_text::Drawable * drawable() const;
+    void setDrawable(gloperate_text::Drawable * drawable);
 
     Vertices & vertices();
     const Vertices & vertices() const;
@@ -55,15 +69,30 @@ public:
     void update(const Vertices & vertices);
 
     void optimize(const std::vector<GlyphSequence> & sequences);
+    // the sequences are not copied, e.g., if they are owned by other objects
+    void optimize(const std::vector<const GlyphSequence *> & sequences);
+    // the vertices sorted by pages and glyphs as uploaded by optimize, does not require an OpenGL context
+    Vertices optimizedVertices(const std::vector<GlyphSequence> & sequences) const;
+    Vertices optimizedVertices(const std::vector<const GlyphSequence *> & sequences) const;
+
+    // the number of vertices uploaded by the last update
+    size_t uploadedSize() const;
+    // bytes uploaded by update since the last call, used for the statistics of GlyphRenderer
+    size_t takeUploadedBytes() const;
 
 protected:
-    static gloperate_text::Drawable * createDrawable();
+    // the vertices sorted by pages and the given depictable characters of all sequences
+    Vertices optimizedVertices(const std::vector<char32_t> & depictableChars) const;
 
 protected:
     Vertices m_vertices;
 
+    globjects::ref_ptr<RenderBackend> m_backend;
     globjects::ref_ptr<gloperate_text::Drawable> m_drawable;
     globjects::ref_ptr<globjects::Texture> m_texture;
+
+    size_t m_uploadedSize;
+    mutable size_t m_uploadedBytes;
 };
 
 
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+
+namespace gloperate_text
+{
+
+
+/**
+*  @brief
+*   Objects addressed by 32 bit handles, as used by the C API (see ll.h).
+*
+*   The objects live in a dense array of slots; a handle holds the slot
+*   index + 1 in its lower and the generation of the slot in its upper 16
+*   bits. The generation is incremented when an object is inserted into or
+*   erased from the slot, so live slots have odd generations and stale
+*   handles of erased objects no longer match. Validation and lookup are a
+*   bounds check and a comparison, without hashing or allocation. Slots of
+*   erased objects are reused last in, first out; the generation wraps
+*   around after 32768 reuses of a slot.
+*
+*   The handle 0 is never valid.
+*/
+template <typename T>
+class HandleTable
+{
+public:
+    using Handle = std::uint32_t;
+
+    // limited by the 16 bits of the slot index
+    static const size_t maxObjects = 0xffff;
+
+public:
+    HandleTable();
+
+    // returns 0 if maxObjects objects exist
+    Handle insert(T object);
+    // resets the slot to T(), false for invalid handles
+    bool erase(Handle handle);
+
+    bool contains(Handle handle) const;
+    // nullptr for invalid handles
+    T * get(Handle handle);
+    const T * get(Handle handle) const;
+
+    size_t size() const;
+
+protected:
+    static size_t slot(Handle handle);
+    static std::uint16_t generation(Handle handle);
+
+protected:
+    std::vector<T> m_objects;
+    std::vector<std::uint16_t> m_generations;
+    std::vector<std::uint16_t> m_freeSlots;
+};
+
+
+} // namespace gloperate_text
+
+
+#include <openll/HandleTable.inl>
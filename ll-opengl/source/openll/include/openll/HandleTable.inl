@@ -0,0 +1,94 @@
+#pragma once
+
+#include <utility>
+
+
+namespace gloperate_text
+{
+
+
+template <typename T>
+const size_t HandleTable<T>::maxObjects;
+
+template <typename T>
+HandleTable<T>::HandleTable()
+{
+}
+
+template <typename T>
+typename HandleTable<T>::Handle HandleTable<T>::insert(T object)
+{
+    size_t index;
+    if (!m_freeSlots.empty())
+    {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_objects[index] = std::move(object);
+    }
+    else
+    {
+        if (m_objects.size() == maxObjects)
+            return 0;
+
+        index = m_objects.size();
+        m_objects.push_back(std::move(object));
+        m_generations.push_back(0);
+    }
+
+    const auto generation = ++m_generations[index];
+    return (static_cast<Handle>(generation) << 16) | static_cast<Handle>(index + 1);
+}
+
+template <typename T>
+bool HandleTable<T>::erase(Handle handle)
+{
+    if (!contains(handle))
+        return false;
+
+    const auto index = slot(handle);
+    m_objects[index] = T();
+    ++m_generations[index];
+    m_freeSlots.push_back(static_cast<std::uint16_t>(index));
+    return true;
+}
+
+template <typename T>
+bool HandleTable<T>::contains(Handle handle) const
+{
+    const auto index = slot(handle);
+    return index < m_generations.size() && m_generations[index] == generation(handle) && (m_generations[index] & 1u) != 0;
+}
+
+template <typename T>
+T * HandleTable<T>::get(Handle handle)
+{
+    return contains(handle) ? &m_objects[slot(handle)] : nullptr;
+}
+
+template <typename T>
+const T * HandleTable<T>::get(Handle handle) const
+{
+    return contains(handle) ? &m_objects[slot(handle)] : nullptr;
+}
+
+template <typename T>
+size_t HandleTable<T>::size() const
+{
+    return m_objects.size() - m_freeSlots.size();
+}
+
+template <typename T>
+size_t HandleTable<T>::slot(Handle handle)
+{
+    // handle 0 wraps around to an index out of bounds
+    return static_cast<size_t>(static_cast<std::uint16_t>((handle & 0xffffu) - 1u));
+}
+
+template <typename T>
+std::uint16_t HandleTable<T>::generation(Handle handle)
+{
+    return static_cast<std::uint16_t>(handle >> 16);
+}
+
+
+} // namespace gloperate_text
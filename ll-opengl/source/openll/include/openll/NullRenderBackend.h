@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+
+#include <openll/RenderBackend.h>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+/**
+*  @brief
+*   Backend without graphics API, records the number of calls and bytes.
+*
+*   No textures or buffers are created, so the font faces and vertex clouds
+*   handled by this backend cannot be drawn by another one.
+*/
+class OPENLL_API NullRenderBackend : public RenderBackend
+{
+public:
+    struct Counters
+    {
+        unsigned int textures;
+        size_t textureBytes;
+        unsigned int textureUpdates;
+        size_t updatedTextureBytes;
+        unsigned int uploads;
+        size_t uploadedBytes;
+        unsigned int drawCalls;
+        // the uploaded vertices of the drawn vertex clouds
+        size_t drawnGlyphs;
+    };
+
+public:
+    NullRenderBackend();
+    virtual ~NullRenderBackend();
+
+    const Counters & counters() const;
+    void reset();
+
+    virtual void createGlyphTexture(FontFace & fontFace) override;
+    virtual void updateGlyphTexture(FontFace & fontFace, const glm::ivec2 & offset, const glm::ivec2 & extent, unsigned int page) override;
+    virtual void uploadVertices(GlyphVertexCloud & vertexCloud, const GlyphVertexCloud::Vertices & vertices) override;
+    virtual void draw(const GlyphVertexCloud & vertexCloud, globjects::Program * program, const glm::mat4 & viewProjection) override;
+
+protected:
+    Counters m_counters;
+};
+
+
+} // namespace gloperate_text
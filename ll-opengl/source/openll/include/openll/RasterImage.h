@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+/**
+*  @brief
+*   RGBA8 image in main memory, the render target of SoftwareGlyphRenderer.
+*
+*   Rows are stored from bottom to top, i.e., in the layout of glReadPixels,
+*   so that images rendered by GlyphRenderer can be compared directly.
+*/
+class OPENLL_API RasterImage
+{
+public:
+    RasterImage();
+    explicit RasterImage(const glm::ivec2 & extent, const glm::vec4 & clearColor = glm::vec4(0.f));
+
+    const glm::ivec2 & extent() const;
+    void resize(const glm::ivec2 & extent);
+
+    void clear(const glm::vec4 & color);
+
+    // 4 bytes per pixel, extent().x * extent().y pixels
+    std::uint8_t * data();
+    const std::uint8_t * data() const;
+
+    // the RGBA components of the pixel, (0, 0) is the lower left pixel
+    std::uint8_t * pixel(int x, int y);
+    const std::uint8_t * pixel(int x, int y) const;
+
+protected:
+    glm::ivec2 m_extent;
+    std::vector<std::uint8_t> m_pixels;
+};
+
+
+} // namespace gloperate_text
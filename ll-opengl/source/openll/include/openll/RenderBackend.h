@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/fwd.hpp>
+
+#include <globjects/base/Referenced.h>
+
+#include <openll/GlyphVertexCloud.h>
+
+#include <openll/openll_api.h>
+
+
+namespace globjects
+{
+class Program;
+}
+
+
+namespace gloperate_text
+{
+
+
+class FontFace;
+
+
+/**
+*  @brief
+*   The graphics API calls of the glyph rendering.
+*
+*   FontLoader creates the glyph textures, DynamicGlyphAtlas updates them,
+*   GlyphVertexCloud uploads its
+*   vertices, and GlyphRenderer draws through a backend. GLRenderBackend
+*   is the OpenGL implementation used by default; NullRenderBackend only
+*   counts the calls and bytes, so that the CPU side of the pipeline can be
+*   tested and profiled without a context.
+*
+*   Backend specific state is kept in the objects passed, e.g., the drawable
+*   of a vertex cloud or the glyph texture of a font face.
+*/
+class OPENLL_API RenderBackend : public globjects::Referenced
+{
+public:
+    RenderBackend();
+    virtual ~RenderBackend();
+
+    // creates the glyph texture array of fontFace from its glyph image, one layer per page (see FontFace::glyphImage)
+    virtual void createGlyphTexture(FontFace & fontFace) = 0;
+    // updates a rectangle of a page of the glyph texture from the glyph image, e.g., for glyphs added to a DynamicGlyphAtlas
+    virtual void updateGlyphTexture(FontFace & fontFace, const glm::ivec2 & offset, const glm::ivec2 & extent, unsigned int page) = 0;
+
+    // replaces the contents of the vertex buffer of vertexCloud by vertices
+    virtual void uploadVertices(GlyphVertexCloud & vertexCloud, const GlyphVertexCloud::Vertices & vertices) = 0;
+
+    // draws the uploaded vertices of vertexCloud with its texture; program may be
+    // nullptr for backends without shaders
+    virtual void draw(const GlyphVertexCloud & vertexCloud, globjects::Program * program, const glm::mat4 & viewProjection) = 0;
+};
+
+
+} // namespace gloperate_text
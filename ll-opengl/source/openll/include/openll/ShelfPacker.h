@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+/**
+*  @brief
+*   Allocates rectangles in rows (shelves) of a fixed area and allows
+*   releasing them again, the allocator of DynamicGlyphAtlas.
+*
+*   A rectangle goes to the lowest fitting shelf not much taller than the
+*   rectangle, to the left-most free span that is wide enough; a new shelf
+*   is opened on top if there is none. Released rectangles return their span
+*   to the shelf, adjacent spans are merged and empty shelves at the top are
+*   closed. Unlike SkylinePacker, space can be reused in any order, at the
+*   price of the height lost to lower glyphs on a shelf.
+*/
+class OPENLL_API ShelfPacker
+{
+public:
+    explicit ShelfPacker(const glm::ivec2 & extent);
+
+    const glm::ivec2 & extent() const;
+    // the sum of the areas of the allocated rectangles
+    long long allocatedArea() const;
+
+    // position is the lower left corner; false if there is no space for the rectangle
+    bool allocate(const glm::ivec2 & size, glm::ivec2 & position);
+    // the position and size of a rectangle allocated before
+    void release(const glm::ivec2 & position, const glm::ivec2 & size);
+
+    void clear();
+
+protected:
+    struct Span
+    {
+        int x;
+        int width;
+    };
+
+    struct Shelf
+    {
+        int y;
+        int height;
+        // sorted by x
+        std::vector<Span> free;
+    };
+
+    static bool allocate(Shelf & shelf, int width, int & x);
+
+protected:
+    glm::ivec2 m_extent;
+    // sorted by y
+    std::vector<Shelf> m_shelves;
+    int m_top;
+    long long m_allocatedArea;
+};
+
+
+} // namespace gloperate_text
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+/**
+*  @brief
+*   Packs rectangles into a fixed area with the bottom-left skyline
+*   heuristic (Jylänki, "A Thousand Ways to Pack the Bin").
+*
+*   The skyline is the upper contour of all rectangles placed so far; a new
+*   rectangle is put on the segment where its top ends up lowest, ties are
+*   broken by the narrower segment. Free space below the skyline is not
+*   reused, which keeps insertion linear in the number of skyline segments.
+*/
+class OPENLL_API SkylinePacker
+{
+public:
+    explicit SkylinePacker(const glm::ivec2 & extent);
+
+    const glm::ivec2 & extent() const;
+    // the top of the highest rectangle
+    int height() const;
+
+    // position is the lower left corner; false if the rectangle does not fit anymore
+    bool pack(const glm::ivec2 & size, glm::ivec2 & position);
+
+    void clear();
+
+    // packs boxes with gutter texels in between into the smallest power of two atlas up to maximumExtent,
+    // trying w x w/2 before w x w; boxes of zero width are put at the origin
+    static bool packAtlas(const std::vector<glm::ivec2> & boxes, int gutter, int maximumExtent
+        , glm::ivec2 & extent, std::vector<glm::ivec2> & positions);
+    // packs boxes into as many pages of maximumExtent x maximumExtent as needed, first fit in page order
+    static bool packPages(const std::vector<glm::ivec2> & boxes, int gutter, int maximumExtent
+        , std::vector<unsigned int> & pages, std::vector<glm::ivec2> & positions);
+
+protected:
+    struct Segment
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    // the y at which the rectangle fits on the skyline starting at segment index, or -1
+    int fit(size_t index, const glm::ivec2 & size) const;
+
+protected:
+    glm::ivec2 m_extent;
+    std::vector<Segment> m_skyline;
+};
+
+
+} // namespace gloperate_text
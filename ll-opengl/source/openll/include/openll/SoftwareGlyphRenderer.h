@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/fwd.hpp>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+class FontFace;
+class GlyphVertexCloud;
+class RasterImage;
+
+
+/**
+*  @brief
+*   Renders glyph vertex clouds on the CPU, e.g., for servers without GPU
+*   or as reference in image comparisons with GlyphRenderer.
+*
+*   Mirrors the glyph shaders: each vertex is expanded to a quad, the
+*   distance field is sampled bilinearly from FontFace::glyphImage (loaded
+*   with FontLoader::setKeepGlyphImage if a glyph texture is created), fragments
+*   below 0.3 are discarded and the coverage is the smoothstep of the
+*   distance around 0.5 for the supersampling pattern of the vertex. The
+*   result is blended into the image as with
+*   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA).
+*
+*   As on the GPU, the derivatives for fwidth are the differences within 2x2
+*   pixel quads. Texture filtering is evaluated in floating point, so results
+*   may differ slightly from GPUs with reduced filtering precision. Quads with
+*   a vertex behind the camera are skipped instead of clipped.
+*
+*   The image is split into tiles that are rendered in parallel; each tile
+*   blends the overlapping glyphs in vertex order, so that the result does
+*   not depend on the number of threads.
+*/
+class OPENLL_API SoftwareGlyphRenderer
+{
+public:
+    // threads = 0 uses one thread per core
+    explicit SoftwareGlyphRenderer(unsigned int threads = 0, int tileSize = 64);
+    virtual ~SoftwareGlyphRenderer();
+
+    unsigned int threads() const;
+    int tileSize() const;
+
+    // the font face provides the glyph atlas the vertex cloud was prepared with
+    void render(const GlyphVertexCloud & vertexCloud, const FontFace & fontFace, RasterImage & image) const;
+    void renderInWorld(const GlyphVertexCloud & vertexCloud, const FontFace & fontFace, const glm::mat4 & viewProjection, RasterImage & image) const;
+
+protected:
+    unsigned int m_threads;
+    int m_tileSize;
+};
+
+
+} // namespace gloperate_text
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+/**
+*  @brief
+*   Work-stealing thread pool for data parallel loops (see TilePipeline).
+*
+*   run deals the task indices to per-thread queues in contiguous ranges;
+*   each thread processes its own range in order and, once it is done,
+*   steals single indices from the end of the other queues. The threads are
+*   kept alive between calls and the calling thread takes part in the work.
+*/
+class OPENLL_API TaskPool
+{
+public:
+    // threads = 0 uses one thread per core; the calling thread of run counts as one of them
+    explicit TaskPool(unsigned int threads = 0);
+    virtual ~TaskPool();
+
+    TaskPool(const TaskPool &) = delete;
+    TaskPool & operator=(const TaskPool &) = delete;
+
+    unsigned int threads() const;
+
+    // calls task(index) for all indices in [0, count) and returns once all calls returned;
+    // the first exception thrown by a task is rethrown after all other tasks finished.
+    // Must not be called concurrently or from within a task of the same pool.
+    void run(size_t count, const std::function<void(size_t)> & task);
+
+protected:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<size_t> indices;
+    };
+
+    void work(size_t worker);
+    void execute(size_t worker);
+    bool pop(size_t worker, size_t & index);
+
+protected:
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    unsigned long long m_generation;
+    unsigned int m_active;
+    bool m_stop;
+
+    const std::function<void(size_t)> * m_task;
+    std::atomic<size_t> m_remaining;
+    std::exception_ptr m_exception;
+};
+
+
+} // namespace gloperate_text
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <openll/GlyphVertexCloud.h>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+class FontFace;
+class RasterImage;
+class TaskPool;
+struct Label;
+
+
+/**
+*  @brief
+*   Batch preparation of label imagery for a z/x/y tile pyramid, e.g., to
+*   warm up a tile cache on a server.
+*
+*   prepare places the labels once for the whole dataset and typesets all
+*   displayed labels in parallel. The glyph quads are then bucketed into the
+*   tiles they overlap, extended by a halo border, and each tile is handed to
+*   a callback or rendered by SoftwareGlyphRenderer on a work-stealing pool.
+*   As every tile sees the same globally placed quads, labels crossing tile
+*   borders continue seamlessly in the neighbouring tiles.
+*
+*   The labels are given in world coordinates; zoom level z divides the
+*   world rectangle into 2^z x 2^z tiles, with tile (0, 0) in the upper left
+*   corner as in common web map tile schemes. Glyph sizes are not scaled
+*   with the zoom level, so labels for different zoom levels are prepared
+*   separately.
+*/
+class OPENLL_API TilePipeline
+{
+public:
+    struct TileId
+    {
+        unsigned int z;
+        unsigned int x;
+        unsigned int y;
+    };
+
+    struct Tile
+    {
+        TileId id;
+        // the world rectangle of the tile, without halo
+        glm::vec2 lowerLeft;
+        glm::vec2 upperRight;
+        // maps the world rectangle to normalized device coordinates
+        glm::mat4 viewProjection;
+        // in world coordinates and in label order
+        GlyphVertexCloud::Vertices vertices;
+    };
+
+    // called concurrently from the threads of the pool
+    using TileCallback = std::function<void(const Tile & tile)>;
+    using ImageCallback = std::function<void(const Tile & tile, const RasterImage & image)>;
+
+    using LayoutFunction = std::function<void(std::vector<Label> & labels)>;
+
+public:
+    // tileSize and halo in pixels; without pool, a pool with one thread per core is created
+    TilePipeline(const glm::vec2 & worldLowerLeft, const glm::vec2 & worldUpperRight, int tileSize = 256, int halo = 16, TaskPool * pool = nullptr);
+    virtual ~TilePipeline();
+
+    int tileSize() const;
+    int halo() const;
+    TaskPool & pool() const;
+
+    // places the labels by layout (if given) and typesets the displayed ones
+    void prepare(std::vector<Label> & labels, const LayoutFunction & layout = nullptr);
+    // the glyphs of the displayed labels in world coordinates
+    const GlyphVertexCloud::Vertices & vertices() const;
+
+    // the tiles of zoom level z with at least one glyph quad in the tile or its halo
+    std::vector<TileId> tiles(unsigned int z) const;
+
+    // calls callback for each of the tiles in parallel, also for tiles without glyphs
+    void process(const std::vector<TileId> & tiles, const TileCallback & callback) const;
+    // renders each of the tiles into a tileSize x tileSize image cleared to clearColor
+    void render(const std::vector<TileId> & tiles, const FontFace & fontFace, const ImageCallback & callback, const glm::vec4 & clearColor = glm::vec4(0.f)) const;
+
+protected:
+    using Buckets = std::vector<std::pair<std::uint64_t, std::uint32_t>>;
+
+    // (tile key, vertex index) sorted by tile key, in label order per tile
+    Buckets bucket(unsigned int z) const;
+    Tile makeTile(const TileId & id) const;
+    glm::vec2 tileExtent(unsigned int z) const;
+
+    static std::uint64_t key(unsigned int x, unsigned int y);
+
+protected:
+    glm::vec2 m_worldLowerLeft;
+    glm::vec2 m_worldUpperRight;
+    int m_tileSize;
+    int m_halo;
+
+    std::unique_ptr<TaskPool> m_ownPool;
+    TaskPool * m_pool;
+
+    GlyphVertexCloud::Vertices m_vertices;
+};
+
+
+} // namespace gloperate_text
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+/**
+*  @brief
+*   Records timed zones and counters for attributing frame time to the stages of openll.
+*
+*   The events are kept in memory per thread and written as Chrome trace_event
+*   JSON, which can be opened in chrome://tracing or https://ui.perfetto.dev.
+*   Nothing is recorded until start is called. The OPENLL_TRACE_ZONE and
+*   OPENLL_TRACE_COUNTER macros used within openll compile to nothing unless
+*   OPENLL_TRACING is defined (see OPTION_ENABLE_TRACING).
+*
+*   Names are not copied and have to outlive the trace, e.g., string literals.
+*/
+class OPENLL_API Trace
+{
+public:
+    // discards all recorded events and starts recording
+    static void start();
+    static void stop();
+    static bool recording();
+
+    // number of recorded zones and counter values
+    static size_t size();
+    static void clear();
+
+    static void write(std::ostream & stream);
+    // returns false if the file cannot be written
+    static bool write(const std::string & filename);
+
+    // microseconds since the start of the recording
+    static double now();
+    static void zone(const char * name, double begin, double end);
+    static void counter(const char * name, double value);
+};
+
+
+// Records the lifetime of this object as zone (see OPENLL_TRACE_ZONE)
+class OPENLL_API TraceZone
+{
+public:
+    explicit TraceZone(const char * name);
+    ~TraceZone();
+
+    TraceZone(const TraceZone &) = delete;
+    TraceZone & operator=(const TraceZone &) = delete;
+
+protected:
+    const char * m_name;
+    // negative if not recording
+    double m_begin;
+};
+
+
+} // namespace gloperate_text
+
+
+#define OPENLL_TRACE_JOIN_(a, b) a##b
+#define OPENLL_TRACE_JOIN(a, b) OPENLL_TRACE_JOIN_(a, b)
+
+#if defined(OPENLL_TRACING)
+// times the enclosing scope
+#define OPENLL_TRACE_ZONE(name) const gloperate_text::TraceZone OPENLL_TRACE_JOIN(openllTraceZone, __LINE__)(name)
+// the value is not evaluated if tracing is disabled
+#define OPENLL_TRACE_COUNTER(name, value) gloperate_text::Trace::counter(name, static_cast<double>(value))
+#else
+#define OPENLL_TRACE_ZONE(name)
+#define OPENLL_TRACE_COUNTER(name, value)
+#endif
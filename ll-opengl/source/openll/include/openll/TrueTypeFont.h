@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+
+namespace gloperate_text
+{
+
+
+/**
+*  @brief
+*   Minimal reader for TrueType fonts (.ttf, first font of a .ttc), the input
+*   of FontFaceGenerator.
+*
+*   Reads the tables needed to generate a FontFace: character to glyph
+*   mapping (cmap formats 4 and 12), horizontal metrics, quadratic glyph
+*   outlines including composite glyphs, and pair kerning from the kern table
+*   (format 0). Hinting is ignored. Fonts with CFF outlines (.otf) and
+*   kerning given only in GPOS are not supported; isValid() is false for the
+*   former, kerning() is zero for the latter.
+*
+*   All metrics are in font units; see unitsPerEm().
+*/
+class OPENLL_API TrueTypeFont
+{
+public:
+    using Contour = std::vector<glm::vec2>;
+    // closed polygons, filled by the nonzero winding rule
+    using Outline = std::vector<Contour>;
+
+    struct KerningPair
+    {
+        std::uint32_t left;  // glyph ids
+        std::uint32_t right;
+        std::int16_t value;
+    };
+
+public:
+    explicit TrueTypeFont(const std::string & filePath);
+    explicit TrueTypeFont(std::vector<std::uint8_t> data);
+    virtual ~TrueTypeFont();
+
+    bool isValid() const;
+
+    // first family name entry of the name table, empty if there is none in ASCII compatible encoding
+    const std::string & familyName() const;
+
+    int unitsPerEm() const;
+    // from hhea; descender is usually negative
+    int ascender() const;
+    int descender() const;
+    int lineGap() const;
+
+    std::uint32_t glyphCount() const;
+
+    // 0 (.notdef) for unmapped code points
+    std::uint32_t glyphId(std::uint32_t codepoint) const;
+    // all mapped code points in ascending order
+    std::vector<std::uint32_t> codepoints() const;
+
+    int advance(std::uint32_t glyph) const;
+    int kerning(std::uint32_t left, std::uint32_t right) const;
+    const std::vector<KerningPair> & kerningPairs() const;
+
+    // control box of the outline, false for empty glyphs
+    bool bounds(std::uint32_t glyph, glm::vec2 & lowerLeft, glm::vec2 & upperRight) const;
+
+    // the outline scaled by scale, with curves flattened to the given tolerance in scaled units
+    Outline outline(std::uint32_t glyph, float scale, float tolerance = 0.1f) const;
+
+protected:
+    bool parse();
+    bool parseCmap(std::uint32_t offset, std::uint32_t length);
+    void parseKern(std::uint32_t offset, std::uint32_t length);
+    void parseName(std::uint32_t offset, std::uint32_t length);
+
+    // the glyf range of the glyph, false for empty glyphs
+    bool glyphRange(std::uint32_t glyph, std::uint32_t & offset, std::uint32_t & length) const;
+    void appendOutline(std::uint32_t glyph, const float transform[6], float tolerance, Outline & outline, int depth) const;
+
+    std::uint8_t u8(std::uint32_t offset) const;
+    std::uint16_t u16(std::uint32_t offset) const;
+    std::int16_t i16(std::uint32_t offset) const;
+    std::uint32_t u32(std::uint32_t offset) const;
+
+protected:
+    std::vector<std::uint8_t> m_data;
+    bool m_valid;
+
+    std::string m_familyName;
+    int m_unitsPerEm;
+    int m_ascender;
+    int m_descender;
+    int m_lineGap;
+
+    std::uint32_t m_glyphCount;
+    std::uint32_t m_horizontalMetricsCount;
+    bool m_longLocations;
+
+    std::uint32_t m_glyf;
+    std::uint32_t m_glyfLength;
+    std::uint32_t m_loca;
+    std::uint32_t m_hmtx;
+
+    // (code point, glyph id), sorted by code point
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> m_characterMap;
+    // sorted by (left, right)
+    std::vector<KerningPair> m_kerningPairs;
+};
+
+
+} // namespace gloperate_text
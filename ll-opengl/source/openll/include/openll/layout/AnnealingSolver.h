@@ -0,0 +1,168 @@
+#pragma once
+
+#include <vector>
+#include <random>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+#include <openll/layout/algorithm.h>
+#include <openll/layout/CollisionGraph.h>
+#include <openll/layout/CounterRandom.h>
+#include <openll/layout/LabelArea.h>
+#include <openll/layout/LayoutBudget.h>
+#include <openll/layout/penalties.h>
+
+namespace gloperate_text
+{
+
+struct Label;
+struct LabelPlacement;
+
+namespace layout
+{
+
+// Temperature schedule of the annealing solvers, the temperature drops after a number of steps or accepted changes
+// proportional to the annealed labels (based on https://www.eecs.harvard.edu/shieber/Biblio/Papers/tog-final.pdf)
+class OPENLL_API AnnealingSchedule
+{
+public:
+    AnnealingSchedule();
+
+    // starts again at the initial temperature, the steps are still counted
+    void restart();
+
+    // counts a step over the given number of annealed labels and returns true if the schedule finished;
+    // afterTemperature is called before the temperature drops
+    template <typename Callback>
+    bool advance(bool changed, size_t labelCount, Callback afterTemperature);
+
+    float temperature() const;
+    unsigned long long steps() const;
+
+protected:
+    float m_temperature;
+    unsigned int m_temperatureChanges;
+    unsigned int m_changesAtTemperature;
+    unsigned int m_stepsAtTemperature;
+    unsigned long long m_steps;
+};
+
+// Placement candidates, collision graph, start placement and annealing schedule shared by the annealing solvers
+class OPENLL_API AnnealingState
+{
+public:
+    bool converged() const;
+
+    // the labels have to be the ones the solver was constructed for
+    void apply(std::vector<Label> & labels) const;
+
+    // total penalty of the best placement found so far
+    float penalty() const;
+    unsigned long long steps() const;
+    const std::vector<size_t> & activeLabels() const;
+
+protected:
+    static const unsigned int noAnchor = ~0u;
+
+    AnnealingState(const std::vector<Label> & labels, bool allowSelection, const glm::vec2 & relativePadding, const ObstacleIndex * obstacles);
+    // warm start from the previous placements (see coherentAnnealing)
+    AnnealingState(const std::vector<Label> & labels, const std::vector<LabelPlacement> & previousPlacements, bool allowSelection, const glm::vec2 & relativePadding, float hysteresis, const ObstacleIndex * obstacles);
+
+    void initialize(const std::vector<Label> & labels, const glm::vec2 & relativePadding, const ObstacleIndex * obstacles);
+    // counts a step and returns true if the schedule finished; afterTemperature is called before the temperature drops
+    template <typename Callback>
+    bool advanceSchedule(bool changed, Callback afterTemperature);
+    void keepIfBest(float penalty);
+    // the penalty for leaving the previous placement, none for labels without one
+    float hysteresisPenalty(size_t labelIndex, unsigned int position) const;
+
+protected:
+    bool m_allowSelection;
+    float m_hysteresis;
+
+    std::vector<std::vector<LabelArea>> m_labelAreas;
+    CollisionGraph m_collisionGraph;
+    // added to the label overlaps of each placement
+    std::vector<std::vector<ObstacleOverlap>> m_obstacleOverlaps;
+    std::vector<unsigned int> m_priorities;
+    std::vector<size_t> m_activeLabels;
+
+    // a position index equal to the number of label areas denotes a hidden label
+    std::vector<unsigned int> m_chosenLabels;
+    // the placements the hysteresis refers to, noAnchor for labels without a previous placement
+    std::vector<unsigned int> m_previousLabels;
+    std::vector<unsigned int> m_bestLabels;
+    float m_bestPenalty;
+
+    AnnealingSchedule m_schedule;
+    bool m_converged;
+};
+
+// Resumable simulated annealing (see simulatedAnnealing and coherentAnnealing).
+// The annealing can be continued across frames by calling run with a budget
+// until it converges; apply writes the best placement found so far.
+class OPENLL_API AnnealingSolver : public AnnealingState
+{
+public:
+    AnnealingSolver(const std::vector<Label> & labels, PenaltyFunction penaltyFunction, bool allowSelection = true, const glm::vec2 & relativePadding = {0.2f, 0.2f}, const ObstacleIndex * obstacles = nullptr);
+    // warm start from the previous placements (see coherentAnnealing)
+    AnnealingSolver(const std::vector<Label> & labels, const std::vector<LabelPlacement> & previousPlacements, PenaltyFunction penaltyFunction, bool allowSelection = true, const glm::vec2 & relativePadding = {0.2f, 0.2f}, float hysteresis = 0.5f, const ObstacleIndex * obstacles = nullptr);
+
+    // anneals until convergence or until the budget (of annealing steps) is exceeded and returns true if converged;
+    // the budget starts with the call, the construction of the solver is not included
+    bool run(const LayoutBudget & budget = LayoutBudget());
+    // as above, with a deadline started earlier, e.g., before the construction of the solver
+    bool run(LayoutDeadline & deadline);
+
+protected:
+    // returns true if converged
+    bool step();
+    float labelPenalty(size_t labelIndex, unsigned int position) const;
+    float totalPenalty() const;
+    void checkpoint();
+
+protected:
+    PenaltyFunction * m_penaltyFunction;
+    std::default_random_engine m_generator;
+};
+
+// AnnealingSolver specialized for a penalty functor (see penalties.h), which is inlined into the annealing step.
+// Uses a counter-based random number generator and evaluates the acceptance probability only for worse placements.
+template <typename Penalty>
+class BasicAnnealingSolver : public AnnealingState
+{
+public:
+    BasicAnnealingSolver(const std::vector<Label> & labels, Penalty penalty = Penalty(), bool allowSelection = true, const glm::vec2 & relativePadding = {0.2f, 0.2f}, const ObstacleIndex * obstacles = nullptr);
+    // warm start from the previous placements (see coherentAnnealing)
+    BasicAnnealingSolver(const std::vector<Label> & labels, const std::vector<LabelPlacement> & previousPlacements, Penalty penalty = Penalty(), bool allowSelection = true, const glm::vec2 & relativePadding = {0.2f, 0.2f}, float hysteresis = 0.5f, const ObstacleIndex * obstacles = nullptr);
+
+    // anneals until convergence or until the budget (of annealing steps) is exceeded and returns true if converged;
+    // the budget starts with the call, the construction of the solver is not included
+    bool run(const LayoutBudget & budget = LayoutBudget());
+    // as above, with a deadline started earlier, e.g., before the construction of the solver
+    bool run(LayoutDeadline & deadline);
+
+protected:
+    // returns true if converged
+    bool step();
+    float labelPenalty(size_t labelIndex, unsigned int position) const;
+    float totalPenalty() const;
+    void checkpoint();
+
+protected:
+    Penalty m_penalty;
+    CounterRandom m_random;
+};
+
+// simulatedAnnealing with an inlined penalty functor, e.g., specializedAnnealing<StandardPenalty>(labels)
+template <typename Penalty>
+void specializedAnnealing(std::vector<Label> & labels, Penalty penalty = Penalty(), bool allowSelection = true, const glm::vec2 & relativePadding = {0.2f, 0.2f}, const LayoutBudget & budget = LayoutBudget(), const ObstacleIndex * obstacles = nullptr);
+
+}
+
+}
+
+
+#include <openll/layout/AnnealingSolver.inl>
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cmath>
+
+#include <openll/Trace.h>
+#include <openll/layout/layoutbase.h>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+template <typename Callback>
+bool AnnealingSchedule::advance(bool changed, size_t labelCount, Callback afterTemperature)
+{
+    if (changed)
+        ++m_changesAtTemperature;
+
+    ++m_steps;
+    ++m_stepsAtTemperature;
+    if (m_changesAtTemperature > 5 * labelCount || m_stepsAtTemperature > 20 * labelCount)
+    {
+        // converged
+        if (m_changesAtTemperature == 0) return true;
+        if (m_temperatureChanges == 50) return true;
+
+        afterTemperature();
+
+        m_temperature *= 0.9f;
+        m_changesAtTemperature = 0;
+        m_stepsAtTemperature = 0;
+        ++m_temperatureChanges;
+    }
+    return false;
+}
+
+template <typename Callback>
+bool AnnealingState::advanceSchedule(bool changed, Callback afterTemperature)
+{
+    return m_schedule.advance(changed, m_activeLabels.size(), afterTemperature);
+}
+
+inline float AnnealingState::hysteresisPenalty(size_t labelIndex, unsigned int position) const
+{
+    if (m_previousLabels.empty())
+        return 0.f;
+
+    const auto previous = m_previousLabels[labelIndex];
+    return previous != noAnchor && previous != position ? m_hysteresis : 0.f;
+}
+
+template <typename Penalty>
+BasicAnnealingSolver<Penalty>::BasicAnnealingSolver(const std::vector<Label> & labels, Penalty penalty, bool allowSelection, const glm::vec2 & relativePadding, const ObstacleIndex * obstacles)
+: AnnealingState(labels, allowSelection, relativePadding, obstacles)
+, m_penalty(penalty)
+{
+    checkpoint();
+}
+
+template <typename Penalty>
+BasicAnnealingSolver<Penalty>::BasicAnnealingSolver(const std::vector<Label> & labels, const std::vector<LabelPlacement> & previousPlacements, Penalty penalty, bool allowSelection, const glm::vec2 & relativePadding, float hysteresis, const ObstacleIndex * obstacles)
+: AnnealingState(labels, previousPlacements, allowSelection, relativePadding, hysteresis, obstacles)
+, m_penalty(penalty)
+{
+    checkpoint();
+}
+
+template <typename Penalty>
+bool BasicAnnealingSolver<Penalty>::run(const LayoutBudget & budget)
+{
+    LayoutDeadline deadline(budget);
+    return run(deadline);
+}
+
+template <typename Penalty>
+bool BasicAnnealingSolver<Penalty>::run(LayoutDeadline & deadline)
+{
+    if (m_converged || m_activeLabels.empty())
+        return true;
+
+    OPENLL_TRACE_ZONE("layout::BasicAnnealingSolver::run");
+    while (deadline.iterate())
+    {
+        if (step())
+        {
+            m_converged = true;
+            break;
+        }
+    }
+
+    checkpoint();
+    OPENLL_TRACE_COUNTER("annealing steps", m_schedule.steps());
+    return m_converged;
+}
+
+template <typename Penalty>
+bool BasicAnnealingSolver<Penalty>::step()
+{
+    const auto labelIndex = m_activeLabels[m_random.uniform(static_cast<std::uint32_t>(m_activeLabels.size()))];
+    const auto oldPosition = m_chosenLabels[labelIndex];
+    const auto positionCount = static_cast<std::uint32_t>(m_labelAreas[labelIndex].size() + (m_allowSelection ? 1 : 0));
+
+    // uniform over all positions except the current one
+    auto newPosition = m_random.uniform(positionCount - 1);
+    if (newPosition >= oldPosition)
+        ++newPosition;
+
+    const auto improvement = labelPenalty(labelIndex, oldPosition) - labelPenalty(labelIndex, newPosition);
+    const auto accept = improvement > 0.f || m_random.uniformFloat() < std::exp(improvement / m_schedule.temperature());
+    if (accept)
+        m_chosenLabels[labelIndex] = newPosition;
+
+    return advanceSchedule(accept, [this]() { checkpoint(); });
+}
+
+template <typename Penalty>
+float BasicAnnealingSolver<Penalty>::labelPenalty(size_t labelIndex, unsigned int position) const
+{
+    const auto priority = m_priorities[labelIndex];
+    const auto hysteresisPenalty = this->hysteresisPenalty(labelIndex, position);
+    if (position == m_labelAreas[labelIndex].size())
+        return m_penalty(0, 0.f, RelativeLabelPosition::Hidden, priority) + hysteresisPenalty;
+
+    const auto & obstacleOverlap = m_obstacleOverlaps[labelIndex][position];
+    auto overlapArea = obstacleOverlap.overlapArea;
+    auto overlapCount = obstacleOverlap.overlapCount;
+    for (const auto & collision : m_collisionGraph[labelIndex][position])
+    {
+        if (m_chosenLabels[collision.index] != collision.position)
+            continue;
+        overlapArea += collision.overlapArea;
+        ++overlapCount;
+    }
+    overlapArea /= m_labelAreas[labelIndex][position].area();
+    return m_penalty(overlapCount, overlapArea, cornerPositions()[position], priority) + hysteresisPenalty;
+}
+
+template <typename Penalty>
+float BasicAnnealingSolver<Penalty>::totalPenalty() const
+{
+    auto penalty = 0.f;
+    for (const auto labelIndex : m_activeLabels)
+        penalty += labelPenalty(labelIndex, m_chosenLabels[labelIndex]);
+    return penalty;
+}
+
+template <typename Penalty>
+void BasicAnnealingSolver<Penalty>::checkpoint()
+{
+    keepIfBest(totalPenalty());
+}
+
+template <typename Penalty>
+void specializedAnnealing(std::vector<Label> & labels, Penalty penalty, bool allowSelection, const glm::vec2 & relativePadding, const LayoutBudget & budget, const ObstacleIndex * obstacles)
+{
+    OPENLL_TRACE_ZONE("layout::specializedAnnealing");
+    // the budget includes the setup of the solver
+    LayoutDeadline deadline(budget);
+    BasicAnnealingSolver<Penalty> solver(labels, penalty, allowSelection, relativePadding, obstacles);
+    solver.run(deadline);
+    solver.apply(labels);
+}
+
+}
+
+}
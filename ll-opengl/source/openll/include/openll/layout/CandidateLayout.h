@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+#include <openll/layout/algorithm.h>
+#include <openll/layout/CandidatePosition.h>
+#include <openll/layout/LabelAreaBlock.h>
+#include <openll/layout/LayoutBudget.h>
+
+namespace gloperate_text
+{
+
+struct Label;
+
+namespace layout
+{
+
+// Label placement with many candidates per label (see candidatePositions), e.g., sliding positions.
+// As the collision graph grows quadratically with the number of candidates, only the neighbouring labels
+// are precomputed (see createNeighbourGraph). The overlap of every candidate with the chosen placements is
+// updated incrementally when a label changes its placement, by testing the new placement against the candidates
+// of the neighbours in a LabelAreaBlock; evaluating a candidate then costs constant time.
+// The labels are placed in order of descending priority first, then improved by local best responses.
+class OPENLL_API CandidateLayout
+{
+public:
+    // displacementPenalty is added to penaltyFunction per unit of CandidatePosition::displacement;
+    // the overlaps of the candidates start with their overlaps with the obstacles
+    CandidateLayout(const std::vector<Label> & labels, const std::vector<CandidatePosition> & positions, PenaltyFunction penaltyFunction, bool allowSelection = true, const glm::vec2 & relativePadding = {0.2f, 0.2f}, float displacementPenalty = 0.3f, const ObstacleIndex * obstacles = nullptr);
+
+    // improves the placement until a local minimum is reached (returns true) or the budget is exceeded;
+    // a label changes its position at most a few times per run, further improvements need another run;
+    // an iteration of the budget is the evaluation of a single label; the construction of the layout is not included
+    bool run(const LayoutBudget & budget = LayoutBudget());
+    // as above, with a deadline started earlier, e.g., before the construction of the layout
+    bool run(LayoutDeadline & deadline);
+    // the labels have to be the ones the layout was constructed for
+    void apply(std::vector<Label> & labels) const;
+
+    // a position index equal to the number of candidates denotes a hidden label
+    unsigned int chosenPosition(size_t labelIndex) const;
+    float penalty(size_t labelIndex, unsigned int position) const;
+    float totalPenalty() const;
+    // number of label pairs whose candidates are tested against each other
+    size_t neighbourCount() const;
+
+protected:
+    void choose(size_t labelIndex, unsigned int position);
+    void addOverlaps(size_t labelIndex, unsigned int position, int sign);
+    unsigned int bestPosition(size_t labelIndex) const;
+    void markDirty(size_t labelIndex);
+    size_t candidateIndex(size_t labelIndex, unsigned int position) const;
+
+protected:
+    std::vector<CandidatePosition> m_positions;
+    PenaltyFunction * m_penaltyFunction;
+    bool m_allowSelection;
+    float m_displacementPenalty;
+
+    std::vector<glm::vec2> m_pointLocations;
+    std::vector<glm::vec2> m_extents;
+    std::vector<unsigned int> m_priorities;
+    std::vector<std::vector<size_t>> m_neighbourGraph;
+    // the candidates of label i start at index i * number of candidates
+    LabelAreaBlock m_candidates;
+
+    std::vector<unsigned int> m_chosenPositions;
+    // overlap of each candidate with the obstacles and the chosen placements of all other labels
+    std::vector<float> m_overlapAreas;
+    std::vector<int> m_overlapCounts;
+
+    std::vector<size_t> m_dirtyLabels;
+    std::vector<bool> m_dirty;
+    // position changes per label within a single run
+    std::vector<unsigned int> m_changes;
+};
+
+}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+#include <openll/layout/RelativeLabelPosition.h>
+
+namespace gloperate_text
+{
+
+struct Label;
+struct LabelArea;
+
+namespace layout
+{
+
+// A placement candidate relative to the labeled point: the label origin is point - anchor * extent.
+// The anchors (0, 0), (1, 0), (1, 1) and (0, 1) are the corner positions UpperRight, UpperLeft, LowerLeft and LowerRight,
+// all other candidates slide along a side of the label, so that the point stays on its border.
+struct OPENLL_API CandidatePosition
+{
+    glm::vec2 anchor;
+    // the nearest corner position, which is passed to penalty functions
+    RelativeLabelPosition corner;
+    // distance to the nearest corner position relative to the extent, 0 for the corners and 0.5 for the side centers
+    float displacement;
+};
+
+// the four corner positions (in the order of cornerPositions), the four side centers and slidingPositions candidates
+// on each half side between a corner and a side center, i.e., 8 + 8 * slidingPositions candidates
+OPENLL_API std::vector<CandidatePosition> candidatePositions(unsigned int slidingPositions = 0);
+
+glm::vec2 OPENLL_API candidateOrigin(const CandidatePosition & position, const glm::vec2 & origin, const glm::vec2 & extent);
+
+// generate LabelArea objects for all candidates of all labels
+std::vector<std::vector<LabelArea>> OPENLL_API computeCandidateAreas(const std::vector<Label> & labels, const std::vector<CandidatePosition> & positions);
+
+}
+
+}
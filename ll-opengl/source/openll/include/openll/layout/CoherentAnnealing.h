@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <random>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+#include <openll/layout/algorithm.h>
+#include <openll/layout/AnnealingSolver.h>
+#include <openll/layout/LayoutBudget.h>
+#include <openll/layout/LayoutEngine.h>
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+// Simulated annealing for label sets that persist across frames, e.g., during navigation (see coherentAnnealing for
+// a single frame). The placement candidates, obstacle overlaps and collision graph are maintained by the LayoutEngine
+// and only recomputed for inserted labels and labels whose point location or extent changed. Each round of the
+// annealing only runs over the labels affected by the changes since the last round; it starts from their current
+// placements and penalizes leaving them by hysteresis, new labels are free. All other labels keep their placement.
+class OPENLL_API CoherentAnnealing : public LayoutEngine
+{
+public:
+    explicit CoherentAnnealing(PenaltyFunction penaltyFunction, bool allowSelection = true, const glm::vec2 & relativePadding = {0.2f, 0.2f}, float hysteresis = 0.5f, float cellSize = 0.f, const ObstacleIndex * obstacles = nullptr);
+
+    virtual LabelId insert(const Label & label) override;
+
+    // continues the annealing of the affected labels until it converges (returns true) or the budget (of annealing steps)
+    // is exceeded; changes since the last call restart the round from its best placement together with the newly affected labels.
+    // The labels show the best placement found so far
+    virtual bool layout(const LayoutBudget & budget = LayoutBudget()) override;
+
+    // the labels of the current round, empty if it converged
+    const std::vector<LabelId> & activeLabels() const;
+    unsigned long long steps() const;
+
+protected:
+    static const unsigned int noAnchor = ~0u;
+
+    void startRound();
+    // returns true if converged
+    bool step();
+    float annealingPenalty(LabelId id, unsigned int position) const;
+    void checkpoint();
+
+protected:
+    float m_hysteresis;
+    std::default_random_engine m_generator;
+    AnnealingSchedule m_schedule;
+
+    std::vector<LabelId> m_activeLabels;
+    std::vector<bool> m_active;
+    // the placements the hysteresis refers to, noAnchor for labels that were not placed by a round yet
+    std::vector<unsigned int> m_previousPositions;
+    std::vector<unsigned int> m_bestPositions;
+    float m_bestPenalty;
+};
+
+}
+
+}
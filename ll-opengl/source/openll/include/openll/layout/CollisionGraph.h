@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+#include <openll/layout/RelativeLabelPosition.h>
+
+namespace gloperate_text
+{
+
+struct Label;
+struct LabelArea;
+
+namespace layout
+{
+
+class ObstacleIndex;
+
+struct OPENLL_API LabelCollision
+{
+    size_t index;
+    size_t position;
+    float overlapArea;
+};
+
+// overlap of a placement with the obstacles (not normalized by the label area)
+struct OPENLL_API ObstacleOverlap
+{
+    float overlapArea;
+    int overlapCount;
+};
+
+// collisionGraph[label][position] lists all placements of other labels colliding with this placement
+using CollisionGraph = std::vector<std::vector<std::vector<LabelCollision>>>;
+
+// the four placements at the corners of the labeled point
+OPENLL_API const std::vector<RelativeLabelPosition> & cornerPositions();
+
+// generate LabelArea objects for all possible label placements
+std::vector<std::vector<LabelArea>> OPENLL_API computeLabelAreas(const std::vector<Label> & labels, const std::vector<RelativeLabelPosition> & positions);
+
+// only the placements of labels near each other are tested (see createNeighbourGraph)
+CollisionGraph OPENLL_API createCollisionGraph(const std::vector<std::vector<LabelArea>> & labelAreas, const glm::vec2 & relativePadding = {0.f, 0.f});
+// only the rows of the given labels are filled, all other rows stay empty
+CollisionGraph OPENLL_API createCollisionGraph(const std::vector<std::vector<LabelArea>> & labelAreas, const std::vector<size_t> & labelIndices, const glm::vec2 & relativePadding = {0.f, 0.f});
+
+// obstacleOverlaps[label][position] is the overlap of the padded placement with the obstacles, all zero without obstacles
+std::vector<std::vector<ObstacleOverlap>> OPENLL_API computeObstacleOverlaps(const std::vector<std::vector<LabelArea>> & labelAreas, const ObstacleIndex * obstacles, const glm::vec2 & relativePadding = {0.f, 0.f});
+
+// neighbourGraph[label] lists the other labels (in ascending order) whose placements may collide with a placement of this label,
+// i.e., whose padded bounding boxes around all placements overlap; it is much smaller than the collision graph for many placements
+std::vector<std::vector<size_t>> OPENLL_API createNeighbourGraph(const std::vector<std::vector<LabelArea>> & labelAreas, const glm::vec2 & relativePadding = {0.f, 0.f});
+
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+// Counter-based random number generator (SplitMix64): each number is a hash of an incremented counter.
+// Much cheaper than std::default_random_engine with std distributions in the inner loop of a solver.
+// Satisfies UniformRandomBitGenerator, so it can be used with std distributions and algorithms as well.
+class CounterRandom
+{
+public:
+    using result_type = std::uint64_t;
+
+    explicit CounterRandom(std::uint64_t seed = 0)
+    : m_counter(seed)
+    {
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        auto z = (m_counter += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // uniform in [0, bound), by multiplication instead of modulo (the bias is negligible for small bounds)
+    std::uint32_t uniform(std::uint32_t bound)
+    {
+        return static_cast<std::uint32_t>(((operator()() >> 32) * bound) >> 32);
+    }
+
+    // uniform in [0, 1)
+    float uniformFloat()
+    {
+        return static_cast<float>(operator()() >> 40) * (1.f / 16777216.f);
+    }
+
+protected:
+    std::uint64_t m_counter;
+};
+
+}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+namespace gloperate_text
+{
+
+struct LabelArea;
+
+namespace layout
+{
+
+// Structure-of-arrays block of label areas for batched overlap tests (SSE, or AVX if OPTION_USE_AVX is enabled).
+// The padded corners are computed once when an area is added; the results equal those of
+// LabelArea::paddedOverlaps and LabelArea::paddedOverlapArea (or overlaps and overlapArea without padding).
+class OPENLL_API LabelAreaBlock
+{
+public:
+    // maximum number of areas tested by a single call of overlaps
+    static const size_t batchSize = 64;
+
+    explicit LabelAreaBlock(const glm::vec2 & relativePadding = {0.f, 0.f});
+
+    void reserve(size_t size);
+    void clear();
+    void push_back(const LabelArea & area);
+    size_t size() const;
+    const glm::vec2 & relativePadding() const;
+
+    // tests area (padded as well) against the areas [first, first + batchSize) of the block;
+    // bit i of the result is set if area first + i overlaps and overlapAreas[i] receives the overlap area
+    // (overlapAreas needs space for batchSize values)
+    std::uint64_t overlaps(const LabelArea & area, size_t first, float * overlapAreas) const;
+    // calls callback(index, overlapArea) for all areas in [first, min(last, size)) overlapping area, in order
+    template <typename Callback>
+    void forEachOverlap(const LabelArea & area, Callback callback, size_t first = 0, size_t last = static_cast<size_t>(-1)) const;
+    // sums the overlap areas of all areas in [first, size) overlapping area and counts them
+    float overlapArea(const LabelArea & area, int & overlapCount, size_t first = 0) const;
+
+protected:
+    struct Corners
+    {
+        float x0, y0, x1, y1;
+    };
+
+    Corners corners(const LabelArea & area) const;
+    static unsigned int lowestBit(std::uint64_t mask);
+    std::uint64_t overlaps(const Corners & corners, size_t first, size_t count, float * overlapAreas) const;
+
+protected:
+    glm::vec2 m_relativePadding;
+    std::vector<float> m_x0;
+    std::vector<float> m_y0;
+    std::vector<float> m_x1;
+    std::vector<float> m_y1;
+};
+
+}
+
+}
+
+
+#include <openll/layout/LabelAreaBlock.inl>
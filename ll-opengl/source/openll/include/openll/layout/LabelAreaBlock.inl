@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+inline unsigned int LabelAreaBlock::lowestBit(std::uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_ctzll(mask));
+#else
+    unsigned int index = 0;
+    while (!(mask & 1))
+    {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+template <typename Callback>
+void LabelAreaBlock::forEachOverlap(const LabelArea & area, Callback callback, size_t first, size_t last) const
+{
+    const auto padded = corners(area);
+    const auto end = std::min(last, size());
+    float overlapAreas[batchSize];
+    for (auto batch = first; batch < end; batch += batchSize)
+    {
+        auto mask = overlaps(padded, batch, std::min(end - batch, static_cast<size_t>(batchSize)), overlapAreas);
+        while (mask)
+        {
+            const auto i = lowestBit(mask);
+            mask &= mask - 1;
+            callback(batch + i, overlapAreas[i]);
+        }
+    }
+}
+
+}
+
+}
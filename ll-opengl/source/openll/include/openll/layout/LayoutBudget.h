@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+
+#include <openll/openll_api.h>
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+// Limits the work of an iterative layout algorithm, which then returns the best placement found so far.
+// The meaning of an iteration is algorithm specific, e.g., a single annealing step or a gradient descent sweep.
+struct OPENLL_API LayoutBudget
+{
+    using Clock = std::chrono::steady_clock;
+
+    // unlimited
+    LayoutBudget();
+    explicit LayoutBudget(Clock::duration duration, unsigned long long iterations = unlimitedIterations());
+
+    static unsigned long long unlimitedIterations();
+
+    Clock::duration duration;
+    unsigned long long iterations;
+};
+
+// tracks the consumption of a LayoutBudget, starting at construction
+class OPENLL_API LayoutDeadline
+{
+public:
+    // the clock is only queried every clockInterval iterations, as it is comparatively expensive for fine-grained iterations
+    explicit LayoutDeadline(const LayoutBudget & budget, unsigned int clockInterval = 64);
+
+    // counts one iteration and returns false if the budget is exceeded
+    bool iterate();
+    // queries the clock without counting an iteration and returns true if the time budget is exceeded
+    bool expired();
+    bool exceeded() const;
+
+    unsigned long long iterations() const;
+
+protected:
+    LayoutBudget m_budget;
+    LayoutBudget::Clock::time_point m_start;
+    unsigned int m_clockInterval;
+    unsigned long long m_iterations;
+    bool m_exceeded;
+};
+
+}
+
+}
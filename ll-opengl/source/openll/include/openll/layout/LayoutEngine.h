@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+#include <openll/layout/layoutbase.h>
+#include <openll/layout/algorithm.h>
+#include <openll/layout/CollisionGraph.h>
+#include <openll/layout/LabelArea.h>
+#include <openll/layout/LayoutBudget.h>
+#include <openll/layout/UniformGrid.h>
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+// Stateful layout for label sets that change continuously, e.g., moving vehicles or new incidents.
+// The placement candidates, a grid spatial index and the collision graph are maintained incrementally
+// on insert, erase and update; layout only re-optimizes the labels affected by these changes
+// (by local discrete gradient descent that propagates to neighbours whose penalties changed).
+class OPENLL_API LayoutEngine
+{
+public:
+    // ids of erased labels are reused
+    using LabelId = size_t;
+
+    // cellSize is the edge length of the spatial index cells; 0 derives it from the mean extent of the labels
+    // and rebuilds the index when the mean extent changed by more than a factor of two;
+    // the overlaps with the obstacles are computed on insert and update, so that the obstacles must not change meanwhile
+    explicit LayoutEngine(PenaltyFunction penaltyFunction, bool allowSelection = true, const glm::vec2 & relativePadding = {0.2f, 0.2f}, float cellSize = 0.f, const ObstacleIndex * obstacles = nullptr);
+    virtual ~LayoutEngine();
+
+    virtual LabelId insert(const Label & label);
+    void erase(LabelId id);
+    // replaces the label, e.g., with a new point location or text; its current placement is kept as start.
+    // The placement candidates and collisions are only recomputed if the point location or the extent changed
+    void update(LabelId id, const Label & label);
+
+    bool contains(LabelId id) const;
+    size_t size() const;
+    // the label including its current placement
+    const Label & label(LabelId id) const;
+    std::vector<LabelId> ids() const;
+    std::vector<Label> labels() const;
+
+    // re-optimizes the labels affected by changes since the last call and returns true if a local minimum is reached;
+    // an iteration of the budget is the evaluation of a single label
+    virtual bool layout(const LayoutBudget & budget = LayoutBudget());
+    // number of labels waiting for re-optimization
+    size_t pendingLabels() const;
+
+    // a label may change its position this often within a single layout call, which bounds oscillations of
+    // asymmetric penalties; further changes are deferred to the next call (default 8)
+    void setMaxChangesPerLayout(unsigned int maxChanges);
+    unsigned int maxChangesPerLayout() const;
+
+    // rows of erased labels are empty
+    const CollisionGraph & collisionGraph() const;
+
+protected:
+    struct GridEntry
+    {
+        LabelId index;
+        unsigned int position;
+    };
+
+    void insertCandidates(LabelId id);
+    void eraseCandidates(LabelId id);
+    void markNeighboursDirty(LabelId id);
+    void markDirty(LabelId id);
+    float labelPenalty(LabelId id, unsigned int position) const;
+    void applyPosition(LabelId id);
+    // writes the placement of the given position to the label
+    void applyPosition(LabelId id, unsigned int position);
+
+    // the padded extent of a label along its longer axis
+    float span(const glm::vec2 & extent) const;
+    void adaptCellSize();
+    void rebuildGrid(float cellSize);
+    void paddedBounds(const LabelArea & area, glm::vec2 & lowerLeft, glm::vec2 & upperRight) const;
+
+protected:
+    PenaltyFunction * m_penaltyFunction;
+    bool m_allowSelection;
+    glm::vec2 m_relativePadding;
+    const ObstacleIndex * m_obstacles;
+    // 0 if derived from the label extents
+    float m_cellSize;
+    double m_spanSum;
+    size_t m_spanCount;
+
+    std::vector<Label> m_labels;
+    std::vector<bool> m_used;
+    std::vector<LabelId> m_freeIds;
+
+    std::vector<std::vector<LabelArea>> m_labelAreas;
+    CollisionGraph m_collisionGraph;
+    // added to the label overlaps of each placement
+    std::vector<std::vector<ObstacleOverlap>> m_obstacleOverlaps;
+    UniformGrid<GridEntry> m_grid;
+    // false while the cell size is unknown, i.e., all labels so far have zero extent
+    bool m_gridValid;
+
+    // a position index equal to the number of label areas denotes a hidden label
+    std::vector<unsigned int> m_chosenPositions;
+
+    std::vector<LabelId> m_dirtyLabels;
+    std::vector<bool> m_dirty;
+    // position changes per label within a single layout call, bounds oscillations of asymmetric penalties
+    std::vector<unsigned int> m_changes;
+    unsigned int m_maxChangesPerLayout;
+};
+
+}
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+#include <openll/layout/LabelArea.h>
+#include <openll/layout/UniformGrid.h>
+
+namespace gloperate_text
+{
+
+struct Label;
+
+namespace layout
+{
+
+// An area labels should not overlap, e.g., an icon or a UI panel; obstacles smaller than a label, including points
+// without extent, are penalized as if they were as large as the shorter side of the label (see ObstacleIndex::overlapArea).
+struct OPENLL_API Obstacle
+{
+    // no label is excluded from the obstacle
+    static const size_t noLabel;
+
+    LabelArea area;
+    // the obstacle does not penalize the placements of this label, e.g., the icon at its own point
+    size_t label;
+};
+
+// obstacles of the given extent centered on the points of the labels, each excluded for its own label
+OPENLL_API std::vector<Obstacle> pointObstacles(const std::vector<Label> & labels, const glm::vec2 & extent);
+
+// Static grid spatial index of obstacles, built once and reused across layout calls.
+// The layout algorithms add the overlap with obstacles to the label overlaps passed to the penalty function;
+// it is computed once per placement candidate, when the collision graph is built (see computeObstacleOverlaps).
+class OPENLL_API ObstacleIndex
+{
+public:
+    // cellSize is the edge length of the grid cells; 0 derives it from the obstacle extents
+    explicit ObstacleIndex(const std::vector<Obstacle> & obstacles, float cellSize = 0.f);
+
+    size_t size() const;
+    const std::vector<Obstacle> & obstacles() const;
+
+    // sums the overlap areas of area, padded by relativePadding, with all obstacles not excluded for labelIndex and counts them;
+    // obstacles overlapping the padded area are grown to at least the shorter side of area in both dimensions
+    float overlapArea(const LabelArea & area, const glm::vec2 & relativePadding, int & overlapCount, size_t labelIndex = Obstacle::noLabel) const;
+
+protected:
+    std::vector<Obstacle> m_obstacles;
+    UniformGrid<std::uint32_t> m_grid;
+};
+
+}
+
+}
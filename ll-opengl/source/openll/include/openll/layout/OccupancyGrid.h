@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+namespace gloperate_text
+{
+
+struct LabelArea;
+
+namespace layout
+{
+
+// Collision backend for very dense label sets: placed labels are rasterized into a coarse screen-space bitmap
+// and candidates are tested against it with word-wide bit operations instead of pairwise rectangle tests.
+// The test is conservative, every cell touched by a label counts as occupied. Areas outside the grid are clipped.
+// Memory is bounded by the resolution (one bit per cell) and reused across frames by clear and reset.
+class OPENLL_API OccupancyGrid
+{
+public:
+    OccupancyGrid(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight, const glm::uvec2 & resolution);
+
+    // clears the grid and maps it to new bounds, e.g., after the view changed; empty bounds contain no cells
+    void reset(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight);
+    void clear();
+
+    // whether the area touches any cell, i.e., lies at least partially within the bounds
+    bool covers(const LabelArea & area) const;
+    void occupy(const LabelArea & area);
+    bool occupied(const LabelArea & area) const;
+    // number of occupied cells covered by the area
+    unsigned int occupiedCells(const LabelArea & area) const;
+    // approximates the overlap of the area with all occupied cells
+    float occupiedArea(const LabelArea & area) const;
+
+    const glm::uvec2 & resolution() const;
+    glm::vec2 cellExtent() const;
+
+protected:
+    // returns false if the area lies outside the grid
+    bool cellRange(const LabelArea & area, glm::uvec2 & lower, glm::uvec2 & upper) const;
+
+protected:
+    glm::vec2 m_lowerLeft;
+    glm::vec2 m_cellsPerUnit;
+    glm::uvec2 m_resolution;
+    size_t m_wordsPerRow;
+    std::vector<std::uint64_t> m_words;
+};
+
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <glm/vec2.hpp>
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+// Sparse uniform grid of square cells hashed by their coordinates, the spatial index of the layout algorithms.
+// An entry is added to every cell overlapped by its bounding box; callers that visit a box and must handle an
+// entry only once use the cell passed to the callback, e.g., by handling it only in the first shared cell.
+template <typename T>
+class UniformGrid
+{
+public:
+    // cellSize is the edge length of the cells and has to be positive
+    explicit UniformGrid(float cellSize = 1.f);
+
+    float cellSize() const;
+    // removes all entries
+    void reset(float cellSize);
+    void clear();
+    bool empty() const;
+
+    glm::ivec2 cell(const glm::vec2 & point) const;
+
+    void insert(const glm::ivec2 & cell, const T & entry);
+    // adds the entry to all cells overlapped by the box
+    void insert(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight, const T & entry);
+    // removes the entries for which predicate(entry) is true from the cells overlapped by the box
+    template <typename Predicate>
+    void erase(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight, Predicate predicate);
+
+    // calls callback(entry) for the entries of the cell
+    template <typename Callback>
+    void forEach(const glm::ivec2 & cell, Callback callback) const;
+    // calls callback(cell, entry) for the entries of the cells overlapped by the box, once per cell of an entry
+    template <typename Callback>
+    void forEach(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight, Callback callback) const;
+
+protected:
+    static std::uint64_t key(int x, int y);
+
+protected:
+    float m_cellSize;
+    std::unordered_map<std::uint64_t, std::vector<T>> m_cells;
+};
+
+}
+
+}
+
+
+#include <openll/layout/UniformGrid.inl>
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+template <typename T>
+UniformGrid<T>::UniformGrid(float cellSize)
+: m_cellSize(cellSize)
+{
+    assert(cellSize > 0.f);
+}
+
+template <typename T>
+float UniformGrid<T>::cellSize() const
+{
+    return m_cellSize;
+}
+
+template <typename T>
+void UniformGrid<T>::reset(float cellSize)
+{
+    assert(cellSize > 0.f);
+    m_cellSize = cellSize;
+    m_cells.clear();
+}
+
+template <typename T>
+void UniformGrid<T>::clear()
+{
+    m_cells.clear();
+}
+
+template <typename T>
+bool UniformGrid<T>::empty() const
+{
+    return m_cells.empty();
+}
+
+template <typename T>
+glm::ivec2 UniformGrid<T>::cell(const glm::vec2 & point) const
+{
+    return glm::ivec2(static_cast<int>(std::floor(point.x / m_cellSize)), static_cast<int>(std::floor(point.y / m_cellSize)));
+}
+
+template <typename T>
+void UniformGrid<T>::insert(const glm::ivec2 & cell, const T & entry)
+{
+    m_cells[key(cell.x, cell.y)].push_back(entry);
+}
+
+template <typename T>
+void UniformGrid<T>::insert(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight, const T & entry)
+{
+    const auto lowerCell = cell(lowerLeft);
+    const auto upperCell = cell(upperRight);
+    for (auto y = lowerCell.y; y <= upperCell.y; ++y)
+    {
+        for (auto x = lowerCell.x; x <= upperCell.x; ++x)
+            m_cells[key(x, y)].push_back(entry);
+    }
+}
+
+template <typename T>
+template <typename Predicate>
+void UniformGrid<T>::erase(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight, Predicate predicate)
+{
+    const auto lowerCell = cell(lowerLeft);
+    const auto upperCell = cell(upperRight);
+    for (auto y = lowerCell.y; y <= upperCell.y; ++y)
+    {
+        for (auto x = lowerCell.x; x <= upperCell.x; ++x)
+        {
+            const auto it = m_cells.find(key(x, y));
+            if (it == m_cells.end())
+                continue;
+
+            auto & entries = it->second;
+            entries.erase(std::remove_if(entries.begin(), entries.end(), predicate), entries.end());
+            if (entries.empty())
+                m_cells.erase(it);
+        }
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void UniformGrid<T>::forEach(const glm::ivec2 & cell, Callback callback) const
+{
+    const auto it = m_cells.find(key(cell.x, cell.y));
+    if (it == m_cells.end())
+        return;
+
+    for (const auto & entry : it->second)
+        callback(entry);
+}
+
+template <typename T>
+template <typename Callback>
+void UniformGrid<T>::forEach(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight, Callback callback) const
+{
+    const auto lowerCell = cell(lowerLeft);
+    const auto upperCell = cell(upperRight);
+    for (auto y = lowerCell.y; y <= upperCell.y; ++y)
+    {
+        for (auto x = lowerCell.x; x <= upperCell.x; ++x)
+        {
+            const auto current = glm::ivec2(x, y);
+            forEach(current, [&](const T & entry) { callback(current, entry); });
+        }
+    }
+}
+
+template <typename T>
+std::uint64_t UniformGrid<T>::key(int x, int y)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/openll_api.h>
+
+#include <openll/layout/RelativeLabelPosition.h>
+
+namespace gloperate_text
+{
+
+struct Label;
+
+namespace layout
+{
+
+// Precomputed level of detail for continuously zoomable maps: the point locations of the labels are in world units,
+// their extents in screen units and a zoom z maps world to screen units by scale(z) = minScale * 2^z.
+// Labels are inserted in order of descending priority; each label gets the corner position with the lowest zoom
+// from which on it does not overlap any label inserted before it at any scale, and stays visible when zooming in.
+// Picking the labels visible at a zoom then needs no layout run and is O(visible).
+class OPENLL_API VisibilityHierarchy
+{
+public:
+    // zoom levels 0 to levels - 1 are considered, a label not placeable at the last level is never visible
+    VisibilityHierarchy(const std::vector<Label> & labels, float minScale, unsigned int levels, const glm::vec2 & relativePadding = {0.f, 0.f});
+
+    float scale(float zoom) const;
+    unsigned int levels() const;
+
+    // first zoom level at which the label is visible, levels() if never
+    unsigned int minLevel(size_t labelIndex) const;
+    RelativeLabelPosition position(size_t labelIndex) const;
+
+    // indices of the labels visible at the zoom, sorted by minLevel and descending priority
+    std::vector<size_t> visibleLabels(float zoom) const;
+    size_t visibleCount(float zoom) const;
+    // all labels in the order of visibleLabels, the first visibleCount(zoom) ones are visible at the zoom
+    const std::vector<size_t> & order() const;
+
+    // sets the placements of the labels for the zoom, the placement offsets are in screen units
+    // (i.e., the screen position of the label origin is pointLocation * scale(zoom) + placement.offset)
+    void apply(std::vector<Label> & labels, float zoom) const;
+
+protected:
+    unsigned int level(float zoom) const;
+
+protected:
+    float m_minScale;
+    unsigned int m_levels;
+    std::vector<unsigned int> m_minLevels;
+    std::vector<RelativeLabelPosition> m_positions;
+    std::vector<glm::vec2> m_offsets;
+    std::vector<size_t> m_order;
+    // number of labels visible at each level
+    std::vector<size_t> m_levelEnds;
+};
+
+}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cassert>
+
+#include <openll/layout/RelativeLabelPosition.h>
+#include <openll/layout/algorithm.h>
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+// Penalties as functor types, which templated solvers (see BasicAnnealingSolver) can inline.
+// The PenaltyFunctions overlapArea, overlapCount and standard are implemented by these.
+
+struct OverlapAreaPenalty
+{
+    float operator()(int, float overlapArea, RelativeLabelPosition, unsigned int) const
+    {
+        return overlapArea;
+    }
+};
+
+struct OverlapCountPenalty
+{
+    float operator()(int overlapCount, float, RelativeLabelPosition, unsigned int) const
+    {
+        return static_cast<float>(overlapCount);
+    }
+};
+
+struct StandardPenalty
+{
+    float operator()(int, float overlapArea, RelativeLabelPosition position, unsigned int priority) const
+    {
+        unsigned int positionPenalty = 0;
+        switch (position)
+        {
+            case RelativeLabelPosition::UpperRight: positionPenalty = 0; break;
+            case RelativeLabelPosition::UpperLeft:  positionPenalty = 1; break;
+            case RelativeLabelPosition::LowerLeft:  positionPenalty = 2; break;
+            case RelativeLabelPosition::LowerRight: positionPenalty = 3; break;
+            case RelativeLabelPosition::Hidden:     return 1.5f * priority;
+            default: assert(false);
+        }
+        return 15.f * overlapArea + .3f * positionPenalty;
+    }
+};
+
+// adapter for arbitrary PenaltyFunctions, which cannot be inlined
+struct FunctionPenalty
+{
+    FunctionPenalty(PenaltyFunction * function = standard)
+    : function(function)
+    {
+    }
+
+    float operator()(int overlapCount, float overlapArea, RelativeLabelPosition position, unsigned int priority) const
+    {
+        return function(overlapCount, overlapArea, position, priority);
+    }
+
+    PenaltyFunction * function;
+};
+
+}
+
+}
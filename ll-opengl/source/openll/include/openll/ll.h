@@ -0,0 +1,99 @@
+#pragma once
+
+/*
+*  C API of the Open Label Library as specified by spec/ll.xml, e.g., for
+*  bindings to other languages.
+*
+*  Objects are addressed by handles that are validated in constant time;
+*  functions given a handle of a destroyed object return
+*  LL_OBJECT_DOES_NOT_EXISTS. The functions are not thread-safe and have to
+*  be called from a single thread (or be synchronized by the caller).
+*  Functions that upload to the GPU require a current OpenGL context.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <openll/openll_api.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef uint32_t llSize;
+typedef float    llPointSize;
+typedef uint8_t  llBool;
+typedef uint32_t llUTF32;
+
+#define LL_FALSE 0
+#define LL_TRUE  1
+
+typedef enum llResult
+{
+    LL_SUCCESS                     = 0,
+    LL_ERROR_OUT_OF_HOST_MEMORY    = -1,
+    LL_ERROR_OUT_OF_DEVICE_MEMORY  = -2,
+    LL_ERROR_TOO_MANY_OBJECTS      = -3,
+    LL_ERROR_EXTENSION_NOT_PRESENT = -4,
+    LL_ERROR_FEATURE_NOT_PRESENT   = -5,
+    LL_OBJECT_DOES_NOT_EXISTS      = -6,
+    LL_ERROR_INVALID_VALUE         = -7,
+    LL_ERROR_LOADING_FAILED        = -8
+} llResult;
+
+/* 0 is never a valid handle */
+typedef uint32_t llFontFace;
+typedef uint32_t llGlyphSequence;
+typedef uint32_t llGlyphVertexCloud;
+
+
+/* font faces */
+
+llResult OPENLL_API llCreateFontFace(llFontFace * fontFace);
+llSize   OPENLL_API llGetMaxFontFaceObjects(void);
+llResult OPENLL_API llDestroyFontFace(llFontFace fontFace);
+
+/* replaces the font face by the one described by a BMFont file, without
+   uploadGlyphTexture no OpenGL context is required; font face objects
+   loading the same file share its glyphs and glyph texture */
+llResult OPENLL_API llLoadFontFace(llFontFace fontFace, const char * filename, llBool uploadGlyphTexture);
+llResult OPENLL_API llGetFontFaceSize(llFontFace fontFace, llPointSize * size);
+llResult OPENLL_API llGetFontFaceLineHeight(llFontFace fontFace, float * lineHeight);
+
+
+/* glyph sequences */
+
+llResult OPENLL_API llCreateGlyphSequence(llGlyphSequence * sequence);
+llSize   OPENLL_API llGetMaxGlyphSequenceObjects(void);
+llResult OPENLL_API llDestroyGlyphSequence(llGlyphSequence sequence);
+
+/* the font face is looked up when the sequence is used, it may be destroyed or replaced in between */
+llResult OPENLL_API llSetGlyphSequenceFontFace(llGlyphSequence sequence, llFontFace fontFace);
+llResult OPENLL_API llSetGlyphSequenceString(llGlyphSequence sequence, const llUTF32 * string, llSize length);
+llResult OPENLL_API llSetGlyphSequenceFontSize(llGlyphSequence sequence, llPointSize fontSize);
+/* rgba */
+llResult OPENLL_API llSetGlyphSequenceFontColor(llGlyphSequence sequence, const float * color);
+/* column-major 4x4 matrix */
+llResult OPENLL_API llSetGlyphSequenceTransform(llGlyphSequence sequence, const float * transform);
+/* width and height, requires an existing font face */
+llResult OPENLL_API llGetGlyphSequenceExtent(llGlyphSequence sequence, float * extent);
+
+
+/* glyph vertex clouds */
+
+llResult OPENLL_API llCreateGlyphVertexCloud(llGlyphVertexCloud * vertexCloud);
+llSize   OPENLL_API llGetMaxGlyphVertexCloudObjects(void);
+llResult OPENLL_API llDestroyGlyphVertexCloud(llGlyphVertexCloud vertexCloud);
+
+/* typesets the sequences into the cloud; all sequences need an existing font face,
+   with upload the vertices are uploaded to the GPU for rendering */
+llResult OPENLL_API llUpdateGlyphVertexCloud(llGlyphVertexCloud vertexCloud, const llGlyphSequence * sequences, llSize count
+    , llBool optimized, llBool upload);
+llResult OPENLL_API llGetGlyphVertexCloudSize(llGlyphVertexCloud vertexCloud, llSize * size);
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -15,8 +15,16 @@ namespace gloperate_text
 
 class FontFace;
 class GlyphSequence;
-
-OPENLL_API GlyphVertexCloud prepareGlyphs(const std::vector<GlyphSequence>& sequences, bool optimized);
+class RenderBackend;
+class TaskPool;
+
+// Without upload, no drawable is created and the optimized vertices replace the vertices of the cloud,
+// e.g., for measuring the preparation without an OpenGL context.
+// With a pool, the sequences are typeset in parallel.
+// The vertex cloud uploads through backend, OpenGL if nullptr (see GlyphVertexCloud).
+OPENLL_API GlyphVertexCloud prepareGlyphs(const std::vector<GlyphSequence>& sequences, bool optimized, bool upload = true, TaskPool * pool = nullptr, RenderBackend * backend = nullptr);
+// as above, for sequences owned elsewhere, which are not copied
+OPENLL_API GlyphVertexCloud prepareGlyphs(const std::vector<const GlyphSequence *>& sequences, bool optimized, bool upload = true, TaskPool * pool = nullptr, RenderBackend * backend = nullptr);
 
 
 } // namespace gloperate_text
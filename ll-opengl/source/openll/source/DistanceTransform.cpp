@@ -0,0 +1,91 @@
+#include <openll/DistanceTransform.h>
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace
+{
+
+
+// lower envelope of the parabolas rooted at (q, f[q]), sampled at 0 .. n-1
+void transform1D(const float * f, float * d, int n, int * v, float * z)
+{
+    const auto infinity = gloperate_text::distanceTransformInfinity();
+
+    auto k = 0;
+    v[0] = 0;
+    z[0] = -infinity;
+    z[1] = infinity;
+
+    for (auto q = 1; q < n; ++q)
+    {
+        auto s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.f * (q - v[k]));
+        while (s <= z[k])
+        {
+            --k;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.f * (q - v[k]));
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = infinity;
+    }
+
+    k = 0;
+    for (auto q = 0; q < n; ++q)
+    {
+        while (z[k + 1] < q)
+            ++k;
+        const auto delta = static_cast<float>(q - v[k]);
+        d[q] = delta * delta + f[v[k]];
+    }
+}
+
+
+} // namespace
+
+
+namespace gloperate_text
+{
+
+
+float distanceTransformInfinity()
+{
+    return 1e20f;
+}
+
+void squaredDistanceTransform(std::vector<float> & grid, int width, int height)
+{
+    assert(width >= 0 && height >= 0);
+    assert(grid.size() == static_cast<size_t>(width) * static_cast<size_t>(height));
+
+    if (width == 0 || height == 0)
+        return;
+
+    const auto n = width > height ? width : height;
+    std::vector<float> f(n);
+    std::vector<float> d(n);
+    std::vector<int> v(n);
+    std::vector<float> z(n + 1);
+
+    // columns first, then rows on the column results
+    for (auto x = 0; x < width; ++x)
+    {
+        for (auto y = 0; y < height; ++y)
+            f[y] = grid[y * width + x];
+        transform1D(f.data(), d.data(), height, v.data(), z.data());
+        for (auto y = 0; y < height; ++y)
+            grid[y * width + x] = d[y];
+    }
+
+    for (auto y = 0; y < height; ++y)
+    {
+        auto row = grid.data() + y * width;
+        std::copy(row, row + width, f.begin());
+        transform1D(f.data(), row, width, v.data(), z.data());
+    }
+}
+
+
+} // namespace gloperate_text
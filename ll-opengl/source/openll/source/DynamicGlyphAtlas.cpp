@@ -0,0 +1,349 @@
+#include <openll/DynamicGlyphAtlas.h>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+#include <openll/FontFace.h>
+#include <openll/RenderBackend.h>
+#include <openll/Trace.h>
+#include <openll/TrueTypeFont.h>
+
+
+namespace
+{
+
+
+// free texels between neighbouring glyphs
+const int gutter = 1;
+
+
+} // namespace
+
+
+namespace gloperate_text
+{
+
+
+DynamicGlyphAtlas::DynamicGlyphAtlas(std::shared_ptr<const TrueTypeFont> font, const glm::ivec2 & extent
+    , const FontFaceGenerator & generator, RenderBackend * backend)
+: m_font(std::move(font))
+, m_generator(generator)
+, m_backend(backend)
+, m_fontFace(new FontFace())
+, m_packer(extent)
+, m_pending(0)
+, m_frame(0)
+, m_evictions(0)
+, m_busy(false)
+, m_stop(false)
+{
+    assert(m_font);
+
+    m_generator.initialize(*m_fontFace, *m_font);
+    m_fontFace->setGlyphTextureExtent(glm::uvec2(extent));
+    m_fontFace->setGlyphImage(std::vector<unsigned char>(static_cast<size_t>(extent.x) * extent.y, 0));
+
+    if (m_backend)
+        m_backend->createGlyphTexture(*m_fontFace);
+
+    const auto & kerningPairs = m_font->kerningPairs();
+    m_kerningByRight.resize(kerningPairs.size());
+    for (std::uint32_t i = 0; i < m_kerningByRight.size(); ++i)
+        m_kerningByRight[i] = i;
+    std::stable_sort(m_kerningByRight.begin(), m_kerningByRight.end(), [&kerningPairs](std::uint32_t a, std::uint32_t b)
+    {
+        return kerningPairs[a].right < kerningPairs[b].right;
+    });
+
+    m_worker = std::thread(&DynamicGlyphAtlas::work, this);
+}
+
+DynamicGlyphAtlas::~DynamicGlyphAtlas()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    m_worker.join();
+}
+
+FontFace * DynamicGlyphAtlas::fontFace() const
+{
+    return m_fontFace;
+}
+
+const TrueTypeFont & DynamicGlyphAtlas::font() const
+{
+    return *m_font;
+}
+
+void DynamicGlyphAtlas::request(const GlyphIndex codepoint)
+{
+    auto it = m_entries.find(codepoint);
+    if (it == m_entries.end())
+    {
+        const auto mapped = codepoint > 0 && m_font->glyphId(codepoint) != 0;
+        it = m_entries.emplace(codepoint, Entry{ mapped ? State::Pending : State::Unmapped, glm::ivec2(0), glm::ivec2(0), m_frame }).first;
+        if (!mapped)
+            return;
+
+        addGlyph(codepoint);
+        enqueue(codepoint);
+        return;
+    }
+
+    auto & entry = it->second;
+    entry.lastUse = m_frame;
+    if (entry.state == State::Evicted)
+    {
+        entry.state = State::Pending;
+        enqueue(codepoint);
+    }
+}
+
+void DynamicGlyphAtlas::request(const std::u32string & string)
+{
+    for (const auto character : string)
+        request(static_cast<GlyphIndex>(character));
+}
+
+size_t DynamicGlyphAtlas::update()
+{
+    OPENLL_TRACE_ZONE("DynamicGlyphAtlas::update");
+
+    auto results = std::vector<Result>();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        results.swap(m_results);
+    }
+
+    auto candidates = std::vector<GlyphIndex>();
+    auto collected = false;
+    auto placed = size_t(0);
+    for (auto & result : results)
+    {
+        const auto codepoint = result.first;
+        const auto & field = result.second;
+        auto & entry = m_entries[codepoint];
+        assert(entry.state == State::Pending);
+        --m_pending;
+
+        if (field.extent.x <= 0)
+        {
+            entry.state = State::Empty;
+            continue;
+        }
+
+        const auto size = field.extent + glm::ivec2(gutter);
+        auto position = glm::ivec2();
+        if (!allocate(size, position, candidates, collected))
+        {
+            // retried when requested again
+            entry.state = State::Evicted;
+            continue;
+        }
+
+        entry.state = State::Resident;
+        entry.position = position;
+        entry.size = size;
+
+        // keep advance and kerning, see addGlyph
+        auto & glyph = m_fontFace->glyph(codepoint);
+        const auto metrics = m_generator.glyph(*m_font, codepoint, field);
+        glyph.setExtent(metrics.extent());
+        glyph.setBearing(metrics.bearing());
+        FontFaceGenerator::place(*m_fontFace, glyph, field, position);
+
+        if (m_backend)
+            m_backend->updateGlyphTexture(*m_fontFace, position, field.extent, 0);
+        ++placed;
+    }
+
+    OPENLL_TRACE_COUNTER("atlas glyphs placed", static_cast<long long>(placed));
+    ++m_frame;
+    return placed;
+}
+
+void DynamicGlyphAtlas::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_queue.empty() && !m_busy; });
+}
+
+bool DynamicGlyphAtlas::resident(const GlyphIndex codepoint) const
+{
+    const auto it = m_entries.find(codepoint);
+    return it != m_entries.end() && it->second.state == State::Resident;
+}
+
+size_t DynamicGlyphAtlas::pending() const
+{
+    return m_pending;
+}
+
+unsigned long long DynamicGlyphAtlas::evictions() const
+{
+    return m_evictions;
+}
+
+unsigned long long DynamicGlyphAtlas::frame() const
+{
+    return m_frame;
+}
+
+void DynamicGlyphAtlas::addGlyph(const GlyphIndex codepoint)
+{
+    // the metrics only; the sub texture is set when the glyph is placed
+    m_fontFace->addGlyph(m_generator.glyph(*m_font, codepoint, GlyphRasterizer::DistanceField()));
+
+    const auto pixelsPerUnit = m_generator.scale(*m_font);
+    const auto glyphId = m_font->glyphId(codepoint);
+    m_codepoints[glyphId].push_back(codepoint);
+
+    // only the pairs of the glyph, with the other glyph already requested
+    const auto & kerningPairs = m_font->kerningPairs();
+    const auto left = std::equal_range(kerningPairs.begin(), kerningPairs.end(), TrueTypeFont::KerningPair{ glyphId, 0, 0 },
+        [](const TrueTypeFont::KerningPair & a, const TrueTypeFont::KerningPair & b) { return a.left < b.left; });
+    for (auto pair = left.first; pair != left.second; ++pair)
+    {
+        const auto others = m_codepoints.find(pair->right);
+        if (others == m_codepoints.end())
+            continue;
+        for (const auto other : others->second)
+            m_fontFace->setKerning(codepoint, other, pair->value * pixelsPerUnit);
+    }
+
+    const auto rightBegin = std::lower_bound(m_kerningByRight.begin(), m_kerningByRight.end(), glyphId,
+        [&kerningPairs](std::uint32_t index, std::uint32_t glyph) { return kerningPairs[index].right < glyph; });
+    const auto rightEnd = std::upper_bound(rightBegin, m_kerningByRight.end(), glyphId,
+        [&kerningPairs](std::uint32_t glyph, std::uint32_t index) { return glyph < kerningPairs[index].right; });
+    for (auto index = rightBegin; index != rightEnd; ++index)
+    {
+        const auto & pair = kerningPairs[*index];
+        const auto others = m_codepoints.find(pair.left);
+        if (others == m_codepoints.end())
+            continue;
+        for (const auto other : others->second)
+        {
+            if (other != codepoint)
+                m_fontFace->setKerning(other, codepoint, pair.value * pixelsPerUnit);
+        }
+    }
+}
+
+bool DynamicGlyphAtlas::allocate(const glm::ivec2 & size, glm::ivec2 & position, std::vector<GlyphIndex> & candidates, bool & collected)
+{
+    if (m_packer.allocate(size, position))
+        return true;
+
+    if (!collected)
+    {
+        candidates = evictionCandidates();
+        collected = true;
+    }
+
+    while (!candidates.empty())
+    {
+        const auto codepoint = candidates.back();
+        candidates.pop_back();
+
+        auto & entry = m_entries[codepoint];
+        if (entry.state != State::Resident)
+            continue;
+
+        evict(codepoint, entry);
+        if (m_packer.allocate(size, position))
+            return true;
+    }
+
+    return false;
+}
+
+std::vector<GlyphIndex> DynamicGlyphAtlas::evictionCandidates() const
+{
+    // glyphs requested in this frame stay
+    auto candidates = std::vector<std::pair<unsigned long long, GlyphIndex>>();
+    for (const auto & pair : m_entries)
+    {
+        if (pair.second.state == State::Resident && pair.second.lastUse < m_frame)
+            candidates.emplace_back(pair.second.lastUse, pair.first);
+    }
+    std::sort(candidates.begin(), candidates.end(), std::greater<std::pair<unsigned long long, GlyphIndex>>());
+
+    auto result = std::vector<GlyphIndex>(candidates.size());
+    std::transform(candidates.begin(), candidates.end(), result.begin(), [](const std::pair<unsigned long long, GlyphIndex> & candidate)
+    {
+        return candidate.second;
+    });
+    return result;
+}
+
+void DynamicGlyphAtlas::evict(const GlyphIndex codepoint, Entry & entry)
+{
+    assert(entry.state == State::Resident);
+
+    m_packer.release(entry.position, entry.size);
+    clear(entry.position, entry.size);
+    entry.state = State::Evicted;
+    ++m_evictions;
+
+    // not depictable, but typesetting stays the same
+    m_fontFace->glyph(codepoint).setSubTextureExtent(glm::vec2(0.f));
+}
+
+void DynamicGlyphAtlas::clear(const glm::ivec2 & position, const glm::ivec2 & size)
+{
+    const auto extent = glm::ivec2(m_fontFace->glyphTextureExtent());
+    const auto clipped = glm::min(position + size, extent) - position;
+    if (clipped.x <= 0 || clipped.y <= 0)
+        return;
+
+    auto & image = m_fontFace->glyphImage();
+    for (auto y = 0; y < clipped.y; ++y)
+    {
+        const auto row = image.begin() + static_cast<size_t>(position.y + y) * extent.x + position.x;
+        std::fill(row, row + clipped.x, 0);
+    }
+
+    if (m_backend)
+        m_backend->updateGlyphTexture(*m_fontFace, position, clipped, 0);
+}
+
+void DynamicGlyphAtlas::enqueue(const GlyphIndex codepoint)
+{
+    ++m_pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(codepoint);
+    }
+    m_wake.notify_one();
+}
+
+void DynamicGlyphAtlas::work()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+        if (m_stop)
+            return;
+
+        const auto codepoint = m_queue.front();
+        m_queue.pop_front();
+        m_busy = true;
+
+        lock.unlock();
+        auto field = m_generator.rasterize(*m_font, codepoint);
+        lock.lock();
+
+        m_results.emplace_back(codepoint, std::move(field));
+        m_busy = false;
+        if (m_queue.empty())
+            m_idle.notify_all();
+    }
+}
+
+
+} // namespace gloperate_text
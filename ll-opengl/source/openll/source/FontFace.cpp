@@ -1,6 +1,8 @@
 
 #include <openll/FontFace.h>
 
+#include <utility>
+
 
 namespace gloperate_text
 {
@@ -10,6 +12,8 @@ FontFace::FontFace()
 : m_ascent (0.f)
 , m_descent(0.f)
 , m_linegap(0.f)
+, m_glyphTexturePages(1)
+, m_revision(0)
 {
 }
 
@@ -32,6 +36,7 @@ void FontFace::setBase(const float base)
 {
     assert(base > 0.f);
     m_base = base;
+    ++m_revision;
 }
 
 float FontFace::ascent() const
@@ -43,6 +48,7 @@ void FontFace::setAscent(const float ascent)
 {
     assert(ascent > 0.f);
     m_ascent = ascent;
+    ++m_revision;
 }
 
 float FontFace::descent() const
@@ -57,6 +63,7 @@ void FontFace::setDescent(const float descent)
     // assert(descent < 0.f);
 
     m_descent = descent;
+    ++m_revision;
 }
 
 float FontFace::linegap() const
@@ -67,6 +74,7 @@ float FontFace::linegap() const
 void FontFace::setLinegap(const float linegap)
 {
     m_linegap = linegap;
+    ++m_revision;
 }
 
 float FontFace::linespace() const
@@ -80,6 +88,7 @@ float FontFace::linespace() const
 void FontFace::setLinespace(const float spacing)
 {
     m_linegap = size() * (spacing - 1);
+    ++m_revision;
 }
 
 float FontFace::lineHeight() const
@@ -90,6 +99,7 @@ float FontFace::lineHeight() const
 void FontFace::setLineHeight(const float lineHeight)
 {
     m_linegap = lineHeight - size();
+    ++m_revision;
 }
 
 const glm::uvec2 & FontFace::glyphTextureExtent() const
@@ -105,6 +115,18 @@ void FontFace::setGlyphTextureExtent(const glm::uvec2 & extent)
     m_glyphTextureExtent = extent;
 }
 
+unsigned int FontFace::glyphTexturePages() const
+{
+    return m_glyphTexturePages;
+}
+
+void FontFace::setGlyphTexturePages(const unsigned int pages)
+{
+    assert(pages > 0);
+
+    m_glyphTexturePages = pages;
+}
+
 const glm::vec4 & FontFace::glyphTexturePadding() const
 {
     return m_glyphTexturePadding;
@@ -130,6 +152,26 @@ void FontFace::setGlyphTexture(globjects::Texture * texture)
     m_glyphTexture = texture;
 }
 
+const std::vector<unsigned char> & FontFace::glyphImage() const
+{
+    return m_glyphImage;
+}
+
+std::vector<unsigned char> & FontFace::glyphImage()
+{
+    return m_glyphImage;
+}
+
+void FontFace::setGlyphImage(std::vector<unsigned char> image)
+{
+    m_glyphImage = std::move(image);
+}
+
+unsigned long long FontFace::revision() const
+{
+    return m_revision;
+}
+
 bool FontFace::hasGlyph(const GlyphIndex index) const
 {
     return m_glyphs.find(index) != m_glyphs.cend();
@@ -137,6 +179,9 @@ bool FontFace::hasGlyph(const GlyphIndex index) const
 
 Glyph & FontFace::glyph(const GlyphIndex index)
 {
+    // the glyph may be modified through the reference
+    ++m_revision;
+
     const auto existing = m_glyphs.find(index);
     if (existing != m_glyphs.cend())
         return existing->second;
@@ -163,6 +208,7 @@ void FontFace::addGlyph(const Glyph & glyph)
     assert(m_glyphs.find(glyph.index()) == m_glyphs.cend());
 
     m_glyphs.emplace(glyph.index(), glyph);
+    ++m_revision;
 }
 
 std::vector<GlyphIndex> FontFace::glyphs() const
@@ -198,6 +244,7 @@ void FontFace::setKerning(const GlyphIndex index, const GlyphIndex subsequentInd
     }
 
     it->second.setKerning(subsequentIndex, kerning);
+    ++m_revision;
 }
 
 
@@ -0,0 +1,210 @@
+#include <openll/FontFaceGenerator.h>
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+#include <openll/FontFace.h>
+#include <openll/SkylinePacker.h>
+#include <openll/TaskPool.h>
+#include <openll/Trace.h>
+#include <openll/TrueTypeFont.h>
+
+
+namespace
+{
+
+
+// free texels between neighbouring glyphs
+const int gutter = 1;
+
+
+} // namespace
+
+
+namespace gloperate_text
+{
+
+
+FontFaceGenerator::FontFaceGenerator(float size, int padding, int oversampling, int maximumPageExtent)
+: m_size(size)
+, m_padding(padding)
+, m_oversampling(oversampling)
+, m_maximumPageExtent(maximumPageExtent)
+{
+    assert(size > 0.f);
+    assert(maximumPageExtent > 0);
+}
+
+float FontFaceGenerator::size() const
+{
+    return m_size;
+}
+
+int FontFaceGenerator::padding() const
+{
+    return m_padding;
+}
+
+int FontFaceGenerator::oversampling() const
+{
+    return m_oversampling;
+}
+
+int FontFaceGenerator::maximumPageExtent() const
+{
+    return m_maximumPageExtent;
+}
+
+FontFace * FontFaceGenerator::generate(const TrueTypeFont & font, const std::vector<GlyphIndex> & codepoints, TaskPool * pool) const
+{
+    OPENLL_TRACE_ZONE("FontFaceGenerator::generate");
+
+    if (!font.isValid())
+        return nullptr;
+
+    auto mapped = std::vector<GlyphIndex>();
+    for (const auto codepoint : codepoints)
+    {
+        if (codepoint > 0 && font.glyphId(codepoint) != 0)
+            mapped.push_back(codepoint);
+    }
+    std::sort(mapped.begin(), mapped.end());
+    mapped.erase(std::unique(mapped.begin(), mapped.end()), mapped.end());
+
+    auto fields = std::vector<GlyphRasterizer::DistanceField>(mapped.size());
+    const auto rasterizeGlyph = [&](size_t index)
+    {
+        fields[index] = rasterize(font, mapped[index]);
+    };
+
+    if (pool)
+    {
+        pool->run(mapped.size(), rasterizeGlyph);
+    }
+    else
+    {
+        for (size_t i = 0; i < mapped.size(); ++i)
+            rasterizeGlyph(i);
+    }
+
+    auto boxes = std::vector<glm::ivec2>(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i)
+        boxes[i] = fields[i].extent;
+
+    // a single page if possible, otherwise pages of the maximum extent
+    auto extent = glm::ivec2();
+    auto positions = std::vector<glm::ivec2>();
+    auto pages = std::vector<unsigned int>(boxes.size(), 0);
+    if (!SkylinePacker::packAtlas(boxes, gutter, m_maximumPageExtent, extent, positions))
+    {
+        if (!SkylinePacker::packPages(boxes, gutter, m_maximumPageExtent, pages, positions))
+            return nullptr;
+        extent = glm::ivec2(m_maximumPageExtent);
+    }
+    const auto pageCount = pages.empty() ? 1u : *std::max_element(pages.begin(), pages.end()) + 1;
+
+    auto fontFace = new FontFace();
+    initialize(*fontFace, font);
+    fontFace->setGlyphTextureExtent(glm::uvec2(extent));
+    fontFace->setGlyphTexturePages(pageCount);
+    fontFace->setGlyphImage(std::vector<unsigned char>(static_cast<size_t>(extent.x) * extent.y * pageCount, 0));
+
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        auto glyph = this->glyph(font, mapped[i], fields[i]);
+        glyph.setPage(pages[i]);
+        place(*fontFace, glyph, fields[i], positions[i]);
+        fontFace->addGlyph(glyph);
+    }
+
+    // several code points may share a glyph
+    auto codepointsByGlyph = std::unordered_map<std::uint32_t, std::vector<GlyphIndex>>();
+    for (const auto codepoint : mapped)
+        codepointsByGlyph[font.glyphId(codepoint)].push_back(codepoint);
+
+    const auto pixelsPerUnit = scale(font);
+    for (const auto & pair : font.kerningPairs())
+    {
+        const auto left = codepointsByGlyph.find(pair.left);
+        const auto right = codepointsByGlyph.find(pair.right);
+        if (left == codepointsByGlyph.end() || right == codepointsByGlyph.end())
+            continue;
+
+        for (const auto first : left->second)
+        {
+            for (const auto second : right->second)
+                fontFace->setKerning(first, second, pair.value * pixelsPerUnit);
+        }
+    }
+
+    OPENLL_TRACE_COUNTER("glyphs generated", static_cast<long long>(mapped.size()));
+    return fontFace;
+}
+
+float FontFaceGenerator::scale(const TrueTypeFont & font) const
+{
+    auto units = font.ascender() - font.descender();
+    if (units <= 0)
+        units = font.unitsPerEm();
+    return units > 0 ? m_size / static_cast<float>(units) : 0.f;
+}
+
+void FontFaceGenerator::initialize(FontFace & fontFace, const TrueTypeFont & font) const
+{
+    const auto pixelsPerUnit = scale(font);
+    fontFace.setAscent(font.ascender() * pixelsPerUnit);
+    fontFace.setDescent(font.descender() * pixelsPerUnit);
+    fontFace.setBase(fontFace.ascent());
+    fontFace.setLineHeight((font.ascender() - font.descender() + font.lineGap()) * pixelsPerUnit);
+    fontFace.setGlyphTexturePadding(glm::vec4(static_cast<float>(m_padding)));
+}
+
+GlyphRasterizer::DistanceField FontFaceGenerator::rasterize(const TrueTypeFont & font, GlyphIndex codepoint) const
+{
+    // flattening well below the sample distance keeps the curves smooth in the distance field
+    const auto tolerance = 0.25f / m_oversampling;
+    return GlyphRasterizer(m_padding, m_oversampling).rasterize(font.outline(font.glyphId(codepoint), scale(font), tolerance));
+}
+
+Glyph FontFaceGenerator::glyph(const TrueTypeFont & font, GlyphIndex codepoint, const GlyphRasterizer::DistanceField & field) const
+{
+    auto glyph = Glyph();
+    glyph.setIndex(codepoint);
+    glyph.setAdvance(font.advance(font.glyphId(codepoint)) * scale(font));
+
+    if (field.extent.x > 0)
+    {
+        glyph.setExtent(glm::vec2(field.extent));
+        // the upper left corner of the outline box, see Typesetter
+        glyph.setBearing(glm::vec2(static_cast<float>(field.lowerLeft.x), static_cast<float>(field.upperRight.y)));
+    }
+
+    return glyph;
+}
+
+void FontFaceGenerator::place(FontFace & fontFace, Glyph & glyph, const GlyphRasterizer::DistanceField & field, const glm::ivec2 & position)
+{
+    if (field.extent.x <= 0)
+        return;
+
+    const auto extent = glm::ivec2(fontFace.glyphTextureExtent());
+    auto & image = fontFace.glyphImage();
+    assert(position.x + field.extent.x <= extent.x && position.y + field.extent.y <= extent.y);
+    assert(glyph.page() < fontFace.glyphTexturePages());
+    assert(image.size() >= static_cast<size_t>(extent.x) * extent.y * fontFace.glyphTexturePages());
+
+    const auto layer = image.begin() + static_cast<size_t>(glyph.page()) * extent.x * extent.y;
+    for (auto y = 0; y < field.extent.y; ++y)
+    {
+        const auto source = field.texels.begin() + static_cast<size_t>(y) * field.extent.x;
+        std::copy(source, source + field.extent.x, layer + static_cast<size_t>(position.y + y) * extent.x + position.x);
+    }
+
+    const auto atlasScale = 1.f / glm::vec2(extent);
+    glyph.setSubTextureOrigin(glm::vec2(position) * atlasScale);
+    glyph.setSubTextureExtent(glm::vec2(field.extent) * atlasScale);
+}
+
+
+} // namespace gloperate_text
@@ -0,0 +1,149 @@
+#include <openll/FontFaceRegistry.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+#include <openll/FontFace.h>
+#include <openll/RenderBackend.h>
+#include <openll/Trace.h>
+
+
+namespace
+{
+
+
+// the absolute path without symbolic links and dot segments, so that different spellings share an entry; filename if it cannot be resolved
+std::string canonicalPath(const std::string & filename)
+{
+#ifdef _WIN32
+    char resolved[_MAX_PATH];
+    if (_fullpath(resolved, filename.c_str(), _MAX_PATH))
+        return std::string(resolved);
+#else
+    char resolved[PATH_MAX];
+    if (realpath(filename.c_str(), resolved))
+        return std::string(resolved);
+#endif
+    return filename;
+}
+
+
+} // namespace
+
+
+namespace gloperate_text
+{
+
+
+FontFaceRegistry & FontFaceRegistry::instance()
+{
+    static FontFaceRegistry registry;
+    return registry;
+}
+
+FontFaceRegistry::FontFaceRegistry()
+: m_hits(0)
+{
+}
+
+FontFaceRegistry::~FontFaceRegistry()
+{
+}
+
+globjects::ref_ptr<FontFace> FontFaceRegistry::load(const std::string & filename, const FontLoader & loader)
+{
+    OPENLL_TRACE_ZONE("FontFaceRegistry::load");
+
+    const auto backend = loader.backend();
+    const auto key = Key(canonicalPath(filename), backend, loader.repackSubset(), loader.subset(), loader.keepGlyphImage());
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    collectUnlocked();
+
+    while (true)
+    {
+        const auto it = m_fontFaces.find(key);
+        if (it == m_fontFaces.end())
+            break;
+
+        if (it->second.fontFace)
+        {
+            ++m_hits;
+            return it->second.fontFace;
+        }
+
+        // loaded by another thread; if that fails, it is loaded again here
+        m_loaded.wait(lock);
+    }
+
+    // other threads requesting the font face wait for this entry
+    const auto entry = m_fontFaces.emplace(key, Entry{ nullptr, backend }).first;
+    lock.unlock();
+
+    auto fontFace = globjects::ref_ptr<FontFace>();
+    try
+    {
+        fontFace = loader.load(filename);
+    }
+    catch (...)
+    {
+        lock.lock();
+        m_fontFaces.erase(entry);
+        m_loaded.notify_all();
+        throw;
+    }
+
+    lock.lock();
+    if (fontFace)
+        entry->second.fontFace = fontFace;
+    else
+        m_fontFaces.erase(entry);
+    m_loaded.notify_all();
+
+    OPENLL_TRACE_COUNTER("font faces registered", static_cast<long long>(m_fontFaces.size()));
+    return fontFace;
+}
+
+size_t FontFaceRegistry::collect()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return collectUnlocked();
+}
+
+size_t FontFaceRegistry::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(std::count_if(m_fontFaces.begin(), m_fontFaces.end(), [](const std::pair<const Key, Entry> & pair)
+    {
+        return pair.second.fontFace != nullptr;
+    }));
+}
+
+unsigned long long FontFaceRegistry::hits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+size_t FontFaceRegistry::collectUnlocked()
+{
+    auto released = size_t(0);
+    for (auto it = m_fontFaces.begin(); it != m_fontFaces.end();)
+    {
+        // the registry holds the last reference; font faces being loaded are not held yet
+        if (it->second.fontFace && it->second.fontFace->refCounter() == 1)
+        {
+            it = m_fontFaces.erase(it);
+            ++released;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return released;
+}
+
+
+} // namespace gloperate_text
@@ -2,17 +2,22 @@
 #include <openll/FontLoader.h>
 
 #include <fstream>
+#include <iostream>
 #include <sstream>
 #include <string>
 #include <functional>
 #include <set>
 #include <map>
 #include <algorithm>
+#include <cstdlib>
 
-#include <glbinding/gl/enum.h>
+#include <glm/vec2.hpp>
 
-#include <openll/RawFile.h>
+#include <openll/GLRenderBackend.h>
+#include <openll/GlyphSequence.h>
 #include <openll/FontFace.h>
+#include <openll/SkylinePacker.h>
+#include <openll/Trace.h>
 
 namespace {
 
@@ -66,6 +71,40 @@ bool hasSuffix(const std::string & string, const std::string & suffix)
     return string.size() >= suffix.size() && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
 }
 
+// the value of key in a line without reading all pairs, to skip glyphs not in the subset; 0 if missing
+gloperate_text::GlyphIndex indexValue(const std::string & line, const std::string & key)
+{
+    const auto position = line.find(" " + key + "=");
+    if (position == std::string::npos)
+        return 0;
+
+    return static_cast<gloperate_text::GlyphIndex>(std::strtoul(line.c_str() + position + key.size() + 2, nullptr, 10));
+}
+
+// the size of the file read by in, 0 if it is not open
+size_t fileSize(std::istream & in)
+{
+    if (!in)
+        return 0;
+
+    in.seekg(0, std::ios::end);
+    const auto size = in.tellg();
+    return size < 0 ? 0 : static_cast<size_t>(size);
+}
+
+// reads count texels at offset of a page file into target; texels past the end of the file are left unchanged
+void readTexels(std::istream & in, size_t fileSize, size_t offset, size_t count, unsigned char * target)
+{
+    if (offset >= fileSize)
+        return;
+
+    in.seekg(static_cast<std::streamoff>(offset));
+    in.read(reinterpret_cast<char *>(target), static_cast<std::streamsize>(std::min(count, fileSize - offset)));
+}
+
+// free texels between neighbouring glyphs of repacked atlases
+const int gutter = 1;
+
 }
 
 
@@ -73,12 +112,22 @@ namespace gloperate_text
 {
 
 
-FontLoader::FontLoader()
+FontLoader::FontLoader(bool uploadGlyphTexture)
+: FontLoader(uploadGlyphTexture ? GLRenderBackend::instance() : nullptr)
+{
+}
+
+FontLoader::FontLoader(RenderBackend * backend)
+: m_backend(backend)
+, m_restrictToSubset(false)
+, m_repackSubset(false)
+, m_keepGlyphImage(false)
 {
 }
 
 FontFace * FontLoader::load(const std::string & filename) const
 {
+    OPENLL_TRACE_ZONE("FontLoader::load");
     std::ifstream in(filename, std::ios::in | std::ios::binary);
 
     if (!in)
@@ -89,6 +138,9 @@ FontFace * FontLoader::load(const std::string & filename) const
 
     auto line = std::string();
     auto identifier = std::string();
+    auto pageLoaded = false;
+    // the raw file of each page, read once all glyphs are known
+    auto pageFiles = std::vector<std::string>();
 
     while (std::getline(in, line))
     {
@@ -111,25 +163,186 @@ FontFace * FontLoader::load(const std::string & filename) const
         }
         else if (identifier == "page")
         {
-            handlePage(ss, *fontFace, filename);
+            pageLoaded = handlePage(ss, *fontFace, filename, pageFiles) || pageLoaded;
         }
         else if (identifier == "char")
         {
-            handleChar(ss, *fontFace);
+            if (inSubset(indexValue(line, "id")))
+                handleChar(ss, *fontFace, pageFiles);
         }
         else if (identifier == "kerning")
         {
-            handleKerning(ss, *fontFace);
+            if (inSubset(indexValue(line, "first")) && inSubset(indexValue(line, "second")))
+                handleKerning(ss, *fontFace);
         }
     }
 
-    if (fontFace->glyphTexture())
+    if (pageLoaded)
+    {
+        // a repacked subset reads only the texels of its glyphs
+        if (!(m_repackSubset && m_restrictToSubset && repack(*fontFace, pageFiles)))
+            readPages(*fontFace, pageFiles);
+
+        // after all pages are read, one layer per page
+        if (m_backend)
+        {
+            m_backend->createGlyphTexture(*fontFace);
+            if (!m_keepGlyphImage)
+                fontFace->setGlyphImage(std::vector<unsigned char>());
+        }
         return fontFace;
+    }
 
     delete fontFace;
     return nullptr;
 }
 
+RenderBackend * FontLoader::backend() const
+{
+    return m_backend;
+}
+
+void FontLoader::setSubset(std::set<GlyphIndex> codepoints)
+{
+    m_restrictToSubset = !codepoints.empty();
+    m_subset = std::move(codepoints);
+}
+
+void FontLoader::setSubset(const std::vector<GlyphSequence> & corpus)
+{
+    m_restrictToSubset = true;
+    m_subset.clear();
+    for (const auto & sequence : corpus)
+        m_subset.insert(sequence.string().begin(), sequence.string().end());
+}
+
+const std::set<GlyphIndex> & FontLoader::subset() const
+{
+    return m_subset;
+}
+
+void FontLoader::setRepackSubset(const bool repack)
+{
+    m_repackSubset = repack;
+}
+
+bool FontLoader::repackSubset() const
+{
+    return m_repackSubset;
+}
+
+void FontLoader::setKeepGlyphImage(const bool keep)
+{
+    m_keepGlyphImage = keep;
+}
+
+bool FontLoader::keepGlyphImage() const
+{
+    return m_keepGlyphImage;
+}
+
+bool FontLoader::inSubset(const GlyphIndex index) const
+{
+    return !m_restrictToSubset || m_subset.count(index) > 0;
+}
+
+bool FontLoader::repack(FontFace & fontFace, const std::vector<std::string> & pageFiles) const
+{
+    OPENLL_TRACE_ZONE("FontLoader::repack");
+
+    const auto extent = glm::ivec2(fontFace.glyphTextureExtent());
+    const auto pageSize = static_cast<size_t>(extent.x) * extent.y;
+
+    // the texel rectangles of the depictable glyphs
+    const auto indices = fontFace.glyphs();
+    auto origins = std::vector<glm::ivec2>(indices.size());
+    auto boxes = std::vector<glm::ivec2>(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        const auto & glyph = fontFace.glyph(indices[i]);
+        if (!glyph.depictable() || glyph.page() >= fontFace.glyphTexturePages())
+            continue;
+
+        origins[i] = glm::ivec2(glyph.subTextureOrigin() * glm::vec2(extent) + 0.5f);
+        boxes[i] = glm::ivec2(glyph.subTextureExtent() * glm::vec2(extent) + 0.5f);
+        boxes[i] = glm::min(boxes[i], extent - origins[i]);
+    }
+
+    // a single page no larger than the loaded one if possible
+    auto packedExtent = glm::ivec2();
+    auto positions = std::vector<glm::ivec2>();
+    auto pages = std::vector<unsigned int>(indices.size(), 0);
+    const auto maximumExtent = std::min(extent.x, extent.y);
+    if (!SkylinePacker::packAtlas(boxes, gutter, std::max(extent.x, extent.y), packedExtent, positions))
+    {
+        if (!SkylinePacker::packPages(boxes, gutter, maximumExtent, pages, positions))
+            return false; // keep the whole atlas
+        packedExtent = glm::ivec2(maximumExtent);
+    }
+
+    const auto pageCount = pages.empty() ? 1u : *std::max_element(pages.begin(), pages.end()) + 1;
+    const auto packedPageSize = static_cast<size_t>(packedExtent.x) * packedExtent.y;
+    if (packedPageSize * pageCount >= pageSize * fontFace.glyphTexturePages())
+        return false;
+
+    // the rows of the glyphs are read from the page files, the whole atlas is never in memory
+    auto packed = std::vector<unsigned char>(packedPageSize * pageCount, 0);
+    const auto packedScale = 1.f / glm::vec2(packedExtent);
+    for (unsigned int page = 0; page < pageFiles.size(); ++page)
+    {
+        std::ifstream in(pageFiles[page], std::ios::in | std::ios::binary);
+        const auto size = fileSize(in);
+
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            auto & glyph = fontFace.glyph(indices[i]);
+            if (boxes[i].x <= 0 || boxes[i].y <= 0 || glyph.page() != page)
+                continue;
+
+            const auto target = packed.begin() + pages[i] * packedPageSize;
+            for (auto y = 0; y < boxes[i].y; ++y)
+            {
+                const auto offset = static_cast<size_t>(origins[i].y + y) * extent.x + origins[i].x;
+                readTexels(in, size, offset, boxes[i].x, &*(target + static_cast<size_t>(positions[i].y + y) * packedExtent.x + positions[i].x));
+            }
+        }
+    }
+
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        if (boxes[i].x <= 0 || boxes[i].y <= 0)
+            continue;
+
+        auto & glyph = fontFace.glyph(indices[i]);
+        glyph.setPage(pages[i]);
+        glyph.setSubTextureOrigin(glm::vec2(positions[i]) * packedScale);
+        glyph.setSubTextureExtent(glm::vec2(boxes[i]) * packedScale);
+    }
+
+    OPENLL_TRACE_COUNTER("atlas bytes saved", static_cast<long long>(pageSize * fontFace.glyphTexturePages() - packed.size()));
+    fontFace.setGlyphTextureExtent(glm::uvec2(packedExtent));
+    fontFace.setGlyphTexturePages(pageCount);
+    fontFace.setGlyphImage(std::move(packed));
+    return true;
+}
+
+void FontLoader::readPages(FontFace & fontFace, const std::vector<std::string> & pageFiles) const
+{
+    // each page is a layer of the glyph image
+    const auto extent = glm::ivec2(fontFace.glyphTextureExtent());
+    const auto pageSize = static_cast<size_t>(extent.x) * extent.y;
+    auto image = std::vector<unsigned char>(pageSize * fontFace.glyphTexturePages(), 0);
+    for (size_t page = 0; page < pageFiles.size(); ++page)
+    {
+        if (pageFiles[page].empty())
+            continue;
+
+        std::ifstream in(pageFiles[page], std::ios::in | std::ios::binary);
+        readTexels(in, fileSize(in), 0, pageSize, image.data() + page * pageSize);
+    }
+    fontFace.setGlyphImage(std::move(image));
+}
+
 void FontLoader::handleInfo(std::stringstream & stream, FontFace & fontFace) const
 {
     auto pairs = readKeyValuePairs(stream, { "padding" });
@@ -160,39 +373,44 @@ void FontLoader::handleCommon(std::stringstream & stream, FontFace & fontFace) c
     fontFace.setGlyphTextureExtent({
         fromString<float>(pairs.at("scaleW")),
         fromString<float>(pairs.at("scaleH")) });
+
+    const auto pages = pairs.find("pages");
+    if (pages != pairs.cend() && fromString<unsigned int>(pages->second) > 0)
+        fontFace.setGlyphTexturePages(fromString<unsigned int>(pages->second));
 }
 
-void FontLoader::handlePage(std::stringstream & stream, FontFace & fontFace, const std::string & filename) const
+bool FontLoader::handlePage(std::stringstream & stream, FontFace & fontFace, const std::string & filename
+    , std::vector<std::string> & pageFiles) const
 {
-    auto pairs = readKeyValuePairs(stream, { "file" });
+    auto pairs = readKeyValuePairs(stream, { "id", "file" });
 
     const auto path = directoryPath(filename);
     const auto file = stripped(pairs.at("file"), { '"', '\r' });
 
     assert(hasSuffix(file, ".raw"));
 
-    auto texture = new globjects::Texture(gl::GL_TEXTURE_2D);
-    auto raw = gloperate_text::RawFile(path + "/" + file);
-
-    if (!raw.isValid())
+    const auto pageFile = path + "/" + file;
+    if (!std::ifstream(pageFile, std::ios::in | std::ios::binary))
     {
+        std::cerr << "Reading from file \"" << pageFile << "\" failed." << std::endl;
         assert(false);
-        return;
+        return false;
     }
 
-    const auto extent = glm::ivec2(fontFace.glyphTextureExtent());
-    texture->image2D(0, gl::GL_R8, extent, 0
-        , gl::GL_RED, gl::GL_UNSIGNED_BYTE, static_cast<const gl::GLvoid *>(raw.data()));
+    // each page is a layer of the glyph image, pages not listed in common are appended
+    const auto page = pairs.count("id") ? fromString<unsigned int>(pairs.at("id")) : 0u;
+    if (page >= fontFace.glyphTexturePages())
+        fontFace.setGlyphTexturePages(page + 1);
 
-    fontFace.setGlyphTexture(texture);
+    if (page >= pageFiles.size())
+        pageFiles.resize(page + 1);
+    pageFiles[page] = pageFile;
 
-    fontFace.glyphTexture()->setParameter(gl::GL_TEXTURE_MIN_FILTER, gl::GL_LINEAR);
-    fontFace.glyphTexture()->setParameter(gl::GL_TEXTURE_MAG_FILTER, gl::GL_LINEAR);
-    fontFace.glyphTexture()->setParameter(gl::GL_TEXTURE_WRAP_S, gl::GL_CLAMP_TO_EDGE);
-    fontFace.glyphTexture()->setParameter(gl::GL_TEXTURE_WRAP_T, gl::GL_CLAMP_TO_EDGE);
+    return true;
 }
 
-void FontLoader::handleChar(std::stringstream & stream, FontFace & fontFace) const
+void FontLoader::handleChar(std::stringstream & stream, FontFace & fontFace
+    , const std::vector<std::string> & pageFiles) const
 {
     auto pairs = readKeyValuePairs(stream, { "id", "x", "y", "width", "height", "xoffset", "yoffset", "xadvance" });
 
@@ -221,6 +439,13 @@ void FontLoader::handleChar(std::stringstream & stream, FontFace & fontFace) con
 
     glyph.setAdvance(fromString<float>(pairs.at("xadvance")));
 
+    // the pages precede the chars, a glyph on a page whose file was not loaded has no texels
+    const auto page = pairs.find("page");
+    if (page != pairs.cend())
+        glyph.setPage(fromString<unsigned int>(page->second));
+    if (glyph.page() >= pageFiles.size() || pageFiles[glyph.page()].empty())
+        return;
+
     fontFace.addGlyph(glyph);
 }
 
@@ -0,0 +1,125 @@
+#include <openll/FontWriter.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include <openll/FontFace.h>
+
+
+namespace
+{
+
+
+std::string directoryPath(const std::string & path)
+{
+    const auto position = path.find_last_of("/\\");
+    return position == std::string::npos ? std::string() : path.substr(0, position + 1);
+}
+
+std::string stem(const std::string & path)
+{
+    const auto name = path.substr(directoryPath(path).size());
+    return name.substr(0, name.find_last_of('.'));
+}
+
+
+} // namespace
+
+
+namespace gloperate_text
+{
+
+
+FontWriter::FontWriter()
+{
+}
+
+bool FontWriter::save(const FontFace & fontFace, const std::string & filename, const std::string & faceName) const
+{
+    const auto extent = fontFace.glyphTextureExtent();
+    const auto pages = fontFace.glyphTexturePages();
+    const auto pageSize = static_cast<size_t>(extent.x) * extent.y;
+    const auto & image = fontFace.glyphImage();
+    if (image.size() < pageSize * pages)
+        return false;
+
+    auto face = faceName.empty() ? stem(filename) : faceName;
+    face.erase(std::remove(face.begin(), face.end(), ' '), face.end());
+
+    // one file per page, the image is stored from bottom to top, as expected by FontLoader
+    auto rawNames = std::vector<std::string>();
+    for (auto page = 0u; page < pages; ++page)
+    {
+        const auto pageStem = pages > 1 ? stem(filename) + "_" + std::to_string(page) : stem(filename);
+        rawNames.push_back(pageStem + "." + std::to_string(extent.x) + "." + std::to_string(extent.y) + ".r.ub.raw");
+
+        std::ofstream raw(directoryPath(filename) + rawNames.back(), std::ios::out | std::ios::binary);
+        if (!raw)
+        {
+            std::cerr << "Writing to file \"" << directoryPath(filename) + rawNames.back() << "\" failed." << std::endl;
+            return false;
+        }
+        raw.write(reinterpret_cast<const char *>(image.data() + page * pageSize), static_cast<std::streamsize>(pageSize));
+        if (!raw)
+            return false;
+    }
+
+    std::ofstream fnt(filename, std::ios::out);
+    if (!fnt)
+    {
+        std::cerr << "Writing to file \"" << filename << "\" failed." << std::endl;
+        return false;
+    }
+
+    // left, right, top, bottom; see FontLoader::handleInfo
+    const auto & padding = fontFace.glyphTexturePadding();
+    fnt << "info face=" << face << " size=" << fontFace.size() << " bold=0 italic=0 charset= unicode=1 stretchH=100 smooth=1 aa=1"
+        << " padding=" << padding[3] << "," << padding[1] << "," << padding[0] << "," << padding[2] << " spacing=0,0 outline=0\n";
+    fnt << "common lineHeight=" << fontFace.lineHeight() << " base=" << fontFace.base()
+        << " ascent=" << fontFace.ascent() << " descent=" << fontFace.descent()
+        << " scaleW=" << extent.x << " scaleH=" << extent.y << " pages=" << pages << " packed=0\n";
+    for (size_t page = 0; page < rawNames.size(); ++page)
+        fnt << "page id=" << page << " file=\"" << rawNames[page] << "\"\n";
+
+    auto glyphs = fontFace.glyphs();
+    std::sort(glyphs.begin(), glyphs.end());
+
+    fnt << "chars count=" << glyphs.size() << "\n";
+    auto kerningCount = size_t(0);
+    for (const auto index : glyphs)
+    {
+        const auto & glyph = fontFace.glyph(index);
+        kerningCount += glyph.kernings().size();
+
+        // pixel positions with y from the top of the image
+        const auto position = glm::vec2(glyph.subTextureOrigin().x * extent.x, glyph.subTextureOrigin().y * extent.y);
+        const auto top = static_cast<float>(extent.y) - position.y - glyph.extent().y;
+        fnt << "char id=" << index
+            << " x=" << static_cast<int>(position.x + 0.5f) << " y=" << static_cast<int>(top + 0.5f)
+            << " width=" << glyph.extent().x << " height=" << glyph.extent().y
+            << " xoffset=" << glyph.bearing().x << " yoffset=" << fontFace.base() - glyph.bearing().y
+            << " xadvance=" << glyph.advance() << " page=" << glyph.page() << " chnl=15\n";
+    }
+
+    fnt << "kernings count=" << kerningCount << "\n";
+    for (const auto index : glyphs)
+    {
+        const auto & kernings = fontFace.glyph(index).kernings();
+        auto subsequents = std::vector<std::pair<GlyphIndex, float>>(kernings.begin(), kernings.end());
+        std::sort(subsequents.begin(), subsequents.end());
+
+        for (const auto & kerning : subsequents)
+            fnt << "kerning first=" << index << " second=" << kerning.first << " amount=" << kerning.second << "\n";
+    }
+
+    return static_cast<bool>(fnt);
+}
+
+
+} // namespace gloperate_text
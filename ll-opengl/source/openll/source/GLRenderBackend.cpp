@@ -0,0 +1,155 @@
+#include <openll/GLRenderBackend.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/boolean.h>
+#include <glbinding/gl/functions.h>
+
+#include <globjects/Buffer.h>
+#include <globjects/Program.h>
+#include <globjects/Texture.h>
+
+#include <openll/Drawable.h>
+#include <openll/FontFace.h>
+#include <openll/Trace.h>
+
+
+namespace gloperate_text
+{
+
+
+GLRenderBackend * GLRenderBackend::instance()
+{
+    static globjects::ref_ptr<GLRenderBackend> backend(new GLRenderBackend);
+    return backend;
+}
+
+GLRenderBackend::GLRenderBackend()
+{
+}
+
+GLRenderBackend::~GLRenderBackend()
+{
+}
+
+void GLRenderBackend::createGlyphTexture(FontFace & fontFace)
+{
+    // one layer per page, the pages follow each other in the glyph image
+    const auto extent = glm::ivec3(glm::ivec2(fontFace.glyphTextureExtent()), fontFace.glyphTexturePages());
+    const auto & image = fontFace.glyphImage();
+    if (image.size() < static_cast<size_t>(extent.x) * extent.y * extent.z)
+    {
+        assert(false);
+        return;
+    }
+
+    auto texture = new globjects::Texture(gl::GL_TEXTURE_2D_ARRAY);
+
+    OPENLL_TRACE_COUNTER("bytes uploaded", extent.x * extent.y * extent.z);
+    texture->image3D(0, gl::GL_R8, extent, 0
+        , gl::GL_RED, gl::GL_UNSIGNED_BYTE, static_cast<const gl::GLvoid *>(image.data()));
+
+    texture->setParameter(gl::GL_TEXTURE_MIN_FILTER, gl::GL_LINEAR);
+    texture->setParameter(gl::GL_TEXTURE_MAG_FILTER, gl::GL_LINEAR);
+    texture->setParameter(gl::GL_TEXTURE_WRAP_S, gl::GL_CLAMP_TO_EDGE);
+    texture->setParameter(gl::GL_TEXTURE_WRAP_T, gl::GL_CLAMP_TO_EDGE);
+
+    fontFace.setGlyphTexture(texture);
+}
+
+void GLRenderBackend::updateGlyphTexture(FontFace & fontFace, const glm::ivec2 & offset, const glm::ivec2 & extent, unsigned int page)
+{
+    const auto texture = fontFace.glyphTexture();
+    if (!texture || extent.x <= 0 || extent.y <= 0)
+        return;
+
+    // the rows of the rectangle are packed tightly for the upload
+    const auto width = static_cast<int>(fontFace.glyphTextureExtent().x);
+    const auto layer = fontFace.glyphImage().begin() + static_cast<size_t>(page) * width * fontFace.glyphTextureExtent().y;
+    std::vector<unsigned char> texels(static_cast<size_t>(extent.x) * extent.y);
+    for (auto y = 0; y < extent.y; ++y)
+    {
+        const auto row = layer + static_cast<size_t>(offset.y + y) * width + offset.x;
+        std::copy(row, row + extent.x, texels.begin() + static_cast<size_t>(y) * extent.x);
+    }
+
+    gl::GLint alignment = 4;
+    gl::glGetIntegerv(gl::GL_UNPACK_ALIGNMENT, &alignment);
+    gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, 1);
+
+    OPENLL_TRACE_COUNTER("bytes uploaded", extent.x * extent.y);
+    texture->subImage3D(0, glm::ivec3(offset, page), glm::ivec3(extent, 1), gl::GL_RED, gl::GL_UNSIGNED_BYTE, static_cast<const gl::GLvoid *>(texels.data()));
+
+    gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, alignment);
+}
+
+void GLRenderBackend::uploadVertices(GlyphVertexCloud & vertexCloud, const GlyphVertexCloud::Vertices & vertices)
+{
+    if (!vertexCloud.drawable())
+        vertexCloud.setDrawable(createDrawable());
+
+    vertexCloud.drawable()->buffer(0)->setData(vertices, gl::GL_STATIC_DRAW);
+    vertexCloud.drawable()->setSize(static_cast<gl::GLsizei>(vertices.size()));
+}
+
+void GLRenderBackend::draw(const GlyphVertexCloud & vertexCloud, globjects::Program * program, const glm::mat4 & viewProjection)
+{
+    assert(program);
+    if (!vertexCloud.drawable() || !vertexCloud.texture())
+        return;
+
+    program->setUniform("viewProjection", viewProjection);
+    program->use();
+
+    vertexCloud.texture()->bindActive(0);
+    vertexCloud.drawable()->draw();
+    vertexCloud.texture()->unbindActive(0);
+
+    program->release();
+}
+
+Drawable * GLRenderBackend::createDrawable()
+{
+    using Vertex = GlyphVertexCloud::Vertex;
+
+    auto drawable = new Drawable();
+
+    drawable->setMode(gl::GL_POINTS);
+    drawable->setDrawMode(DrawMode::Arrays);
+
+    drawable->bindAttributes({ 0, 1, 2, 3, 4, 5, 6 });
+
+    globjects::Buffer * vertexBuffer = new globjects::Buffer;
+    drawable->setBuffer(0, vertexBuffer);
+    drawable->setAttributeBindingBuffer(0, vertexBuffer, 0, sizeof(Vertex));
+    drawable->setAttributeBindingBuffer(1, vertexBuffer, 0, sizeof(Vertex));
+    drawable->setAttributeBindingBuffer(2, vertexBuffer, 0, sizeof(Vertex));
+    drawable->setAttributeBindingBuffer(3, vertexBuffer, 0, sizeof(Vertex));
+    drawable->setAttributeBindingBuffer(4, vertexBuffer, 0, sizeof(Vertex));
+    drawable->setAttributeBindingBuffer(5, vertexBuffer, 0, sizeof(Vertex));
+    drawable->setAttributeBindingBuffer(6, vertexBuffer, 0, sizeof(Vertex));
+
+    drawable->setAttributeBindingFormat(0, 3, gl::GL_FLOAT,        gl::GL_FALSE, offsetof(Vertex, origin));
+    drawable->setAttributeBindingFormat(1, 3, gl::GL_FLOAT,        gl::GL_FALSE, offsetof(Vertex, vtan));
+    drawable->setAttributeBindingFormat(2, 3, gl::GL_FLOAT,        gl::GL_FALSE, offsetof(Vertex, vbitan));
+    drawable->setAttributeBindingFormat(3, 4, gl::GL_FLOAT,        gl::GL_FALSE, offsetof(Vertex, uvRect));
+    drawable->setAttributeBindingFormat(4, 4, gl::GL_FLOAT,        gl::GL_FALSE, offsetof(Vertex, fontColor));
+    // integer attributes, not converted to float
+    drawable->setAttributeBindingFormatI(5, 1, gl::GL_UNSIGNED_INT, offsetof(Vertex, superSampling));
+    drawable->setAttributeBindingFormatI(6, 1, gl::GL_UNSIGNED_INT, offsetof(Vertex, page));
+
+    drawable->enableAllAttributeBindings();
+
+    return drawable;
+}
+
+
+} // namespace gloperate_text
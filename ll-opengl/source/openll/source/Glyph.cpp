@@ -8,6 +8,7 @@ namespace gloperate_text
 
 Glyph::Glyph()
 : m_index(0u)
+, m_page(0u)
 , m_advance(0)
 {
 }
@@ -54,6 +55,16 @@ void Glyph::setSubTextureExtent(const glm::vec2 & extent)
     m_subtextureExtent = extent;
 }
 
+unsigned int Glyph::page() const
+{
+    return m_page;
+}
+
+void Glyph::setPage(const unsigned int page)
+{
+    m_page = page;
+}
+
 bool Glyph::depictable() const
 {
     return m_subtextureExtent.x > 0.f && m_subtextureExtent.y > 0.f;
@@ -109,5 +120,10 @@ void Glyph::setKerning(GlyphIndex subsequentIndex, const float kerning)
     m_kernings[subsequentIndex] = kerning;
 }
 
+const std::unordered_map<GlyphIndex, float> & Glyph::kernings() const
+{
+    return m_kernings;
+}
+
 
 } // namespace gloperate_text
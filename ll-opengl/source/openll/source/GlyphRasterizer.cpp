@@ -0,0 +1,175 @@
+#include <openll/GlyphRasterizer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include <openll/DistanceTransform.h>
+#include <openll/Trace.h>
+
+
+namespace
+{
+
+
+struct Edge
+{
+    glm::vec2 from;
+    glm::vec2 to;
+    int winding;
+};
+
+// inside samples of the grid with the given origin and sample distance
+std::vector<bool> fill(const gloperate_text::TrueTypeFont::Outline & outline, const glm::vec2 & origin, float step, int width, int height)
+{
+    std::vector<Edge> edges;
+    for (const auto & contour : outline)
+    {
+        for (size_t i = 0; i < contour.size(); ++i)
+        {
+            const auto & a = contour[i];
+            const auto & b = contour[(i + 1) % contour.size()];
+            if (a.y == b.y)
+                continue;
+            edges.push_back(a.y < b.y ? Edge{ a, b, 1 } : Edge{ b, a, -1 });
+        }
+    }
+
+    std::vector<bool> inside(static_cast<size_t>(width) * height, false);
+    std::vector<std::pair<float, int>> crossings;
+
+    for (auto y = 0; y < height; ++y)
+    {
+        const auto sampleY = origin.y + (y + 0.5f) * step;
+
+        crossings.clear();
+        for (const auto & edge : edges)
+        {
+            // half-open in y, so that vertices shared by two edges are counted once
+            if (sampleY < edge.from.y || sampleY >= edge.to.y)
+                continue;
+            const auto t = (sampleY - edge.from.y) / (edge.to.y - edge.from.y);
+            crossings.emplace_back(edge.from.x + t * (edge.to.x - edge.from.x), edge.winding);
+        }
+        std::sort(crossings.begin(), crossings.end());
+
+        auto winding = 0;
+        for (size_t i = 0; i + 1 < crossings.size(); ++i)
+        {
+            winding += crossings[i].second;
+            if (winding == 0)
+                continue;
+
+            // samples with centers in [crossing i, crossing i + 1)
+            const auto begin = std::max(static_cast<int>(std::ceil((crossings[i].first - origin.x) / step - 0.5f)), 0);
+            const auto end = std::min(static_cast<int>(std::ceil((crossings[i + 1].first - origin.x) / step - 0.5f)), width);
+            for (auto x = begin; x < end; ++x)
+                inside[static_cast<size_t>(y) * width + x] = true;
+        }
+    }
+
+    return inside;
+}
+
+
+} // namespace
+
+
+namespace gloperate_text
+{
+
+
+GlyphRasterizer::GlyphRasterizer(int padding, int oversampling)
+: m_padding(padding)
+, m_oversampling(oversampling)
+{
+    assert(padding > 0);
+    assert(oversampling > 0);
+}
+
+int GlyphRasterizer::padding() const
+{
+    return m_padding;
+}
+
+int GlyphRasterizer::oversampling() const
+{
+    return m_oversampling;
+}
+
+GlyphRasterizer::DistanceField GlyphRasterizer::rasterize(const TrueTypeFont::Outline & outline) const
+{
+    OPENLL_TRACE_ZONE("GlyphRasterizer::rasterize");
+
+    DistanceField field;
+    field.lowerLeft = glm::ivec2(0);
+    field.upperRight = glm::ivec2(0);
+    field.extent = glm::ivec2(0);
+
+    auto lowerLeft = glm::vec2(std::numeric_limits<float>::max());
+    auto upperRight = glm::vec2(std::numeric_limits<float>::lowest());
+    for (const auto & contour : outline)
+    {
+        for (const auto & point : contour)
+        {
+            lowerLeft = glm::vec2(std::min(lowerLeft.x, point.x), std::min(lowerLeft.y, point.y));
+            upperRight = glm::vec2(std::max(upperRight.x, point.x), std::max(upperRight.y, point.y));
+        }
+    }
+
+    if (lowerLeft.x > upperRight.x)
+        return field;
+
+    field.lowerLeft = glm::ivec2(static_cast<int>(std::floor(lowerLeft.x)), static_cast<int>(std::floor(lowerLeft.y)));
+    field.upperRight = glm::ivec2(static_cast<int>(std::ceil(upperRight.x)), static_cast<int>(std::ceil(upperRight.y)));
+    field.extent = field.upperRight - field.lowerLeft + glm::ivec2(2 * m_padding);
+
+    const auto k = m_oversampling;
+    const auto width = field.extent.x * k;
+    const auto height = field.extent.y * k;
+    const auto origin = glm::vec2(field.lowerLeft - glm::ivec2(m_padding));
+
+    const auto inside = fill(outline, origin, 1.f / k, width, height);
+
+    // distances of outside samples to the shape and of inside samples to the background
+    const auto infinity = distanceTransformInfinity();
+    const auto samples = static_cast<size_t>(width) * height;
+    std::vector<float> toInside(samples);
+    std::vector<float> toOutside(samples);
+    for (size_t i = 0; i < samples; ++i)
+    {
+        toInside[i] = inside[i] ? 0.f : infinity;
+        toOutside[i] = inside[i] ? infinity : 0.f;
+    }
+    squaredDistanceTransform(toInside, width, height);
+    squaredDistanceTransform(toOutside, width, height);
+
+    // the boundary lies half a sample between neighbouring inside and outside samples
+    const auto spread = static_cast<float>(m_padding * k);
+    field.texels.resize(static_cast<size_t>(field.extent.x) * field.extent.y);
+    for (auto y = 0; y < field.extent.y; ++y)
+    {
+        for (auto x = 0; x < field.extent.x; ++x)
+        {
+            auto distance = 0.f;
+            for (auto sy = y * k; sy < (y + 1) * k; ++sy)
+            {
+                for (auto sx = x * k; sx < (x + 1) * k; ++sx)
+                {
+                    const auto i = static_cast<size_t>(sy) * width + sx;
+                    distance += inside[i] ? 0.5f - std::sqrt(toOutside[i]) : std::sqrt(toInside[i]) - 0.5f;
+                }
+            }
+            distance /= static_cast<float>(k * k);
+
+            const auto value = std::min(std::max(0.5f - distance / (2.f * spread), 0.f), 1.f);
+            field.texels[static_cast<size_t>(y) * field.extent.x + x] = static_cast<unsigned char>(value * 255.f + 0.5f);
+        }
+    }
+
+    return field;
+}
+
+
+} // namespace gloperate_text
@@ -0,0 +1,194 @@
+#include <openll/GlyphRenderStatistics.h>
+
+#include <algorithm>
+#include <cassert>
+
+#include <glbinding/gl/enum.h>
+
+
+namespace gloperate_text
+{
+
+
+double GlyphRenderStatistics::Frame::gpuTime() const
+{
+    if (pendingTimings > 0)
+        return -1.0;
+
+    auto time = 0.0;
+    for (const auto drawCallTime : gpuTimes)
+        time += drawCallTime;
+    return time;
+}
+
+GlyphRenderStatistics::GlyphRenderStatistics(bool gpuTiming, size_t history)
+: m_gpuTiming(gpuTiming)
+, m_history(std::max(history, size_t(1)))
+{
+    reset();
+}
+
+GlyphRenderStatistics::~GlyphRenderStatistics()
+{
+}
+
+bool GlyphRenderStatistics::gpuTiming() const
+{
+    return m_gpuTiming;
+}
+
+void GlyphRenderStatistics::beginFrame()
+{
+    assert(!m_activeQuery);
+
+    const auto next = m_frames.back().index + 1;
+    m_frames.push_back({next, 0, 0, 0, {}, 0});
+
+    collectQueries();
+
+    // frames are completed in order, as the GPU processes them in order
+    while (m_completeFrames < next)
+    {
+        const auto oldest = frame(m_completeFrames);
+        if (oldest && oldest->pendingTimings > 0)
+            break;
+        if (oldest)
+            complete(*oldest);
+        ++m_completeFrames;
+    }
+
+    while (m_frames.size() > m_history)
+    {
+        // a frame still waiting for query results is counted without them
+        if (m_frames.front().index >= m_completeFrames)
+        {
+            complete(m_frames.front());
+            m_completeFrames = m_frames.front().index + 1;
+        }
+        m_frames.pop_front();
+    }
+}
+
+const GlyphRenderStatistics::Frame & GlyphRenderStatistics::currentFrame() const
+{
+    return m_frames.back();
+}
+
+const GlyphRenderStatistics::Frame * GlyphRenderStatistics::lastCompleteFrame() const
+{
+    if (m_completeFrames == 0 || m_frames.front().index >= m_completeFrames)
+        return nullptr;
+    return &m_frames[static_cast<size_t>(m_completeFrames - 1 - m_frames.front().index)];
+}
+
+const std::deque<GlyphRenderStatistics::Frame> & GlyphRenderStatistics::frames() const
+{
+    return m_frames;
+}
+
+const GlyphRenderStatistics::Summary & GlyphRenderStatistics::summary() const
+{
+    return m_summary;
+}
+
+void GlyphRenderStatistics::reset()
+{
+    assert(!m_activeQuery);
+
+    m_frames.clear();
+    m_frames.push_back({0, 0, 0, 0, {}, 0});
+    m_summary = {0, 0, 0, 0, 0.0, 0.0};
+    m_timedFrames = 0;
+    m_completeFrames = 0;
+
+    // the results of pending queries are discarded
+    for (const auto & pending : m_pendingQueries)
+        m_freeQueries.push_back(pending.query);
+    m_pendingQueries.clear();
+}
+
+void GlyphRenderStatistics::beginDraw()
+{
+    if (!m_gpuTiming)
+        return;
+
+    assert(!m_activeQuery);
+    if (m_freeQueries.empty())
+    {
+        m_activeQuery = new globjects::Query;
+    }
+    else
+    {
+        m_activeQuery = m_freeQueries.back();
+        m_freeQueries.pop_back();
+    }
+    m_activeQuery->begin(gl::GL_TIME_ELAPSED);
+}
+
+void GlyphRenderStatistics::endDraw(size_t glyphs, size_t uploadedBytes)
+{
+    auto & current = m_frames.back();
+
+    if (m_gpuTiming)
+    {
+        assert(m_activeQuery);
+        m_activeQuery->end(gl::GL_TIME_ELAPSED);
+        m_pendingQueries.push_back({m_activeQuery, current.index, current.drawCalls});
+        m_activeQuery = nullptr;
+
+        current.gpuTimes.push_back(-1.0);
+        ++current.pendingTimings;
+    }
+
+    ++current.drawCalls;
+    current.glyphs += glyphs;
+    current.uploadedBytes += uploadedBytes;
+}
+
+void GlyphRenderStatistics::collectQueries()
+{
+    // the results of each frame become available in order, so that polling stops at the first pending query
+    size_t collected = 0;
+    for (; collected < m_pendingQueries.size(); ++collected)
+    {
+        const auto & pending = m_pendingQueries[collected];
+        if (!pending.query->resultAvailable())
+            break;
+
+        // frames dropped from the history are not updated
+        if (const auto target = frame(pending.frame))
+        {
+            const auto nanoseconds = pending.query->get64(gl::GL_QUERY_RESULT);
+            target->gpuTimes[pending.drawCall] = static_cast<double>(nanoseconds) * 1e-6;
+            --target->pendingTimings;
+        }
+        m_freeQueries.push_back(pending.query);
+    }
+    m_pendingQueries.erase(m_pendingQueries.begin(), m_pendingQueries.begin() + collected);
+}
+
+void GlyphRenderStatistics::complete(const Frame & frame)
+{
+    ++m_summary.frames;
+    m_summary.drawCalls += frame.drawCalls;
+    m_summary.glyphs += frame.glyphs;
+    m_summary.uploadedBytes += frame.uploadedBytes;
+
+    const auto gpuTime = frame.gpuTime();
+    if (!m_gpuTiming || frame.drawCalls == 0 || gpuTime < 0.0)
+        return;
+
+    ++m_timedFrames;
+    m_summary.meanGpuTime += (gpuTime - m_summary.meanGpuTime) / static_cast<double>(m_timedFrames);
+    m_summary.maxGpuTime = std::max(m_summary.maxGpuTime, gpuTime);
+}
+
+GlyphRenderStatistics::Frame * GlyphRenderStatistics::frame(unsigned long long index)
+{
+    if (index < m_frames.front().index || index > m_frames.back().index)
+        return nullptr;
+    return &m_frames[static_cast<size_t>(index - m_frames.front().index)];
+}
+
+
+} // namespace gloperate_text
@@ -7,6 +7,8 @@
 #include <globjects/Shader.h>
 #include <globjects/Program.h>
 
+#include <openll/GLRenderBackend.h>
+#include <openll/GlyphRenderStatistics.h>
 #include <openll/GlyphVertexCloud.h>
 #include <glm/mat4x4.hpp>
 
@@ -35,8 +37,18 @@ GlyphRenderer::GlyphRenderer(globjects::Shader * fragmentShader)
 }
 
 GlyphRenderer::GlyphRenderer(globjects::Program * program)
-: m_program(program)
+: GlyphRenderer(new GLRenderBackend, program)
 {
+}
+
+GlyphRenderer::GlyphRenderer(RenderBackend * backend, globjects::Program * program)
+: m_backend(backend)
+, m_program(program)
+, m_statistics(nullptr)
+{
+    if (!m_program)
+        return;
+
     m_program->setUniform<gl::GLint>("glyphs", 0);
     m_program->setUniform<glm::mat4>("viewProjection", glm::mat4());
 }
@@ -52,15 +64,7 @@ void GlyphRenderer::render(const GlyphVertexCloud & vertexCloud) const
         return;
     }
 
-    m_program->setUniform("viewProjection", glm::mat4());
-
-    m_program->use();
-
-    vertexCloud.texture()->bindActive(0);
-    vertexCloud.drawable()->draw();
-    vertexCloud.texture()->unbindActive(0);
-
-    m_program->release();
+    draw(vertexCloud, glm::mat4());
 }
 
 void GlyphRenderer::renderInWorld(const GlyphVertexCloud & vertexCloud, const glm::mat4 & viewProjection) const
@@ -70,15 +74,7 @@ void GlyphRenderer::renderInWorld(const GlyphVertexCloud & vertexCloud, const gl
         return;
     }
 
-    m_program->setUniform("viewProjection", viewProjection);
-
-    m_program->use();
-
-    vertexCloud.texture()->bindActive(0);
-    vertexCloud.drawable()->draw();
-    vertexCloud.texture()->unbindActive(0);
-
-    m_program->release();
+    draw(vertexCloud, viewProjection);
 }
 
 globjects::Program * GlyphRenderer::program()
@@ -91,5 +87,31 @@ const globjects::Program * GlyphRenderer::program() const
     return m_program;
 }
 
+RenderBackend * GlyphRenderer::backend() const
+{
+    return m_backend;
+}
+
+GlyphRenderStatistics * GlyphRenderer::statistics() const
+{
+    return m_statistics;
+}
+
+void GlyphRenderer::setStatistics(GlyphRenderStatistics * statistics)
+{
+    m_statistics = statistics;
+}
+
+void GlyphRenderer::draw(const GlyphVertexCloud & vertexCloud, const glm::mat4 & viewProjection) const
+{
+    if (m_statistics)
+        m_statistics->beginDraw();
+
+    m_backend->draw(vertexCloud, m_program, viewProjection);
+
+    if (m_statistics)
+        m_statistics->endDraw(vertexCloud.vertices().size(), vertexCloud.takeUploadedBytes());
+}
+
 
 } // namespace
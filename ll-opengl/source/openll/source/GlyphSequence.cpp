@@ -8,6 +8,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <openll/FontFace.h>
+#include <openll/Typesetter.h>
 
 
 namespace gloperate_text
@@ -24,7 +25,8 @@ GlyphSequence::GlyphSequence()
 , m_fontSize(12.f)
 , m_superSampling(SuperSampling::Quincunx)
 , m_transformValid(false)
-
+, m_extentValid(false)
+, m_extentRevision(0)
 {
 }
 
@@ -59,6 +61,7 @@ void GlyphSequence::setString(const std::u32string & string)
         return;
 
     m_string = string;
+    invalidateExtent();
 }
 
 const std::vector<char32_t> & GlyphSequence::chars(
@@ -92,6 +95,8 @@ bool GlyphSequence::wordWrap() const
 
 void GlyphSequence::setWordWrap(bool enable)
 {
+    if (m_wordWrap != enable)
+        invalidateExtent();
     m_wordWrap = enable;
 }
 
@@ -105,6 +110,8 @@ float GlyphSequence::lineWidth() const
 
 void GlyphSequence::setLineWidth(float lineWidth)
 {
+    if (m_lineWidth != lineWidth)
+        invalidateExtent();
     m_lineWidth = lineWidth;
 }
 
@@ -157,6 +164,7 @@ FontFace * GlyphSequence::fontFace() const
 void GlyphSequence::setFontFace(FontFace * fontFace)
 {
     m_transformValid = false;
+    invalidateExtent();
     m_fontFace = fontFace;
 }
 
@@ -168,6 +176,7 @@ float GlyphSequence::fontSize() const
 void GlyphSequence::setFontSize(float fontSize)
 {
     m_transformValid = false;
+    invalidateExtent();
     m_fontSize = fontSize;
 }
 
@@ -190,6 +199,7 @@ const glm::mat4 & GlyphSequence::additionalTransform() const
 void GlyphSequence::setAdditionalTransform(const glm::mat4 & additionalTransform)
 {
     m_transformValid = false;
+    invalidateExtent();
     m_additionalTransform = additionalTransform;
 }
 
@@ -203,6 +213,23 @@ const glm::mat4 & GlyphSequence::transform() const
     return m_transform;
 }
 
+const glm::vec2 & GlyphSequence::extent() const
+{
+    const auto revision = m_fontFace ? m_fontFace->revision() : 0;
+    if (!m_extentValid || m_extentRevision != revision)
+    {
+        m_extent = Typesetter::typeset(*this, GlyphVertexCloud::Vertices::iterator(), true);
+        m_extentValid = true;
+        m_extentRevision = revision;
+    }
+    return m_extent;
+}
+
+void GlyphSequence::invalidateExtent()
+{
+    m_extentValid = false;
+}
+
 void GlyphSequence::computeTransform() const
 {
     assert(m_fontFace);
@@ -3,11 +3,11 @@
 
 #include <numeric>
 #include <algorithm>
+#include <utility>
 
-#include <glbinding/gl/enum.h>
-#include <glbinding/gl/boolean.h>
-
+#include <openll/GLRenderBackend.h>
 #include <openll/GlyphSequence.h>
+#include <openll/Trace.h>
 
 
 namespace
@@ -40,12 +40,6 @@ std::vector<T> apply_permutation(
     return sorted_vec;
 }
 
-template <typename Class, typename Type>
-std::ptrdiff_t offset(Type Class::*member)
-{
-    return reinterpret_cast<std::ptrdiff_t>(&(((Class*)0)->*member));
-}
-
 }
 
 
@@ -53,7 +47,10 @@ namespace gloperate_text
 {
 
 
-GlyphVertexCloud::GlyphVertexCloud()
+GlyphVertexCloud::GlyphVertexCloud(RenderBackend * backend)
+: m_backend(backend)
+, m_uploadedSize(0)
+, m_uploadedBytes(0)
 {
 }
 
@@ -61,6 +58,16 @@ GlyphVertexCloud::~GlyphVertexCloud()
 {
 }
 
+GlyphVertexCloud::GlyphVertexCloud(const GlyphVertexCloud & other) = default;
+GlyphVertexCloud::GlyphVertexCloud(GlyphVertexCloud && other) = default;
+GlyphVertexCloud & GlyphVertexCloud::operator=(const GlyphVertexCloud & other) = default;
+GlyphVertexCloud & GlyphVertexCloud::operator=(GlyphVertexCloud && other) = default;
+
+RenderBackend * GlyphVertexCloud::backend() const
+{
+    return m_backend;
+}
+
 const globjects::Texture * GlyphVertexCloud::texture() const
 {
     return m_texture;
@@ -81,6 +88,11 @@ const gloperate_text::Drawable * GlyphVertexCloud::drawable() const
     return m_drawable;
 }
 
+void GlyphVertexCloud::setDrawable(gloperate_text::Drawable * drawable)
+{
+    m_drawable = drawable;
+}
+
 GlyphVertexCloud::Vertices & GlyphVertexCloud::vertices()
 {
     return m_vertices;
@@ -91,71 +103,86 @@ const GlyphVertexCloud::Vertices & GlyphVertexCloud::vertices() const
     return m_vertices;
 }
 
-gloperate_text::Drawable * GlyphVertexCloud::createDrawable()
+void GlyphVertexCloud::update()
 {
-    auto drawable = new gloperate_text::Drawable();
-
-    drawable->setMode(gl::GL_POINTS);
-    drawable->setDrawMode(gloperate_text::DrawMode::Arrays);
-
-    drawable->bindAttributes({ 0, 1, 2, 3, 4, 5 });
-
-    globjects::Buffer * vertexBuffer = new globjects::Buffer;
-    drawable->setBuffer(0, vertexBuffer);
-    drawable->setAttributeBindingBuffer(0, vertexBuffer, 0, sizeof(Vertex));
-    drawable->setAttributeBindingBuffer(1, vertexBuffer, 0, sizeof(Vertex));
-    drawable->setAttributeBindingBuffer(2, vertexBuffer, 0, sizeof(Vertex));
-    drawable->setAttributeBindingBuffer(3, vertexBuffer, 0, sizeof(Vertex));
-    drawable->setAttributeBindingBuffer(4, vertexBuffer, 0, sizeof(Vertex));
-    drawable->setAttributeBindingBuffer(5, vertexBuffer, 0, sizeof(Vertex));
+    update(m_vertices);
+}
 
-    drawable->setAttributeBindingFormat(0, 3, gl::GL_FLOAT,        gl::GL_FALSE, offset(&Vertex::origin));
-    drawable->setAttributeBindingFormat(1, 3, gl::GL_FLOAT,        gl::GL_FALSE, offset(&Vertex::vtan));
-    drawable->setAttributeBindingFormat(2, 3, gl::GL_FLOAT,        gl::GL_FALSE, offset(&Vertex::vbitan));
-    drawable->setAttributeBindingFormat(3, 4, gl::GL_FLOAT,        gl::GL_FALSE, offset(&Vertex::uvRect));
-    drawable->setAttributeBindingFormat(4, 4, gl::GL_FLOAT,        gl::GL_FALSE, offset(&Vertex::fontColor));
-    drawable->setAttributeBindingFormat(5, 1, gl::GL_UNSIGNED_INT, gl::GL_FALSE, offset(&Vertex::superSampling));
+void GlyphVertexCloud::update(const Vertices & vertices)
+{
+    OPENLL_TRACE_ZONE("GlyphVertexCloud::update");
+    OPENLL_TRACE_COUNTER("bytes uploaded", vertices.size() * sizeof(Vertex));
 
-    drawable->enableAllAttributeBindings();
+    if (!m_backend)
+        m_backend = GLRenderBackend::instance();
 
-    return drawable;
+    m_backend->uploadVertices(*this, vertices);
+    m_uploadedSize = vertices.size();
+    m_uploadedBytes += vertices.size() * sizeof(Vertex);
 }
 
-void GlyphVertexCloud::update()
+void GlyphVertexCloud::optimize(const std::vector<GlyphSequence> & sequences)
 {
-    if (!m_drawable)
-        m_drawable = createDrawable();
-
-    m_drawable->buffer(0)->setData(m_vertices, gl::GL_STATIC_DRAW);
-    m_drawable->setSize(m_vertices.size());
+    OPENLL_TRACE_ZONE("GlyphVertexCloud::optimize");
+    update(optimizedVertices(sequences));
 }
 
-void GlyphVertexCloud::update(const Vertices & vertices)
+void GlyphVertexCloud::optimize(const std::vector<const GlyphSequence *> & sequences)
 {
-    if (!m_drawable)
-        m_drawable = createDrawable();
+    OPENLL_TRACE_ZONE("GlyphVertexCloud::optimize");
+    update(optimizedVertices(sequences));
+}
 
-    m_drawable->buffer(0)->setData(vertices, gl::GL_STATIC_DRAW);
-    m_drawable->setSize(vertices.size());
+size_t GlyphVertexCloud::uploadedSize() const
+{
+    return m_uploadedSize;
 }
 
-void GlyphVertexCloud::optimize(const std::vector<GlyphSequence> & sequences)
+size_t GlyphVertexCloud::takeUploadedBytes() const
 {
-    // L1/texture-cache optimization: sort vertex cloud by glyphs
+    const auto uploadedBytes = m_uploadedBytes;
+    m_uploadedBytes = 0;
+    return uploadedBytes;
+}
 
+GlyphVertexCloud::Vertices GlyphVertexCloud::optimizedVertices(const std::vector<GlyphSequence> & sequences) const
+{
     // create string associated with all depictable glyphs
     auto depictableChars = std::vector<char32_t>();
-    auto vertices = m_vertices;
+    // depictableChars reserves only the size of each sequence, which would reallocate for every sequence
+    depictableChars.reserve(m_vertices.size());
 
     for (const auto & sequence : sequences)
         sequence.depictableChars(depictableChars);
 
-    assert(vertices.size() == depictableChars.size());
+    return optimizedVertices(depictableChars);
+}
+
+GlyphVertexCloud::Vertices GlyphVertexCloud::optimizedVertices(const std::vector<const GlyphSequence *> & sequences) const
+{
+    auto depictableChars = std::vector<char32_t>();
+    depictableChars.reserve(m_vertices.size());
+
+    for (const auto sequence : sequences)
+        sequence->depictableChars(depictableChars);
+
+    return optimizedVertices(depictableChars);
+}
+
+GlyphVertexCloud::Vertices GlyphVertexCloud::optimizedVertices(const std::vector<char32_t> & depictableChars) const
+{
+    // L1/texture-cache optimization: sort vertex cloud by pages and glyphs,
+    // so that the glyphs of each page of the glyph texture are drawn in one run
+    assert(m_vertices.size() == depictableChars.size());
+
+    auto keys = std::vector<std::pair<unsigned int, char32_t>>(depictableChars.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+        keys[i] = std::make_pair(m_vertices[i].page, depictableChars[i]);
 
-    const auto p = sort_permutation(depictableChars,
-        [](const char32_t & a, const char32_t & b) { return a < b; });
+    const auto p = sort_permutation(keys,
+        [](const std::pair<unsigned int, char32_t> & a, const std::pair<unsigned int, char32_t> & b) { return a < b; });
 
-    update(apply_permutation(vertices, p));
+    return apply_permutation(m_vertices, p);
 }
 
 
@@ -0,0 +1,56 @@
+#include <openll/NullRenderBackend.h>
+
+#include <openll/FontFace.h>
+
+
+namespace gloperate_text
+{
+
+
+NullRenderBackend::NullRenderBackend()
+{
+    reset();
+}
+
+NullRenderBackend::~NullRenderBackend()
+{
+}
+
+const NullRenderBackend::Counters & NullRenderBackend::counters() const
+{
+    return m_counters;
+}
+
+void NullRenderBackend::reset()
+{
+    m_counters = Counters();
+}
+
+void NullRenderBackend::createGlyphTexture(FontFace & fontFace)
+{
+    // one layer per page
+    const auto extent = fontFace.glyphTextureExtent();
+    ++m_counters.textures;
+    m_counters.textureBytes += static_cast<size_t>(extent.x) * extent.y * fontFace.glyphTexturePages();
+}
+
+void NullRenderBackend::updateGlyphTexture(FontFace & /*fontFace*/, const glm::ivec2 & /*offset*/, const glm::ivec2 & extent, unsigned int /*page*/)
+{
+    ++m_counters.textureUpdates;
+    m_counters.updatedTextureBytes += static_cast<size_t>(extent.x) * extent.y;
+}
+
+void NullRenderBackend::uploadVertices(GlyphVertexCloud & /*vertexCloud*/, const GlyphVertexCloud::Vertices & vertices)
+{
+    ++m_counters.uploads;
+    m_counters.uploadedBytes += vertices.size() * sizeof(GlyphVertexCloud::Vertex);
+}
+
+void NullRenderBackend::draw(const GlyphVertexCloud & vertexCloud, globjects::Program * /*program*/, const glm::mat4 & /*viewProjection*/)
+{
+    ++m_counters.drawCalls;
+    m_counters.drawnGlyphs += vertexCloud.uploadedSize();
+}
+
+
+} // namespace gloperate_text
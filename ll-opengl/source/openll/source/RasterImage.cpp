@@ -0,0 +1,69 @@
+#include <openll/RasterImage.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+namespace gloperate_text
+{
+
+
+RasterImage::RasterImage()
+: m_extent(0, 0)
+{
+}
+
+RasterImage::RasterImage(const glm::ivec2 & extent, const glm::vec4 & clearColor)
+{
+    resize(extent);
+    clear(clearColor);
+}
+
+const glm::ivec2 & RasterImage::extent() const
+{
+    return m_extent;
+}
+
+void RasterImage::resize(const glm::ivec2 & extent)
+{
+    assert(extent.x >= 0 && extent.y >= 0);
+
+    m_extent = extent;
+    m_pixels.resize(static_cast<size_t>(extent.x) * static_cast<size_t>(extent.y) * 4);
+}
+
+void RasterImage::clear(const glm::vec4 & color)
+{
+    std::uint8_t value[4];
+    for (int i = 0; i < 4; ++i)
+        value[i] = static_cast<std::uint8_t>(std::floor(std::min(std::max(color[i], 0.f), 1.f) * 255.f + 0.5f));
+
+    for (size_t i = 0; i < m_pixels.size(); i += 4)
+        std::copy(value, value + 4, m_pixels.begin() + i);
+}
+
+std::uint8_t * RasterImage::data()
+{
+    return m_pixels.data();
+}
+
+const std::uint8_t * RasterImage::data() const
+{
+    return m_pixels.data();
+}
+
+std::uint8_t * RasterImage::pixel(int x, int y)
+{
+    assert(x >= 0 && x < m_extent.x && y >= 0 && y < m_extent.y);
+    return m_pixels.data() + (static_cast<size_t>(y) * m_extent.x + x) * 4;
+}
+
+const std::uint8_t * RasterImage::pixel(int x, int y) const
+{
+    assert(x >= 0 && x < m_extent.x && y >= 0 && y < m_extent.y);
+    return m_pixels.data() + (static_cast<size_t>(y) * m_extent.x + x) * 4;
+}
+
+
+} // namespace gloperate_text
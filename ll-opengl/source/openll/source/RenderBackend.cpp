@@ -0,0 +1,17 @@
+#include <openll/RenderBackend.h>
+
+
+namespace gloperate_text
+{
+
+
+RenderBackend::RenderBackend()
+{
+}
+
+RenderBackend::~RenderBackend()
+{
+}
+
+
+} // namespace gloperate_text
@@ -0,0 +1,152 @@
+#include <openll/ShelfPacker.h>
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace
+{
+
+
+// shelves are opened at multiples of this height, so that glyphs of similar height share them
+const int heightGranularity = 4;
+
+// a rectangle may use a shelf up to this factor taller than itself while new shelves can be opened
+const float maximumWaste = 1.5f;
+
+
+} // namespace
+
+
+namespace gloperate_text
+{
+
+
+ShelfPacker::ShelfPacker(const glm::ivec2 & extent)
+: m_extent(extent)
+, m_top(0)
+, m_allocatedArea(0)
+{
+    assert(extent.x > 0 && extent.y > 0);
+}
+
+const glm::ivec2 & ShelfPacker::extent() const
+{
+    return m_extent;
+}
+
+long long ShelfPacker::allocatedArea() const
+{
+    return m_allocatedArea;
+}
+
+bool ShelfPacker::allocate(const glm::ivec2 & size, glm::ivec2 & position)
+{
+    assert(size.x > 0 && size.y > 0);
+    if (size.x > m_extent.x || size.y > m_extent.y)
+        return false;
+
+    // the shelves by height, lowest first among equal heights
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < m_shelves.size(); ++i)
+    {
+        if (m_shelves[i].height >= size.y)
+            candidates.push_back(i);
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [this](size_t a, size_t b) { return m_shelves[a].height < m_shelves[b].height; });
+
+    auto place = [&](Shelf & shelf) -> bool
+    {
+        auto x = 0;
+        if (!allocate(shelf, size.x, x))
+            return false;
+
+        position = glm::ivec2(x, shelf.y);
+        m_allocatedArea += static_cast<long long>(size.x) * size.y;
+        return true;
+    };
+
+    for (const auto index : candidates)
+    {
+        if (m_shelves[index].height <= size.y * maximumWaste && place(m_shelves[index]))
+            return true;
+    }
+
+    if (m_top + size.y <= m_extent.y)
+    {
+        const auto height = std::min((size.y + heightGranularity - 1) / heightGranularity * heightGranularity, m_extent.y - m_top);
+        m_shelves.push_back(Shelf{ m_top, height, { Span{ 0, m_extent.x } } });
+        m_top += height;
+        return place(m_shelves.back());
+    }
+
+    // full, use the space of taller shelves
+    for (const auto index : candidates)
+    {
+        if (place(m_shelves[index]))
+            return true;
+    }
+
+    return false;
+}
+
+void ShelfPacker::release(const glm::ivec2 & position, const glm::ivec2 & size)
+{
+    const auto shelf = std::lower_bound(m_shelves.begin(), m_shelves.end(), position.y, [](const Shelf & shelf, int y) { return shelf.y < y; });
+    if (shelf == m_shelves.end() || shelf->y != position.y)
+    {
+        assert(false);
+        return;
+    }
+
+    auto & free = shelf->free;
+    const auto next = std::lower_bound(free.begin(), free.end(), position.x, [](const Span & span, int x) { return span.x < x; });
+    auto span = free.insert(next, Span{ position.x, size.x });
+    m_allocatedArea -= static_cast<long long>(size.x) * size.y;
+
+    // merge with the neighbours
+    if (span + 1 != free.end() && span->x + span->width == (span + 1)->x)
+    {
+        span->width += (span + 1)->width;
+        free.erase(span + 1);
+    }
+    if (span != free.begin() && (span - 1)->x + (span - 1)->width == span->x)
+    {
+        (span - 1)->width += span->width;
+        free.erase(span);
+    }
+
+    // close empty shelves at the top
+    while (!m_shelves.empty() && m_shelves.back().free.size() == 1 && m_shelves.back().free.front().width == m_extent.x)
+    {
+        m_top = m_shelves.back().y;
+        m_shelves.pop_back();
+    }
+}
+
+void ShelfPacker::clear()
+{
+    m_shelves.clear();
+    m_top = 0;
+    m_allocatedArea = 0;
+}
+
+bool ShelfPacker::allocate(Shelf & shelf, int width, int & x)
+{
+    for (auto span = shelf.free.begin(); span != shelf.free.end(); ++span)
+    {
+        if (span->width < width)
+            continue;
+
+        x = span->x;
+        span->x += width;
+        span->width -= width;
+        if (span->width == 0)
+            shelf.free.erase(span);
+        return true;
+    }
+    return false;
+}
+
+
+} // namespace gloperate_text
@@ -0,0 +1,231 @@
+#include <openll/SkylinePacker.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+
+namespace
+{
+
+
+// large boxes first
+std::vector<size_t> packingOrder(const std::vector<glm::ivec2> & boxes)
+{
+    std::vector<size_t> order(boxes.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&boxes](size_t a, size_t b)
+    {
+        return boxes[a].y != boxes[b].y ? boxes[a].y > boxes[b].y : boxes[a].x > boxes[b].x;
+    });
+    return order;
+}
+
+
+} // namespace
+
+
+namespace gloperate_text
+{
+
+
+SkylinePacker::SkylinePacker(const glm::ivec2 & extent)
+: m_extent(extent)
+{
+    assert(extent.x > 0 && extent.y > 0);
+    clear();
+}
+
+const glm::ivec2 & SkylinePacker::extent() const
+{
+    return m_extent;
+}
+
+int SkylinePacker::height() const
+{
+    auto height = 0;
+    for (const auto & segment : m_skyline)
+        height = std::max(height, segment.y);
+    return height;
+}
+
+bool SkylinePacker::pack(const glm::ivec2 & size, glm::ivec2 & position)
+{
+    assert(size.x >= 0 && size.y >= 0);
+
+    auto bestIndex = m_skyline.size();
+    auto bestTop = std::numeric_limits<int>::max();
+    auto bestWidth = std::numeric_limits<int>::max();
+    auto bestY = 0;
+
+    for (size_t i = 0; i < m_skyline.size(); ++i)
+    {
+        const auto y = fit(i, size);
+        if (y < 0)
+            continue;
+
+        const auto top = y + size.y;
+        if (top < bestTop || (top == bestTop && m_skyline[i].width < bestWidth))
+        {
+            bestIndex = i;
+            bestTop = top;
+            bestWidth = m_skyline[i].width;
+            bestY = y;
+        }
+    }
+
+    if (bestIndex == m_skyline.size())
+        return false;
+
+    position = glm::ivec2(m_skyline[bestIndex].x, bestY);
+    if (size.x == 0)
+        return true;
+
+    m_skyline.insert(m_skyline.begin() + bestIndex, Segment{ position.x, bestTop, size.x });
+
+    // the new segment shadows the following ones
+    for (auto i = bestIndex + 1; i < m_skyline.size(); )
+    {
+        const auto & previous = m_skyline[i - 1];
+        auto & segment = m_skyline[i];
+        const auto shadow = previous.x + previous.width - segment.x;
+        if (shadow <= 0)
+            break;
+
+        segment.x += shadow;
+        segment.width -= shadow;
+        if (segment.width > 0)
+            break;
+
+        m_skyline.erase(m_skyline.begin() + i);
+    }
+
+    for (size_t i = 0; i + 1 < m_skyline.size(); )
+    {
+        if (m_skyline[i].y == m_skyline[i + 1].y)
+        {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+void SkylinePacker::clear()
+{
+    m_skyline.assign(1, Segment{ 0, 0, m_extent.x });
+}
+
+int SkylinePacker::fit(size_t index, const glm::ivec2 & size) const
+{
+    const auto x = m_skyline[index].x;
+    if (x + size.x > m_extent.x)
+        return -1;
+
+    auto y = m_skyline[index].y;
+    auto remaining = size.x;
+    for (auto i = index; remaining > 0; ++i)
+    {
+        assert(i < m_skyline.size());
+        y = std::max(y, m_skyline[i].y);
+        remaining -= m_skyline[i].width;
+    }
+
+    return y + size.y <= m_extent.y ? y : -1;
+}
+
+
+bool SkylinePacker::packAtlas(const std::vector<glm::ivec2> & boxes, int gutter, int maximumExtent, glm::ivec2 & extent, std::vector<glm::ivec2> & positions)
+{
+    auto area = 0.0;
+    auto widest = 1;
+    auto tallest = 1;
+    for (const auto & box : boxes)
+    {
+        area += static_cast<double>(box.x + gutter) * (box.y + gutter);
+        widest = std::max(widest, box.x + gutter);
+        tallest = std::max(tallest, box.y + gutter);
+    }
+
+    const auto order = packingOrder(boxes);
+
+    auto width = 1;
+    while (width < widest || static_cast<double>(width) * width < area)
+        width *= 2;
+
+    positions.resize(boxes.size());
+    for (; width <= maximumExtent; width *= 2)
+    {
+        for (const auto height : { width / 2, width })
+        {
+            if (height < tallest || static_cast<double>(width) * height < area)
+                continue;
+
+            SkylinePacker packer({ width, height });
+            auto packed = true;
+            for (const auto index : order)
+            {
+                if (boxes[index].x == 0)
+                {
+                    positions[index] = glm::ivec2(0);
+                    continue;
+                }
+                if (!packer.pack(boxes[index] + glm::ivec2(gutter), positions[index]))
+                {
+                    packed = false;
+                    break;
+                }
+            }
+
+            if (packed)
+            {
+                extent = glm::ivec2(width, height);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool SkylinePacker::packPages(const std::vector<glm::ivec2> & boxes, int gutter, int maximumExtent, std::vector<unsigned int> & pages, std::vector<glm::ivec2> & positions)
+{
+    std::vector<SkylinePacker> packers;
+
+    pages.resize(boxes.size());
+    positions.resize(boxes.size());
+    for (const auto index : packingOrder(boxes))
+    {
+        pages[index] = 0;
+        if (boxes[index].x == 0)
+        {
+            positions[index] = glm::ivec2(0);
+            continue;
+        }
+
+        const auto box = boxes[index] + glm::ivec2(gutter);
+        if (box.x > maximumExtent || box.y > maximumExtent)
+            return false;
+
+        auto page = size_t(0);
+        while (page < packers.size() && !packers[page].pack(box, positions[index]))
+            ++page;
+
+        if (page == packers.size())
+        {
+            packers.emplace_back(glm::ivec2(maximumExtent));
+            packers.back().pack(box, positions[index]);
+        }
+        pages[index] = static_cast<unsigned int>(page);
+    }
+
+    return true;
+}
+
+} // namespace gloperate_text
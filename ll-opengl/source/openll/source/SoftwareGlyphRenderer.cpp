@@ -0,0 +1,527 @@
+#include <openll/SoftwareGlyphRenderer.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <openll/FontFace.h>
+#include <openll/GlyphVertexCloud.h>
+#include <openll/RasterImage.h>
+#include <openll/SuperSampling.h>
+#include <openll/Trace.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OPENLL_SOFTWAREGLYPHRENDERER_SSE
+#endif
+
+
+namespace
+{
+
+
+// sample offset of glyph.frag in units of dFdx(uv.x) and dFdy(uv.y)
+struct Tap
+{
+    float x;
+    float y;
+    float weight;
+};
+
+using Taps = std::vector<Tap>;
+
+Taps grid(const std::vector<float> & xs, const std::vector<float> & ys)
+{
+    Taps taps;
+    const auto weight = 1.f / static_cast<float>(xs.size() * ys.size());
+    for (const auto x : xs)
+    {
+        for (const auto y : ys)
+            taps.push_back({ x, y, weight });
+    }
+    return taps;
+}
+
+// indexed by SuperSampling
+const std::array<Taps, 8> & superSamplingTaps()
+{
+    static const std::array<Taps, 8> taps = {{
+        // None
+        { { 0.f, 0.f, 1.f } },
+        // Grid1x3
+        grid({ 0.f }, { -1.f / 3.f, 0.f, 1.f / 3.f }),
+        // Grid2x4
+        grid({ -1.f / 4.f, 1.f / 4.f }, { -3.f / 8.f, -1.f / 8.f, 1.f / 8.f, 3.f / 8.f }),
+        // RGSS2x2
+        {
+            { -3.f / 8.f, 1.f / 8.f, 1.f / 4.f }, { -1.f / 8.f, -3.f / 8.f, 1.f / 4.f },
+            { 3.f / 8.f, -1.f / 8.f, 1.f / 4.f }, { 1.f / 8.f, 3.f / 8.f, 1.f / 4.f }
+        },
+        // Quincunx
+        {
+            { 0.f, 0.f, 4.f / 8.f },
+            { -0.5f, 0.5f, 1.f / 8.f }, { -0.5f, -0.5f, 1.f / 8.f },
+            { 0.5f, 0.5f, 1.f / 8.f }, { 0.5f, -0.5f, 1.f / 8.f }
+        },
+        // Rooks8
+        {
+            { -7.f / 16.f, 3.f / 16.f, 1.f / 8.f }, { -5.f / 16.f, -1.f / 16.f, 1.f / 8.f },
+            { -3.f / 16.f, 5.f / 16.f, 1.f / 8.f }, { -1.f / 16.f, -7.f / 16.f, 1.f / 8.f },
+            { 1.f / 16.f, 7.f / 16.f, 1.f / 8.f }, { 3.f / 16.f, -5.f / 16.f, 1.f / 8.f },
+            { 5.f / 16.f, 1.f / 16.f, 1.f / 8.f }, { 7.f / 16.f, -3.f / 16.f, 1.f / 8.f }
+        },
+        // Grid3x3
+        grid({ -1.f / 3.f, 0.f, 1.f / 3.f }, { -1.f / 3.f, 0.f, 1.f / 3.f }),
+        // Grid4x4
+        grid({ -3.f / 8.f, -1.f / 8.f, 1.f / 8.f, 3.f / 8.f }, { -3.f / 8.f, -1.f / 8.f, 1.f / 8.f, 3.f / 8.f })
+    }};
+    return taps;
+}
+
+struct Atlas
+{
+    const unsigned char * texels;
+    int width;
+    int height;
+    unsigned int pages;
+};
+
+// the layer of a texture array
+Atlas page(const Atlas & atlas, unsigned int index)
+{
+    return { atlas.texels + static_cast<size_t>(index) * atlas.width * atlas.height, atlas.width, atlas.height, 1 };
+}
+
+// bilinear sample with clamp to edge (GL_LINEAR, GL_CLAMP_TO_EDGE)
+float sample(const Atlas & atlas, const glm::vec2 & uv)
+{
+    const auto x = std::min(std::max(uv.x * atlas.width - 0.5f, -1.f), static_cast<float>(atlas.width));
+    const auto y = std::min(std::max(uv.y * atlas.height - 0.5f, -1.f), static_cast<float>(atlas.height));
+    const auto xf = std::floor(x);
+    const auto yf = std::floor(y);
+    const auto fx = x - xf;
+    const auto fy = y - yf;
+
+    const auto x0 = std::min(std::max(static_cast<int>(xf), 0), atlas.width - 1);
+    const auto x1 = std::min(std::max(static_cast<int>(xf) + 1, 0), atlas.width - 1);
+    const auto y0 = std::min(std::max(static_cast<int>(yf), 0), atlas.height - 1);
+    const auto y1 = std::min(std::max(static_cast<int>(yf) + 1, 0), atlas.height - 1);
+
+    const auto row0 = atlas.texels + static_cast<size_t>(y0) * atlas.width;
+    const auto row1 = atlas.texels + static_cast<size_t>(y1) * atlas.width;
+    const auto bottom = row0[x0] + (static_cast<float>(row0[x1]) - row0[x0]) * fx;
+    const auto top = row1[x0] + (static_cast<float>(row1[x1]) - row1[x0]) * fx;
+    return (bottom + (top - bottom) * fy) / 255.f;
+}
+
+// aastep(0.5, value) of glyph.frag
+float aastep(float value, float afwidth)
+{
+    if (afwidth <= 0.f)
+        return value < 0.5f ? 0.f : 1.f;
+
+    const auto t = std::min(std::max((value - (0.5f - afwidth)) / (2.f * afwidth), 0.f), 1.f);
+    return t * t * (3.f - 2.f * t);
+}
+
+// A * x + B * y + C, with a plane of (u/w, v/w, 1/w) for perspective correct interpolation
+struct Plane
+{
+    float a;
+    float b;
+    float c;
+
+    float operator()(float x, float y) const
+    {
+        return a * x + b * y + c;
+    }
+};
+
+// a glyph quad in window coordinates
+struct Quad
+{
+    // positive inside
+    std::array<Plane, 4> edges;
+    Plane u;
+    Plane v;
+    Plane w;
+
+    // pixel bounds, upper bounds exclusive
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+
+    // RGB in [0, 255]
+    float color[3];
+    float alpha;
+    unsigned int superSampling;
+    unsigned int page;
+};
+
+// perspective correct uv at a point in window coordinates
+glm::vec2 interpolate(const Quad & quad, const glm::vec2 & point)
+{
+    const auto w = quad.w(point.x, point.y);
+    return glm::vec2(quad.u(point.x, point.y) / w, quad.v(point.x, point.y) / w);
+}
+
+bool inside(const Plane & edge, float x, float y)
+{
+    const auto value = edge(x, y);
+    // pixel centers on an edge belong to a single one of two adjacent quads
+    return value > 0.f || (value == 0.f && (edge.a > 0.f || (edge.a == 0.f && edge.b > 0.f)));
+}
+
+bool inside(const Quad & quad, int x, float y)
+{
+    const auto center = static_cast<float>(x) + 0.5f;
+    return inside(quad.edges[0], center, y) && inside(quad.edges[1], center, y)
+        && inside(quad.edges[2], center, y) && inside(quad.edges[3], center, y);
+}
+
+Plane interpolation(const glm::vec2 (& p)[3], const float (& values)[3], float determinant)
+{
+    const auto d1 = p[1] - p[0];
+    const auto d2 = p[2] - p[0];
+    const auto v1 = values[1] - values[0];
+    const auto v2 = values[2] - values[0];
+
+    Plane plane;
+    plane.a = (v1 * d2.y - v2 * d1.y) / determinant;
+    plane.b = (v2 * d1.x - v1 * d2.x) / determinant;
+    plane.c = values[0] - plane.a * p[0].x - plane.b * p[0].y;
+    return plane;
+}
+
+// returns false if the quad is degenerate, outside the image or (partially) behind the camera
+bool setup(const gloperate_text::GlyphVertexCloud::Vertex & vertex, const glm::mat4 & viewProjection, const glm::ivec2 & extent, Quad & quad)
+{
+    // corners in counterclockwise order as expanded by glyph.geom: lower left, lower right, upper right, upper left
+    const glm::vec3 corners[4] = {
+        vertex.origin,
+        vertex.origin + vertex.vtan,
+        vertex.origin + vertex.vtan + vertex.vbitan,
+        vertex.origin + vertex.vbitan };
+    const glm::vec2 uvs[4] = {
+        { vertex.uvRect.x, vertex.uvRect.y },
+        { vertex.uvRect.z, vertex.uvRect.y },
+        { vertex.uvRect.z, vertex.uvRect.w },
+        { vertex.uvRect.x, vertex.uvRect.w } };
+
+    glm::vec2 window[4];
+    float inverseW[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        const auto clip = viewProjection * glm::vec4(corners[i], 1.f);
+        if (!(clip.w > 0.f))
+            return false;
+
+        inverseW[i] = 1.f / clip.w;
+        window[i] = glm::vec2(
+            (clip.x * inverseW[i] + 1.f) * 0.5f * static_cast<float>(extent.x),
+            (clip.y * inverseW[i] + 1.f) * 0.5f * static_cast<float>(extent.y));
+    }
+
+    // lower left, lower right and upper left span the plane of the quad
+    const glm::vec2 triangle[3] = { window[0], window[1], window[3] };
+    const auto d1 = window[1] - window[0];
+    const auto d2 = window[3] - window[0];
+    const auto determinant = d1.x * d2.y - d2.x * d1.y;
+    if (std::abs(determinant) < 1e-6f)
+        return false;
+
+    const float us[3] = { uvs[0].x * inverseW[0], uvs[1].x * inverseW[1], uvs[3].x * inverseW[3] };
+    const float vs[3] = { uvs[0].y * inverseW[0], uvs[1].y * inverseW[1], uvs[3].y * inverseW[3] };
+    const float ws[3] = { inverseW[0], inverseW[1], inverseW[3] };
+    quad.u = interpolation(triangle, us, determinant);
+    quad.v = interpolation(triangle, vs, determinant);
+    quad.w = interpolation(triangle, ws, determinant);
+
+    // mirrored quads are clockwise, both faces are rendered as culling is disabled
+    const auto orientation = determinant > 0.f ? 1.f : -1.f;
+    for (int i = 0; i < 4; ++i)
+    {
+        const auto & from = window[i];
+        const auto & to = window[(i + 1) % 4];
+        quad.edges[i].a = -(to.y - from.y) * orientation;
+        quad.edges[i].b = (to.x - from.x) * orientation;
+        quad.edges[i].c = -(quad.edges[i].a * from.x + quad.edges[i].b * from.y);
+    }
+
+    auto lower = window[0];
+    auto upper = window[0];
+    for (int i = 1; i < 4; ++i)
+    {
+        lower = glm::min(lower, window[i]);
+        upper = glm::max(upper, window[i]);
+    }
+    quad.x0 = static_cast<int>(std::max(std::floor(lower.x), 0.f));
+    quad.y0 = static_cast<int>(std::max(std::floor(lower.y), 0.f));
+    quad.x1 = static_cast<int>(std::min(std::ceil(upper.x), static_cast<float>(extent.x)));
+    quad.y1 = static_cast<int>(std::min(std::ceil(upper.y), static_cast<float>(extent.y)));
+    if (quad.x0 >= quad.x1 || quad.y0 >= quad.y1)
+        return false;
+
+    // clamped like the color, so that the scalar and the SSE blending agree
+    for (int i = 0; i < 3; ++i)
+        quad.color[i] = std::min(std::max(vertex.fontColor[i], 0.f), 1.f) * 255.f;
+    quad.alpha = std::min(std::max(vertex.fontColor[3], 0.f), 1.f);
+    quad.superSampling = std::min(vertex.superSampling, static_cast<unsigned int>(gloperate_text::SuperSampling::Grid4x4));
+    quad.page = vertex.page;
+    return true;
+}
+
+// the pixels [start, end) of row y within [lower, upper) covered by the quad
+void span(const Quad & quad, int y, int lower, int upper, int & start, int & end)
+{
+    const auto center = static_cast<float>(y) + 0.5f;
+
+    // estimate the span from the edge intersections, then correct it by the exact coverage test
+    auto from = static_cast<float>(lower);
+    auto to = static_cast<float>(upper);
+    for (const auto & edge : quad.edges)
+    {
+        const auto offset = edge.b * center + edge.c;
+        if (edge.a > 0.f)
+            from = std::max(from, -offset / edge.a - 0.5f);
+        else if (edge.a < 0.f)
+            to = std::min(to, -offset / edge.a - 0.5f);
+    }
+    if (from > to + 1.f)
+    {
+        start = end = lower;
+        return;
+    }
+
+    start = std::max(lower, static_cast<int>(std::floor(from)));
+    end = std::min(upper, static_cast<int>(std::ceil(to)) + 2);
+    while (start < end && !inside(quad, start, center))
+        ++start;
+    while (end > start && !inside(quad, end - 1, center))
+        --end;
+}
+
+// alpha of the fragment at the pixel center as computed by glyph.frag, 0 if discarded
+float coverage(const Quad & quad, const Atlas & textureArray, int x, int y)
+{
+    const auto atlas = page(textureArray, quad.page);
+
+    // glyph.frag runs on 2x2 pixel quads, the derivatives are the differences to the horizontal and vertical neighbour
+    const auto center = glm::vec2(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f);
+    const auto neighbourX = glm::vec2(static_cast<float>(x ^ 1) + 0.5f, center.y);
+    const auto neighbourY = glm::vec2(center.x, static_cast<float>(y ^ 1) + 0.5f);
+
+    const auto uv = interpolate(quad, center);
+    if (sample(atlas, uv) < 0.3f)
+        return 0.f;
+
+    const auto uvX = interpolate(quad, neighbourX);
+    const auto uvY = interpolate(quad, neighbourY);
+
+    const auto dudx = (x & 1) ? uv.x - uvX.x : uvX.x - uv.x;
+    const auto dvdy = (y & 1) ? uv.y - uvY.y : uvY.y - uv.y;
+
+    auto a = 0.f;
+    for (const auto & tap : superSamplingTaps()[quad.superSampling])
+    {
+        const auto offset = glm::vec2(tap.x * dudx, tap.y * dvdy);
+        const auto value = sample(atlas, uv + offset);
+        const auto afwidth = std::abs(sample(atlas, uvX + offset) - value) + std::abs(sample(atlas, uvY + offset) - value);
+        a += tap.weight * aastep(value, afwidth);
+    }
+    return quad.alpha * a;
+}
+
+// glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) for all four channels of an RGBA8 target
+void blend(const Quad & quad, const float * alphas, int count, std::uint8_t * target)
+{
+    int i = 0;
+
+#if defined(OPENLL_SOFTWAREGLYPHRENDERER_SSE)
+    const auto zero = _mm_setzero_si128();
+    const auto half = _mm_set1_ps(0.5f);
+    const auto one = _mm_set1_ps(1.f);
+    const auto rgb = _mm_setr_ps(quad.color[0], quad.color[1], quad.color[2], 0.f);
+    const auto alphaChannel = _mm_setr_ps(0.f, 0.f, 0.f, 255.f);
+
+    // four pixels at a time
+    for (; i + 4 <= count; i += 4)
+    {
+        const auto destination = _mm_loadu_si128(reinterpret_cast<const __m128i *>(target + i * 4));
+        const auto low = _mm_unpacklo_epi8(destination, zero);
+        const auto high = _mm_unpackhi_epi8(destination, zero);
+        const __m128 pixels[4] = {
+            _mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)),
+            _mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)),
+            _mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)),
+            _mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)) };
+
+        __m128i results[4];
+        for (int j = 0; j < 4; ++j)
+        {
+            const auto alpha = _mm_set1_ps(alphas[i + j]);
+            const auto source = _mm_add_ps(rgb, _mm_mul_ps(alphaChannel, alpha));
+            const auto result = _mm_add_ps(_mm_mul_ps(source, alpha), _mm_mul_ps(pixels[j], _mm_sub_ps(one, alpha)));
+            results[j] = _mm_cvttps_epi32(_mm_add_ps(result, half));
+        }
+
+        const auto packed = _mm_packus_epi16(_mm_packs_epi32(results[0], results[1]), _mm_packs_epi32(results[2], results[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(target + i * 4), packed);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const auto alpha = alphas[i];
+        const float source[4] = { quad.color[0], quad.color[1], quad.color[2], 255.f * alpha };
+        auto pixel = target + i * 4;
+        for (int c = 0; c < 4; ++c)
+        {
+            const auto result = source[c] * alpha + static_cast<float>(pixel[c]) * (1.f - alpha);
+            pixel[c] = static_cast<std::uint8_t>(result + 0.5f);
+        }
+    }
+}
+
+void renderTile(const std::vector<Quad> & quads, const std::vector<std::uint32_t> & bin, const Atlas & atlas,
+    int x0, int y0, int x1, int y1, std::vector<float> & alphas, gloperate_text::RasterImage & image)
+{
+    for (const auto index : bin)
+    {
+        const auto & quad = quads[index];
+        const auto lower = std::max(quad.x0, x0);
+        const auto upper = std::min(quad.x1, x1);
+
+        for (auto y = std::max(quad.y0, y0); y < std::min(quad.y1, y1); ++y)
+        {
+            int start, end;
+            span(quad, y, lower, upper, start, end);
+            if (start >= end)
+                continue;
+
+            for (auto x = start; x < end; ++x)
+                alphas[x - start] = coverage(quad, atlas, x, y);
+
+            blend(quad, alphas.data(), end - start, image.pixel(start, y));
+        }
+    }
+}
+
+
+} // namespace
+
+
+namespace gloperate_text
+{
+
+
+SoftwareGlyphRenderer::SoftwareGlyphRenderer(unsigned int threads, int tileSize)
+: m_threads(threads > 0 ? threads : std::max(std::thread::hardware_concurrency(), 1u))
+, m_tileSize(std::max(tileSize, 1))
+{
+}
+
+SoftwareGlyphRenderer::~SoftwareGlyphRenderer()
+{
+}
+
+unsigned int SoftwareGlyphRenderer::threads() const
+{
+    return m_threads;
+}
+
+int SoftwareGlyphRenderer::tileSize() const
+{
+    return m_tileSize;
+}
+
+void SoftwareGlyphRenderer::render(const GlyphVertexCloud & vertexCloud, const FontFace & fontFace, RasterImage & image) const
+{
+    renderInWorld(vertexCloud, fontFace, glm::mat4(), image);
+}
+
+void SoftwareGlyphRenderer::renderInWorld(const GlyphVertexCloud & vertexCloud, const FontFace & fontFace, const glm::mat4 & viewProjection, RasterImage & image) const
+{
+    const auto & extent = image.extent();
+    const auto atlasExtent = glm::ivec2(fontFace.glyphTextureExtent());
+    const auto & glyphImage = fontFace.glyphImage();
+
+    if (vertexCloud.vertices().empty() || extent.x <= 0 || extent.y <= 0)
+    {
+        return;
+    }
+
+    const auto pages = fontFace.glyphTexturePages();
+    if (atlasExtent.x <= 0 || atlasExtent.y <= 0 || glyphImage.size() < static_cast<size_t>(atlasExtent.x) * atlasExtent.y * pages)
+    {
+        assert(false);
+        return;
+    }
+
+    OPENLL_TRACE_ZONE("SoftwareGlyphRenderer::render");
+
+    const Atlas atlas = { glyphImage.data(), atlasExtent.x, atlasExtent.y, pages };
+    const auto tilesX = (extent.x + m_tileSize - 1) / m_tileSize;
+    const auto tilesY = (extent.y + m_tileSize - 1) / m_tileSize;
+
+    // the quads overlapping each tile in vertex order
+    std::vector<Quad> quads;
+    std::vector<std::vector<std::uint32_t>> bins(static_cast<size_t>(tilesX) * tilesY);
+    quads.reserve(vertexCloud.vertices().size());
+    for (const auto & vertex : vertexCloud.vertices())
+    {
+        Quad quad;
+        if (!setup(vertex, viewProjection, extent, quad) || quad.page >= atlas.pages)
+            continue;
+
+        const auto index = static_cast<std::uint32_t>(quads.size());
+        quads.push_back(quad);
+        for (auto y = quad.y0 / m_tileSize; y <= (quad.y1 - 1) / m_tileSize; ++y)
+        {
+            for (auto x = quad.x0 / m_tileSize; x <= (quad.x1 - 1) / m_tileSize; ++x)
+                bins[static_cast<size_t>(y) * tilesX + x].push_back(index);
+        }
+    }
+
+    std::vector<size_t> tiles;
+    for (size_t tile = 0; tile < bins.size(); ++tile)
+    {
+        if (!bins[tile].empty())
+            tiles.push_back(tile);
+    }
+
+    std::atomic<size_t> next(0);
+    const auto work = [&]()
+    {
+        OPENLL_TRACE_ZONE("SoftwareGlyphRenderer::renderTiles");
+        std::vector<float> alphas(static_cast<size_t>(m_tileSize));
+        for (auto i = next++; i < tiles.size(); i = next++)
+        {
+            const auto tile = tiles[i];
+            const auto x0 = static_cast<int>(tile % tilesX) * m_tileSize;
+            const auto y0 = static_cast<int>(tile / tilesX) * m_tileSize;
+            renderTile(quads, bins[tile], atlas, x0, y0, std::min(x0 + m_tileSize, extent.x), std::min(y0 + m_tileSize, extent.y), alphas, image);
+        }
+    };
+
+    // the calling thread renders as well
+    std::vector<std::thread> workers;
+    const auto threads = std::min(static_cast<size_t>(m_threads), tiles.size());
+    for (size_t i = 1; i < threads; ++i)
+        workers.emplace_back(work);
+    work();
+    for (auto & worker : workers)
+        worker.join();
+}
+
+
+} // namespace gloperate_text
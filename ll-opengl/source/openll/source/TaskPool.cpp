@@ -0,0 +1,165 @@
+#include <openll/TaskPool.h>
+
+#include <algorithm>
+
+
+namespace gloperate_text
+{
+
+
+TaskPool::TaskPool(unsigned int threads)
+: m_generation(0)
+, m_active(0)
+, m_stop(false)
+, m_task(nullptr)
+, m_remaining(0)
+{
+    const auto count = threads > 0 ? threads : std::max(std::thread::hardware_concurrency(), 1u);
+    for (unsigned int i = 0; i < count; ++i)
+        m_queues.emplace_back(new Queue);
+
+    // the queue 0 belongs to the calling thread of run
+    for (unsigned int i = 1; i < count; ++i)
+        m_workers.emplace_back(&TaskPool::work, this, i);
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (auto & worker : m_workers)
+        worker.join();
+}
+
+unsigned int TaskPool::threads() const
+{
+    return static_cast<unsigned int>(m_queues.size());
+}
+
+void TaskPool::run(size_t count, const std::function<void(size_t)> & task)
+{
+    if (count == 0)
+        return;
+
+    if (m_workers.empty() || count == 1)
+    {
+        for (size_t index = 0; index < count; ++index)
+            task(index);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_exception = nullptr;
+        m_remaining = count;
+
+        const auto queues = m_queues.size();
+        for (size_t i = 0; i < queues; ++i)
+        {
+            auto & queue = *m_queues[i];
+            std::lock_guard<std::mutex> queueLock(queue.mutex);
+            for (auto index = i * count / queues; index < (i + 1) * count / queues; ++index)
+                queue.indices.push_back(index);
+        }
+
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    execute(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]() { return m_remaining == 0 && m_active == 0; });
+    m_task = nullptr;
+
+    if (m_exception)
+    {
+        auto exception = m_exception;
+        m_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void TaskPool::work(size_t worker)
+{
+    auto generation = 0ull;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wake.wait(lock, [this, generation]() { return m_stop || m_generation != generation; });
+        if (m_stop)
+            return;
+
+        generation = m_generation;
+        ++m_active;
+        lock.unlock();
+
+        execute(worker);
+
+        lock.lock();
+        if (--m_active == 0)
+            m_done.notify_all();
+    }
+}
+
+void TaskPool::execute(size_t worker)
+{
+    size_t index;
+    while (pop(worker, index))
+    {
+        try
+        {
+            (*m_task)(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception)
+                m_exception = std::current_exception();
+        }
+
+        if (--m_remaining == 0)
+        {
+            // run may wait for the last task only
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_done.notify_all();
+        }
+    }
+}
+
+bool TaskPool::pop(size_t worker, size_t & index)
+{
+    {
+        auto & own = *m_queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.indices.empty())
+        {
+            index = own.indices.front();
+            own.indices.pop_front();
+            return true;
+        }
+    }
+
+    // steal from the end of the other queues, i.e., the indices their owners would process last
+    for (size_t i = 1; i < m_queues.size(); ++i)
+    {
+        auto & other = *m_queues[(worker + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.indices.empty())
+        {
+            index = other.indices.back();
+            other.indices.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+
+} // namespace gloperate_text
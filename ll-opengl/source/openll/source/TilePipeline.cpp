@@ -0,0 +1,266 @@
+#include <openll/TilePipeline.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <map>
+
+#include <glm/common.hpp>
+
+#include <openll/GlyphSequence.h>
+#include <openll/RasterImage.h>
+#include <openll/SoftwareGlyphRenderer.h>
+#include <openll/TaskPool.h>
+#include <openll/Trace.h>
+#include <openll/layout/layoutbase.h>
+#include <openll/stages/GlyphPreparationStage.h>
+
+
+namespace
+{
+
+// labels and glyphs per task of the parallel loops
+const size_t labelsPerTask = 1024;
+const size_t glyphsPerTask = 16384;
+
+size_t taskCount(size_t count, size_t perTask)
+{
+    return (count + perTask - 1) / perTask;
+}
+
+}
+
+
+namespace gloperate_text
+{
+
+
+TilePipeline::TilePipeline(const glm::vec2 & worldLowerLeft, const glm::vec2 & worldUpperRight, int tileSize, int halo, TaskPool * pool)
+: m_worldLowerLeft(worldLowerLeft)
+, m_worldUpperRight(worldUpperRight)
+, m_tileSize(std::max(tileSize, 1))
+, m_halo(std::max(halo, 0))
+, m_ownPool(pool ? nullptr : new TaskPool)
+, m_pool(pool ? pool : m_ownPool.get())
+{
+    assert(worldUpperRight.x > worldLowerLeft.x && worldUpperRight.y > worldLowerLeft.y);
+}
+
+TilePipeline::~TilePipeline()
+{
+}
+
+int TilePipeline::tileSize() const
+{
+    return m_tileSize;
+}
+
+int TilePipeline::halo() const
+{
+    return m_halo;
+}
+
+TaskPool & TilePipeline::pool() const
+{
+    return *m_pool;
+}
+
+void TilePipeline::prepare(std::vector<Label> & labels, const LayoutFunction & layout)
+{
+    OPENLL_TRACE_ZONE("TilePipeline::prepare");
+
+    if (layout)
+    {
+        OPENLL_TRACE_ZONE("TilePipeline::layout");
+        layout(labels);
+    }
+
+    std::vector<size_t> displayed;
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        if (labels[i].placement.display)
+            displayed.push_back(i);
+    }
+
+    std::vector<GlyphSequence> sequences(displayed.size());
+    m_pool->run(taskCount(displayed.size(), labelsPerTask), [&](size_t task)
+    {
+        const auto end = std::min((task + 1) * labelsPerTask, displayed.size());
+        for (auto i = task * labelsPerTask; i < end; ++i)
+            sequences[i] = applyPlacement(labels[displayed[i]]);
+    });
+
+    auto vertexCloud = prepareGlyphs(sequences, false, false, m_pool);
+    m_vertices = std::move(vertexCloud.vertices());
+}
+
+const GlyphVertexCloud::Vertices & TilePipeline::vertices() const
+{
+    return m_vertices;
+}
+
+std::vector<TilePipeline::TileId> TilePipeline::tiles(unsigned int z) const
+{
+    const auto buckets = bucket(z);
+
+    std::vector<TileId> tiles;
+    for (size_t i = 0; i < buckets.size(); ++i)
+    {
+        if (i > 0 && buckets[i].first == buckets[i - 1].first)
+            continue;
+        const auto x = static_cast<unsigned int>(buckets[i].first >> 32);
+        const auto y = static_cast<unsigned int>(buckets[i].first & 0xffffffffu);
+        tiles.push_back({ z, x, y });
+    }
+    return tiles;
+}
+
+void TilePipeline::process(const std::vector<TileId> & tiles, const TileCallback & callback) const
+{
+    OPENLL_TRACE_ZONE("TilePipeline::process");
+
+    std::map<unsigned int, Buckets> buckets;
+    for (const auto & id : tiles)
+    {
+        if (buckets.find(id.z) == buckets.end())
+            buckets[id.z] = bucket(id.z);
+    }
+
+    const auto compare = [](const std::pair<std::uint64_t, std::uint32_t> & entry, std::uint64_t key) { return entry.first < key; };
+    m_pool->run(tiles.size(), [&](size_t index)
+    {
+        const auto & id = tiles[index];
+        const auto & entries = buckets.at(id.z);
+        const auto tileKey = key(id.x, id.y);
+
+        auto tile = makeTile(id);
+        for (auto it = std::lower_bound(entries.begin(), entries.end(), tileKey, compare); it != entries.end() && it->first == tileKey; ++it)
+            tile.vertices.push_back(m_vertices[it->second]);
+
+        callback(tile);
+    });
+}
+
+void TilePipeline::render(const std::vector<TileId> & tiles, const FontFace & fontFace, const ImageCallback & callback, const glm::vec4 & clearColor) const
+{
+    // the tiles are rendered in parallel, each by a single thread
+    const SoftwareGlyphRenderer renderer(1, m_tileSize);
+
+    process(tiles, [&](const Tile & tile)
+    {
+        OPENLL_TRACE_ZONE("TilePipeline::renderTile");
+
+        RasterImage image({ m_tileSize, m_tileSize }, clearColor);
+        GlyphVertexCloud vertexCloud;
+        vertexCloud.vertices() = tile.vertices;
+        renderer.renderInWorld(vertexCloud, fontFace, tile.viewProjection, image);
+
+        callback(tile, image);
+    });
+}
+
+TilePipeline::Buckets TilePipeline::bucket(unsigned int z) const
+{
+    OPENLL_TRACE_ZONE("TilePipeline::bucket");
+    assert(z < 32);
+
+    const auto count = static_cast<double>(1ull << z);
+    const auto extent = tileExtent(z);
+    const auto haloX = static_cast<double>(extent.x) * m_halo / m_tileSize;
+    const auto haloY = static_cast<double>(extent.y) * m_halo / m_tileSize;
+
+    // tile index range of an interval, false if outside of the world
+    const auto range = [count](double lower, double upper, double tileExtent, unsigned int & first, unsigned int & last)
+    {
+        const auto from = std::floor(lower / tileExtent);
+        const auto to = std::floor(upper / tileExtent);
+        if (to < 0.0 || from >= count)
+            return false;
+        first = static_cast<unsigned int>(std::max(from, 0.0));
+        last = static_cast<unsigned int>(std::min(to, count - 1.0));
+        return true;
+    };
+
+    // buckets of consecutive vertex ranges, concatenated in order
+    std::vector<Buckets> partial(taskCount(m_vertices.size(), glyphsPerTask));
+    m_pool->run(partial.size(), [&](size_t task)
+    {
+        auto & entries = partial[task];
+        const auto end = std::min((task + 1) * glyphsPerTask, m_vertices.size());
+        for (auto i = task * glyphsPerTask; i < end; ++i)
+        {
+            const auto & vertex = m_vertices[i];
+            const glm::vec2 corners[4] = {
+                glm::vec2(vertex.origin),
+                glm::vec2(vertex.origin + vertex.vtan),
+                glm::vec2(vertex.origin + vertex.vbitan),
+                glm::vec2(vertex.origin + vertex.vtan + vertex.vbitan) };
+
+            auto lower = corners[0];
+            auto upper = corners[0];
+            for (const auto & corner : corners)
+            {
+                lower = glm::min(lower, corner);
+                upper = glm::max(upper, corner);
+            }
+
+            // tile rows are counted from the top
+            unsigned int x0, x1, y0, y1;
+            if (!range(lower.x - haloX - m_worldLowerLeft.x, upper.x + haloX - m_worldLowerLeft.x, extent.x, x0, x1)
+                || !range(m_worldUpperRight.y - upper.y - haloY, m_worldUpperRight.y - lower.y + haloY, extent.y, y0, y1))
+                continue;
+
+            for (auto y = y0; y <= y1; ++y)
+            {
+                for (auto x = x0; x <= x1; ++x)
+                    entries.emplace_back(key(x, y), static_cast<std::uint32_t>(i));
+            }
+        }
+    });
+
+    Buckets buckets;
+    for (const auto & entries : partial)
+        buckets.insert(buckets.end(), entries.begin(), entries.end());
+
+    std::stable_sort(buckets.begin(), buckets.end(), [](const std::pair<std::uint64_t, std::uint32_t> & a, const std::pair<std::uint64_t, std::uint32_t> & b)
+    {
+        return a.first < b.first;
+    });
+    return buckets;
+}
+
+TilePipeline::Tile TilePipeline::makeTile(const TileId & id) const
+{
+    // in double precision for deep zoom levels
+    const auto count = static_cast<double>(1ull << id.z);
+    const auto width = (static_cast<double>(m_worldUpperRight.x) - m_worldLowerLeft.x) / count;
+    const auto height = (static_cast<double>(m_worldUpperRight.y) - m_worldLowerLeft.y) / count;
+    const auto left = m_worldLowerLeft.x + id.x * width;
+    const auto top = m_worldUpperRight.y - id.y * height;
+
+    Tile tile;
+    tile.id = id;
+    tile.lowerLeft = glm::vec2(static_cast<float>(left), static_cast<float>(top - height));
+    tile.upperRight = glm::vec2(static_cast<float>(left + width), static_cast<float>(top));
+
+    // orthographic projection of the tile rectangle
+    tile.viewProjection = glm::mat4();
+    tile.viewProjection[0][0] = static_cast<float>(2.0 / width);
+    tile.viewProjection[1][1] = static_cast<float>(2.0 / height);
+    tile.viewProjection[3][0] = static_cast<float>(-(2.0 * left + width) / width);
+    tile.viewProjection[3][1] = static_cast<float>(-(2.0 * top - height) / height);
+    return tile;
+}
+
+glm::vec2 TilePipeline::tileExtent(unsigned int z) const
+{
+    return (m_worldUpperRight - m_worldLowerLeft) / static_cast<float>(1ull << z);
+}
+
+std::uint64_t TilePipeline::key(unsigned int x, unsigned int y)
+{
+    return (static_cast<std::uint64_t>(x) << 32) | y;
+}
+
+
+} // namespace gloperate_text
@@ -0,0 +1,215 @@
+#include <openll/Trace.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Event
+{
+    const char * name;
+    // 'X' for zones and 'C' for counters
+    char phase;
+    double timestamp;
+    // duration of zones, value of counters
+    double value;
+};
+
+// Events of a single thread; the mutex is only contended while writing the trace
+struct ThreadBuffer
+{
+    std::mutex mutex;
+    std::vector<Event> events;
+    unsigned int threadId;
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    // owned by the registry, so that the events of finished threads are kept
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::atomic<bool> recording{false};
+    std::atomic<Clock::rep> start{0};
+};
+
+Registry & registry()
+{
+    static Registry registry;
+    return registry;
+}
+
+ThreadBuffer & threadBuffer()
+{
+    thread_local ThreadBuffer * buffer = nullptr;
+    if (!buffer)
+    {
+        auto & global = registry();
+        std::lock_guard<std::mutex> lock(global.mutex);
+        global.buffers.emplace_back(new ThreadBuffer());
+        buffer = global.buffers.back().get();
+        buffer->threadId = static_cast<unsigned int>(global.buffers.size());
+    }
+    return *buffer;
+}
+
+void record(const Event & event)
+{
+    auto & buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back(event);
+}
+
+void writeString(std::ostream & stream, const char * string)
+{
+    stream << '"';
+    for (auto c = string; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            stream << '\\';
+        stream << *c;
+    }
+    stream << '"';
+}
+
+}
+
+
+namespace gloperate_text
+{
+
+
+void Trace::start()
+{
+    clear();
+    auto & global = registry();
+    global.start = Clock::now().time_since_epoch().count();
+    global.recording = true;
+}
+
+void Trace::stop()
+{
+    registry().recording = false;
+}
+
+bool Trace::recording()
+{
+    return registry().recording;
+}
+
+size_t Trace::size()
+{
+    auto & global = registry();
+    std::lock_guard<std::mutex> lock(global.mutex);
+    auto size = size_t(0);
+    for (const auto & buffer : global.buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        size += buffer->events.size();
+    }
+    return size;
+}
+
+void Trace::clear()
+{
+    auto & global = registry();
+    std::lock_guard<std::mutex> lock(global.mutex);
+    for (const auto & buffer : global.buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+    }
+}
+
+void Trace::write(std::ostream & stream)
+{
+    auto & global = registry();
+    std::lock_guard<std::mutex> lock(global.mutex);
+
+    // microseconds with nanosecond resolution, also for traces longer than a second
+    const auto flags = stream.flags();
+    const auto precision = stream.precision();
+    stream << std::fixed << std::setprecision(3);
+
+    stream << "{\"traceEvents\":[";
+    auto first = true;
+    for (const auto & buffer : global.buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        for (const auto & event : buffer->events)
+        {
+            stream << (first ? "\n" : ",\n") << "{\"name\":";
+            writeString(stream, event.name);
+            stream << ",\"ph\":\"" << event.phase << "\",\"ts\":" << event.timestamp
+                << ",\"pid\":1,\"tid\":" << buffer->threadId;
+            if (event.phase == 'X')
+            {
+                stream << ",\"dur\":" << event.value << "}";
+            }
+            else
+            {
+                stream << ",\"args\":{";
+                writeString(stream, event.name);
+                stream << ":" << event.value << "}}";
+            }
+            first = false;
+        }
+    }
+    stream << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+bool Trace::write(const std::string & filename)
+{
+    std::ofstream stream(filename);
+    if (!stream)
+        return false;
+
+    write(stream);
+    return static_cast<bool>(stream);
+}
+
+double Trace::now()
+{
+    const auto start = Clock::time_point(Clock::duration(registry().start.load()));
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+void Trace::zone(const char * name, double begin, double end)
+{
+    if (recording())
+        record({name, 'X', begin, end - begin});
+}
+
+void Trace::counter(const char * name, double value)
+{
+    if (recording())
+        record({name, 'C', now(), value});
+}
+
+
+TraceZone::TraceZone(const char * name)
+: m_name(name)
+, m_begin(Trace::recording() ? Trace::now() : -1.0)
+{
+}
+
+TraceZone::~TraceZone()
+{
+    if (m_begin >= 0.0)
+        Trace::zone(m_name, m_begin, Trace::now());
+}
+
+
+} // namespace gloperate_text
@@ -0,0 +1,758 @@
+#include <openll/TrueTypeFont.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+
+namespace
+{
+
+
+constexpr std::uint32_t tag(const char * name)
+{
+    return (static_cast<std::uint32_t>(name[0]) << 24) | (static_cast<std::uint32_t>(name[1]) << 16)
+        | (static_cast<std::uint32_t>(name[2]) << 8) | static_cast<std::uint32_t>(name[3]);
+}
+
+// composite glyph flags
+const std::uint16_t argumentsAreWords = 0x0001;
+const std::uint16_t argumentsAreOffsets = 0x0002;
+const std::uint16_t hasScale = 0x0008;
+const std::uint16_t moreComponents = 0x0020;
+const std::uint16_t hasXYScale = 0x0040;
+const std::uint16_t hasTwoByTwo = 0x0080;
+
+// simple glyph flags
+const std::uint8_t onCurve = 0x01;
+const std::uint8_t xShort = 0x02;
+const std::uint8_t yShort = 0x04;
+const std::uint8_t repeat = 0x08;
+const std::uint8_t xSameOrPositive = 0x10;
+const std::uint8_t ySameOrPositive = 0x20;
+
+// nesting of composite glyphs
+const int maximumDepth = 8;
+
+struct Point
+{
+    glm::vec2 position;
+    bool onCurve;
+};
+
+glm::vec2 apply(const float transform[6], float x, float y)
+{
+    return glm::vec2(transform[0] * x + transform[2] * y + transform[4], transform[1] * x + transform[3] * y + transform[5]);
+}
+
+void appendQuadratic(gloperate_text::TrueTypeFont::Contour & contour, const glm::vec2 & p0, const glm::vec2 & p1, const glm::vec2 & p2, float tolerance)
+{
+    // the deviation of a chord of a quadratic curve split into n parts is at most |p0 - 2 p1 + p2| / (8 n^2)
+    const auto d = p0 - 2.f * p1 + p2;
+    const auto deviation = std::sqrt(d.x * d.x + d.y * d.y);
+    const auto segments = std::min(std::max(static_cast<int>(std::ceil(std::sqrt(deviation / (8.f * tolerance)))), 1), 64);
+
+    for (auto i = 1; i <= segments; ++i)
+    {
+        const auto t = static_cast<float>(i) / segments;
+        const auto s = 1.f - t;
+        contour.push_back(s * s * p0 + 2.f * s * t * p1 + t * t * p2);
+    }
+}
+
+// converts a closed quadratic b-spline with implied on-curve points into a polygon
+gloperate_text::TrueTypeFont::Contour flatten(const std::vector<Point> & points, float tolerance)
+{
+    gloperate_text::TrueTypeFont::Contour contour;
+    if (points.size() < 2)
+        return contour;
+
+    const auto count = points.size();
+
+    // start on an on-curve point, or in between two off-curve points
+    size_t first = 0;
+    size_t last = count;
+    glm::vec2 start;
+    if (points[0].onCurve)
+    {
+        start = points[0].position;
+        first = 1;
+    }
+    else if (points[count - 1].onCurve)
+    {
+        start = points[count - 1].position;
+        last = count - 1;
+    }
+    else
+    {
+        start = 0.5f * (points[0].position + points[count - 1].position);
+    }
+
+    contour.push_back(start);
+    auto previous = start;
+    auto control = glm::vec2();
+    auto hasControl = false;
+
+    for (auto i = first; i < last; ++i)
+    {
+        const auto & point = points[i];
+        if (point.onCurve)
+        {
+            if (hasControl)
+                appendQuadratic(contour, previous, control, point.position, tolerance);
+            else
+                contour.push_back(point.position);
+            previous = point.position;
+            hasControl = false;
+        }
+        else
+        {
+            if (hasControl)
+            {
+                const auto middle = 0.5f * (control + point.position);
+                appendQuadratic(contour, previous, control, middle, tolerance);
+                previous = middle;
+            }
+            control = point.position;
+            hasControl = true;
+        }
+    }
+
+    if (hasControl)
+        appendQuadratic(contour, previous, control, start, tolerance);
+
+    // the polygon is closed implicitly
+    if (contour.size() > 1 && contour.back() == contour.front())
+        contour.pop_back();
+
+    return contour;
+}
+
+
+} // namespace
+
+
+namespace gloperate_text
+{
+
+
+TrueTypeFont::TrueTypeFont(const std::string & filePath)
+: m_valid(false)
+, m_unitsPerEm(0)
+, m_ascender(0)
+, m_descender(0)
+, m_lineGap(0)
+, m_glyphCount(0)
+, m_horizontalMetricsCount(0)
+, m_longLocations(false)
+, m_glyf(0)
+, m_glyfLength(0)
+, m_loca(0)
+, m_hmtx(0)
+{
+    std::ifstream ifs(filePath, std::ios::in | std::ios::binary);
+    if (!ifs)
+    {
+        std::cerr << "Reading from file \"" << filePath << "\" failed." << std::endl;
+        return;
+    }
+
+    m_data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    m_valid = parse();
+
+    if (!m_valid)
+        std::cerr << "Font file \"" << filePath << "\" is no supported TrueType font." << std::endl;
+}
+
+TrueTypeFont::TrueTypeFont(std::vector<std::uint8_t> data)
+: m_data(std::move(data))
+, m_valid(false)
+, m_unitsPerEm(0)
+, m_ascender(0)
+, m_descender(0)
+, m_lineGap(0)
+, m_glyphCount(0)
+, m_horizontalMetricsCount(0)
+, m_longLocations(false)
+, m_glyf(0)
+, m_glyfLength(0)
+, m_loca(0)
+, m_hmtx(0)
+{
+    m_valid = parse();
+}
+
+TrueTypeFont::~TrueTypeFont()
+{
+}
+
+bool TrueTypeFont::isValid() const
+{
+    return m_valid;
+}
+
+const std::string & TrueTypeFont::familyName() const
+{
+    return m_familyName;
+}
+
+int TrueTypeFont::unitsPerEm() const
+{
+    return m_unitsPerEm;
+}
+
+int TrueTypeFont::ascender() const
+{
+    return m_ascender;
+}
+
+int TrueTypeFont::descender() const
+{
+    return m_descender;
+}
+
+int TrueTypeFont::lineGap() const
+{
+    return m_lineGap;
+}
+
+std::uint32_t TrueTypeFont::glyphCount() const
+{
+    return m_glyphCount;
+}
+
+std::uint32_t TrueTypeFont::glyphId(std::uint32_t codepoint) const
+{
+    const auto it = std::lower_bound(m_characterMap.begin(), m_characterMap.end(), codepoint,
+        [](const std::pair<std::uint32_t, std::uint32_t> & entry, std::uint32_t value) { return entry.first < value; });
+
+    if (it == m_characterMap.end() || it->first != codepoint)
+        return 0;
+
+    return it->second;
+}
+
+std::vector<std::uint32_t> TrueTypeFont::codepoints() const
+{
+    std::vector<std::uint32_t> result;
+    result.reserve(m_characterMap.size());
+    for (const auto & entry : m_characterMap)
+        result.push_back(entry.first);
+    return result;
+}
+
+int TrueTypeFont::advance(std::uint32_t glyph) const
+{
+    if (m_horizontalMetricsCount == 0)
+        return 0;
+
+    // glyphs beyond the long metrics share the last advance
+    const auto index = std::min(glyph, m_horizontalMetricsCount - 1);
+    return u16(m_hmtx + 4 * index);
+}
+
+int TrueTypeFont::kerning(std::uint32_t left, std::uint32_t right) const
+{
+    const auto it = std::lower_bound(m_kerningPairs.begin(), m_kerningPairs.end(), std::make_pair(left, right),
+        [](const KerningPair & pair, const std::pair<std::uint32_t, std::uint32_t> & value)
+        {
+            return std::make_pair(pair.left, pair.right) < value;
+        });
+
+    if (it == m_kerningPairs.end() || it->left != left || it->right != right)
+        return 0;
+
+    return it->value;
+}
+
+const std::vector<TrueTypeFont::KerningPair> & TrueTypeFont::kerningPairs() const
+{
+    return m_kerningPairs;
+}
+
+bool TrueTypeFont::bounds(std::uint32_t glyph, glm::vec2 & lowerLeft, glm::vec2 & upperRight) const
+{
+    std::uint32_t offset, length;
+    if (!glyphRange(glyph, offset, length) || length < 10)
+        return false;
+
+    lowerLeft = glm::vec2(i16(offset + 2), i16(offset + 4));
+    upperRight = glm::vec2(i16(offset + 6), i16(offset + 8));
+    return true;
+}
+
+TrueTypeFont::Outline TrueTypeFont::outline(std::uint32_t glyph, float scale, float tolerance) const
+{
+    Outline result;
+    if (!m_valid)
+        return result;
+
+    const float transform[6] = { scale, 0.f, 0.f, scale, 0.f, 0.f };
+    appendOutline(glyph, transform, tolerance, result, 0);
+    return result;
+}
+
+bool TrueTypeFont::parse()
+{
+    if (m_data.size() < 12)
+        return false;
+
+    std::uint32_t directory = 0;
+
+    // first font of a collection
+    if (u32(0) == tag("ttcf"))
+        directory = u32(12);
+
+    const auto version = u32(directory);
+    if (version != 0x00010000 && version != tag("true"))
+        return false; // e.g., CFF outlines ('OTTO')
+
+    std::uint32_t head = 0, hhea = 0, maxp = 0, cmap = 0, cmapLength = 0, kern = 0, kernLength = 0, name = 0, nameLength = 0;
+    std::uint32_t hmtxLength = 0, locaLength = 0;
+
+    const auto tableCount = u16(directory + 4);
+    for (std::uint32_t i = 0; i < tableCount; ++i)
+    {
+        const auto record = directory + 12 + 16 * i;
+        const auto offset = u32(record + 8);
+        const auto length = u32(record + 12);
+        if (static_cast<std::uint64_t>(offset) + length > m_data.size())
+            continue;
+
+        switch (u32(record))
+        {
+        case tag("head"): head = offset; break;
+        case tag("hhea"): hhea = offset; break;
+        case tag("maxp"): maxp = offset; break;
+        case tag("hmtx"): m_hmtx = offset; hmtxLength = length; break;
+        case tag("loca"): m_loca = offset; locaLength = length; break;
+        case tag("glyf"): m_glyf = offset; m_glyfLength = length; break;
+        case tag("cmap"): cmap = offset; cmapLength = length; break;
+        case tag("kern"): kern = offset; kernLength = length; break;
+        case tag("name"): name = offset; nameLength = length; break;
+        default: break;
+        }
+    }
+
+    if (!head || !hhea || !maxp || !m_hmtx || !m_loca || !m_glyf || !cmap)
+        return false;
+
+    m_unitsPerEm = u16(head + 18);
+    m_longLocations = i16(head + 50) != 0;
+    m_ascender = i16(hhea + 4);
+    m_descender = i16(hhea + 6);
+    m_lineGap = i16(hhea + 8);
+    m_horizontalMetricsCount = u16(hhea + 34);
+    m_glyphCount = u16(maxp + 4);
+
+    if (m_unitsPerEm == 0 || m_glyphCount == 0)
+        return false;
+    if (hmtxLength < 4 * m_horizontalMetricsCount)
+        return false;
+    if (locaLength < (m_glyphCount + 1) * (m_longLocations ? 4u : 2u))
+        return false;
+
+    if (!parseCmap(cmap, cmapLength))
+        return false;
+
+    if (kern)
+        parseKern(kern, kernLength);
+    if (name)
+        parseName(name, nameLength);
+
+    return true;
+}
+
+bool TrueTypeFont::parseCmap(std::uint32_t offset, std::uint32_t length)
+{
+    // prefer full unicode (format 12) over the basic multilingual plane (format 4)
+    std::uint32_t subtable = 0;
+    auto bestRank = 0;
+
+    const auto count = u16(offset + 2);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const auto record = offset + 4 + 8 * i;
+        const auto platform = u16(record);
+        const auto encoding = u16(record + 2);
+        const auto subtableOffset = u32(record + 4);
+        if (subtableOffset >= length)
+            continue;
+
+        const auto format = u16(offset + subtableOffset);
+        const auto unicode = platform == 0 || (platform == 3 && (encoding == 1 || encoding == 10));
+        const auto rank = !unicode ? 0 : format == 12 ? 2 : format == 4 ? 1 : 0;
+        if (rank > bestRank)
+        {
+            bestRank = rank;
+            subtable = offset + subtableOffset;
+        }
+    }
+
+    if (bestRank == 0)
+        return false;
+
+    auto addMapping = [this](std::uint32_t codepoint, std::uint32_t glyph)
+    {
+        if (glyph != 0 && glyph < m_glyphCount)
+            m_characterMap.emplace_back(codepoint, glyph);
+    };
+
+    if (u16(subtable) == 12)
+    {
+        const auto groupCount = u32(subtable + 12);
+        for (std::uint32_t i = 0; i < groupCount && subtable + 16 + 12 * i + 12 <= m_data.size(); ++i)
+        {
+            const auto group = subtable + 16 + 12 * i;
+            const auto startCode = u32(group);
+            const auto endCode = u32(group + 4);
+            const auto startGlyph = u32(group + 8);
+            if (endCode < startCode || endCode > 0x10FFFF)
+                continue;
+
+            for (auto codepoint = startCode; codepoint <= endCode; ++codepoint)
+                addMapping(codepoint, startGlyph + (codepoint - startCode));
+        }
+    }
+    else
+    {
+        const std::uint32_t segmentCount = u16(subtable + 6) / 2;
+        const auto endCodes = subtable + 14;
+        const auto startCodes = endCodes + 2 * segmentCount + 2;
+        const auto deltas = startCodes + 2 * segmentCount;
+        const auto rangeOffsets = deltas + 2 * segmentCount;
+
+        for (std::uint32_t i = 0; i < segmentCount; ++i)
+        {
+            const std::uint32_t startCode = u16(startCodes + 2 * i);
+            const std::uint32_t endCode = u16(endCodes + 2 * i);
+            const auto delta = u16(deltas + 2 * i);
+            const auto rangeOffset = u16(rangeOffsets + 2 * i);
+
+            for (auto codepoint = startCode; codepoint <= endCode && codepoint != 0xFFFF; ++codepoint)
+            {
+                std::uint32_t glyph;
+                if (rangeOffset == 0)
+                {
+                    glyph = (codepoint + delta) & 0xFFFF;
+                }
+                else
+                {
+                    // idRangeOffset is relative to its own location
+                    glyph = u16(rangeOffsets + 2 * i + rangeOffset + 2 * (codepoint - startCode));
+                    if (glyph != 0)
+                        glyph = (glyph + delta) & 0xFFFF;
+                }
+                addMapping(codepoint, glyph);
+            }
+        }
+    }
+
+    std::sort(m_characterMap.begin(), m_characterMap.end());
+    m_characterMap.erase(std::unique(m_characterMap.begin(), m_characterMap.end(),
+        [](const std::pair<std::uint32_t, std::uint32_t> & a, const std::pair<std::uint32_t, std::uint32_t> & b) { return a.first == b.first; }),
+        m_characterMap.end());
+
+    return true;
+}
+
+void TrueTypeFont::parseKern(std::uint32_t offset, std::uint32_t length)
+{
+    const auto end = offset + length;
+
+    // Microsoft (version 0) and Apple (version 1.0) headers differ in field sizes
+    const auto apple = u16(offset) == 1;
+    const auto tableCount = apple ? u32(offset + 4) : u16(offset + 2);
+    auto subtable = offset + (apple ? 8 : 4);
+
+    for (std::uint32_t i = 0; i < tableCount && subtable < end; ++i)
+    {
+        std::uint32_t subtableLength, pairs;
+        bool horizontalPairs;
+        if (apple)
+        {
+            subtableLength = u32(subtable);
+            const auto coverage = u16(subtable + 4);
+            // not vertical, not cross-stream, not variation, format 0
+            horizontalPairs = (coverage & 0xE000) == 0 && (coverage & 0xFF) == 0;
+            pairs = subtable + 8;
+        }
+        else
+        {
+            subtableLength = u16(subtable + 2);
+            const auto coverage = u16(subtable + 4);
+            // horizontal, not minimum, not cross-stream, format 0
+            horizontalPairs = (coverage & 0x0007) == 0x0001 && (coverage >> 8) == 0;
+            pairs = subtable + 6;
+        }
+
+        if (horizontalPairs)
+        {
+            const auto pairCount = u16(pairs);
+            for (std::uint32_t j = 0; j < pairCount; ++j)
+            {
+                const auto pair = pairs + 8 + 6 * j;
+                if (pair + 6 > end)
+                    break;
+                m_kerningPairs.push_back({ u16(pair), u16(pair + 2), i16(pair + 4) });
+            }
+
+            // the 16 bit length of large subtables overflows; a single subtable is the common case
+            if (!apple)
+                subtableLength = std::max(subtableLength, 14u + 6u * pairCount);
+        }
+
+        if (subtableLength == 0)
+            break;
+        subtable += subtableLength;
+    }
+
+    // subtables add up
+    std::sort(m_kerningPairs.begin(), m_kerningPairs.end(), [](const KerningPair & a, const KerningPair & b)
+    {
+        return std::make_pair(a.left, a.right) < std::make_pair(b.left, b.right);
+    });
+
+    std::vector<KerningPair> merged;
+    for (const auto & pair : m_kerningPairs)
+    {
+        if (!merged.empty() && merged.back().left == pair.left && merged.back().right == pair.right)
+            merged.back().value = static_cast<std::int16_t>(merged.back().value + pair.value);
+        else
+            merged.push_back(pair);
+    }
+
+    merged.erase(std::remove_if(merged.begin(), merged.end(), [](const KerningPair & pair) { return pair.value == 0; }), merged.end());
+    m_kerningPairs = std::move(merged);
+}
+
+void TrueTypeFont::parseName(std::uint32_t offset, std::uint32_t length)
+{
+    const auto count = u16(offset + 2);
+    const auto strings = offset + u16(offset + 4);
+
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const auto record = offset + 6 + 12 * i;
+        const auto platform = u16(record);
+        const auto nameId = u16(record + 6);
+        const auto nameLength = u16(record + 8);
+        const auto nameOffset = strings + u16(record + 10);
+        if (nameId != 1 || nameOffset + nameLength > offset + length)
+            continue;
+
+        // windows names are UTF-16BE, macintosh names single byte
+        const auto wide = platform == 0 || platform == 3;
+        std::string name;
+        for (std::uint32_t j = 0; j < nameLength; j += wide ? 2 : 1)
+        {
+            const auto character = wide ? u16(nameOffset + j) : u8(nameOffset + j);
+            if (character > 0 && character < 128)
+                name.push_back(static_cast<char>(character));
+        }
+
+        if (!name.empty())
+        {
+            m_familyName = name;
+            return;
+        }
+    }
+}
+
+bool TrueTypeFont::glyphRange(std::uint32_t glyph, std::uint32_t & offset, std::uint32_t & length) const
+{
+    if (glyph >= m_glyphCount)
+        return false;
+
+    std::uint32_t begin, end;
+    if (m_longLocations)
+    {
+        begin = u32(m_loca + 4 * glyph);
+        end = u32(m_loca + 4 * glyph + 4);
+    }
+    else
+    {
+        begin = 2u * u16(m_loca + 2 * glyph);
+        end = 2u * u16(m_loca + 2 * glyph + 2);
+    }
+
+    if (end <= begin || end > m_glyfLength)
+        return false;
+
+    offset = m_glyf + begin;
+    length = end - begin;
+    return true;
+}
+
+void TrueTypeFont::appendOutline(std::uint32_t glyph, const float transform[6], float tolerance, Outline & outline, int depth) const
+{
+    std::uint32_t offset, length;
+    if (depth > maximumDepth || !glyphRange(glyph, offset, length) || length < 10)
+        return;
+
+    const auto end = offset + length;
+    const auto contourCount = i16(offset);
+
+    if (contourCount < 0)
+    {
+        auto component = offset + 10;
+        std::uint16_t flags;
+        do
+        {
+            if (component + 4 > end)
+                return;
+
+            flags = u16(component);
+            const auto componentGlyph = u16(component + 2);
+            component += 4;
+
+            float dx = 0.f, dy = 0.f;
+            if (flags & argumentsAreWords)
+            {
+                dx = i16(component);
+                dy = i16(component + 2);
+                component += 4;
+            }
+            else
+            {
+                dx = static_cast<std::int8_t>(u8(component));
+                dy = static_cast<std::int8_t>(u8(component + 1));
+                component += 2;
+            }
+
+            // point matching (arguments are point indices) is not supported, the component is placed unmoved
+            if (!(flags & argumentsAreOffsets))
+                dx = dy = 0.f;
+
+            // F2Dot14
+            auto fixed = [this](std::uint32_t position) { return i16(position) / 16384.f; };
+            float a = 1.f, b = 0.f, c = 0.f, d = 1.f;
+            if (flags & hasScale)
+            {
+                a = d = fixed(component);
+                component += 2;
+            }
+            else if (flags & hasXYScale)
+            {
+                a = fixed(component);
+                d = fixed(component + 2);
+                component += 4;
+            }
+            else if (flags & hasTwoByTwo)
+            {
+                a = fixed(component);
+                b = fixed(component + 2);
+                c = fixed(component + 4);
+                d = fixed(component + 6);
+                component += 8;
+            }
+
+            const float combined[6] = {
+                transform[0] * a + transform[2] * b,
+                transform[1] * a + transform[3] * b,
+                transform[0] * c + transform[2] * d,
+                transform[1] * c + transform[3] * d,
+                transform[0] * dx + transform[2] * dy + transform[4],
+                transform[1] * dx + transform[3] * dy + transform[5] };
+
+            appendOutline(componentGlyph, combined, tolerance, outline, depth + 1);
+
+        } while (flags & moreComponents);
+
+        return;
+    }
+
+    if (contourCount == 0)
+        return;
+
+    const auto endPoints = offset + 10;
+    const std::uint32_t pointCount = u16(endPoints + 2 * (contourCount - 1)) + 1u;
+    const auto instructionLength = u16(endPoints + 2 * contourCount);
+    auto position = endPoints + 2 * contourCount + 2 + instructionLength;
+
+    std::vector<std::uint8_t> flags;
+    flags.reserve(pointCount);
+    while (flags.size() < pointCount)
+    {
+        if (position >= end)
+            return;
+        const auto flag = u8(position++);
+        flags.push_back(flag);
+        if (flag & repeat)
+        {
+            const auto repetitions = u8(position++);
+            for (std::uint32_t i = 0; i < repetitions && flags.size() < pointCount; ++i)
+                flags.push_back(flag);
+        }
+    }
+
+    // delta encoded coordinates, all x before all y
+    std::vector<int> xs(pointCount), ys(pointCount);
+    auto readCoordinates = [&](std::vector<int> & values, std::uint8_t shortFlag, std::uint8_t sameOrPositiveFlag)
+    {
+        auto value = 0;
+        for (std::uint32_t i = 0; i < pointCount; ++i)
+        {
+            const auto flag = flags[i];
+            if (flag & shortFlag)
+            {
+                const auto delta = static_cast<int>(u8(position++));
+                value += (flag & sameOrPositiveFlag) ? delta : -delta;
+            }
+            else if (!(flag & sameOrPositiveFlag))
+            {
+                value += i16(position);
+                position += 2;
+            }
+            values[i] = value;
+        }
+    };
+    readCoordinates(xs, xShort, xSameOrPositive);
+    readCoordinates(ys, yShort, ySameOrPositive);
+    if (position > end)
+        return;
+
+    std::uint32_t first = 0;
+    std::vector<Point> points;
+    for (auto contour = 0; contour < contourCount; ++contour)
+    {
+        const std::uint32_t last = u16(endPoints + 2 * contour);
+        if (last < first || last >= pointCount)
+            return;
+
+        points.clear();
+        for (auto i = first; i <= last; ++i)
+            points.push_back({ apply(transform, static_cast<float>(xs[i]), static_cast<float>(ys[i])), (flags[i] & onCurve) != 0 });
+
+        auto polygon = flatten(points, tolerance);
+        if (polygon.size() > 2)
+            outline.push_back(std::move(polygon));
+
+        first = last + 1;
+    }
+}
+
+std::uint8_t TrueTypeFont::u8(std::uint32_t offset) const
+{
+    return offset < m_data.size() ? m_data[offset] : 0;
+}
+
+std::uint16_t TrueTypeFont::u16(std::uint32_t offset) const
+{
+    return static_cast<std::uint16_t>((u8(offset) << 8) | u8(offset + 1));
+}
+
+std::int16_t TrueTypeFont::i16(std::uint32_t offset) const
+{
+    return static_cast<std::int16_t>(u16(offset));
+}
+
+std::uint32_t TrueTypeFont::u32(std::uint32_t offset) const
+{
+    return (static_cast<std::uint32_t>(u16(offset)) << 16) | u16(offset + 2);
+}
+
+
+} // namespace gloperate_text
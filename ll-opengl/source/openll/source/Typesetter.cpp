@@ -10,6 +10,7 @@
 #include <openll/Alignment.h>
 #include <openll/FontFace.h>
 #include <openll/GlyphSequence.h>
+#include <openll/Trace.h>
 
 
 namespace gloperate_text
@@ -23,14 +24,15 @@ const char32_t & Typesetter::lineFeed()
 
 glm::vec2 Typesetter::extent(const GlyphSequence & sequence)
 {
-    return typeset(sequence, GlyphVertexCloud::Vertices::iterator(), true);
+    // dry-run typesetting is cached by the sequence itself
+    return sequence.extent();
 }
 
 std::pair<glm::vec2, glm::vec2> Typesetter::rectangle(
     const GlyphSequence & sequence,
     glm::vec3 origin)
 {
-    auto extent = Typesetter::extent(sequence);
+    const auto & extent = sequence.extent();
     auto offset = sequence.fontFace()->lineHeight() - sequence.fontFace()->base();
 
     switch (sequence.lineAnchor())
@@ -82,8 +84,9 @@ glm::vec2 Typesetter::typeset(
 ,   const GlyphVertexCloud::Vertices::iterator & begin
 ,   bool dryrun)
 {
+    OPENLL_TRACE_ZONE("Typesetter::typeset");
     //const auto & padding = fontFace.glyphTexturePadding();
-    auto & fontFace = *sequence.fontFace();
+    const auto & fontFace = *sequence.fontFace();
 
     auto pen = glm::vec2(0.f);
     auto vertex = begin;
@@ -190,6 +193,7 @@ inline std::u32string::const_iterator Typesetter::typeset_forward(
     const auto iBegin = sequence.string().cbegin();
     const auto iEnd = sequence.string().cend();
 
+    const auto & fontFace = *sequence.fontFace();
     width = 0.f; // reset the width
 
     // accumulate glyph advances (including kerning) up to the next
@@ -198,9 +202,9 @@ inline std::u32string::const_iterator Typesetter::typeset_forward(
     while (i != iEnd && delimiters.find(*i) == delimiters.npos)
     {
         if (i != iBegin)
-            width += sequence.fontFace()->kerning(*(i - 1), *i);
+            width += fontFace.kerning(*(i - 1), *i);
 
-        width += sequence.fontFace()->glyph(*i++).advance();
+        width += fontFace.glyph(*i++).advance();
     }
     return i;
 }
@@ -222,6 +226,7 @@ inline void Typesetter::typeset_glyph(
     const auto ll = glyph.subTextureOrigin();
     const auto ur = glyph.subTextureOrigin() + glyph.subTextureExtent();
     vertex->uvRect = glm::vec4(ll, ur);
+    vertex->page   = glyph.page();
 }
 
 inline void Typesetter::typeset_extent(
@@ -0,0 +1,325 @@
+#include <openll/layout/AnnealingSolver.h>
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+#include <openll/GlyphSequence.h>
+#include <openll/Trace.h>
+#include <openll/layout/layoutbase.h>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+const unsigned int AnnealingState::noAnchor;
+
+namespace
+{
+
+template<typename T>
+T randomIndexExcept(T except, T size, std::default_random_engine & engine)
+{
+    std::uniform_int_distribution<T> positionDistribution(0, size - 1);
+    T randomNumber;
+    do
+    {
+        randomNumber = positionDistribution(engine);
+    }
+    while (randomNumber == except);
+    return randomNumber;
+}
+
+// index of the label area matching a previous placement or -1 if the candidates changed
+int matchingPlacement(const Label & label, const LabelPlacement & placement, const std::vector<LabelArea> & labelAreas)
+{
+    if (!placement.display)
+        return static_cast<int>(labelAreas.size());
+
+    for (size_t position = 0; position < labelAreas.size(); ++position)
+    {
+        const auto & labelArea = labelAreas[position];
+        const auto offset = labelArea.origin - label.pointLocation;
+        const auto tolerance = 1e-4f * glm::max(labelArea.extent.x, labelArea.extent.y);
+        if (std::abs(offset.x - placement.offset.x) <= tolerance && std::abs(offset.y - placement.offset.y) <= tolerance)
+            return static_cast<int>(position);
+    }
+    return -1;
+}
+
+}
+
+AnnealingSchedule::AnnealingSchedule()
+: m_steps(0)
+{
+    restart();
+}
+
+void AnnealingSchedule::restart()
+{
+    m_temperature = 0.91023922662f;
+    m_temperatureChanges = 0;
+    m_changesAtTemperature = 0;
+    m_stepsAtTemperature = 0;
+}
+
+float AnnealingSchedule::temperature() const
+{
+    return m_temperature;
+}
+
+unsigned long long AnnealingSchedule::steps() const
+{
+    return m_steps;
+}
+
+AnnealingState::AnnealingState(const std::vector<Label> & labels, bool allowSelection, const glm::vec2 & relativePadding, const ObstacleIndex * obstacles)
+: m_allowSelection(allowSelection)
+, m_hysteresis(0.f)
+{
+    initialize(labels, relativePadding, obstacles);
+
+    m_activeLabels.resize(labels.size());
+    std::iota(m_activeLabels.begin(), m_activeLabels.end(), 0);
+
+    m_collisionGraph = createCollisionGraph(m_labelAreas, relativePadding);
+}
+
+AnnealingState::AnnealingState(const std::vector<Label> & labels, const std::vector<LabelPlacement> & previousPlacements, bool allowSelection, const glm::vec2 & relativePadding, float hysteresis, const ObstacleIndex * obstacles)
+: m_allowSelection(allowSelection)
+, m_hysteresis(hysteresis)
+{
+    initialize(labels, relativePadding, obstacles);
+
+    const auto & positions = cornerPositions();
+    std::vector<bool> active(labels.size(), false);
+    m_previousLabels.assign(labels.size(), noAnchor);
+
+    // start from the previous placements; labels without a matching candidate have to be re-optimized
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        const auto previous = i < previousPlacements.size()
+            ? matchingPlacement(labels[i], previousPlacements[i], m_labelAreas[i]) : -1;
+        const auto hidden = previous == static_cast<int>(m_labelAreas[i].size());
+        if (previous < 0 || (hidden && !allowSelection))
+        {
+            // anchored at the corner of a previously displayed label, new and hidden labels are free
+            active[i] = true;
+            if (i < previousPlacements.size() && previousPlacements[i].display)
+            {
+                const auto position = relativeLabelPosition(previousPlacements[i].offset, m_labelAreas[i].front().extent);
+                m_chosenLabels[i] = std::find(positions.begin(), positions.end(), position) - positions.begin();
+                m_previousLabels[i] = m_chosenLabels[i];
+            }
+            continue;
+        }
+        m_chosenLabels[i] = previous;
+        m_previousLabels[i] = previous;
+
+        // hidden labels are tested again, as space may have become free
+        if (hidden)
+            active[i] = true;
+    }
+
+    // labels colliding in the previous placement (with other labels or obstacles) have to be re-optimized as well
+    std::vector<size_t> visibleLabels;
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        if (m_chosenLabels[i] == m_labelAreas[i].size())
+            continue;
+        visibleLabels.push_back(i);
+        if (m_obstacleOverlaps[i][m_chosenLabels[i]].overlapCount > 0)
+            active[i] = true;
+    }
+    const auto chosenLabel = [&](size_t i) -> const LabelArea & { return m_labelAreas[i][m_chosenLabels[i]]; };
+    const auto lowerX = [&](size_t i) { return chosenLabel(i).origin.x - chosenLabel(i).extent.x * relativePadding.x; };
+    std::sort(visibleLabels.begin(), visibleLabels.end(), [&](size_t a, size_t b) { return lowerX(a) < lowerX(b); });
+    for (size_t a = 0; a < visibleLabels.size(); ++a)
+    {
+        const auto & area = chosenLabel(visibleLabels[a]);
+        const auto upperX = area.origin.x + area.extent.x * (relativePadding.x + 1.f);
+        for (size_t b = a + 1; b < visibleLabels.size() && lowerX(visibleLabels[b]) < upperX; ++b)
+        {
+            if (!area.paddedOverlaps(chosenLabel(visibleLabels[b]), relativePadding))
+                continue;
+            active[visibleLabels[a]] = true;
+            active[visibleLabels[b]] = true;
+        }
+    }
+
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        if (active[i])
+            m_activeLabels.push_back(i);
+    }
+
+    m_collisionGraph = createCollisionGraph(m_labelAreas, m_activeLabels, relativePadding);
+}
+
+void AnnealingState::initialize(const std::vector<Label> & labels, const glm::vec2 & relativePadding, const ObstacleIndex * obstacles)
+{
+    m_labelAreas = computeLabelAreas(labels, cornerPositions());
+    m_obstacleOverlaps = computeObstacleOverlaps(m_labelAreas, obstacles, relativePadding);
+
+    m_priorities.reserve(labels.size());
+    for (const auto & label : labels)
+        m_priorities.push_back(label.priority);
+
+    // random start positions
+    std::default_random_engine generator;
+    m_chosenLabels.reserve(labels.size());
+    for (const auto & singleLabelAreas : m_labelAreas)
+    {
+        std::uniform_int_distribution<int> distribution(0, singleLabelAreas.size() - 1);
+        m_chosenLabels.push_back(distribution(generator));
+    }
+
+    m_bestPenalty = std::numeric_limits<float>::max();
+    m_converged = labels.empty();
+}
+
+void AnnealingState::keepIfBest(float penalty)
+{
+    // the annealing accepts worse placements, so the best one is tracked at every temperature change
+    if (penalty > m_bestPenalty)
+        return;
+
+    m_bestPenalty = penalty;
+    m_bestLabels = m_chosenLabels;
+}
+
+bool AnnealingState::converged() const
+{
+    return m_converged;
+}
+
+void AnnealingState::apply(std::vector<Label> & labels) const
+{
+    assert(labels.size() == m_labelAreas.size());
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        const auto visible = m_bestLabels[i] != m_labelAreas[i].size();
+        const auto position = visible ? (m_labelAreas[i][m_bestLabels[i]].origin - labels[i].pointLocation) : glm::vec2(0.f);
+        labels[i].placement = {position, Alignment::LeftAligned, LineAnchor::Bottom, visible};
+    }
+}
+
+float AnnealingState::penalty() const
+{
+    return m_bestPenalty;
+}
+
+unsigned long long AnnealingState::steps() const
+{
+    return m_schedule.steps();
+}
+
+const std::vector<size_t> & AnnealingState::activeLabels() const
+{
+    return m_activeLabels;
+}
+
+AnnealingSolver::AnnealingSolver(const std::vector<Label> & labels, PenaltyFunction penaltyFunction, bool allowSelection, const glm::vec2 & relativePadding, const ObstacleIndex * obstacles)
+: AnnealingState(labels, allowSelection, relativePadding, obstacles)
+, m_penaltyFunction(penaltyFunction)
+{
+    checkpoint();
+}
+
+AnnealingSolver::AnnealingSolver(const std::vector<Label> & labels, const std::vector<LabelPlacement> & previousPlacements, PenaltyFunction penaltyFunction, bool allowSelection, const glm::vec2 & relativePadding, float hysteresis, const ObstacleIndex * obstacles)
+: AnnealingState(labels, previousPlacements, allowSelection, relativePadding, hysteresis, obstacles)
+, m_penaltyFunction(penaltyFunction)
+{
+    checkpoint();
+}
+
+bool AnnealingSolver::run(const LayoutBudget & budget)
+{
+    LayoutDeadline deadline(budget);
+    return run(deadline);
+}
+
+bool AnnealingSolver::run(LayoutDeadline & deadline)
+{
+    if (m_converged || m_activeLabels.empty())
+        return true;
+
+    OPENLL_TRACE_ZONE("layout::AnnealingSolver::run");
+    while (deadline.iterate())
+    {
+        if (step())
+        {
+            m_converged = true;
+            break;
+        }
+    }
+
+    checkpoint();
+    OPENLL_TRACE_COUNTER("annealing steps", m_schedule.steps());
+    return m_converged;
+}
+
+bool AnnealingSolver::step()
+{
+    std::uniform_int_distribution<size_t> labelDistribution(0, m_activeLabels.size() - 1);
+
+    const auto labelIndex = m_activeLabels[labelDistribution(m_generator)];
+    const auto oldPosition = m_chosenLabels[labelIndex];
+    const auto newPosition = randomIndexExcept<unsigned int>(oldPosition, m_labelAreas[labelIndex].size() + (m_allowSelection ? 1 : 0), m_generator);
+
+    const auto oldPenalty = labelPenalty(labelIndex, oldPosition);
+    const auto newPenalty = labelPenalty(labelIndex, newPosition);
+    const auto improvement = oldPenalty - newPenalty;
+
+    float chance = std::exp(improvement / m_schedule.temperature());
+    std::bernoulli_distribution doAnyway(chance);
+    const auto accept = improvement > 0 || doAnyway(m_generator);
+    if (accept)
+    {
+        m_chosenLabels[labelIndex] = newPosition;
+    }
+
+    return advanceSchedule(accept, [this]() { checkpoint(); });
+}
+
+float AnnealingSolver::labelPenalty(size_t labelIndex, unsigned int position) const
+{
+    const auto priority = m_priorities[labelIndex];
+    const auto hysteresisPenalty = this->hysteresisPenalty(labelIndex, position);
+    if (position == m_labelAreas[labelIndex].size())
+        return m_penaltyFunction(0, 0.f, RelativeLabelPosition::Hidden, priority) + hysteresisPenalty;
+
+    const auto & obstacleOverlap = m_obstacleOverlaps[labelIndex][position];
+    auto overlapArea = obstacleOverlap.overlapArea;
+    auto overlapCount = obstacleOverlap.overlapCount;
+    for (const auto & collision : m_collisionGraph[labelIndex][position])
+    {
+        if (m_chosenLabels[collision.index] != collision.position)
+            continue;
+        overlapArea += collision.overlapArea;
+        ++overlapCount;
+    }
+    overlapArea /= m_labelAreas[labelIndex][position].area();
+    return m_penaltyFunction(overlapCount, overlapArea, cornerPositions()[position], priority) + hysteresisPenalty;
+}
+
+float AnnealingSolver::totalPenalty() const
+{
+    auto penalty = 0.f;
+    for (const auto labelIndex : m_activeLabels)
+        penalty += labelPenalty(labelIndex, m_chosenLabels[labelIndex]);
+    return penalty;
+}
+
+void AnnealingSolver::checkpoint()
+{
+    keepIfBest(totalPenalty());
+}
+
+}
+
+}
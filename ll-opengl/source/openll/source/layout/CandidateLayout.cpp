@@ -0,0 +1,233 @@
+#include <openll/layout/CandidateLayout.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <openll/Trace.h>
+#include <openll/layout/layoutbase.h>
+#include <openll/layout/CollisionGraph.h>
+#include <openll/layout/LabelArea.h>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+namespace
+{
+
+// a label may change its position this often within a single run, bounds oscillations of asymmetric penalties
+const unsigned int maxChangesPerRun = 8;
+
+// changes smaller than this are no improvement, prevents cycling between equally good positions
+const float minimalImprovement = 1e-5f;
+
+}
+
+CandidateLayout::CandidateLayout(const std::vector<Label> & labels, const std::vector<CandidatePosition> & positions, PenaltyFunction penaltyFunction, bool allowSelection, const glm::vec2 & relativePadding, float displacementPenalty, const ObstacleIndex * obstacles)
+: m_positions(positions)
+, m_penaltyFunction(penaltyFunction)
+, m_allowSelection(allowSelection)
+, m_displacementPenalty(displacementPenalty)
+, m_candidates(relativePadding)
+, m_chosenPositions(labels.size(), static_cast<unsigned int>(positions.size()))
+, m_overlapAreas(labels.size() * positions.size(), 0.f)
+, m_overlapCounts(labels.size() * positions.size(), 0)
+, m_dirty(labels.size(), false)
+, m_changes(labels.size(), 0)
+{
+    m_pointLocations.reserve(labels.size());
+    m_extents.reserve(labels.size());
+    m_priorities.reserve(labels.size());
+    for (const auto & label : labels)
+    {
+        m_pointLocations.push_back(label.pointLocation);
+        m_extents.push_back(label.sequence.extent());
+        m_priorities.push_back(label.priority);
+    }
+
+    {
+        const auto labelAreas = computeCandidateAreas(labels, positions);
+        m_neighbourGraph = createNeighbourGraph(labelAreas, relativePadding);
+        const auto obstacleOverlaps = computeObstacleOverlaps(labelAreas, obstacles, relativePadding);
+        m_candidates.reserve(labels.size() * positions.size());
+        for (size_t labelIndex = 0; labelIndex < labelAreas.size(); ++labelIndex)
+        {
+            for (unsigned int position = 0; position < positions.size(); ++position)
+            {
+                m_candidates.push_back(labelAreas[labelIndex][position]);
+                const auto index = candidateIndex(labelIndex, position);
+                m_overlapAreas[index] = obstacleOverlaps[labelIndex][position].overlapArea;
+                m_overlapCounts[index] = obstacleOverlaps[labelIndex][position].overlapCount;
+            }
+        }
+    }
+
+    // start with all labels hidden, then place them in order of descending priority
+    std::vector<size_t> order(labels.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return m_priorities[a] > m_priorities[b]; });
+    for (const auto labelIndex : order)
+        choose(labelIndex, bestPosition(labelIndex));
+
+    // labels placed early may improve by reacting to the ones placed later
+    for (const auto labelIndex : order)
+        markDirty(labelIndex);
+}
+
+bool CandidateLayout::run(const LayoutBudget & budget)
+{
+    LayoutDeadline deadline(budget);
+    return run(deadline);
+}
+
+bool CandidateLayout::run(LayoutDeadline & deadline)
+{
+    OPENLL_TRACE_ZONE("layout::CandidateLayout::run");
+    std::vector<size_t> changedLabels;
+    std::vector<size_t> deferredLabels;
+
+    while (!m_dirtyLabels.empty() && deadline.iterate())
+    {
+        const auto labelIndex = m_dirtyLabels.back();
+        m_dirtyLabels.pop_back();
+        m_dirty[labelIndex] = false;
+        if (m_changes[labelIndex] >= maxChangesPerRun)
+        {
+            deferredLabels.push_back(labelIndex);
+            continue;
+        }
+
+        const auto oldPosition = m_chosenPositions[labelIndex];
+        const auto newPosition = bestPosition(labelIndex);
+        if (newPosition == oldPosition || penalty(labelIndex, oldPosition) - penalty(labelIndex, newPosition) < minimalImprovement)
+            continue;
+
+        choose(labelIndex, newPosition);
+        if (m_changes[labelIndex]++ == 0)
+            changedLabels.push_back(labelIndex);
+    }
+
+    for (const auto labelIndex : changedLabels)
+        m_changes[labelIndex] = 0;
+    for (const auto labelIndex : deferredLabels)
+        markDirty(labelIndex);
+
+    return m_dirtyLabels.empty();
+}
+
+void CandidateLayout::apply(std::vector<Label> & labels) const
+{
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        const auto position = m_chosenPositions[i];
+        if (position == m_positions.size())
+        {
+            labels[i].placement = {{0.f, 0.f}, Alignment::LeftAligned, LineAnchor::Bottom, false};
+            continue;
+        }
+        const auto offset = candidateOrigin(m_positions[position], m_pointLocations[i], m_extents[i]) - m_pointLocations[i];
+        labels[i].placement = {offset, Alignment::LeftAligned, LineAnchor::Bottom, true};
+    }
+}
+
+unsigned int CandidateLayout::chosenPosition(size_t labelIndex) const
+{
+    return m_chosenPositions[labelIndex];
+}
+
+float CandidateLayout::penalty(size_t labelIndex, unsigned int position) const
+{
+    const auto priority = m_priorities[labelIndex];
+    if (position == m_positions.size())
+        return m_penaltyFunction(0, 0.f, RelativeLabelPosition::Hidden, priority);
+
+    const auto & candidate = m_positions[position];
+    const auto index = candidateIndex(labelIndex, position);
+    const auto area = m_extents[labelIndex].x * m_extents[labelIndex].y;
+    const auto overlapArea = area > 0.f ? m_overlapAreas[index] / area : 0.f;
+    return m_penaltyFunction(m_overlapCounts[index], overlapArea, candidate.corner, priority)
+        + m_displacementPenalty * candidate.displacement;
+}
+
+float CandidateLayout::totalPenalty() const
+{
+    auto result = 0.f;
+    for (size_t i = 0; i < m_chosenPositions.size(); ++i)
+        result += penalty(i, m_chosenPositions[i]);
+    return result;
+}
+
+size_t CandidateLayout::neighbourCount() const
+{
+    size_t result = 0;
+    for (const auto & neighbours : m_neighbourGraph)
+        result += neighbours.size();
+    return result / 2;
+}
+
+void CandidateLayout::choose(size_t labelIndex, unsigned int position)
+{
+    addOverlaps(labelIndex, m_chosenPositions[labelIndex], -1);
+    m_chosenPositions[labelIndex] = position;
+    addOverlaps(labelIndex, position, 1);
+}
+
+void CandidateLayout::addOverlaps(size_t labelIndex, unsigned int position, int sign)
+{
+    if (position == m_positions.size())
+        return;
+
+    const LabelArea area {candidateOrigin(m_positions[position], m_pointLocations[labelIndex], m_extents[labelIndex]), m_extents[labelIndex]};
+    for (const auto neighbour : m_neighbourGraph[labelIndex])
+    {
+        auto changed = false;
+        m_candidates.forEachOverlap(area, [&](size_t index, float overlapArea)
+        {
+            auto & count = m_overlapCounts[index];
+            count += sign;
+            // reset instead of subtracting, so that rounding errors do not accumulate
+            m_overlapAreas[index] = count == 0 ? 0.f : m_overlapAreas[index] + sign * overlapArea;
+            changed = true;
+        }, candidateIndex(neighbour, 0), candidateIndex(neighbour + 1, 0));
+
+        if (changed)
+            markDirty(neighbour);
+    }
+}
+
+unsigned int CandidateLayout::bestPosition(size_t labelIndex) const
+{
+    auto best = static_cast<unsigned int>(m_positions.size());
+    auto bestPenalty = m_allowSelection ? penalty(labelIndex, best) : std::numeric_limits<float>::max();
+    for (unsigned int position = 0; position < m_positions.size(); ++position)
+    {
+        const auto positionPenalty = penalty(labelIndex, position);
+        if (positionPenalty < bestPenalty)
+        {
+            bestPenalty = positionPenalty;
+            best = position;
+        }
+    }
+    return best;
+}
+
+size_t CandidateLayout::candidateIndex(size_t labelIndex, unsigned int position) const
+{
+    return labelIndex * m_positions.size() + position;
+}
+
+void CandidateLayout::markDirty(size_t labelIndex)
+{
+    if (m_dirty[labelIndex])
+        return;
+    m_dirty[labelIndex] = true;
+    m_dirtyLabels.push_back(labelIndex);
+}
+
+}
+
+}
@@ -0,0 +1,73 @@
+#include <openll/layout/CandidatePosition.h>
+
+#include <algorithm>
+
+#include <openll/GlyphSequence.h>
+#include <openll/layout/layoutbase.h>
+#include <openll/layout/LabelArea.h>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+namespace
+{
+
+CandidatePosition candidate(const glm::vec2 & anchor, float displacement)
+{
+    return {anchor, relativeLabelPosition(-anchor, glm::vec2(1.f)), displacement};
+}
+
+// the candidates at t on the four sides, t = 0 is at the corner preceding the side in the order of cornerPositions
+void addSideCandidates(float t, std::vector<CandidatePosition> & positions)
+{
+    const auto displacement = std::min(t, 1.f - t);
+    positions.push_back(candidate({t, 0.f}, displacement));
+    positions.push_back(candidate({1.f, t}, displacement));
+    positions.push_back(candidate({1.f - t, 1.f}, displacement));
+    positions.push_back(candidate({0.f, 1.f - t}, displacement));
+}
+
+}
+
+std::vector<CandidatePosition> candidatePositions(unsigned int slidingPositions)
+{
+    std::vector<CandidatePosition> positions;
+    positions.reserve(8 + 8 * slidingPositions);
+    addSideCandidates(0.f, positions);
+    addSideCandidates(0.5f, positions);
+    for (unsigned int i = 1; i <= slidingPositions; ++i)
+    {
+        const auto t = 0.5f * i / (slidingPositions + 1);
+        addSideCandidates(t, positions);
+        addSideCandidates(1.f - t, positions);
+    }
+    return positions;
+}
+
+glm::vec2 candidateOrigin(const CandidatePosition & position, const glm::vec2 & origin, const glm::vec2 & extent)
+{
+    return origin - position.anchor * extent;
+}
+
+std::vector<std::vector<LabelArea>> computeCandidateAreas(const std::vector<Label> & labels, const std::vector<CandidatePosition> & positions)
+{
+    std::vector<std::vector<LabelArea>> result;
+    result.reserve(labels.size());
+    for (const auto & label : labels)
+    {
+        result.push_back({});
+        result.back().reserve(positions.size());
+        const auto & extent = label.sequence.extent();
+        for (const auto & position : positions)
+            result.back().push_back({candidateOrigin(position, label.pointLocation, extent), extent});
+    }
+    return result;
+}
+
+}
+
+}
@@ -0,0 +1,169 @@
+#include <openll/layout/CoherentAnnealing.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <openll/Trace.h>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+const unsigned int CoherentAnnealing::noAnchor;
+
+CoherentAnnealing::CoherentAnnealing(PenaltyFunction penaltyFunction, bool allowSelection, const glm::vec2 & relativePadding, float hysteresis, float cellSize, const ObstacleIndex * obstacles)
+: LayoutEngine(penaltyFunction, allowSelection, relativePadding, cellSize, obstacles)
+, m_hysteresis(hysteresis)
+, m_bestPenalty(std::numeric_limits<float>::max())
+{
+}
+
+CoherentAnnealing::LabelId CoherentAnnealing::insert(const Label & label)
+{
+    const auto id = LayoutEngine::insert(label);
+    if (id >= m_active.size())
+    {
+        m_active.resize(id + 1, false);
+        m_previousPositions.resize(id + 1, noAnchor);
+        m_bestPositions.resize(id + 1, 0);
+    }
+
+    // a reused id belongs to a new label without a previous placement
+    m_previousPositions[id] = noAnchor;
+    m_bestPositions[id] = m_chosenPositions[id];
+    return id;
+}
+
+bool CoherentAnnealing::layout(const LayoutBudget & budget)
+{
+    OPENLL_TRACE_ZONE("layout::CoherentAnnealing::layout");
+    LayoutDeadline deadline(budget);
+
+    const auto erased = std::any_of(m_activeLabels.begin(), m_activeLabels.end(), [this](LabelId id) { return !m_used[id]; });
+    if (erased || !m_dirtyLabels.empty())
+        startRound();
+    if (m_activeLabels.empty())
+        return true;
+
+    auto converged = false;
+    while (deadline.iterate())
+    {
+        if (step())
+        {
+            converged = true;
+            break;
+        }
+    }
+    checkpoint();
+    OPENLL_TRACE_COUNTER("annealing steps", m_schedule.steps());
+
+    // the annealing continues from its current placement, the labels show the best one
+    for (const auto id : m_activeLabels)
+        applyPosition(id, m_bestPositions[id]);
+    if (!converged)
+        return false;
+
+    for (const auto id : m_activeLabels)
+    {
+        m_chosenPositions[id] = m_bestPositions[id];
+        m_previousPositions[id] = m_bestPositions[id];
+        m_active[id] = false;
+    }
+    m_activeLabels.clear();
+    return true;
+}
+
+const std::vector<CoherentAnnealing::LabelId> & CoherentAnnealing::activeLabels() const
+{
+    return m_activeLabels;
+}
+
+unsigned long long CoherentAnnealing::steps() const
+{
+    return m_schedule.steps();
+}
+
+void CoherentAnnealing::startRound()
+{
+    // labels of an unfinished round continue from their best placement and keep their anchor
+    auto end = std::remove_if(m_activeLabels.begin(), m_activeLabels.end(), [this](LabelId id)
+    {
+        if (m_used[id])
+            return false;
+        m_active[id] = false;
+        return true;
+    });
+    m_activeLabels.erase(end, m_activeLabels.end());
+    for (const auto id : m_activeLabels)
+        m_chosenPositions[id] = m_bestPositions[id];
+
+    for (const auto id : m_dirtyLabels)
+    {
+        m_dirty[id] = false;
+        if (!m_used[id] || m_active[id])
+            continue;
+        m_active[id] = true;
+        m_activeLabels.push_back(id);
+    }
+    m_dirtyLabels.clear();
+
+    m_schedule.restart();
+    m_bestPenalty = std::numeric_limits<float>::max();
+    checkpoint();
+}
+
+bool CoherentAnnealing::step()
+{
+    std::uniform_int_distribution<size_t> labelDistribution(0, m_activeLabels.size() - 1);
+
+    const auto id = m_activeLabels[labelDistribution(m_generator)];
+    const auto oldPosition = m_chosenPositions[id];
+    const auto positionCount = static_cast<unsigned int>(m_labelAreas[id].size() + (m_allowSelection ? 1 : 0));
+
+    auto accept = false;
+    if (positionCount > 1)
+    {
+        // uniform over all positions except the current one
+        std::uniform_int_distribution<unsigned int> positionDistribution(0, positionCount - 2);
+        auto newPosition = positionDistribution(m_generator);
+        if (newPosition >= oldPosition)
+            ++newPosition;
+
+        const auto improvement = annealingPenalty(id, oldPosition) - annealingPenalty(id, newPosition);
+        std::bernoulli_distribution doAnyway(improvement > 0.f ? 1.0 : std::exp(improvement / m_schedule.temperature()));
+        accept = improvement > 0.f || doAnyway(m_generator);
+        if (accept)
+            m_chosenPositions[id] = newPosition;
+    }
+
+    return m_schedule.advance(accept, m_activeLabels.size(), [this]() { checkpoint(); });
+}
+
+float CoherentAnnealing::annealingPenalty(LabelId id, unsigned int position) const
+{
+    const auto previous = m_previousPositions[id];
+    const auto hysteresisPenalty = previous != noAnchor && previous != position ? m_hysteresis : 0.f;
+    return labelPenalty(id, position) + hysteresisPenalty;
+}
+
+void CoherentAnnealing::checkpoint()
+{
+    // the annealing accepts worse placements, so the best one is tracked at every temperature change
+    auto penalty = 0.f;
+    for (const auto id : m_activeLabels)
+        penalty += annealingPenalty(id, m_chosenPositions[id]);
+    if (penalty > m_bestPenalty)
+        return;
+
+    m_bestPenalty = penalty;
+    for (const auto id : m_activeLabels)
+        m_bestPositions[id] = m_chosenPositions[id];
+}
+
+}
+
+}
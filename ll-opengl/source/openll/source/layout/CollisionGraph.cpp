@@ -0,0 +1,245 @@
+#include <openll/layout/CollisionGraph.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include <glm/common.hpp>
+
+#include <openll/GlyphSequence.h>
+#include <openll/Trace.h>
+#include <openll/layout/layoutbase.h>
+#include <openll/layout/LabelArea.h>
+#include <openll/layout/LabelAreaBlock.h>
+#include <openll/layout/ObstacleIndex.h>
+#include <openll/layout/UniformGrid.h>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+namespace
+{
+
+// labels whose bounding boxes are larger than this many cells in either dimension are kept out of the grid
+const float oversizedCells = 4.f;
+
+float span(const std::pair<glm::vec2, glm::vec2> & bound)
+{
+    return std::max(bound.second.x - bound.first.x, bound.second.y - bound.first.y);
+}
+
+bool overlaps(const std::pair<glm::vec2, glm::vec2> & first, const std::pair<glm::vec2, glm::vec2> & second)
+{
+    return first.first.x <= second.second.x && first.second.x >= second.first.x
+        && first.first.y <= second.second.y && first.second.y >= second.first.y;
+}
+
+// all label areas in a single block with the first area of each label, and a grid over the
+// padded bounding boxes of the labels, so that only the candidates of nearby labels are tested;
+// the cells are sized by the median label and oversized labels are tested linearly instead,
+// so that single long labels do not coarsen the grid
+struct FlatLabelAreas
+{
+    FlatLabelAreas(const std::vector<std::vector<LabelArea>> & labelAreas, const glm::vec2 & relativePadding)
+    : block(relativePadding)
+    , indexed(false)
+    {
+        auto spans = std::vector<float>();
+        spans.reserve(labelAreas.size());
+        firstArea.reserve(labelAreas.size() + 1);
+        bounds.reserve(labelAreas.size());
+        for (const auto & singleLabelAreas : labelAreas)
+        {
+            firstArea.push_back(block.size());
+            auto lowerLeft = glm::vec2(std::numeric_limits<float>::max());
+            auto upperRight = glm::vec2(std::numeric_limits<float>::lowest());
+            for (const auto & area : singleLabelAreas)
+            {
+                block.push_back(area);
+                lowerLeft = glm::min(lowerLeft, area.origin - area.extent * relativePadding);
+                upperRight = glm::max(upperRight, area.origin + area.extent * (relativePadding + 1.f));
+            }
+            bounds.push_back({lowerLeft, upperRight});
+            if (!singleLabelAreas.empty() && span(bounds.back()) > 0.f)
+                spans.push_back(span(bounds.back()));
+        }
+        firstArea.push_back(block.size());
+
+        if (spans.empty())
+            return;
+        const auto median = spans.begin() + spans.size() / 2;
+        std::nth_element(spans.begin(), median, spans.end());
+        grid.reset(*median);
+        indexed = true;
+        for (size_t labelIndex = 0; labelIndex < labelAreas.size(); ++labelIndex)
+        {
+            if (labelAreas[labelIndex].empty())
+                continue;
+            if (oversized(labelIndex))
+                oversizedLabels.push_back(static_cast<std::uint32_t>(labelIndex));
+            else
+                grid.insert(bounds[labelIndex].first, bounds[labelIndex].second, static_cast<std::uint32_t>(labelIndex));
+        }
+    }
+
+    bool oversized(size_t labelIndex) const
+    {
+        return span(bounds[labelIndex]) > oversizedCells * grid.cellSize();
+    }
+
+    // the other labels whose bounding boxes overlap the one of labelIndex, in ascending order
+    void neighbours(size_t labelIndex, std::vector<std::uint32_t> & result) const
+    {
+        result.clear();
+        if (!indexed || firstArea[labelIndex] == firstArea[labelIndex + 1])
+            return;
+
+        const auto & bound = bounds[labelIndex];
+        const auto add = [&](std::uint32_t other)
+        {
+            if (other != labelIndex && overlaps(bound, bounds[other]))
+                result.push_back(other);
+        };
+
+        if (oversized(labelIndex))
+        {
+            // would visit more cells than there are labels nearby
+            for (size_t other = 0; other < bounds.size(); ++other)
+            {
+                if (firstArea[other] != firstArea[other + 1])
+                    add(static_cast<std::uint32_t>(other));
+            }
+            return;
+        }
+
+        grid.forEach(bound.first, bound.second, [&](const glm::ivec2 &, std::uint32_t other) { add(other); });
+        for (const auto other : oversizedLabels)
+            add(other);
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+    }
+
+    LabelAreaBlock block;
+    std::vector<size_t> firstArea;
+    std::vector<std::pair<glm::vec2, glm::vec2>> bounds;
+    UniformGrid<std::uint32_t> grid;
+    std::vector<std::uint32_t> oversizedLabels;
+    // false if all labels have zero extent
+    bool indexed;
+};
+
+// collect the collisions of all possible placements of a single label
+void addCollisions(const std::vector<std::vector<LabelArea>>& labelAreas, const FlatLabelAreas & flatLabelAreas, size_t labelIndex, CollisionGraph & collisionGraph, std::vector<std::uint32_t> & neighbours)
+{
+    flatLabelAreas.neighbours(labelIndex, neighbours);
+
+    auto & collisionElements = collisionGraph[labelIndex];
+    collisionElements.resize(labelAreas[labelIndex].size());
+    for (size_t position = 0; position < labelAreas[labelIndex].size(); ++position)
+    {
+        auto & collisions = collisionElements[position];
+        for (const auto other : neighbours)
+        {
+            const auto first = flatLabelAreas.firstArea[other];
+            flatLabelAreas.block.forEachOverlap(labelAreas[labelIndex][position], [&](size_t flatIndex, float overlapArea)
+            {
+                collisions.push_back({other, flatIndex - first, overlapArea});
+            }, first, flatLabelAreas.firstArea[other + 1]);
+        }
+    }
+}
+
+}
+
+const std::vector<RelativeLabelPosition> & cornerPositions()
+{
+    static const std::vector<RelativeLabelPosition> positions {
+        RelativeLabelPosition::UpperRight, RelativeLabelPosition::UpperLeft,
+        RelativeLabelPosition::LowerLeft, RelativeLabelPosition::LowerRight
+    };
+    return positions;
+}
+
+CollisionGraph createCollisionGraph(const std::vector<std::vector<LabelArea>>& labelAreas, const glm::vec2 & relativePadding)
+{
+    OPENLL_TRACE_ZONE("layout::createCollisionGraph");
+    const FlatLabelAreas flatLabelAreas(labelAreas, relativePadding);
+    CollisionGraph collisionGraph;
+    collisionGraph.resize(labelAreas.size());
+    std::vector<std::uint32_t> neighbours;
+    for (size_t i = 0; i < labelAreas.size(); ++i)
+    {
+        addCollisions(labelAreas, flatLabelAreas, i, collisionGraph, neighbours);
+    }
+    return collisionGraph;
+}
+
+CollisionGraph createCollisionGraph(const std::vector<std::vector<LabelArea>>& labelAreas, const std::vector<size_t> & labelIndices, const glm::vec2 & relativePadding)
+{
+    OPENLL_TRACE_ZONE("layout::createCollisionGraph");
+    const FlatLabelAreas flatLabelAreas(labelAreas, relativePadding);
+    CollisionGraph collisionGraph;
+    collisionGraph.resize(labelAreas.size());
+    std::vector<std::uint32_t> neighbours;
+    for (const auto i : labelIndices)
+    {
+        addCollisions(labelAreas, flatLabelAreas, i, collisionGraph, neighbours);
+    }
+    return collisionGraph;
+}
+
+std::vector<std::vector<ObstacleOverlap>> computeObstacleOverlaps(const std::vector<std::vector<LabelArea>> & labelAreas, const ObstacleIndex * obstacles, const glm::vec2 & relativePadding)
+{
+    std::vector<std::vector<ObstacleOverlap>> result(labelAreas.size());
+    for (size_t labelIndex = 0; labelIndex < labelAreas.size(); ++labelIndex)
+    {
+        auto & overlaps = result[labelIndex];
+        overlaps.resize(labelAreas[labelIndex].size(), {0.f, 0});
+        if (!obstacles)
+            continue;
+        for (size_t position = 0; position < overlaps.size(); ++position)
+        {
+            auto & overlap = overlaps[position];
+            overlap.overlapArea = obstacles->overlapArea(labelAreas[labelIndex][position], relativePadding, overlap.overlapCount, labelIndex);
+        }
+    }
+    return result;
+}
+
+std::vector<std::vector<size_t>> createNeighbourGraph(const std::vector<std::vector<LabelArea>> & labelAreas, const glm::vec2 & relativePadding)
+{
+    OPENLL_TRACE_ZONE("layout::createNeighbourGraph");
+    const FlatLabelAreas flatLabelAreas(labelAreas, relativePadding);
+    std::vector<std::vector<size_t>> neighbourGraph(labelAreas.size());
+    std::vector<std::uint32_t> neighbours;
+    for (size_t i = 0; i < labelAreas.size(); ++i)
+    {
+        flatLabelAreas.neighbours(i, neighbours);
+        neighbourGraph[i].assign(neighbours.begin(), neighbours.end());
+    }
+    return neighbourGraph;
+}
+
+std::vector<std::vector<LabelArea>> computeLabelAreas(const std::vector<Label> & labels, const std::vector<RelativeLabelPosition>& positions)
+{
+    std::vector<std::vector<LabelArea>> result;
+    for (const auto & label : labels)
+    {
+        result.push_back({});
+        const auto & extent = label.sequence.extent();
+        for (const auto& position : positions)
+        {
+            const auto origin = labelOrigin(position, label.pointLocation, extent);
+            result.back().push_back({origin, extent});
+        }
+    }
+    return result;
+}
+
+} // namespace layout
+
+} // namespace gloperate_text
@@ -0,0 +1,160 @@
+#include <openll/layout/LabelAreaBlock.h>
+
+#include <algorithm>
+
+#include <openll/layout/LabelArea.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define OPENLL_LABELAREABLOCK_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OPENLL_LABELAREABLOCK_SSE
+#endif
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+const size_t LabelAreaBlock::batchSize;
+
+LabelAreaBlock::LabelAreaBlock(const glm::vec2 & relativePadding)
+: m_relativePadding(relativePadding)
+{
+}
+
+void LabelAreaBlock::reserve(size_t size)
+{
+    m_x0.reserve(size);
+    m_y0.reserve(size);
+    m_x1.reserve(size);
+    m_y1.reserve(size);
+}
+
+void LabelAreaBlock::clear()
+{
+    m_x0.clear();
+    m_y0.clear();
+    m_x1.clear();
+    m_y1.clear();
+}
+
+void LabelAreaBlock::push_back(const LabelArea & area)
+{
+    const auto padded = corners(area);
+    m_x0.push_back(padded.x0);
+    m_y0.push_back(padded.y0);
+    m_x1.push_back(padded.x1);
+    m_y1.push_back(padded.y1);
+}
+
+size_t LabelAreaBlock::size() const
+{
+    return m_x0.size();
+}
+
+const glm::vec2 & LabelAreaBlock::relativePadding() const
+{
+    return m_relativePadding;
+}
+
+std::uint64_t LabelAreaBlock::overlaps(const LabelArea & area, size_t first, float * overlapAreas) const
+{
+    if (first >= size())
+        return 0;
+    return overlaps(corners(area), first, std::min(size() - first, static_cast<size_t>(batchSize)), overlapAreas);
+}
+
+float LabelAreaBlock::overlapArea(const LabelArea & area, int & overlapCount, size_t first) const
+{
+    float result = 0.f;
+    overlapCount = 0;
+    forEachOverlap(area, [&](size_t, float overlapArea)
+    {
+        result += overlapArea;
+        ++overlapCount;
+    }, first);
+    return result;
+}
+
+LabelAreaBlock::Corners LabelAreaBlock::corners(const LabelArea & area) const
+{
+    // same computation as in LabelArea::paddedOverlaps, so the results match exactly
+    const auto lowerLeft = area.origin - area.extent * m_relativePadding;
+    const auto upperRight = area.origin + area.extent * (m_relativePadding + 1.f);
+    return {lowerLeft.x, lowerLeft.y, upperRight.x, upperRight.y};
+}
+
+std::uint64_t LabelAreaBlock::overlaps(const Corners & a, size_t first, size_t count, float * overlapAreas) const
+{
+    const auto x0 = m_x0.data() + first;
+    const auto y0 = m_y0.data() + first;
+    const auto x1 = m_x1.data() + first;
+    const auto y1 = m_y1.data() + first;
+
+    std::uint64_t mask = 0;
+    size_t i = 0;
+
+#if defined(OPENLL_LABELAREABLOCK_AVX)
+    const auto ax0 = _mm256_set1_ps(a.x0);
+    const auto ay0 = _mm256_set1_ps(a.y0);
+    const auto ax1 = _mm256_set1_ps(a.x1);
+    const auto ay1 = _mm256_set1_ps(a.y1);
+    const auto zero = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8)
+    {
+        const auto bx0 = _mm256_loadu_ps(x0 + i);
+        const auto by0 = _mm256_loadu_ps(y0 + i);
+        const auto bx1 = _mm256_loadu_ps(x1 + i);
+        const auto by1 = _mm256_loadu_ps(y1 + i);
+
+        const auto overlapX = _mm256_and_ps(_mm256_cmp_ps(ax0, bx1, _CMP_LT_OQ), _mm256_cmp_ps(ax1, bx0, _CMP_GT_OQ));
+        const auto overlapY = _mm256_and_ps(_mm256_cmp_ps(ay0, by1, _CMP_LT_OQ), _mm256_cmp_ps(ay1, by0, _CMP_GT_OQ));
+        mask |= static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_and_ps(overlapX, overlapY))) << i;
+
+        const auto width = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(ax1, bx1), _mm256_max_ps(ax0, bx0)));
+        const auto height = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(ay1, by1), _mm256_max_ps(ay0, by0)));
+        _mm256_storeu_ps(overlapAreas + i, _mm256_mul_ps(width, height));
+    }
+#elif defined(OPENLL_LABELAREABLOCK_SSE)
+    const auto ax0 = _mm_set1_ps(a.x0);
+    const auto ay0 = _mm_set1_ps(a.y0);
+    const auto ax1 = _mm_set1_ps(a.x1);
+    const auto ay1 = _mm_set1_ps(a.y1);
+    const auto zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4)
+    {
+        const auto bx0 = _mm_loadu_ps(x0 + i);
+        const auto by0 = _mm_loadu_ps(y0 + i);
+        const auto bx1 = _mm_loadu_ps(x1 + i);
+        const auto by1 = _mm_loadu_ps(y1 + i);
+
+        const auto overlapX = _mm_and_ps(_mm_cmplt_ps(ax0, bx1), _mm_cmpgt_ps(ax1, bx0));
+        const auto overlapY = _mm_and_ps(_mm_cmplt_ps(ay0, by1), _mm_cmpgt_ps(ay1, by0));
+        mask |= static_cast<std::uint64_t>(_mm_movemask_ps(_mm_and_ps(overlapX, overlapY))) << i;
+
+        const auto width = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(ax1, bx1), _mm_max_ps(ax0, bx0)));
+        const auto height = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(ay1, by1), _mm_max_ps(ay0, by0)));
+        _mm_storeu_ps(overlapAreas + i, _mm_mul_ps(width, height));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (a.x0 < x1[i] && a.x1 > x0[i] && a.y0 < y1[i] && a.y1 > y0[i])
+            mask |= std::uint64_t(1) << i;
+
+        const auto width = std::max(0.f, std::min(a.x1, x1[i]) - std::max(a.x0, x0[i]));
+        const auto height = std::max(0.f, std::min(a.y1, y1[i]) - std::max(a.y0, y0[i]));
+        overlapAreas[i] = width * height;
+    }
+
+    return mask;
+}
+
+}
+
+}
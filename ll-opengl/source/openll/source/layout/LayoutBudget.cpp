@@ -0,0 +1,69 @@
+#include <openll/layout/LayoutBudget.h>
+
+#include <limits>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+LayoutBudget::LayoutBudget()
+: LayoutBudget(Clock::duration::max())
+{
+}
+
+LayoutBudget::LayoutBudget(Clock::duration duration, unsigned long long iterations)
+: duration(duration)
+, iterations(iterations)
+{
+}
+
+unsigned long long LayoutBudget::unlimitedIterations()
+{
+    return std::numeric_limits<unsigned long long>::max();
+}
+
+
+LayoutDeadline::LayoutDeadline(const LayoutBudget & budget, unsigned int clockInterval)
+: m_budget(budget)
+, m_start(LayoutBudget::Clock::now())
+, m_clockInterval(clockInterval > 0 ? clockInterval : 1)
+, m_iterations(0)
+, m_exceeded(false)
+{
+}
+
+bool LayoutDeadline::iterate()
+{
+    if (m_exceeded)
+        return false;
+
+    m_exceeded = m_iterations >= m_budget.iterations
+        || (m_iterations % m_clockInterval == 0 && expired());
+    if (!m_exceeded)
+        ++m_iterations;
+    return !m_exceeded;
+}
+
+bool LayoutDeadline::expired()
+{
+    if (m_budget.duration != LayoutBudget::Clock::duration::max())
+        m_exceeded = m_exceeded || LayoutBudget::Clock::now() - m_start >= m_budget.duration;
+    return m_exceeded;
+}
+
+bool LayoutDeadline::exceeded() const
+{
+    return m_exceeded;
+}
+
+unsigned long long LayoutDeadline::iterations() const
+{
+    return m_iterations;
+}
+
+}
+
+}
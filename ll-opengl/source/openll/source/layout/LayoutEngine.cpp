@@ -0,0 +1,431 @@
+#include <openll/layout/LayoutEngine.h>
+
+#include <algorithm>
+#include <cassert>
+
+#include <glm/common.hpp>
+
+#include <openll/GlyphSequence.h>
+#include <openll/Trace.h>
+#include <openll/layout/ObstacleIndex.h>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+namespace
+{
+
+// changes smaller than this are no improvement, prevents cycling between equally good positions
+const float minimalImprovement = 1e-5f;
+
+template<typename T>
+void eraseIndex(std::vector<T> & entries, size_t index)
+{
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [index](const T & entry) { return entry.index == index; }), entries.end());
+}
+
+}
+
+LayoutEngine::LayoutEngine(PenaltyFunction penaltyFunction, bool allowSelection, const glm::vec2 & relativePadding, float cellSize, const ObstacleIndex * obstacles)
+: m_penaltyFunction(penaltyFunction)
+, m_allowSelection(allowSelection)
+, m_relativePadding(relativePadding)
+, m_obstacles(obstacles)
+, m_cellSize(cellSize)
+, m_spanSum(0.0)
+, m_spanCount(0)
+, m_grid(cellSize > 0.f ? cellSize : 1.f)
+, m_gridValid(cellSize > 0.f)
+, m_maxChangesPerLayout(8)
+{
+}
+
+LayoutEngine::~LayoutEngine()
+{
+}
+
+LayoutEngine::LabelId LayoutEngine::insert(const Label & label)
+{
+    LabelId id;
+    if (m_freeIds.empty())
+    {
+        id = m_labels.size();
+        m_labels.push_back(label);
+        m_used.push_back(true);
+        m_labelAreas.push_back({});
+        m_collisionGraph.push_back({});
+        m_obstacleOverlaps.push_back({});
+        m_chosenPositions.push_back(0);
+        m_dirty.push_back(false);
+        m_changes.push_back(0);
+    }
+    else
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+        m_labels[id] = label;
+        m_used[id] = true;
+        m_chosenPositions[id] = 0;
+    }
+
+    insertCandidates(id);
+    applyPosition(id);
+    markDirty(id);
+    markNeighboursDirty(id);
+    return id;
+}
+
+void LayoutEngine::erase(LabelId id)
+{
+    assert(contains(id));
+    markNeighboursDirty(id);
+    eraseCandidates(id);
+
+    m_used[id] = false;
+    m_labels[id] = Label();
+    m_freeIds.push_back(id);
+}
+
+void LayoutEngine::update(LabelId id, const Label & label)
+{
+    assert(contains(id));
+
+    // e.g., a new priority or text of the same extent, the penalties of the label may still change
+    if (label.pointLocation == m_labels[id].pointLocation && label.sequence.extent() == m_labels[id].sequence.extent())
+    {
+        m_labels[id] = label;
+        applyPosition(id);
+        markDirty(id);
+        return;
+    }
+
+    // the old neighbours may improve by the label leaving, the new ones have to react to it
+    markNeighboursDirty(id);
+    eraseCandidates(id);
+
+    m_labels[id] = label;
+    insertCandidates(id);
+    applyPosition(id);
+    markDirty(id);
+    markNeighboursDirty(id);
+}
+
+bool LayoutEngine::contains(LabelId id) const
+{
+    return id < m_used.size() && m_used[id];
+}
+
+size_t LayoutEngine::size() const
+{
+    return m_labels.size() - m_freeIds.size();
+}
+
+const Label & LayoutEngine::label(LabelId id) const
+{
+    assert(contains(id));
+    return m_labels[id];
+}
+
+std::vector<LayoutEngine::LabelId> LayoutEngine::ids() const
+{
+    std::vector<LabelId> result;
+    result.reserve(size());
+    for (LabelId id = 0; id < m_labels.size(); ++id)
+    {
+        if (m_used[id])
+            result.push_back(id);
+    }
+    return result;
+}
+
+std::vector<Label> LayoutEngine::labels() const
+{
+    std::vector<Label> result;
+    result.reserve(size());
+    for (LabelId id = 0; id < m_labels.size(); ++id)
+    {
+        if (m_used[id])
+            result.push_back(m_labels[id]);
+    }
+    return result;
+}
+
+bool LayoutEngine::layout(const LayoutBudget & budget)
+{
+    OPENLL_TRACE_ZONE("layout::LayoutEngine::layout");
+    LayoutDeadline deadline(budget);
+    std::vector<LabelId> changedLabels;
+    std::vector<LabelId> deferredLabels;
+
+    while (!m_dirtyLabels.empty() && deadline.iterate())
+    {
+        const auto id = m_dirtyLabels.back();
+        m_dirtyLabels.pop_back();
+        m_dirty[id] = false;
+        if (!m_used[id])
+            continue;
+        if (m_changes[id] >= m_maxChangesPerLayout)
+        {
+            deferredLabels.push_back(id);
+            continue;
+        }
+
+        const auto positionCount = static_cast<unsigned int>(m_labelAreas[id].size() + (m_allowSelection ? 1 : 0));
+        const auto oldPosition = m_chosenPositions[id];
+        const auto oldPenalty = labelPenalty(id, oldPosition);
+        auto bestPosition = oldPosition;
+        auto bestPenalty = oldPenalty;
+        for (unsigned int position = 0; position < positionCount; ++position)
+        {
+            const auto penalty = labelPenalty(id, position);
+            if (penalty < bestPenalty)
+            {
+                bestPenalty = penalty;
+                bestPosition = position;
+            }
+        }
+        if (bestPosition == oldPosition || oldPenalty - bestPenalty < minimalImprovement)
+            continue;
+
+        // the neighbours colliding with the old or the new position see a changed penalty
+        for (const auto position : { oldPosition, bestPosition })
+        {
+            if (position == m_labelAreas[id].size())
+                continue;
+            for (const auto & collision : m_collisionGraph[id][position])
+                markDirty(collision.index);
+        }
+
+        m_chosenPositions[id] = bestPosition;
+        applyPosition(id);
+        if (m_changes[id]++ == 0)
+            changedLabels.push_back(id);
+    }
+
+    for (const auto id : changedLabels)
+        m_changes[id] = 0;
+    for (const auto id : deferredLabels)
+        markDirty(id);
+
+    return m_dirtyLabels.empty();
+}
+
+size_t LayoutEngine::pendingLabels() const
+{
+    return m_dirtyLabels.size();
+}
+
+void LayoutEngine::setMaxChangesPerLayout(unsigned int maxChanges)
+{
+    m_maxChangesPerLayout = maxChanges;
+}
+
+unsigned int LayoutEngine::maxChangesPerLayout() const
+{
+    return m_maxChangesPerLayout;
+}
+
+const CollisionGraph & LayoutEngine::collisionGraph() const
+{
+    return m_collisionGraph;
+}
+
+void LayoutEngine::insertCandidates(LabelId id)
+{
+    const auto & label = m_labels[id];
+    const auto & extent = label.sequence.extent();
+    const auto & positions = cornerPositions();
+
+    auto & labelAreas = m_labelAreas[id];
+    labelAreas.clear();
+
+    // the label has no areas yet, so that a rebuild of the grid does not add them
+    m_spanSum += span(extent);
+    ++m_spanCount;
+    adaptCellSize();
+
+    for (const auto & position : positions)
+        labelAreas.push_back({labelOrigin(position, label.pointLocation, extent), extent});
+
+    auto & collisions = m_collisionGraph[id];
+    collisions.assign(labelAreas.size(), {});
+
+    auto & obstacleOverlaps = m_obstacleOverlaps[id];
+    obstacleOverlaps.assign(labelAreas.size(), {0.f, 0});
+    if (m_obstacles)
+    {
+        for (unsigned int position = 0; position < labelAreas.size(); ++position)
+        {
+            auto & overlap = obstacleOverlaps[position];
+            overlap.overlapArea = m_obstacles->overlapArea(labelAreas[position], m_relativePadding, overlap.overlapCount, id);
+        }
+    }
+
+    // labels with zero extent are not indexed until a cell size is known; they cannot overlap anyway
+    if (!m_gridValid)
+        return;
+
+    for (unsigned int position = 0; position < labelAreas.size(); ++position)
+    {
+        const auto & area = labelAreas[position];
+        glm::vec2 lowerLeft, upperRight;
+        paddedBounds(area, lowerLeft, upperRight);
+        const auto lowerCell = m_grid.cell(lowerLeft);
+
+        m_grid.forEach(lowerLeft, upperRight, [&](const glm::ivec2 & cell, const GridEntry & entry)
+        {
+            if (entry.index == id)
+                return;
+
+            // a pair sharing several cells is only handled in the first of them
+            const auto & other = m_labelAreas[entry.index][entry.position];
+            glm::vec2 otherLowerLeft, otherUpperRight;
+            paddedBounds(other, otherLowerLeft, otherUpperRight);
+            if (glm::max(lowerCell, m_grid.cell(otherLowerLeft)) != cell)
+                return;
+
+            if (!area.paddedOverlaps(other, m_relativePadding))
+                return;
+            const auto overlapArea = area.paddedOverlapArea(other, m_relativePadding);
+            collisions[position].push_back({entry.index, entry.position, overlapArea});
+            m_collisionGraph[entry.index][entry.position].push_back({id, position, overlapArea});
+        });
+        m_grid.insert(lowerLeft, upperRight, {id, position});
+    }
+}
+
+void LayoutEngine::eraseCandidates(LabelId id)
+{
+    auto & labelAreas = m_labelAreas[id];
+    auto & collisions = m_collisionGraph[id];
+
+    for (unsigned int position = 0; position < collisions.size(); ++position)
+    {
+        for (const auto & collision : collisions[position])
+            eraseIndex(m_collisionGraph[collision.index][collision.position], id);
+    }
+
+    if (m_gridValid)
+    {
+        for (const auto & area : labelAreas)
+        {
+            glm::vec2 lowerLeft, upperRight;
+            paddedBounds(area, lowerLeft, upperRight);
+            m_grid.erase(lowerLeft, upperRight, [id](const GridEntry & entry) { return entry.index == id; });
+        }
+    }
+
+    if (!labelAreas.empty())
+    {
+        m_spanSum -= span(labelAreas.front().extent);
+        --m_spanCount;
+    }
+    labelAreas.clear();
+    collisions.clear();
+    m_obstacleOverlaps[id].clear();
+}
+
+void LayoutEngine::markNeighboursDirty(LabelId id)
+{
+    for (const auto & collisions : m_collisionGraph[id])
+    {
+        for (const auto & collision : collisions)
+            markDirty(collision.index);
+    }
+}
+
+void LayoutEngine::markDirty(LabelId id)
+{
+    if (m_dirty[id])
+        return;
+    m_dirty[id] = true;
+    m_dirtyLabels.push_back(id);
+}
+
+float LayoutEngine::labelPenalty(LabelId id, unsigned int position) const
+{
+    const auto priority = m_labels[id].priority;
+    if (position == m_labelAreas[id].size())
+        return m_penaltyFunction(0, 0.f, RelativeLabelPosition::Hidden, priority);
+
+    const auto & obstacleOverlap = m_obstacleOverlaps[id][position];
+    auto overlapArea = obstacleOverlap.overlapArea;
+    auto overlapCount = obstacleOverlap.overlapCount;
+    for (const auto & collision : m_collisionGraph[id][position])
+    {
+        if (m_chosenPositions[collision.index] != collision.position)
+            continue;
+        overlapArea += collision.overlapArea;
+        ++overlapCount;
+    }
+    const auto area = m_labelAreas[id][position].area();
+    if (area > 0.f)
+        overlapArea /= area;
+    return m_penaltyFunction(overlapCount, overlapArea, cornerPositions()[position], priority);
+}
+
+void LayoutEngine::applyPosition(LabelId id)
+{
+    applyPosition(id, m_chosenPositions[id]);
+}
+
+void LayoutEngine::applyPosition(LabelId id, unsigned int position)
+{
+    auto & label = m_labels[id];
+    const auto visible = position < m_labelAreas[id].size();
+    const auto offset = visible ? (m_labelAreas[id][position].origin - label.pointLocation) : glm::vec2(0.f);
+    label.placement = {offset, Alignment::LeftAligned, LineAnchor::Bottom, visible};
+}
+
+float LayoutEngine::span(const glm::vec2 & extent) const
+{
+    return glm::max(extent.x, extent.y) * (1.f + 2.f * glm::max(m_relativePadding.x, m_relativePadding.y));
+}
+
+void LayoutEngine::adaptCellSize()
+{
+    if (m_cellSize > 0.f || m_spanCount == 0)
+        return;
+
+    // twice the mean span, so that a label usually covers up to 2x2 cells; larger labels are added to more cells
+    const auto cellSize = static_cast<float>(2.0 * m_spanSum / m_spanCount);
+    if (cellSize <= 0.f)
+        return;
+    if (m_gridValid && cellSize <= 2.f * m_grid.cellSize() && cellSize >= 0.5f * m_grid.cellSize())
+        return;
+
+    rebuildGrid(cellSize);
+}
+
+void LayoutEngine::rebuildGrid(float cellSize)
+{
+    OPENLL_TRACE_ZONE("layout::LayoutEngine::rebuildGrid");
+    m_grid.reset(cellSize);
+    m_gridValid = true;
+
+    // the collisions do not depend on the grid
+    for (LabelId id = 0; id < m_labelAreas.size(); ++id)
+    {
+        const auto & labelAreas = m_labelAreas[id];
+        for (unsigned int position = 0; position < labelAreas.size(); ++position)
+        {
+            glm::vec2 lowerLeft, upperRight;
+            paddedBounds(labelAreas[position], lowerLeft, upperRight);
+            m_grid.insert(lowerLeft, upperRight, {id, position});
+        }
+    }
+}
+
+void LayoutEngine::paddedBounds(const LabelArea & area, glm::vec2 & lowerLeft, glm::vec2 & upperRight) const
+{
+    lowerLeft = area.origin - area.extent * m_relativePadding;
+    upperRight = area.origin + area.extent * (m_relativePadding + 1.f);
+}
+
+}
+
+}
@@ -0,0 +1,90 @@
+#include <openll/layout/ObstacleIndex.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/common.hpp>
+
+#include <openll/layout/layoutbase.h>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+const size_t Obstacle::noLabel = std::numeric_limits<size_t>::max();
+
+std::vector<Obstacle> pointObstacles(const std::vector<Label> & labels, const glm::vec2 & extent)
+{
+    std::vector<Obstacle> result;
+    result.reserve(labels.size());
+    for (size_t i = 0; i < labels.size(); ++i)
+        result.push_back({{labels[i].pointLocation - extent / 2.f, extent}, i});
+    return result;
+}
+
+ObstacleIndex::ObstacleIndex(const std::vector<Obstacle> & obstacles, float cellSize)
+: m_obstacles(obstacles)
+{
+    if (cellSize <= 0.f)
+    {
+        // twice the mean obstacle size, larger obstacles are added to several cells
+        auto sum = 0.f;
+        for (const auto & obstacle : m_obstacles)
+            sum += glm::max(obstacle.area.extent.x, obstacle.area.extent.y);
+        cellSize = m_obstacles.empty() || sum <= 0.f ? 1.f : 2.f * sum / m_obstacles.size();
+    }
+    m_grid.reset(cellSize);
+
+    for (size_t i = 0; i < m_obstacles.size(); ++i)
+    {
+        const auto & area = m_obstacles[i].area;
+        m_grid.insert(area.origin, area.origin + area.extent, static_cast<std::uint32_t>(i));
+    }
+}
+
+size_t ObstacleIndex::size() const
+{
+    return m_obstacles.size();
+}
+
+const std::vector<Obstacle> & ObstacleIndex::obstacles() const
+{
+    return m_obstacles;
+}
+
+float ObstacleIndex::overlapArea(const LabelArea & area, const glm::vec2 & relativePadding, int & overlapCount, size_t labelIndex) const
+{
+    const LabelArea padded {area.origin - area.extent * relativePadding, area.extent * (1.f + 2.f * relativePadding)};
+    // the line height for single-line labels
+    const auto minimumExtent = glm::vec2(glm::min(area.extent.x, area.extent.y));
+    const auto lowerCell = m_grid.cell(padded.origin);
+
+    auto result = 0.f;
+    overlapCount = 0;
+    m_grid.forEach(padded.origin, padded.origin + padded.extent, [&](const glm::ivec2 & cell, std::uint32_t index)
+    {
+        const auto & obstacle = m_obstacles[index];
+        if (obstacle.label == labelIndex && labelIndex != Obstacle::noLabel)
+            return;
+
+        // an obstacle sharing several cells with the area is only handled in the first of them
+        if (glm::max(lowerCell, m_grid.cell(obstacle.area.origin)) != cell)
+            return;
+
+        if (!padded.overlaps(obstacle.area))
+            return;
+        // points and thin obstacles are grown around their center, so that they add an overlap area as well
+        const auto extent = glm::max(obstacle.area.extent, minimumExtent);
+        const LabelArea grown {obstacle.area.origin + (obstacle.area.extent - extent) / 2.f, extent};
+        result += padded.overlapArea(grown);
+        ++overlapCount;
+    });
+    return result;
+}
+
+}
+
+}
@@ -0,0 +1,180 @@
+#include <openll/layout/OccupancyGrid.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/common.hpp>
+
+#include <openll/layout/LabelArea.h>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+namespace
+{
+
+const unsigned int bitsPerWord = 64;
+
+// bits [first, last] of a word, both in [0, 63]
+std::uint64_t bitMask(unsigned int first, unsigned int last)
+{
+    const auto upper = last == bitsPerWord - 1 ? ~std::uint64_t(0) : (std::uint64_t(1) << (last + 1)) - 1;
+    return upper & (~std::uint64_t(0) << first);
+}
+
+unsigned int popcount(std::uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned int>(__builtin_popcountll(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<unsigned int>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// calls operation(word, mask) for every word of the rows covering the cell range
+template <typename Words, typename Operation>
+void forEachWord(Words & words, size_t wordsPerRow, const glm::uvec2 & lower, const glm::uvec2 & upper, Operation operation)
+{
+    const auto firstWord = lower.x / bitsPerWord;
+    const auto lastWord = upper.x / bitsPerWord;
+    for (auto y = lower.y; y <= upper.y; ++y)
+    {
+        auto row = &words[y * wordsPerRow];
+        for (auto word = firstWord; word <= lastWord; ++word)
+        {
+            const auto first = word == firstWord ? lower.x % bitsPerWord : 0u;
+            const auto last = word == lastWord ? upper.x % bitsPerWord : bitsPerWord - 1;
+            if (!operation(row[word], bitMask(first, last)))
+                return;
+        }
+    }
+}
+
+}
+
+OccupancyGrid::OccupancyGrid(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight, const glm::uvec2 & resolution)
+: m_resolution(resolution)
+, m_wordsPerRow((resolution.x + bitsPerWord - 1) / bitsPerWord)
+, m_words(m_wordsPerRow * resolution.y, 0)
+{
+    reset(lowerLeft, upperRight);
+}
+
+void OccupancyGrid::reset(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight)
+{
+    m_lowerLeft = lowerLeft;
+    clear();
+
+    // degenerate bounds map to no cells, all areas then lie outside the grid
+    const auto extent = upperRight - lowerLeft;
+    if (!(extent.x > 0.f && extent.y > 0.f))
+    {
+        m_cellsPerUnit = glm::vec2(0.f);
+        return;
+    }
+    m_cellsPerUnit = glm::vec2(m_resolution) / extent;
+}
+
+void OccupancyGrid::clear()
+{
+    std::fill(m_words.begin(), m_words.end(), 0);
+}
+
+bool OccupancyGrid::covers(const LabelArea & area) const
+{
+    glm::uvec2 lower, upper;
+    return cellRange(area, lower, upper);
+}
+
+void OccupancyGrid::occupy(const LabelArea & area)
+{
+    glm::uvec2 lower, upper;
+    if (!cellRange(area, lower, upper))
+        return;
+
+    forEachWord(m_words, m_wordsPerRow, lower, upper, [](std::uint64_t & word, std::uint64_t mask)
+    {
+        word |= mask;
+        return true;
+    });
+}
+
+bool OccupancyGrid::occupied(const LabelArea & area) const
+{
+    glm::uvec2 lower, upper;
+    if (!cellRange(area, lower, upper))
+        return false;
+
+    auto result = false;
+    forEachWord(m_words, m_wordsPerRow, lower, upper, [&result](std::uint64_t word, std::uint64_t mask)
+    {
+        result = (word & mask) != 0;
+        return !result;
+    });
+    return result;
+}
+
+unsigned int OccupancyGrid::occupiedCells(const LabelArea & area) const
+{
+    glm::uvec2 lower, upper;
+    if (!cellRange(area, lower, upper))
+        return 0;
+
+    unsigned int count = 0;
+    forEachWord(m_words, m_wordsPerRow, lower, upper, [&count](std::uint64_t word, std::uint64_t mask)
+    {
+        count += popcount(word & mask);
+        return true;
+    });
+    return count;
+}
+
+float OccupancyGrid::occupiedArea(const LabelArea & area) const
+{
+    const auto cell = cellExtent();
+    return std::min(area.area(), occupiedCells(area) * cell.x * cell.y);
+}
+
+const glm::uvec2 & OccupancyGrid::resolution() const
+{
+    return m_resolution;
+}
+
+glm::vec2 OccupancyGrid::cellExtent() const
+{
+    if (m_cellsPerUnit.x == 0.f || m_cellsPerUnit.y == 0.f)
+        return glm::vec2(0.f);
+
+    return 1.f / m_cellsPerUnit;
+}
+
+bool OccupancyGrid::cellRange(const LabelArea & area, glm::uvec2 & lower, glm::uvec2 & upper) const
+{
+    if (m_resolution.x == 0 || m_resolution.y == 0 || m_cellsPerUnit.x == 0.f || m_cellsPerUnit.y == 0.f)
+        return false;
+
+    const auto lowerCell = (area.origin - m_lowerLeft) * m_cellsPerUnit;
+    const auto upperCell = (area.origin + area.extent - m_lowerLeft) * m_cellsPerUnit;
+    const auto maximum = glm::vec2(m_resolution);
+    if (upperCell.x <= 0.f || upperCell.y <= 0.f || lowerCell.x >= maximum.x || lowerCell.y >= maximum.y)
+        return false;
+
+    // the upper bound is exclusive, an area ending exactly on a cell border does not touch the next cell
+    lower.x = static_cast<unsigned int>(std::max(0.f, std::floor(lowerCell.x)));
+    lower.y = static_cast<unsigned int>(std::max(0.f, std::floor(lowerCell.y)));
+    upper.x = static_cast<unsigned int>(std::min(maximum.x, std::ceil(upperCell.x))) - 1;
+    upper.y = static_cast<unsigned int>(std::min(maximum.y, std::ceil(upperCell.y))) - 1;
+    upper = glm::max(upper, lower);
+    return true;
+}
+
+}
+
+}
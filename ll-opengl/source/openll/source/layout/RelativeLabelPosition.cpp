@@ -20,12 +20,12 @@ glm::vec2 labelOrigin(RelativeLabelPosition position, const glm::vec2 & origin,
 
 RelativeLabelPosition relativeLabelPosition(const glm::vec2 & offset, const glm::vec2 & extent)
 {
+    // labels centered on an axis (see CandidatePosition) count as right or upper
     const auto midpointOffset = offset + extent / 2.f;
-    if (midpointOffset.x > 0 && midpointOffset.y > 0) return RelativeLabelPosition::UpperRight;
-    if (midpointOffset.x < 0 && midpointOffset.y > 0) return RelativeLabelPosition::UpperLeft;
+    if (midpointOffset.x >= 0 && midpointOffset.y >= 0) return RelativeLabelPosition::UpperRight;
+    if (midpointOffset.x < 0 && midpointOffset.y >= 0) return RelativeLabelPosition::UpperLeft;
     if (midpointOffset.x < 0 && midpointOffset.y < 0) return RelativeLabelPosition::LowerLeft;
-    if (midpointOffset.x > 0 && midpointOffset.y < 0) return RelativeLabelPosition::LowerRight;
-    assert(false);
+    return RelativeLabelPosition::LowerRight;
 }
 
 } // namespace gloperate_text
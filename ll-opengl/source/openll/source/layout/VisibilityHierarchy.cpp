@@ -0,0 +1,245 @@
+#include <openll/layout/VisibilityHierarchy.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+#include <glm/common.hpp>
+
+#include <openll/GlyphSequence.h>
+#include <openll/Trace.h>
+#include <openll/layout/layoutbase.h>
+#include <openll/layout/CollisionGraph.h>
+#include <openll/layout/UniformGrid.h>
+
+
+namespace gloperate_text
+{
+
+namespace layout
+{
+
+namespace
+{
+
+// a label rectangle in screen units relative to its point, padded
+struct Candidate
+{
+    glm::vec2 point;
+    glm::vec2 offset;
+    glm::vec2 extent;
+};
+
+// scales s > 0 with a < d * s < b as open interval (lower, upper), returns false if there are none
+bool axisConflict(float d, float a, float b, float & lower, float & upper)
+{
+    if (d == 0.f)
+    {
+        lower = 0.f;
+        upper = std::numeric_limits<float>::infinity();
+        return a < 0.f && 0.f < b;
+    }
+    lower = std::max(0.f, (d > 0.f ? a : b) / d);
+    upper = (d > 0.f ? b : a) / d;
+    return lower < upper;
+}
+
+// true if both labels overlap at any scale in [lowerScale, upperScale)
+bool conflicts(const Candidate & i, const Candidate & j, float lowerScale, float upperScale)
+{
+    // i and j overlap along an axis at scale s if i.offset - j.offset - j.extent < (j.point - i.point) * s < i.offset - j.offset + i.extent
+    const auto d = j.point - i.point;
+    const auto a = i.offset - j.offset - j.extent;
+    const auto b = i.offset - j.offset + i.extent;
+
+    // the labels only move apart when zooming in, so most pairs are already separated at the lower scale
+    const auto lowerD = d * lowerScale;
+    if ((d.x > 0.f && lowerD.x >= b.x) || (d.x < 0.f && lowerD.x <= a.x) || (d.y > 0.f && lowerD.y >= b.y) || (d.y < 0.f && lowerD.y <= a.y))
+        return false;
+
+    float lowerX, upperX, lowerY, upperY;
+    if (!axisConflict(d.x, a.x, b.x, lowerX, upperX) || !axisConflict(d.y, a.y, b.y, lowerY, upperY))
+        return false;
+
+    const auto lower = std::max(lowerX, lowerY);
+    const auto upper = std::min(upperX, upperY);
+    return lower < upper && lower < upperScale && upper > lowerScale;
+}
+
+// the placed labels visible at a single zoom level, hashed into cells of at least twice the distance of conflicting labels
+class LevelGrid
+{
+public:
+    LevelGrid(float cellSize)
+    : m_grid(cellSize)
+    {
+    }
+
+    void insert(const glm::vec2 & point, std::uint32_t labelIndex)
+    {
+        m_grid.insert(m_grid.cell(point), labelIndex);
+    }
+
+    // visits the labels that may overlap a label at point; as the cells are twice as wide as the maximum distance,
+    // only the containing cell and the nearer neighbours along both axes have to be visited
+    template <typename Callback>
+    void forEachNeighbour(const glm::vec2 & point, Callback callback) const
+    {
+        const auto cellPoint = point / m_grid.cellSize();
+        const auto cell = m_grid.cell(point);
+        const auto neighbour = glm::ivec2(cellPoint.x - cell.x < 0.5f ? cell.x - 1 : cell.x + 1, cellPoint.y - cell.y < 0.5f ? cell.y - 1 : cell.y + 1);
+
+        for (const auto y : { cell.y, neighbour.y })
+        {
+            for (const auto x : { cell.x, neighbour.x })
+                m_grid.forEach(glm::ivec2(x, y), callback);
+        }
+    }
+
+protected:
+    UniformGrid<std::uint32_t> m_grid;
+};
+
+}
+
+VisibilityHierarchy::VisibilityHierarchy(const std::vector<Label> & labels, float minScale, unsigned int levels, const glm::vec2 & relativePadding)
+: m_minScale(minScale)
+, m_levels(levels)
+, m_minLevels(labels.size(), levels)
+, m_positions(labels.size(), RelativeLabelPosition::Hidden)
+, m_offsets(labels.size(), glm::vec2(0.f))
+, m_levelEnds(levels, 0)
+{
+    OPENLL_TRACE_ZONE("layout::VisibilityHierarchy");
+    const auto & positions = cornerPositions();
+
+    // all padded candidates of a label lie within radius of its point (in screen units)
+    auto radius = 0.f;
+    for (const auto & label : labels)
+    {
+        const auto extent = label.sequence.extent() * (1.f + relativePadding);
+        radius = std::max(radius, std::max(extent.x, extent.y));
+    }
+    // labels closer than 2 * radius / scale in world units may overlap, the grid cells of a level have twice this size
+    std::vector<LevelGrid> grids;
+    for (unsigned int level = 0; level < levels; ++level)
+        grids.emplace_back(radius > 0.f ? 4.f * radius / scale(static_cast<float>(level)) : 1.f);
+
+    std::vector<size_t> priorityOrder(labels.size());
+    std::iota(priorityOrder.begin(), priorityOrder.end(), 0);
+    std::stable_sort(priorityOrder.begin(), priorityOrder.end(), [&labels](size_t a, size_t b) { return labels[a].priority > labels[b].priority; });
+
+    std::vector<Candidate> placed(labels.size());
+    std::vector<Candidate> candidates(positions.size());
+    std::vector<unsigned int> minLevels(positions.size());
+    for (const auto labelIndex : priorityOrder)
+    {
+        const auto & label = labels[labelIndex];
+        const auto & extent = label.sequence.extent();
+        for (size_t position = 0; position < positions.size(); ++position)
+        {
+            const auto offset = labelOrigin(positions[position], glm::vec2(0.f), extent);
+            candidates[position] = { label.pointLocation, offset - extent * relativePadding, extent * (1.f + 2.f * relativePadding) };
+            minLevels[position] = 0;
+        }
+
+        // each position is visible from the level above the finest one with a conflict
+        auto remaining = positions.size();
+        for (auto level = levels; level > 0 && remaining > 0; --level)
+        {
+            const auto lowerScale = scale(static_cast<float>(level - 1));
+            const auto upperScale = level == levels ? std::numeric_limits<float>::infinity() : scale(static_cast<float>(level));
+            grids[level - 1].forEachNeighbour(label.pointLocation, [&](std::uint32_t otherIndex)
+            {
+                const auto & other = placed[otherIndex];
+                for (size_t position = 0; position < positions.size(); ++position)
+                {
+                    if (minLevels[position] == 0 && conflicts(candidates[position], other, lowerScale, upperScale))
+                    {
+                        minLevels[position] = level;
+                        --remaining;
+                    }
+                }
+            });
+        }
+
+        const auto best = static_cast<size_t>(std::min_element(minLevels.begin(), minLevels.end()) - minLevels.begin());
+        const auto bestLevel = minLevels[best];
+        m_minLevels[labelIndex] = bestLevel;
+        if (bestLevel == levels)
+            continue;
+
+        m_positions[labelIndex] = positions[best];
+        m_offsets[labelIndex] = labelOrigin(positions[best], glm::vec2(0.f), extent);
+        placed[labelIndex] = candidates[best];
+        for (auto level = bestLevel; level < levels; ++level)
+            grids[level].insert(label.pointLocation, static_cast<std::uint32_t>(labelIndex));
+    }
+
+    m_order = priorityOrder;
+    std::stable_sort(m_order.begin(), m_order.end(), [this](size_t a, size_t b) { return m_minLevels[a] < m_minLevels[b]; });
+    for (const auto minLevel : m_minLevels)
+    {
+        for (auto level = minLevel; level < levels; ++level)
+            ++m_levelEnds[level];
+    }
+}
+
+float VisibilityHierarchy::scale(float zoom) const
+{
+    return m_minScale * std::pow(2.f, zoom);
+}
+
+unsigned int VisibilityHierarchy::levels() const
+{
+    return m_levels;
+}
+
+unsigned int VisibilityHierarchy::minLevel(size_t labelIndex) const
+{
+    return m_minLevels[labelIndex];
+}
+
+RelativeLabelPosition VisibilityHierarchy::position(size_t labelIndex) const
+{
+    return m_positions[labelIndex];
+}
+
+std::vector<size_t> VisibilityHierarchy::visibleLabels(float zoom) const
+{
+    const auto count = visibleCount(zoom);
+    return std::vector<size_t>(m_order.begin(), m_order.begin() + count);
+}
+
+size_t VisibilityHierarchy::visibleCount(float zoom) const
+{
+    if (zoom < 0.f || m_levels == 0)
+        return 0;
+    return m_levelEnds[level(zoom)];
+}
+
+const std::vector<size_t> & VisibilityHierarchy::order() const
+{
+    return m_order;
+}
+
+void VisibilityHierarchy::apply(std::vector<Label> & labels, float zoom) const
+{
+    const auto currentLevel = zoom < 0.f || m_levels == 0 ? -1 : static_cast<int>(level(zoom));
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        const auto visible = static_cast<int>(m_minLevels[i]) <= currentLevel;
+        labels[i].placement = {visible ? m_offsets[i] : glm::vec2(0.f), Alignment::LeftAligned, LineAnchor::Bottom, visible};
+    }
+}
+
+unsigned int VisibilityHierarchy::level(float zoom) const
+{
+    return std::min(static_cast<unsigned int>(zoom), m_levels - 1);
+}
+
+}
+
+}
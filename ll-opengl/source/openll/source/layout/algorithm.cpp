@@ -6,9 +6,15 @@
 
 #include <openll/GlyphSequence.h>
 #include <openll/FontFace.h>
+#include <openll/Trace.h>
 #include <openll/layout/layoutbase.h>
 #include <openll/layout/LabelArea.h>
-#include <openll/Typesetter.h>
+#include <openll/layout/LabelAreaBlock.h>
+#include <openll/layout/CollisionGraph.h>
+#include <openll/layout/OccupancyGrid.h>
+#include <openll/layout/AnnealingSolver.h>
+#include <openll/layout/CandidateLayout.h>
+#include <openll/layout/penalties.h>
 
 
 namespace gloperate_text
@@ -20,95 +26,6 @@ namespace layout
 namespace
 {
 
-struct LabelCollision
-{
-    size_t index;
-    size_t position;
-    float overlapArea;
-};
-
-
-struct Index2D
-{
-    template<typename T>
-    void next(const std::vector<std::vector<T>>& container)
-    {
-        ++inner;
-        if (inner == container[outer].size())
-        {
-            ++outer;
-            inner = 0;
-        }
-    }
-
-    template<typename T>
-    bool end(const std::vector<std::vector<T>>& container) const
-    {
-        return outer == container.size();
-    }
-
-    template<typename T>
-    T& element(std::vector<std::vector<T>>& container) const
-    {
-        return container[outer][inner];
-    }
-
-    template<typename T>
-    const T& element(const std::vector<std::vector<T>>& container) const
-    {
-        return container[outer][inner];
-    }
-
-    size_t outer = 0;
-    size_t inner = 0;
-};
-
-std::vector<std::vector<std::vector<LabelCollision>>> createCollisionGraph(const std::vector<std::vector<LabelArea>>& labelAreas, const glm::vec2 & relativePadding = {0.f, 0.f})
-{
-    std::vector<std::vector<std::vector<LabelCollision>>> collisionGraph;
-    collisionGraph.resize(labelAreas.size());
-    for (size_t i = 0; i < labelAreas.size(); ++i)
-    {
-        collisionGraph[i].resize(labelAreas[i].size());
-    }
-
-    for (Index2D index1; !index1.end(labelAreas); index1.next(labelAreas))
-    {
-        auto & collisionElement = index1.element(collisionGraph);
-        for (Index2D index2; !index2.end(labelAreas); index2.next(labelAreas))
-        {
-            if (index1.outer == index2.outer)
-                continue;
-            const auto & label1 = index1.element(labelAreas);
-            const auto & label2 = index2.element(labelAreas);
-            if (label1.paddedOverlaps(label2, relativePadding))
-            {
-                auto area = label1.paddedOverlapArea(label2, relativePadding);
-                collisionElement.push_back({index2.outer, index2.inner, area});
-                assert(index1.element(collisionGraph).size() > 0);
-            }
-        }
-    }
-    return collisionGraph;
-}
-
-// generate LabelArea objects for all possible label placements
-std::vector<std::vector<LabelArea>> computeLabelAreas(const std::vector<Label> & labels, const std::vector<RelativeLabelPosition>& positions)
-{
-    std::vector<std::vector<LabelArea>> result;
-    for (const auto & label : labels)
-    {
-        result.push_back({});
-        const auto extent = Typesetter::extent(label.sequence);
-        for (const auto& position : positions)
-        {
-            const auto origin = labelOrigin(position, label.pointLocation, extent);
-            result.back().push_back({origin, extent});
-        }
-    }
-    return result;
-}
-
 std::vector<unsigned int> randomStartLabelAreas(const std::vector<std::vector<LabelArea>> & labelAreas)
 {
     std::vector<unsigned int> result;
@@ -121,23 +38,11 @@ std::vector<unsigned int> randomStartLabelAreas(const std::vector<std::vector<La
     return result;
 }
 
-template<typename T>
-T randomIndexExcept(T except, T size, std::default_random_engine engine)
-{
-    std::uniform_int_distribution<T> positionDistribution(0, size - 1);
-    T randomNumber;
-    do
-    {
-        randomNumber = positionDistribution(engine);
-    }
-    while (randomNumber == except);
-    return randomNumber;
-}
-
 }
 
 void constant(std::vector<Label> & labels)
 {
+    OPENLL_TRACE_ZONE("layout::constant");
     for (auto & label : labels)
     {
         label.placement = {{0.f, 0.f}, Alignment::LeftAligned, LineAnchor::Bottom, true};
@@ -146,11 +51,12 @@ void constant(std::vector<Label> & labels)
 
 void random(std::vector<Label> & labels)
 {
+    OPENLL_TRACE_ZONE("layout::random");
     std::default_random_engine generator;
     std::bernoulli_distribution bool_distribution;
     for (auto & label : labels)
     {
-        const auto extent = Typesetter::extent(label.sequence);
+        const auto & extent = label.sequence.extent();
         glm::vec2 offset;
         offset.x = bool_distribution(generator) ? -extent.x : 0.f;
         offset.y = bool_distribution(generator) ? -extent.y : 0.f;
@@ -158,41 +64,29 @@ void random(std::vector<Label> & labels)
     }
 }
 
-float overlapArea(int, float overlapArea, RelativeLabelPosition, unsigned int)
+float overlapArea(int overlapCount, float overlapArea, RelativeLabelPosition position, unsigned int priority)
 {
-    return overlapArea;
+    return OverlapAreaPenalty()(overlapCount, overlapArea, position, priority);
 }
-float overlapCount(int overlapCount, float, RelativeLabelPosition, unsigned int)
+float overlapCount(int overlapCount, float overlapArea, RelativeLabelPosition position, unsigned int priority)
 {
-    return overlapCount;
+    return OverlapCountPenalty()(overlapCount, overlapArea, position, priority);
 }
 
-float standard(int, float overlapArea, RelativeLabelPosition position, unsigned int priority)
+float standard(int overlapCount, float overlapArea, RelativeLabelPosition position, unsigned int priority)
 {
-    unsigned int positionPenalty = 0;
-    switch (position)
-    {
-        case RelativeLabelPosition::UpperRight: positionPenalty = 0; break;
-        case RelativeLabelPosition::UpperLeft:  positionPenalty = 1; break;
-        case RelativeLabelPosition::LowerLeft:  positionPenalty = 2; break;
-        case RelativeLabelPosition::LowerRight: positionPenalty = 3; break;
-        case RelativeLabelPosition::Hidden:     return 1.5f * priority;
-        default: assert(false);
-    }
-    return 15.f * overlapArea + .3f * positionPenalty;
+    return StandardPenalty()(overlapCount, overlapArea, position, priority);
 }
 
-
-void greedy(std::vector<Label> & labels, PenaltyFunction penaltyFunction)
+void greedy(std::vector<Label> & labels, PenaltyFunction penaltyFunction, OccupancyGrid * occupancy)
 {
-    std::vector<LabelArea> labelAreas;
-    const std::vector<RelativeLabelPosition> positions {
-        RelativeLabelPosition::UpperRight, RelativeLabelPosition::UpperLeft,
-        RelativeLabelPosition::LowerLeft, RelativeLabelPosition::LowerRight
-    };
+    OPENLL_TRACE_ZONE("layout::greedy");
+    LabelAreaBlock labelAreas;
+    labelAreas.reserve(occupancy ? 0 : labels.size());
+    const auto & positions = cornerPositions();
     for (auto & label : labels)
     {
-        const auto extent = Typesetter::extent(label.sequence);
+        const auto & extent = label.sequence.extent();
         float bestPenalty = std::numeric_limits<float>::max();
         glm::vec2 bestOrigin;
         for (const auto& position : positions)
@@ -201,10 +95,14 @@ void greedy(std::vector<Label> & labels, PenaltyFunction penaltyFunction)
             const LabelArea newLabelArea {origin, extent};
             float overlapArea = 0.f;
             int overlapCount = 0;
-            for (const auto& other : labelAreas)
+            if (occupancy)
+            {
+                overlapArea = occupancy->occupiedArea(newLabelArea);
+                overlapCount = overlapArea > 0.f ? 1 : 0;
+            }
+            else
             {
-                overlapArea += newLabelArea.overlapArea(other);
-                overlapCount += newLabelArea.overlaps(other) ? 1 : 0;
+                overlapArea = labelAreas.overlapArea(newLabelArea, overlapCount);
             }
             overlapArea /= newLabelArea.area();
             auto penalty = penaltyFunction(overlapCount, overlapArea, position, 1);
@@ -215,24 +113,87 @@ void greedy(std::vector<Label> & labels, PenaltyFunction penaltyFunction)
             }
         }
         label.placement = {bestOrigin - label.pointLocation, Alignment::LeftAligned, LineAnchor::Bottom, true};
-        labelAreas.push_back({bestOrigin, extent});
+        if (occupancy)
+            occupancy->occupy({bestOrigin, extent});
+        else
+            labelAreas.push_back({bestOrigin, extent});
     }
 }
 
-void discreteGradientDescent(std::vector<Label> & labels, PenaltyFunction penaltyFunction)
+void priorityPlacement(std::vector<Label> & labels, PenaltyFunction penaltyFunction, OccupancyGrid & occupancy)
 {
-    const std::vector<RelativeLabelPosition> positions {
-        RelativeLabelPosition::UpperRight, RelativeLabelPosition::UpperLeft,
-        RelativeLabelPosition::LowerLeft, RelativeLabelPosition::LowerRight
+    OPENLL_TRACE_ZONE("layout::priorityPlacement");
+    // gathered into a compact array first, as visiting the labels in priority order is a random memory access
+    struct Candidate
+    {
+        glm::vec2 pointLocation;
+        glm::vec2 extent;
+        unsigned int priority;
+        unsigned int index;
     };
+    // only labels with a candidate in the grid, i.e., the view, are sorted and placed, all others are hidden
+    std::vector<Candidate> candidates;
+    candidates.reserve(labels.size());
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        auto & label = labels[i];
+        const auto extent = label.sequence.extent();
+        // the four corner candidates span the point location +- extent
+        if (!occupancy.covers({label.pointLocation - extent, 2.f * extent}))
+        {
+            label.placement = {{0.f, 0.f}, Alignment::LeftAligned, LineAnchor::Bottom, false};
+            continue;
+        }
+        candidates.push_back({label.pointLocation, extent, label.priority, static_cast<unsigned int>(i)});
+    }
+    OPENLL_TRACE_COUNTER("labels in view", static_cast<long long>(candidates.size()));
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate & a, const Candidate & b) { return a.priority > b.priority; });
+
+    const auto & positions = cornerPositions();
+    for (const auto & candidate : candidates)
+    {
+        auto bestPenalty = penaltyFunction(0, 0.f, RelativeLabelPosition::Hidden, candidate.priority);
+        auto visible = false;
+        glm::vec2 bestOrigin;
+        for (const auto & position : positions)
+        {
+            const LabelArea labelArea {labelOrigin(position, candidate.pointLocation, candidate.extent), candidate.extent};
+            const auto area = labelArea.area();
+            const auto overlapArea = area > 0.f ? occupancy.occupiedArea(labelArea) / area : 0.f;
+            const auto penalty = penaltyFunction(overlapArea > 0.f ? 1 : 0, overlapArea, position, candidate.priority);
+            if (penalty < bestPenalty)
+            {
+                bestPenalty = penalty;
+                bestOrigin = labelArea.origin;
+                visible = true;
+            }
+        }
 
+        auto & placement = labels[candidate.index].placement;
+        if (!visible)
+        {
+            placement = {{0.f, 0.f}, Alignment::LeftAligned, LineAnchor::Bottom, false};
+            continue;
+        }
+        placement = {bestOrigin - candidate.pointLocation, Alignment::LeftAligned, LineAnchor::Bottom, true};
+        occupancy.occupy({bestOrigin, candidate.extent});
+    }
+}
+
+void discreteGradientDescent(std::vector<Label> & labels, PenaltyFunction penaltyFunction, const LayoutBudget & budget)
+{
+    OPENLL_TRACE_ZONE("layout::discreteGradientDescent");
+    // every sweep only improves the placement, so the current one is the best one when the budget is exceeded
+    LayoutDeadline deadline(budget, 1);
+
+    const auto & positions = cornerPositions();
     const std::vector<std::vector<LabelArea>> labelAreas = computeLabelAreas(labels, positions);
     std::vector<unsigned int> chosenLabels = randomStartLabelAreas(labelAreas);
     const auto collisionGraph = createCollisionGraph(labelAreas);
     const auto chosenLabel = [&](unsigned int i) { return labelAreas[i][chosenLabels[i]]; };
 
     // upper limit to iterations
-    for (int iteration = 0; iteration < 1000; ++iteration)
+    for (int iteration = 0; iteration < 1000 && deadline.iterate(); ++iteration)
     {
         float bestImprovement = 0.f;
         int bestLabelIndex = -1;
@@ -240,6 +201,10 @@ void discreteGradientDescent(std::vector<Label> & labels, PenaltyFunction penalt
         size_t labelIndex = 0;
         for (auto & singleLabelAreas : labelAreas)
         {
+            // sweeps over many labels may take longer than the budget, so it is checked within as well
+            if ((labelIndex & 255) == 255 && deadline.expired())
+                break;
+
             std::vector<float> penalties;
             int bestIndex = 0;
             for (size_t index = 0; index < singleLabelAreas.size(); ++index)
@@ -282,85 +247,31 @@ void discreteGradientDescent(std::vector<Label> & labels, PenaltyFunction penalt
     }
 }
 
-void simulatedAnnealing(std::vector<Label> & labels, PenaltyFunction penaltyFunction, bool allowSelection, const glm::vec2 & relativePadding)
+void simulatedAnnealing(std::vector<Label> & labels, PenaltyFunction penaltyFunction, bool allowSelection, const glm::vec2 & relativePadding, const LayoutBudget & budget, const ObstacleIndex * obstacles)
 {
-    // based on https://www.eecs.harvard.edu/shieber/Biblio/Papers/tog-final.pdf
-
-    const std::vector<RelativeLabelPosition> positions {
-        RelativeLabelPosition::UpperRight, RelativeLabelPosition::UpperLeft,
-        RelativeLabelPosition::LowerLeft, RelativeLabelPosition::LowerRight
-    };
-
-    const std::vector<std::vector<LabelArea>> labelAreas = computeLabelAreas(labels, positions);
-    std::vector<unsigned int> chosenLabels = randomStartLabelAreas(labelAreas);
-    const auto collisionGraph = createCollisionGraph(labelAreas, relativePadding);
-    const auto chosenLabel = [&](unsigned int i) { return labelAreas[i][chosenLabels[i]]; };
-
-    std::default_random_engine generator;
-    std::uniform_int_distribution<unsigned int> labelDistribution(0, labels.size() - 1);
-
-    float temperature = 0.91023922662f;
-    unsigned int temperatureChanges = 0;
-    unsigned int changesAtTemperature = 0;
-    unsigned int stepsAtTemperature = 0;
-
-    while (true)
-    {
-        const auto labelIndex = labelDistribution(generator);
-        const auto oldPosition = chosenLabels[labelIndex];
-        const auto newPosition = randomIndexExcept<unsigned int>(oldPosition, labelAreas[labelIndex].size() + (allowSelection ? 1 : 0), generator);
-        const auto oldHidden = oldPosition == labelAreas[labelIndex].size();
-        const auto newHidden = newPosition == labelAreas[labelIndex].size();
-
-        const auto computePenalty = [&](const LabelArea & labelArea, size_t position, bool hidden, unsigned int priority)
-        {
-            if (hidden)
-                return penaltyFunction(0, 0.f, RelativeLabelPosition::Hidden, priority);
-            float overlapArea = 0.f;
-            int overlapCount = 0;
-            for (const auto & collision : collisionGraph[labelIndex][position])
-            {
-                if (chosenLabels[collision.index] != collision.position)
-                    continue;
-                overlapArea += collision.overlapArea;
-                ++overlapCount;
-            }
-            overlapArea /= labelArea.area();
-            return penaltyFunction(overlapCount, overlapArea, positions[position], priority);
-        };
-
-        const auto oldPenalty = computePenalty(chosenLabel(labelIndex), oldPosition, oldHidden, labels[labelIndex].priority);
-        const auto newPenalty = computePenalty(labelAreas[labelIndex][newPosition], newPosition, newHidden, labels[labelIndex].priority);
-        const auto improvement = oldPenalty - newPenalty;
-
-        float chance = std::exp(improvement / temperature);
-        std::bernoulli_distribution doAnyway(chance);
-        if (improvement > 0 || doAnyway(generator))
-        {
-            chosenLabels[labelIndex] = newPosition;
-            ++changesAtTemperature;
-        }
-
-        ++stepsAtTemperature;
-        if (changesAtTemperature > 5 * labels.size() || stepsAtTemperature > 20 * labels.size())
-        {
-            // converged
-            if (changesAtTemperature == 0) break;
-            if (temperatureChanges == 50) break;
+    OPENLL_TRACE_ZONE("layout::simulatedAnnealing");
+    LayoutDeadline deadline(budget);
+    AnnealingSolver solver(labels, penaltyFunction, allowSelection, relativePadding, obstacles);
+    solver.run(deadline);
+    solver.apply(labels);
+}
 
-            temperature *= 0.9f;
-            changesAtTemperature = 0;
-            stepsAtTemperature = 0;
-            ++temperatureChanges;
-        }
-    }
+void slidingPlacement(std::vector<Label> & labels, PenaltyFunction penaltyFunction, unsigned int slidingPositions, bool allowSelection, const glm::vec2 & relativePadding, float displacementPenalty, const LayoutBudget & budget, const ObstacleIndex * obstacles)
+{
+    OPENLL_TRACE_ZONE("layout::slidingPlacement");
+    LayoutDeadline deadline(budget);
+    CandidateLayout layout(labels, candidatePositions(slidingPositions), penaltyFunction, allowSelection, relativePadding, displacementPenalty, obstacles);
+    layout.run(deadline);
+    layout.apply(labels);
+}
 
-    for (size_t i = 0; i < labels.size(); ++i)
-    {
-        const auto visible = chosenLabels[i] != labelAreas[i].size();
-        const auto position = visible ? (chosenLabel(i).origin - labels[i].pointLocation) : glm::vec2(0.f);
-        labels[i].placement = {position, Alignment::LeftAligned, LineAnchor::Bottom, visible};
-    }
+void coherentAnnealing(std::vector<Label> & labels, const std::vector<LabelPlacement> & previousPlacements, PenaltyFunction penaltyFunction, bool allowSelection, const glm::vec2 & relativePadding, float hysteresis, const LayoutBudget & budget, const ObstacleIndex * obstacles)
+{
+    OPENLL_TRACE_ZONE("layout::coherentAnnealing");
+    LayoutDeadline deadline(budget);
+    AnnealingSolver solver(labels, previousPlacements, penaltyFunction, allowSelection, relativePadding, hysteresis, obstacles);
+    solver.run(deadline);
+    solver.apply(labels);
 }
 
 } // namespace layout
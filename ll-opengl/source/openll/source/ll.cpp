@@ -0,0 +1,336 @@
+#include <openll/ll.h>
+
+#include <new>
+#include <string>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFace.h>
+#include <openll/FontFaceRegistry.h>
+#include <openll/FontLoader.h>
+#include <openll/GlyphSequence.h>
+#include <openll/GlyphVertexCloud.h>
+#include <openll/HandleTable.h>
+#include <openll/stages/GlyphPreparationStage.h>
+
+
+namespace
+{
+
+using gloperate_text::HandleTable;
+
+struct SequenceObject
+{
+    SequenceObject()
+    : fontFace(0)
+    {
+    }
+
+    gloperate_text::GlyphSequence sequence;
+    llFontFace fontFace;
+    // keeps the font face alive while the sequence points to it
+    globjects::ref_ptr<gloperate_text::FontFace> resolved;
+};
+
+struct State
+{
+    HandleTable<globjects::ref_ptr<gloperate_text::FontFace>> fontFaces;
+    HandleTable<SequenceObject> sequences;
+    HandleTable<gloperate_text::GlyphVertexCloud> vertexClouds;
+
+    // reused by llUpdateGlyphVertexCloud, the sequences stay owned by their objects
+    std::vector<const gloperate_text::GlyphSequence *> preparedSequences;
+};
+
+State & state()
+{
+    static State state;
+    return state;
+}
+
+template <typename T, typename Factory>
+llResult create(HandleTable<T> & table, std::uint32_t * handle, Factory factory)
+{
+    if (!handle)
+        return LL_ERROR_INVALID_VALUE;
+
+    try
+    {
+        *handle = table.insert(factory());
+    }
+    catch (const std::bad_alloc &)
+    {
+        *handle = 0;
+        return LL_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    return *handle != 0 ? LL_SUCCESS : LL_ERROR_TOO_MANY_OBJECTS;
+}
+
+template <typename T>
+llResult destroy(HandleTable<T> & table, std::uint32_t handle)
+{
+    return table.erase(handle) ? LL_SUCCESS : LL_OBJECT_DOES_NOT_EXISTS;
+}
+
+// points the sequence to the current object of its font face handle
+llResult resolveFontFace(SequenceObject & object)
+{
+    const auto fontFace = state().fontFaces.get(object.fontFace);
+    if (!fontFace)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+
+    // changing the font face invalidates the cached extent of the sequence
+    if (object.resolved.get() != fontFace->get())
+    {
+        object.resolved = *fontFace;
+        object.sequence.setFontFace(object.resolved.get());
+    }
+    return LL_SUCCESS;
+}
+
+}
+
+
+llResult llCreateFontFace(llFontFace * fontFace)
+{
+    return create(state().fontFaces, fontFace, []() { return globjects::ref_ptr<gloperate_text::FontFace>(new gloperate_text::FontFace); });
+}
+
+llSize llGetMaxFontFaceObjects(void)
+{
+    return static_cast<llSize>(HandleTable<globjects::ref_ptr<gloperate_text::FontFace>>::maxObjects);
+}
+
+llResult llDestroyFontFace(llFontFace fontFace)
+{
+    return destroy(state().fontFaces, fontFace);
+}
+
+llResult llLoadFontFace(llFontFace fontFace, const char * filename, llBool uploadGlyphTexture)
+{
+    const auto object = state().fontFaces.get(fontFace);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+    if (!filename)
+        return LL_ERROR_INVALID_VALUE;
+
+    try
+    {
+        // font faces of the same file are shared, they are not modified through the api
+        const auto loaded = gloperate_text::FontFaceRegistry::instance().load(filename, gloperate_text::FontLoader(uploadGlyphTexture != LL_FALSE));
+        if (!loaded)
+            return LL_ERROR_LOADING_FAILED;
+        *object = loaded;
+    }
+    catch (const std::bad_alloc &)
+    {
+        return LL_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    return LL_SUCCESS;
+}
+
+llResult llGetFontFaceSize(llFontFace fontFace, llPointSize * size)
+{
+    const auto object = state().fontFaces.get(fontFace);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+    if (!size)
+        return LL_ERROR_INVALID_VALUE;
+
+    *size = (*object)->size();
+    return LL_SUCCESS;
+}
+
+llResult llGetFontFaceLineHeight(llFontFace fontFace, float * lineHeight)
+{
+    const auto object = state().fontFaces.get(fontFace);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+    if (!lineHeight)
+        return LL_ERROR_INVALID_VALUE;
+
+    *lineHeight = (*object)->lineHeight();
+    return LL_SUCCESS;
+}
+
+
+llResult llCreateGlyphSequence(llGlyphSequence * sequence)
+{
+    return create(state().sequences, sequence, []() { return SequenceObject(); });
+}
+
+llSize llGetMaxGlyphSequenceObjects(void)
+{
+    return static_cast<llSize>(HandleTable<SequenceObject>::maxObjects);
+}
+
+llResult llDestroyGlyphSequence(llGlyphSequence sequence)
+{
+    return destroy(state().sequences, sequence);
+}
+
+llResult llSetGlyphSequenceFontFace(llGlyphSequence sequence, llFontFace fontFace)
+{
+    const auto object = state().sequences.get(sequence);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+    if (!state().fontFaces.contains(fontFace))
+        return LL_OBJECT_DOES_NOT_EXISTS;
+
+    object->fontFace = fontFace;
+    return resolveFontFace(*object);
+}
+
+llResult llSetGlyphSequenceString(llGlyphSequence sequence, const llUTF32 * string, llSize length)
+{
+    const auto object = state().sequences.get(sequence);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+    if (!string && length > 0)
+        return LL_ERROR_INVALID_VALUE;
+
+    try
+    {
+        object->sequence.setString(length > 0 ? std::u32string(string, string + length) : std::u32string());
+    }
+    catch (const std::bad_alloc &)
+    {
+        return LL_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    return LL_SUCCESS;
+}
+
+llResult llSetGlyphSequenceFontSize(llGlyphSequence sequence, llPointSize fontSize)
+{
+    const auto object = state().sequences.get(sequence);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+
+    object->sequence.setFontSize(fontSize);
+    return LL_SUCCESS;
+}
+
+llResult llSetGlyphSequenceFontColor(llGlyphSequence sequence, const float * color)
+{
+    const auto object = state().sequences.get(sequence);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+    if (!color)
+        return LL_ERROR_INVALID_VALUE;
+
+    object->sequence.setFontColor(glm::vec4(color[0], color[1], color[2], color[3]));
+    return LL_SUCCESS;
+}
+
+llResult llSetGlyphSequenceTransform(llGlyphSequence sequence, const float * transform)
+{
+    const auto object = state().sequences.get(sequence);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+    if (!transform)
+        return LL_ERROR_INVALID_VALUE;
+
+    glm::mat4 matrix;
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+            matrix[column][row] = transform[column * 4 + row];
+    }
+    object->sequence.setAdditionalTransform(matrix);
+    return LL_SUCCESS;
+}
+
+llResult llGetGlyphSequenceExtent(llGlyphSequence sequence, float * extent)
+{
+    const auto object = state().sequences.get(sequence);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+    if (!extent)
+        return LL_ERROR_INVALID_VALUE;
+
+    const auto result = resolveFontFace(*object);
+    if (result != LL_SUCCESS)
+        return result;
+
+    try
+    {
+        const auto & sequenceExtent = object->sequence.extent();
+        extent[0] = sequenceExtent.x;
+        extent[1] = sequenceExtent.y;
+    }
+    catch (const std::bad_alloc &)
+    {
+        return LL_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    return LL_SUCCESS;
+}
+
+
+llResult llCreateGlyphVertexCloud(llGlyphVertexCloud * vertexCloud)
+{
+    return create(state().vertexClouds, vertexCloud, []() { return gloperate_text::GlyphVertexCloud(); });
+}
+
+llSize llGetMaxGlyphVertexCloudObjects(void)
+{
+    return static_cast<llSize>(HandleTable<gloperate_text::GlyphVertexCloud>::maxObjects);
+}
+
+llResult llDestroyGlyphVertexCloud(llGlyphVertexCloud vertexCloud)
+{
+    return destroy(state().vertexClouds, vertexCloud);
+}
+
+llResult llUpdateGlyphVertexCloud(llGlyphVertexCloud vertexCloud, const llGlyphSequence * sequences, llSize count
+    , llBool optimized, llBool upload)
+{
+    auto & current = state();
+    const auto object = current.vertexClouds.get(vertexCloud);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+    if (!sequences && count > 0)
+        return LL_ERROR_INVALID_VALUE;
+
+    // validate all handles before the cloud is changed
+    for (llSize i = 0; i < count; ++i)
+    {
+        const auto sequence = current.sequences.get(sequences[i]);
+        if (!sequence)
+            return LL_OBJECT_DOES_NOT_EXISTS;
+        const auto result = resolveFontFace(*sequence);
+        if (result != LL_SUCCESS)
+            return result;
+    }
+
+    try
+    {
+        auto & prepared = current.preparedSequences;
+        prepared.clear();
+        for (llSize i = 0; i < count; ++i)
+            prepared.push_back(&current.sequences.get(sequences[i])->sequence);
+
+        *object = gloperate_text::prepareGlyphs(prepared, optimized != LL_FALSE, upload != LL_FALSE);
+        prepared.clear();
+    }
+    catch (const std::bad_alloc &)
+    {
+        return LL_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    return LL_SUCCESS;
+}
+
+llResult llGetGlyphVertexCloudSize(llGlyphVertexCloud vertexCloud, llSize * size)
+{
+    const auto object = state().vertexClouds.get(vertexCloud);
+    if (!object)
+        return LL_OBJECT_DOES_NOT_EXISTS;
+    if (!size)
+        return LL_ERROR_INVALID_VALUE;
+
+    *size = static_cast<llSize>(object->vertices().size());
+    return LL_SUCCESS;
+}
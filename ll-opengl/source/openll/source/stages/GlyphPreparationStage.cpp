@@ -1,42 +1,90 @@
 
 #include <openll/stages/GlyphPreparationStage.h>
 
+#include <algorithm>
 #include <cassert>
 
 #include <openll/FontFace.h>
 #include <openll/GlyphSequence.h>
+#include <openll/RenderBackend.h>
+#include <openll/TaskPool.h>
+#include <openll/Trace.h>
 #include <openll/Typesetter.h>
 
 
 namespace gloperate_text
 {
 
-OPENLL_API GlyphVertexCloud prepareGlyphs(const std::vector<GlyphSequence>& sequences, bool optimized)
+namespace
+{
+
+// sequences per task of the parallel typesetting
+const size_t sequencesPerTask = 256;
+
+const GlyphSequence & sequenceAt(const std::vector<GlyphSequence> & sequences, size_t index)
+{
+    return sequences[index];
+}
+
+const GlyphSequence & sequenceAt(const std::vector<const GlyphSequence *> & sequences, size_t index)
+{
+    return *sequences[index];
+}
+
+template <typename Sequences>
+GlyphVertexCloud prepare(const Sequences & sequences, bool optimized, bool upload, TaskPool * pool, RenderBackend * backend)
 {
     if (sequences.empty())
     {
-        return {};
+        return GlyphVertexCloud(backend);
     }
 
-    // get total number of glyphs
+    const auto parallel = pool && sequences.size() > sequencesPerTask;
+
+    // get total number of glyphs and the first vertex of each sequence
     auto numGlyphs = size_t(0u);
-    for (const auto & sequence : sequences)
-        numGlyphs += sequence.depictableSize();
+    std::vector<size_t> offsets(parallel ? sequences.size() : 0);
+    for (size_t i = 0; i < sequences.size(); ++i)
+    {
+        if (parallel)
+            offsets[i] = numGlyphs;
+        numGlyphs += sequenceAt(sequences, i).depictableSize();
+    }
+    OPENLL_TRACE_COUNTER("glyphs", numGlyphs);
 
     // prepare vertex cloud storage
-    GlyphVertexCloud vertexCloud;
+    GlyphVertexCloud vertexCloud(backend);
     vertexCloud.vertices().resize(numGlyphs);
 
-    auto index = vertexCloud.vertices().begin();
-    for (const auto & sequence : sequences)
+    if (parallel)
     {
-        Typesetter::typeset(sequence, index);
-        index += sequence.depictableSize();
+        const auto tasks = (sequences.size() + sequencesPerTask - 1) / sequencesPerTask;
+        pool->run(tasks, [&](size_t task)
+        {
+            const auto end = std::min((task + 1) * sequencesPerTask, sequences.size());
+            for (auto i = task * sequencesPerTask; i < end; ++i)
+                Typesetter::typeset(sequenceAt(sequences, i), vertexCloud.vertices().begin() + offsets[i]);
+        });
+    }
+    else
+    {
+        auto index = vertexCloud.vertices().begin();
+        for (size_t i = 0; i < sequences.size(); ++i)
+        {
+            const auto & sequence = sequenceAt(sequences, i);
+            Typesetter::typeset(sequence, index);
+            index += sequence.depictableSize();
+        }
     }
 
-    FontFace * face = sequences[0].fontFace();
+    FontFace * face = sequenceAt(sequences, 0).fontFace();
 
-    if(optimized)
+    if (!upload)
+    {
+        if (optimized)
+            vertexCloud.vertices() = vertexCloud.optimizedVertices(sequences);
+    }
+    else if(optimized)
         vertexCloud.optimize(sequences); // optimize and update drawable
     else
         vertexCloud.update(); // update drawable
@@ -46,5 +94,19 @@ OPENLL_API GlyphVertexCloud prepareGlyphs(const std::vector<GlyphSequence>& sequ
     return vertexCloud;
 }
 
+}
+
+OPENLL_API GlyphVertexCloud prepareGlyphs(const std::vector<GlyphSequence>& sequences, bool optimized, bool upload, TaskPool * pool, RenderBackend * backend)
+{
+    OPENLL_TRACE_ZONE("prepareGlyphs");
+    return prepare(sequences, optimized, upload, pool, backend);
+}
+
+OPENLL_API GlyphVertexCloud prepareGlyphs(const std::vector<const GlyphSequence *>& sequences, bool optimized, bool upload, TaskPool * pool, RenderBackend * backend)
+{
+    OPENLL_TRACE_ZONE("prepareGlyphs");
+    return prepare(sequences, optimized, upload, pool, backend);
+}
+
 
 } // namespace gloperate_text
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/FontFace.h>
+#include <openll/layout/algorithm.h>
+#include <openll/layout/AnnealingSolver.h>
+#include <openll/layout/layoutbase.h>
+#include <openll/layout/penalties.h>
+
+#include "../openll-test/LayoutTestFixture.h"
+
+
+// Annealing steps per second of AnnealingSolver (penalty function pointer, std::default_random_engine)
+// and BasicAnnealingSolver (inlined penalty functor, counter-based RNG); items/s are steps/s.
+
+namespace
+{
+
+// steps per benchmark iteration
+const unsigned long long stepsPerIteration = 10000;
+
+// glyphs a to z of 6x10pt, so that no font data is needed
+gloperate_text::FontFace * syntheticFont()
+{
+    static std::unique_ptr<gloperate_text::FontFace> fontFace;
+    if (!fontFace)
+    {
+        fontFace.reset(new gloperate_text::FontFace);
+        layouttest::setMetrics(*fontFace, 10.f);
+        layouttest::addGlyphs(*fontFace, U"abcdefghijklmnopqrstuvwxyz", 6.f, glm::vec2(6.f, 10.f), glm::vec2(0.01f));
+    }
+    return fontFace.get();
+}
+
+// about one label per 40x40 units, so that many labels collide
+std::vector<gloperate_text::Label> labels(size_t count)
+{
+    std::default_random_engine generator;
+    const auto size = 40.f * std::sqrt(static_cast<float>(count));
+    std::uniform_real_distribution<float> locationDistribution(0.f, size);
+    std::uniform_int_distribution<int> lengthDistribution(3, 12);
+    std::uniform_int_distribution<int> charDistribution('a', 'z');
+    std::uniform_int_distribution<unsigned int> priorityDistribution(1, 10);
+
+    std::vector<gloperate_text::Label> result;
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::u32string string;
+        const auto length = lengthDistribution(generator);
+        for (int c = 0; c < length; ++c)
+            string.push_back(static_cast<char32_t>(charDistribution(generator)));
+
+        const auto location = glm::vec2(locationDistribution(generator), locationDistribution(generator));
+        result.push_back(layouttest::label(layouttest::sequence(*syntheticFont(), string), location, priorityDistribution(generator)));
+    }
+    return result;
+}
+
+// runs the annealing in slices of stepsPerIteration, a converged solver is replaced outside the measurement
+template <typename Factory>
+void anneal(benchmark::State & state, Factory factory)
+{
+    const auto budget = gloperate_text::layout::LayoutBudget(gloperate_text::layout::LayoutBudget::Clock::duration::max(), stepsPerIteration);
+    const auto input = labels(static_cast<size_t>(state.range(0)));
+    auto solver = factory(input);
+    auto steps = 0ull;
+
+    for (auto _ : state)
+    {
+        const auto before = solver->steps();
+        if (solver->run(budget))
+        {
+            steps += solver->steps() - before;
+            state.PauseTiming();
+            solver = factory(input);
+            state.ResumeTiming();
+            continue;
+        }
+        steps += solver->steps() - before;
+    }
+    state.SetItemsProcessed(static_cast<long long>(steps));
+}
+
+}
+
+
+static void AnnealingSolver_functionPointer(benchmark::State & state, gloperate_text::layout::PenaltyFunction penaltyFunction)
+{
+    anneal(state, [penaltyFunction](const std::vector<gloperate_text::Label> & labels)
+    {
+        return std::unique_ptr<gloperate_text::layout::AnnealingSolver>(new gloperate_text::layout::AnnealingSolver(labels, penaltyFunction));
+    });
+}
+BENCHMARK_CAPTURE(AnnealingSolver_functionPointer, standard, gloperate_text::layout::standard)->Arg(2000);
+BENCHMARK_CAPTURE(AnnealingSolver_functionPointer, overlapArea, gloperate_text::layout::overlapArea)->Arg(2000);
+BENCHMARK_CAPTURE(AnnealingSolver_functionPointer, overlapCount, gloperate_text::layout::overlapCount)->Arg(2000);
+
+static void BasicAnnealingSolver_functionPenalty(benchmark::State & state, gloperate_text::layout::PenaltyFunction penaltyFunction)
+{
+    using Solver = gloperate_text::layout::BasicAnnealingSolver<gloperate_text::layout::FunctionPenalty>;
+    anneal(state, [penaltyFunction](const std::vector<gloperate_text::Label> & labels)
+    {
+        return std::unique_ptr<Solver>(new Solver(labels, penaltyFunction));
+    });
+}
+BENCHMARK_CAPTURE(BasicAnnealingSolver_functionPenalty, standard, gloperate_text::layout::standard)->Arg(2000);
+BENCHMARK_CAPTURE(BasicAnnealingSolver_functionPenalty, overlapArea, gloperate_text::layout::overlapArea)->Arg(2000);
+BENCHMARK_CAPTURE(BasicAnnealingSolver_functionPenalty, overlapCount, gloperate_text::layout::overlapCount)->Arg(2000);
+
+template <typename Penalty>
+static void BasicAnnealingSolver_functor(benchmark::State & state)
+{
+    using Solver = gloperate_text::layout::BasicAnnealingSolver<Penalty>;
+    anneal(state, [](const std::vector<gloperate_text::Label> & labels)
+    {
+        return std::unique_ptr<Solver>(new Solver(labels));
+    });
+}
+BENCHMARK_TEMPLATE(BasicAnnealingSolver_functor, gloperate_text::layout::StandardPenalty)->Arg(2000);
+BENCHMARK_TEMPLATE(BasicAnnealingSolver_functor, gloperate_text::layout::OverlapAreaPenalty)->Arg(2000);
+BENCHMARK_TEMPLATE(BasicAnnealingSolver_functor, gloperate_text::layout::OverlapCountPenalty)->Arg(2000);
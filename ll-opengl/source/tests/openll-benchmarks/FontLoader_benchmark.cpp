@@ -0,0 +1,31 @@
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFace.h>
+#include <openll/FontLoader.h>
+
+
+// opensansr144 is not benchmarked, its glyph atlas is not part of the data directory
+static void FontLoader_load(benchmark::State & state, const std::string & name)
+{
+    // parses the font description and reads the glyph atlas, the texture upload is skipped
+    const gloperate_text::FontLoader loader(false);
+    const auto filename = std::string(OPENLL_DATA_PATH) + "/fonts/" + name + "/" + name + ".fnt";
+
+    for (auto _ : state)
+    {
+        globjects::ref_ptr<gloperate_text::FontFace> fontFace = loader.load(filename);
+        if (!fontFace)
+        {
+            state.SkipWithError(("cannot load " + filename).c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(fontFace.get());
+    }
+}
+BENCHMARK_CAPTURE(FontLoader_load, opensansr36, std::string("opensansr36"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(FontLoader_load, opensansr72, std::string("opensansr72"))->Unit(benchmark::kMillisecond);
@@ -0,0 +1,68 @@
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/GlyphSequence.h>
+#include <openll/GlyphVertexCloud.h>
+#include <openll/NullRenderBackend.h>
+#include <openll/stages/GlyphPreparationStage.h>
+
+#include "fixtures.h"
+
+
+// the numbers of short labels
+static void batchSizes(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->RangeMultiplier(8)->Range(1, 32768);
+}
+
+static void GlyphVertexCloud_optimize(benchmark::State & state)
+{
+    const auto labels = shortLabels(font("opensansr36"), static_cast<size_t>(state.range(0)));
+    // sorts the vertices by glyph, the upload of optimize is skipped
+    const auto cloud = gloperate_text::prepareGlyphs(labels, false, false);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(cloud.optimizedVertices(labels).data());
+    state.SetItemsProcessed(state.iterations() * cloud.vertices().size());
+}
+BENCHMARK(GlyphVertexCloud_optimize)->Apply(batchSizes);
+
+static void prepareGlyphs(benchmark::State & state, bool optimized)
+{
+    const auto labels = shortLabels(font("opensansr36"), static_cast<size_t>(state.range(0)));
+    auto glyphs = size_t(0);
+
+    for (auto _ : state)
+    {
+        // typesets and optimizes without creating the drawable
+        const auto cloud = gloperate_text::prepareGlyphs(labels, optimized, false);
+        glyphs = cloud.vertices().size();
+        benchmark::DoNotOptimize(cloud.vertices().data());
+    }
+    state.SetItemsProcessed(state.iterations() * glyphs);
+}
+BENCHMARK_CAPTURE(prepareGlyphs, unoptimized, false)->Apply(batchSizes);
+BENCHMARK_CAPTURE(prepareGlyphs, optimized, true)->Apply(batchSizes);
+
+static void prepareGlyphsUploaded(benchmark::State & state, bool optimized)
+{
+    const auto labels = shortLabels(font("opensansr36"), static_cast<size_t>(state.range(0)));
+    globjects::ref_ptr<gloperate_text::NullRenderBackend> backend = new gloperate_text::NullRenderBackend;
+    auto glyphs = size_t(0);
+
+    for (auto _ : state)
+    {
+        // the full preparation including the upload calls, which only count the bytes
+        const auto cloud = gloperate_text::prepareGlyphs(labels, optimized, true, nullptr, backend);
+        glyphs = cloud.vertices().size();
+        benchmark::DoNotOptimize(cloud.vertices().data());
+    }
+    state.SetItemsProcessed(state.iterations() * glyphs);
+    state.SetBytesProcessed(backend->counters().uploadedBytes);
+}
+BENCHMARK_CAPTURE(prepareGlyphsUploaded, unoptimized, false)->Apply(batchSizes);
+BENCHMARK_CAPTURE(prepareGlyphsUploaded, optimized, true)->Apply(batchSizes);
@@ -0,0 +1,83 @@
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <openll/GlyphSequence.h>
+#include <openll/GlyphVertexCloud.h>
+#include <openll/Typesetter.h>
+
+#include "fixtures.h"
+
+
+namespace
+{
+
+std::vector<gloperate_text::GlyphSequence> sequences(bool wrapped, size_t count)
+{
+    const auto fontFace = font("opensansr36");
+    return wrapped ? wrappedTexts(fontFace, count) : shortLabels(fontFace, count);
+}
+
+size_t glyphCount(const std::vector<gloperate_text::GlyphSequence> & sequences)
+{
+    auto count = size_t(0);
+    for (const auto & sequence : sequences)
+        count += sequence.size();
+    return count;
+}
+
+}
+
+
+// GlyphSequence caches its extent, so that the uncached dry run of the typesetter is measured
+static void Typesetter_extent(benchmark::State & state, bool wrapped)
+{
+    const auto labels = sequences(wrapped, 100);
+
+    for (auto _ : state)
+    {
+        for (const auto & sequence : labels)
+            benchmark::DoNotOptimize(gloperate_text::Typesetter::typeset(sequence, gloperate_text::GlyphVertexCloud::Vertices::iterator(), true));
+    }
+    state.SetItemsProcessed(state.iterations() * glyphCount(labels));
+}
+BENCHMARK_CAPTURE(Typesetter_extent, shortLabels, false);
+BENCHMARK_CAPTURE(Typesetter_extent, wrappedText, true);
+
+static void Typesetter_typeset(benchmark::State & state, bool wrapped)
+{
+    const auto labels = sequences(wrapped, 100);
+    auto depictableSize = size_t(0);
+    for (const auto & sequence : labels)
+        depictableSize += sequence.depictableSize();
+    gloperate_text::GlyphVertexCloud::Vertices vertices(depictableSize);
+
+    for (auto _ : state)
+    {
+        auto vertex = vertices.begin();
+        for (const auto & sequence : labels)
+        {
+            gloperate_text::Typesetter::typeset(sequence, vertex);
+            vertex += sequence.depictableSize();
+        }
+        benchmark::DoNotOptimize(vertices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * glyphCount(labels));
+}
+BENCHMARK_CAPTURE(Typesetter_typeset, shortLabels, false);
+BENCHMARK_CAPTURE(Typesetter_typeset, wrappedText, true);
+
+static void GlyphSequence_depictableSize(benchmark::State & state, bool wrapped)
+{
+    const auto labels = sequences(wrapped, 100);
+
+    for (auto _ : state)
+    {
+        for (const auto & sequence : labels)
+            benchmark::DoNotOptimize(sequence.depictableSize());
+    }
+    state.SetItemsProcessed(state.iterations() * glyphCount(labels));
+}
+BENCHMARK_CAPTURE(GlyphSequence_depictableSize, shortLabels, false);
+BENCHMARK_CAPTURE(GlyphSequence_depictableSize, wrappedText, true);
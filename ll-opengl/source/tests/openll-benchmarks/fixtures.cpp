@@ -0,0 +1,77 @@
+#include "fixtures.h"
+
+#include <map>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFace.h>
+#include <openll/FontLoader.h>
+
+namespace
+{
+
+const char * const names[] = {
+    "Berlin", "Potsdam Hauptbahnhof", "Brandenburg an der Havel", "Cottbus", "Frankfurt (Oder)",
+    "Eberswalde", "Oranienburg", "Neuruppin", "Luckenwalde", "Wusterhausen/Dosse",
+};
+
+const char * const paragraph =
+    "Typesetting converts a sequence of characters into positioned glyphs. Each glyph advances the pen "
+    "by its advance width and the kerning to the subsequent glyph; lines are broken at the last space "
+    "before the line width is exceeded. ";
+
+std::u32string toU32(const std::string & string)
+{
+    return std::u32string(string.begin(), string.end());
+}
+
+gloperate_text::GlyphSequence sequence(gloperate_text::FontFace * fontFace, const std::u32string & string)
+{
+    gloperate_text::GlyphSequence sequence;
+    sequence.setString(string);
+    sequence.setFontFace(fontFace);
+    sequence.setFontSize(16.f);
+    return sequence;
+}
+
+}
+
+gloperate_text::FontFace * font(const std::string & name)
+{
+    static std::map<std::string, globjects::ref_ptr<gloperate_text::FontFace>> fonts;
+
+    auto & fontFace = fonts[name];
+    if (!fontFace)
+    {
+        const gloperate_text::FontLoader loader(false);
+        fontFace = loader.load(std::string(OPENLL_DATA_PATH) + "/fonts/" + name + "/" + name + ".fnt");
+    }
+    return fontFace;
+}
+
+std::vector<gloperate_text::GlyphSequence> shortLabels(gloperate_text::FontFace * fontFace, size_t count)
+{
+    const auto nameCount = sizeof(names) / sizeof(names[0]);
+    std::vector<gloperate_text::GlyphSequence> sequences;
+    sequences.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        sequences.push_back(sequence(fontFace, toU32(names[i % nameCount])));
+    return sequences;
+}
+
+std::vector<gloperate_text::GlyphSequence> wrappedTexts(gloperate_text::FontFace * fontFace, size_t count)
+{
+    std::string text;
+    while (text.size() < 1000)
+        text += paragraph;
+
+    std::vector<gloperate_text::GlyphSequence> sequences;
+    sequences.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        sequences.push_back(sequence(fontFace, toU32(text)));
+        sequences.back().setWordWrap(true);
+        sequences.back().setLineWidth(400.f);
+    }
+    return sequences;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <openll/GlyphSequence.h>
+
+namespace gloperate_text
+{
+class FontFace;
+}
+
+// the fonts of the data directory, loaded without uploading the glyph textures
+gloperate_text::FontFace * font(const std::string & name);
+
+// place names of 5 to 25 characters, as used for point labels
+std::vector<gloperate_text::GlyphSequence> shortLabels(gloperate_text::FontFace * fontFace, size_t count);
+
+// paragraphs of about 1000 characters, wrapped at a line width of 400pt
+std::vector<gloperate_text::GlyphSequence> wrappedTexts(gloperate_text::FontFace * fontFace, size_t count);
@@ -0,0 +1,137 @@
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+
+#include <openll/layout/algorithm.h>
+#include <openll/layout/CandidateLayout.h>
+#include <openll/layout/CandidatePosition.h>
+#include <openll/layout/CollisionGraph.h>
+#include <openll/layout/LabelArea.h>
+#include <openll/layout/layoutbase.h>
+
+#include "LayoutTestFixture.h"
+
+class CandidateLayout_test: public testing::Test, public LayoutTestFixture
+{
+public:
+    // labels of 20x10 units at random locations
+    std::vector<gloperate_text::Label> randomLabels(size_t count, float size)
+    {
+        std::default_random_engine generator;
+        std::uniform_real_distribution<float> coordinate(0.f, size);
+        std::uniform_int_distribution<unsigned int> priority(1, 10);
+        std::vector<gloperate_text::Label> labels;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const glm::vec2 location(coordinate(generator), coordinate(generator));
+            labels.push_back(label(location, priority(generator)));
+        }
+        return labels;
+    }
+};
+
+TEST_F(CandidateLayout_test, CandidatePositionsStartWithCorners)
+{
+    const auto positions = gloperate_text::layout::candidatePositions(3);
+    ASSERT_EQ(8u + 8u * 3u, positions.size());
+
+    const glm::vec2 point(5.f, 7.f);
+    const glm::vec2 extent(20.f, 10.f);
+    const auto & corners = gloperate_text::layout::cornerPositions();
+    for (size_t i = 0; i < corners.size(); ++i)
+    {
+        const auto origin = gloperate_text::layout::candidateOrigin(positions[i], point, extent);
+        EXPECT_EQ(gloperate_text::labelOrigin(corners[i], point, extent), origin);
+        EXPECT_EQ(corners[i], positions[i].corner);
+        EXPECT_EQ(0.f, positions[i].displacement);
+    }
+
+    for (const auto & position : positions)
+    {
+        // the point lies on the border of the label
+        const auto onVerticalSide = position.anchor.x == 0.f || position.anchor.x == 1.f;
+        const auto onHorizontalSide = position.anchor.y == 0.f || position.anchor.y == 1.f;
+        EXPECT_TRUE(onVerticalSide || onHorizontalSide);
+        EXPECT_LE(position.displacement, 0.5f);
+    }
+}
+
+TEST_F(CandidateLayout_test, PrunedCollisionGraphMatchesPairwiseTests)
+{
+    const auto labels = randomLabels(200, 250.f);
+    const auto labelAreas = gloperate_text::layout::computeCandidateAreas(labels, gloperate_text::layout::candidatePositions(1));
+    const glm::vec2 padding(0.2f);
+    const auto graph = gloperate_text::layout::createCollisionGraph(labelAreas, padding);
+
+    for (size_t i = 0; i < labelAreas.size(); ++i)
+    {
+        for (size_t position = 0; position < labelAreas[i].size(); ++position)
+        {
+            std::vector<std::tuple<size_t, size_t, float>> expected;
+            for (size_t j = 0; j < labelAreas.size(); ++j)
+            {
+                for (size_t otherPosition = 0; j != i && otherPosition < labelAreas[j].size(); ++otherPosition)
+                {
+                    const auto & area = labelAreas[i][position];
+                    const auto & other = labelAreas[j][otherPosition];
+                    if (area.paddedOverlaps(other, padding))
+                        expected.emplace_back(j, otherPosition, area.paddedOverlapArea(other, padding));
+                }
+            }
+
+            std::vector<std::tuple<size_t, size_t, float>> actual;
+            for (const auto & collision : graph[i][position])
+                actual.emplace_back(collision.index, collision.position, collision.overlapArea);
+            ASSERT_EQ(expected, actual);
+        }
+    }
+}
+
+TEST_F(CandidateLayout_test, IncrementalOverlapsMatchRecomputation)
+{
+    const auto labels = randomLabels(200, 150.f);
+    const auto positions = gloperate_text::layout::candidatePositions(2);
+    const glm::vec2 padding(0.f);
+    gloperate_text::layout::CandidateLayout layout(labels, positions, gloperate_text::layout::overlapArea, true, padding, 0.f);
+    layout.run();
+
+    const auto labelAreas = gloperate_text::layout::computeCandidateAreas(labels, positions);
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        for (unsigned int position = 0; position < positions.size(); ++position)
+        {
+            auto overlapArea = 0.f;
+            for (size_t j = 0; j < labels.size(); ++j)
+            {
+                const auto chosen = layout.chosenPosition(j);
+                if (j != i && chosen < positions.size())
+                    overlapArea += labelAreas[i][position].overlapArea(labelAreas[j][chosen]);
+            }
+            EXPECT_NEAR(overlapArea / labelAreas[i][position].area(), layout.penalty(i, position), 1e-4f);
+        }
+    }
+}
+
+TEST_F(CandidateLayout_test, SlidingPositionsHideFewerLabels)
+{
+    const auto hiddenLabels = [this](unsigned int slidingPositions, bool corners)
+    {
+        auto labels = randomLabels(400, 250.f);
+        auto positions = gloperate_text::layout::candidatePositions(slidingPositions);
+        if (corners)
+            positions.resize(4);
+
+        gloperate_text::layout::CandidateLayout layout(labels, positions, gloperate_text::layout::standard);
+        EXPECT_TRUE(layout.run());
+        layout.apply(labels);
+        return std::count_if(labels.begin(), labels.end(), [](const gloperate_text::Label & label) { return !label.placement.display; });
+    };
+
+    const auto cornersOnly = hiddenLabels(0, true);
+    const auto fixedPositions = hiddenLabels(0, false);
+    const auto slidingPositions = hiddenLabels(2, false);
+    EXPECT_LT(fixedPositions, cornersOnly);
+    EXPECT_LE(slidingPositions, fixedPositions);
+}
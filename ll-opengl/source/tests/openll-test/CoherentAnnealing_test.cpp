@@ -0,0 +1,80 @@
+#include <gmock/gmock.h>
+
+#include <openll/layout/CoherentAnnealing.h>
+#include <openll/layout/ObstacleIndex.h>
+#include <openll/layout/penalties.h>
+#include <openll/layout/layoutbase.h>
+
+#include "LayoutTestFixture.h"
+
+class CoherentAnnealing_test: public testing::Test, public LayoutTestFixture
+{
+};
+
+TEST_F(CoherentAnnealing_test, AnnealsOnlyAffectedLabels)
+{
+    gloperate_text::layout::CoherentAnnealing annealing(gloperate_text::layout::standard, false, glm::vec2(0.f));
+    for (int i = 0; i < 100; ++i)
+        annealing.insert(label({(i % 10) * 100.f, (i / 10) * 100.f}));
+    EXPECT_TRUE(annealing.layout());
+    EXPECT_TRUE(annealing.activeLabels().empty());
+    const auto before = annealing.labels();
+
+    // a new label at the point of label 33 collides with it, all other labels are not touched
+    const auto id = annealing.insert(label({300.f, 300.f}));
+    EXPECT_FALSE(annealing.layout(gloperate_text::layout::LayoutBudget(gloperate_text::layout::LayoutBudget::Clock::duration::max(), 1)));
+    EXPECT_EQ(2u, annealing.activeLabels().size());
+    EXPECT_TRUE(annealing.layout());
+    EXPECT_TRUE(annealing.activeLabels().empty());
+
+    const auto & a = annealing.label(33).placement;
+    const auto & b = annealing.label(id).placement;
+    EXPECT_TRUE(a.display && b.display);
+    EXPECT_TRUE(a.offset != b.offset);
+    for (size_t i = 0; i < before.size(); ++i)
+    {
+        if (i == 33) continue;
+        EXPECT_EQ(before[i].placement.offset, annealing.label(i).placement.offset);
+    }
+
+    // a new text of the same extent keeps the placement candidates
+    const auto steps = annealing.steps();
+    auto renamed = annealing.label(50);
+    annealing.update(50, renamed);
+    EXPECT_TRUE(annealing.layout());
+    EXPECT_GT(annealing.steps(), steps);
+    EXPECT_EQ(before[50].placement.offset, annealing.label(50).placement.offset);
+}
+
+TEST_F(CoherentAnnealing_test, HysteresisKeepsPlacements)
+{
+    gloperate_text::layout::CoherentAnnealing annealing(gloperate_text::layout::standard, false, glm::vec2(0.f));
+    const auto first = annealing.insert(label({0.f, 0.f}));
+    const auto second = annealing.insert(label({0.f, 0.f}));
+    EXPECT_TRUE(annealing.layout());
+    const auto offset = annealing.label(first).placement.offset;
+    EXPECT_NE(offset, annealing.label(second).placement.offset);
+
+    // the other label moves away, all placements are equally good now
+    annealing.update(second, label({500.f, 0.f}));
+    EXPECT_TRUE(annealing.layout());
+    EXPECT_EQ(offset, annealing.label(first).placement.offset);
+
+    // an erased label leaves the round
+    annealing.update(second, label({0.f, 0.f}));
+    annealing.erase(second);
+    EXPECT_TRUE(annealing.layout());
+    EXPECT_EQ(offset, annealing.label(first).placement.offset);
+}
+
+TEST_F(CoherentAnnealing_test, AvoidsObstacles)
+{
+    // a panel above the labeled point
+    const gloperate_text::layout::ObstacleIndex index({{{{-30.f, 2.f}, {60.f, 20.f}}, gloperate_text::layout::Obstacle::noLabel}});
+    gloperate_text::layout::CoherentAnnealing annealing(gloperate_text::layout::standard, false, glm::vec2(0.f), 0.5f, 0.f, &index);
+    const auto id = annealing.insert(label({0.f, 0.f}));
+    EXPECT_TRUE(annealing.layout());
+
+    EXPECT_TRUE(annealing.label(id).placement.display);
+    EXPECT_GT(0.f, annealing.label(id).placement.offset.y);
+}
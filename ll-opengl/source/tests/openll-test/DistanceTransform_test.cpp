@@ -0,0 +1,58 @@
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <openll/DistanceTransform.h>
+
+class DistanceTransform_test: public testing::Test
+{
+public:
+};
+
+TEST_F(DistanceTransform_test, MatchesBruteForce)
+{
+    const auto width = 37;
+    const auto height = 23;
+
+    std::default_random_engine generator(3);
+    std::bernoulli_distribution feature(0.03);
+
+    std::vector<float> grid(width * height, gloperate_text::distanceTransformInfinity());
+    std::vector<std::pair<int, int>> features;
+    for (auto y = 0; y < height; ++y)
+    {
+        for (auto x = 0; x < width; ++x)
+        {
+            if (!feature(generator))
+                continue;
+            grid[y * width + x] = 0.f;
+            features.emplace_back(x, y);
+        }
+    }
+    ASSERT_FALSE(features.empty());
+
+    gloperate_text::squaredDistanceTransform(grid, width, height);
+
+    for (auto y = 0; y < height; ++y)
+    {
+        for (auto x = 0; x < width; ++x)
+        {
+            auto expected = width * width + height * height;
+            for (const auto & f : features)
+                expected = std::min(expected, (x - f.first) * (x - f.first) + (y - f.second) * (y - f.second));
+            EXPECT_EQ(static_cast<float>(expected), grid[y * width + x]) << x << ", " << y;
+        }
+    }
+}
+
+TEST_F(DistanceTransform_test, KeepsInfinityWithoutFeatures)
+{
+    std::vector<float> grid(12, gloperate_text::distanceTransformInfinity());
+    gloperate_text::squaredDistanceTransform(grid, 4, 3);
+
+    for (const auto value : grid)
+        EXPECT_GE(value, gloperate_text::distanceTransformInfinity());
+}
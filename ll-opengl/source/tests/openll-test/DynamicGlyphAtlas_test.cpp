@@ -0,0 +1,143 @@
+
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <string>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/DynamicGlyphAtlas.h>
+#include <openll/FontFace.h>
+#include <openll/NullRenderBackend.h>
+#include <openll/TrueTypeFont.h>
+
+#include "TestFont.h"
+
+class DynamicGlyphAtlas_test: public testing::Test
+{
+public:
+    DynamicGlyphAtlas_test()
+    : m_font(std::make_shared<gloperate_text::TrueTypeFont>(testfont::testFont()))
+    , m_backend(new gloperate_text::NullRenderBackend)
+    // 1000 font units are 16 pixels, glyphs of 20 x 20 texels with padding
+    , m_generator(16.f, 2, 1)
+    {
+    }
+
+protected:
+    std::shared_ptr<const gloperate_text::TrueTypeFont> m_font;
+    globjects::ref_ptr<gloperate_text::NullRenderBackend> m_backend;
+    gloperate_text::FontFaceGenerator m_generator;
+};
+
+TEST_F(DynamicGlyphAtlas_test, ProvidesMetricsBeforeImages)
+{
+    gloperate_text::DynamicGlyphAtlas atlas(m_font, { 64, 64 }, m_generator, m_backend);
+    const auto fontFace = atlas.fontFace();
+    EXPECT_EQ(1u, m_backend->counters().textures);
+
+    atlas.request(U"AB Z");
+    EXPECT_EQ(3u, atlas.pending());
+
+    // typesetting works right away
+    ASSERT_TRUE(fontFace->hasGlyph('A'));
+    EXPECT_FLOAT_EQ(19.2f, fontFace->glyph('A').advance());
+    EXPECT_FLOAT_EQ(-1.6f, fontFace->kerning('A', 'B'));
+    EXPECT_FLOAT_EQ(-0.8f, fontFace->kerning('B', 'A'));
+    EXPECT_FALSE(fontFace->depictable('A'));
+    EXPECT_FALSE(fontFace->hasGlyph('Z'));
+
+    atlas.wait();
+    EXPECT_EQ(2u, atlas.update());
+    EXPECT_EQ(0u, atlas.pending());
+
+    EXPECT_TRUE(atlas.resident('A'));
+    EXPECT_TRUE(atlas.resident('B'));
+    EXPECT_FALSE(atlas.resident(' '));
+    EXPECT_TRUE(fontFace->depictable('A'));
+    EXPECT_FLOAT_EQ(-1.6f, fontFace->kerning('A', 'B'));
+    EXPECT_EQ(2u, m_backend->counters().textureUpdates);
+
+    // nothing to do for resident glyphs
+    atlas.request(U"AB");
+    atlas.wait();
+    EXPECT_EQ(0u, atlas.update());
+    EXPECT_EQ(2u, m_backend->counters().textureUpdates);
+}
+
+TEST_F(DynamicGlyphAtlas_test, EvictsLeastRecentlyUsed)
+{
+    // room for a single glyph
+    gloperate_text::DynamicGlyphAtlas atlas(m_font, { 24, 24 }, m_generator, m_backend);
+    const auto fontFace = atlas.fontFace();
+
+    atlas.request('A');
+    atlas.wait();
+    EXPECT_EQ(1u, atlas.update());
+    EXPECT_TRUE(atlas.resident('A'));
+
+    atlas.request('O');
+    atlas.wait();
+    EXPECT_EQ(1u, atlas.update());
+    EXPECT_TRUE(atlas.resident('O'));
+    EXPECT_FALSE(atlas.resident('A'));
+    EXPECT_EQ(1u, atlas.evictions());
+
+    // evicted glyphs keep their metrics
+    EXPECT_TRUE(fontFace->hasGlyph('A'));
+    EXPECT_FALSE(fontFace->depictable('A'));
+    EXPECT_FLOAT_EQ(19.2f, fontFace->glyph('A').advance());
+
+    // glyphs requested in the current frame are not evicted
+    atlas.request(U"AO");
+    atlas.wait();
+    EXPECT_EQ(0u, atlas.update());
+    EXPECT_TRUE(atlas.resident('O'));
+    EXPECT_FALSE(atlas.resident('A'));
+    EXPECT_EQ(1u, atlas.evictions());
+
+    // until the next frame
+    atlas.request('A');
+    atlas.wait();
+    EXPECT_EQ(1u, atlas.update());
+    EXPECT_TRUE(atlas.resident('A'));
+    EXPECT_TRUE(fontFace->depictable('A'));
+    EXPECT_EQ(2u, atlas.evictions());
+    EXPECT_EQ(4u, atlas.frame());
+}
+
+TEST_F(DynamicGlyphAtlas_test, ClearsEvictedGlyphs)
+{
+    // room for a single glyph
+    gloperate_text::DynamicGlyphAtlas atlas(m_font, { 24, 24 }, m_generator, m_backend);
+    const auto fontFace = atlas.fontFace();
+
+    for (const auto codepoint : U"ABO")
+    {
+        if (codepoint == 0)
+            break;
+        atlas.request(static_cast<gloperate_text::GlyphIndex>(codepoint));
+        atlas.wait();
+        EXPECT_EQ(1u, atlas.update());
+    }
+    EXPECT_EQ(2u, atlas.evictions());
+    ASSERT_TRUE(atlas.resident('O'));
+
+    // only the texels of the resident glyph remain
+    const auto & glyph = fontFace->glyph('O');
+    const auto origin = glm::ivec2(glyph.subTextureOrigin() * 24.f + 0.5f);
+    const auto extent = glm::ivec2(glyph.subTextureExtent() * 24.f + 0.5f);
+    const auto & image = fontFace->glyphImage();
+    for (auto y = 0; y < 24; ++y)
+    {
+        for (auto x = 0; x < 24; ++x)
+        {
+            if (x >= origin.x && x < origin.x + extent.x && y >= origin.y && y < origin.y + extent.y)
+                continue;
+            EXPECT_EQ(0, image[y * 24 + x]) << x << ", " << y;
+        }
+    }
+
+    // each eviction clears its rectangle in the texture
+    EXPECT_EQ(5u, m_backend->counters().textureUpdates);
+}
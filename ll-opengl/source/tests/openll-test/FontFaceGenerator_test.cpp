@@ -0,0 +1,206 @@
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFace.h>
+#include <openll/FontFaceGenerator.h>
+#include <openll/FontLoader.h>
+#include <openll/FontWriter.h>
+#include <openll/TaskPool.h>
+#include <openll/TrueTypeFont.h>
+
+#include "TestFont.h"
+
+class FontFaceGenerator_test: public testing::Test
+{
+public:
+    FontFaceGenerator_test()
+    : m_font(testfont::testFont())
+    {
+    }
+
+    // the atlas value at a position relative to the lower left corner of the glyph's box
+    float texel(const gloperate_text::FontFace & fontFace, gloperate_text::GlyphIndex index, int x, int y) const
+    {
+        const auto & extent = fontFace.glyphTextureExtent();
+        const auto & glyph = fontFace.glyph(index);
+        const auto column = static_cast<int>(glyph.subTextureOrigin().x * extent.x + 0.5f) + x;
+        const auto row = static_cast<int>(glyph.subTextureOrigin().y * extent.y + 0.5f) + y;
+        return fontFace.glyphImage()[(glyph.page() * extent.y + row) * extent.x + column] / 255.f;
+    }
+
+protected:
+    gloperate_text::TrueTypeFont m_font;
+};
+
+TEST_F(FontFaceGenerator_test, ReadsTrueTypeTables)
+{
+    ASSERT_TRUE(m_font.isValid());
+    EXPECT_EQ(1000, m_font.unitsPerEm());
+    EXPECT_EQ(800, m_font.ascender());
+    EXPECT_EQ(-200, m_font.descender());
+    EXPECT_EQ(5u, m_font.glyphCount());
+
+    EXPECT_EQ(std::vector<std::uint32_t>({ 32, 65, 66, 79 }), m_font.codepoints());
+    EXPECT_EQ(2u, m_font.glyphId('B'));
+    EXPECT_EQ(0u, m_font.glyphId('C'));
+    EXPECT_EQ(1300, m_font.advance(2));
+
+    EXPECT_EQ(-100, m_font.kerning(1, 2));
+    EXPECT_EQ(-50, m_font.kerning(2, 1));
+    EXPECT_EQ(0, m_font.kerning(1, 3));
+
+    EXPECT_FALSE(gloperate_text::TrueTypeFont(std::vector<std::uint8_t>(64, 0)).isValid());
+}
+
+TEST_F(FontFaceGenerator_test, FlattensOutlines)
+{
+    const auto square = m_font.outline(1, 0.1f);
+    ASSERT_EQ(2u, square.size());
+    EXPECT_EQ(gloperate_text::TrueTypeFont::Contour({ { 0.f, 0.f }, { 0.f, 100.f }, { 100.f, 100.f }, { 100.f, 0.f } }), square[0]);
+
+    const auto composite = m_font.outline(2, 0.1f);
+    ASSERT_EQ(2u, composite.size());
+    EXPECT_EQ(glm::vec2(110.f, 0.f), composite[0][3]);
+
+    // implied on-curve points at the edge centers, the curves bulge towards the corners up to (12.5, 12.5)
+    const auto round = m_font.outline(3, 0.1f, 0.01f);
+    ASSERT_EQ(1u, round.size());
+    EXPECT_GT(round[0].size(), 16u);
+    EXPECT_EQ(glm::vec2(50.f, 0.f), round[0].front());
+    for (const auto & point : round[0])
+    {
+        const auto distance = std::sqrt((point.x - 50.f) * (point.x - 50.f) + (point.y - 50.f) * (point.y - 50.f));
+        EXPECT_GE(distance, 50.f - 1e-3f);
+        EXPECT_LE(distance, 37.5f * std::sqrt(2.f) + 1e-3f);
+    }
+
+    EXPECT_TRUE(m_font.outline(4, 0.1f).empty());
+}
+
+TEST_F(FontFaceGenerator_test, GeneratesDistanceFields)
+{
+    const auto generator = gloperate_text::FontFaceGenerator(50.f, 4, 4);
+    const auto fontFace = globjects::ref_ptr<gloperate_text::FontFace>(generator.generate(m_font, { ' ', 'A', 'B', 'C', 'O' }));
+    ASSERT_NE(nullptr, fontFace.get());
+
+    EXPECT_FLOAT_EQ(50.f, fontFace->size());
+    EXPECT_FLOAT_EQ(40.f, fontFace->base());
+    EXPECT_FLOAT_EQ(55.f, fontFace->lineHeight());
+    EXPECT_EQ(std::vector<gloperate_text::GlyphIndex>({ ' ', 'A', 'B', 'O' }), [&fontFace]()
+    {
+        auto glyphs = fontFace->glyphs();
+        std::sort(glyphs.begin(), glyphs.end());
+        return glyphs;
+    }());
+
+    EXPECT_FALSE(fontFace->depictable(' '));
+    EXPECT_FLOAT_EQ(15.f, fontFace->glyph(' ').advance());
+
+    // 50 pixels and 4 pixels of padding on each side, the top left corner of the outline at the baseline
+    const auto & a = fontFace->glyph('A');
+    EXPECT_EQ(glm::vec2(58.f, 58.f), a.extent());
+    EXPECT_EQ(glm::vec2(0.f, 50.f), a.bearing());
+    EXPECT_FLOAT_EQ(60.f, a.advance());
+    EXPECT_FLOAT_EQ(-5.f, fontFace->kerning('A', 'B'));
+    EXPECT_FLOAT_EQ(-2.5f, fontFace->kerning('B', 'A'));
+
+    // filled ring, hole and background; the outline is at 0.5
+    EXPECT_GT(texel(*fontFace, 'A', 4 + 6, 4 + 25), 0.6f);
+    EXPECT_LT(texel(*fontFace, 'A', 4 + 25, 4 + 25), 0.4f);
+    EXPECT_LT(texel(*fontFace, 'A', 1, 1), 0.2f);
+    EXPECT_NEAR(0.5f, texel(*fontFace, 'A', 4 + 0, 4 + 25) / 2.f + texel(*fontFace, 'A', 4 - 1, 4 + 25) / 2.f, 0.05f);
+}
+
+TEST_F(FontFaceGenerator_test, IndependentOfThreads)
+{
+    const auto generator = gloperate_text::FontFaceGenerator(40.f, 6, 3);
+    const auto codepoints = m_font.codepoints();
+
+    gloperate_text::TaskPool pool(3);
+    const auto sequential = globjects::ref_ptr<gloperate_text::FontFace>(generator.generate(m_font, codepoints));
+    const auto parallel = globjects::ref_ptr<gloperate_text::FontFace>(generator.generate(m_font, codepoints, &pool));
+
+    EXPECT_EQ(sequential->glyphTextureExtent(), parallel->glyphTextureExtent());
+    EXPECT_EQ(sequential->glyphImage(), parallel->glyphImage());
+}
+
+TEST_F(FontFaceGenerator_test, WritesLoadableFontFace)
+{
+    const auto generator = gloperate_text::FontFaceGenerator(50.f, 4, 2);
+    const auto generated = globjects::ref_ptr<gloperate_text::FontFace>(generator.generate(m_font, m_font.codepoints()));
+    ASSERT_NE(nullptr, generated.get());
+
+    // in the working directory of the test
+    const auto filename = std::string("./openll-fontgen-test.fnt");
+    ASSERT_TRUE(gloperate_text::FontWriter().save(*generated, filename, "Test Font"));
+
+    const auto loaded = globjects::ref_ptr<gloperate_text::FontFace>(gloperate_text::FontLoader(false).load(filename));
+    const auto extent = generated->glyphTextureExtent();
+    std::remove(filename.c_str());
+    std::remove(("./openll-fontgen-test." + std::to_string(extent.x) + "." + std::to_string(extent.y) + ".r.ub.raw").c_str());
+    ASSERT_NE(nullptr, loaded.get());
+
+    EXPECT_EQ(generated->glyphTextureExtent(), loaded->glyphTextureExtent());
+    EXPECT_EQ(generated->glyphImage(), loaded->glyphImage());
+    EXPECT_EQ(generated->glyphTexturePadding(), loaded->glyphTexturePadding());
+    EXPECT_FLOAT_EQ(generated->size(), loaded->size());
+    EXPECT_FLOAT_EQ(generated->base(), loaded->base());
+    EXPECT_FLOAT_EQ(generated->lineHeight(), loaded->lineHeight());
+
+    for (const auto index : generated->glyphs())
+    {
+        const auto & expected = generated->glyph(index);
+        const auto & actual = loaded->glyph(index);
+        EXPECT_EQ(expected.extent(), actual.extent()) << index;
+        EXPECT_EQ(expected.bearing(), actual.bearing()) << index;
+        EXPECT_FLOAT_EQ(expected.advance(), actual.advance()) << index;
+        EXPECT_EQ(expected.depictable(), actual.depictable()) << index;
+        if (expected.depictable())
+        {
+            EXPECT_NEAR(expected.subTextureOrigin().x, actual.subTextureOrigin().x, 1e-6f) << index;
+            EXPECT_NEAR(expected.subTextureOrigin().y, actual.subTextureOrigin().y, 1e-6f) << index;
+        }
+    }
+    EXPECT_FLOAT_EQ(-5.f, loaded->kerning('A', 'B'));
+}
+
+TEST_F(FontFaceGenerator_test, SpreadsGlyphsOverPages)
+{
+    // 'A', 'B' and 'O' need more than 50 x 50 texels each
+    const auto generator = gloperate_text::FontFaceGenerator(50.f, 4, 2, 64);
+    const auto generated = globjects::ref_ptr<gloperate_text::FontFace>(generator.generate(m_font, m_font.codepoints()));
+    ASSERT_NE(nullptr, generated.get());
+
+    const auto pages = generated->glyphTexturePages();
+    EXPECT_EQ(glm::uvec2(64, 64), generated->glyphTextureExtent());
+    EXPECT_EQ(3u, pages);
+    EXPECT_EQ(64u * 64u * pages, generated->glyphImage().size());
+    EXPECT_NE(generated->glyph('A').page(), generated->glyph('B').page());
+    EXPECT_LT(texel(*generated, 'B', 4 + 25, 4 + 25), 0.4f);
+
+    // a glyph larger than a page
+    EXPECT_EQ(nullptr, gloperate_text::FontFaceGenerator(50.f, 4, 2, 32).generate(m_font, m_font.codepoints()));
+
+    const auto filename = std::string("./openll-fontgen-pages-test.fnt");
+    ASSERT_TRUE(gloperate_text::FontWriter().save(*generated, filename));
+
+    const auto loaded = globjects::ref_ptr<gloperate_text::FontFace>(gloperate_text::FontLoader(false).load(filename));
+    std::remove(filename.c_str());
+    for (auto page = 0u; page < pages; ++page)
+        std::remove(("./openll-fontgen-pages-test_" + std::to_string(page) + ".64.64.r.ub.raw").c_str());
+    ASSERT_NE(nullptr, loaded.get());
+
+    EXPECT_EQ(pages, loaded->glyphTexturePages());
+    EXPECT_EQ(generated->glyphImage(), loaded->glyphImage());
+    for (const auto index : generated->glyphs())
+        EXPECT_EQ(generated->glyph(index).page(), loaded->glyph(index).page()) << index;
+}
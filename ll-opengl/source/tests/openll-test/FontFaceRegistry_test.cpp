@@ -0,0 +1,178 @@
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFace.h>
+#include <openll/FontFaceGenerator.h>
+#include <openll/FontFaceRegistry.h>
+#include <openll/FontLoader.h>
+#include <openll/FontWriter.h>
+#include <openll/NullRenderBackend.h>
+#include <openll/TrueTypeFont.h>
+
+#include "TemporaryDirectory.h"
+#include "TestFont.h"
+
+// loads another font face through the registry while creating the glyph texture
+class ReentrantBackend: public gloperate_text::NullRenderBackend
+{
+public:
+    ReentrantBackend(gloperate_text::FontFaceRegistry & registry, const std::string & filename)
+    : m_registry(registry)
+    , m_filename(filename)
+    {
+    }
+
+    void createGlyphTexture(gloperate_text::FontFace & fontFace) override
+    {
+        gloperate_text::NullRenderBackend::createGlyphTexture(fontFace);
+        m_nested = m_registry.load(m_filename, gloperate_text::FontLoader(false));
+    }
+
+    gloperate_text::FontFaceRegistry & m_registry;
+    std::string m_filename;
+    globjects::ref_ptr<gloperate_text::FontFace> m_nested;
+};
+
+class FontFaceRegistry_test: public testing::Test
+{
+public:
+    FontFaceRegistry_test()
+    : m_filename(m_directory.file("openll-registry-test.fnt"))
+    {
+    }
+
+    void SetUp() override
+    {
+        ASSERT_FALSE(m_directory.path().empty());
+        const auto font = gloperate_text::TrueTypeFont(testfont::testFont());
+        m_fontFace = gloperate_text::FontFaceGenerator(50.f, 4, 2).generate(font, font.codepoints());
+        ASSERT_NE(nullptr, m_fontFace.get());
+        ASSERT_TRUE(gloperate_text::FontWriter().save(*m_fontFace, m_filename));
+    }
+
+    void TearDown() override
+    {
+        const auto & extent = m_fontFace->glyphTextureExtent();
+        std::remove(m_filename.c_str());
+        std::remove(m_directory.file("openll-registry-test." + std::to_string(extent.x) + "." + std::to_string(extent.y) + ".r.ub.raw").c_str());
+    }
+
+protected:
+    TemporaryDirectory m_directory;
+    std::string m_filename;
+    globjects::ref_ptr<gloperate_text::FontFace> m_fontFace;
+};
+
+TEST_F(FontFaceRegistry_test, SharesFontFaceOfSameFile)
+{
+    gloperate_text::FontFaceRegistry registry;
+    const auto loader = gloperate_text::FontLoader(false);
+
+    const auto first = registry.load(m_filename, loader);
+    ASSERT_NE(nullptr, first.get());
+    EXPECT_EQ(m_fontFace->glyphs().size(), first->glyphs().size());
+
+    // another spelling of the path
+    const auto second = registry.load(m_directory.path() + "/././openll-registry-test.fnt", loader);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(1u, registry.size());
+    EXPECT_EQ(1u, registry.hits());
+}
+
+TEST_F(FontFaceRegistry_test, SeparatesLoadOptions)
+{
+    gloperate_text::FontFaceRegistry registry;
+    auto loader = gloperate_text::FontLoader(false);
+    const auto all = registry.load(m_filename, loader);
+
+    loader.setSubset(std::set<gloperate_text::GlyphIndex>{ 'A' });
+    const auto subset = registry.load(m_filename, loader);
+    ASSERT_NE(nullptr, subset.get());
+    EXPECT_NE(all.get(), subset.get());
+    EXPECT_FALSE(subset->depictable('B'));
+
+    loader.setRepackSubset(true);
+    const auto repacked = registry.load(m_filename, loader);
+    EXPECT_NE(subset.get(), repacked.get());
+
+    EXPECT_EQ(3u, registry.size());
+    EXPECT_EQ(0u, registry.hits());
+}
+
+TEST_F(FontFaceRegistry_test, ReleasesUnreferencedFontFaces)
+{
+    gloperate_text::FontFaceRegistry registry;
+    const auto loader = gloperate_text::FontLoader(false);
+
+    auto fontFace = registry.load(m_filename, loader);
+    EXPECT_EQ(0u, registry.collect());
+    EXPECT_EQ(1u, registry.size());
+
+    fontFace = nullptr;
+    EXPECT_EQ(1u, registry.collect());
+    EXPECT_EQ(0u, registry.size());
+
+    // loaded again
+    fontFace = registry.load(m_filename, loader);
+    EXPECT_NE(nullptr, fontFace.get());
+    EXPECT_EQ(0u, registry.hits());
+}
+
+TEST_F(FontFaceRegistry_test, KeepsFailedLoadsOut)
+{
+    gloperate_text::FontFaceRegistry registry;
+
+    EXPECT_EQ(nullptr, registry.load(m_directory.file("openll-registry-missing.fnt"), gloperate_text::FontLoader(false)).get());
+    EXPECT_EQ(0u, registry.size());
+}
+
+TEST_F(FontFaceRegistry_test, LoadsOnceForConcurrentRequests)
+{
+    gloperate_text::FontFaceRegistry registry;
+    const auto loader = gloperate_text::FontLoader(false);
+
+    auto loaded = std::vector<globjects::ref_ptr<gloperate_text::FontFace>>(4);
+    auto threads = std::vector<std::thread>();
+    for (size_t i = 0; i < loaded.size(); ++i)
+        threads.emplace_back([&, i]() { loaded[i] = registry.load(m_filename, loader); });
+    for (auto & thread : threads)
+        thread.join();
+
+    for (const auto & fontFace : loaded)
+        EXPECT_EQ(loaded.front().get(), fontFace.get());
+    EXPECT_EQ(1u, registry.size());
+    EXPECT_EQ(3u, registry.hits());
+}
+
+TEST_F(FontFaceRegistry_test, SeparatesBackendInstances)
+{
+    gloperate_text::FontFaceRegistry registry;
+    const auto first = gloperate_text::FontLoader(new gloperate_text::NullRenderBackend);
+    const auto second = gloperate_text::FontLoader(new gloperate_text::NullRenderBackend);
+
+    const auto fontFace = registry.load(m_filename, first);
+    EXPECT_EQ(fontFace.get(), registry.load(m_filename, gloperate_text::FontLoader(first.backend())).get());
+    EXPECT_NE(fontFace.get(), registry.load(m_filename, second).get());
+    EXPECT_EQ(2u, registry.size());
+    EXPECT_EQ(1u, registry.hits());
+}
+
+TEST_F(FontFaceRegistry_test, LoadsOutsideTheLock)
+{
+    gloperate_text::FontFaceRegistry registry;
+    globjects::ref_ptr<ReentrantBackend> backend = new ReentrantBackend(registry, m_filename);
+
+    // the nested load would deadlock if the registry was locked during the load
+    const auto fontFace = registry.load(m_filename, gloperate_text::FontLoader(backend.get()));
+    ASSERT_NE(nullptr, fontFace.get());
+    ASSERT_NE(nullptr, backend->m_nested.get());
+    EXPECT_NE(fontFace.get(), backend->m_nested.get());
+    EXPECT_EQ(2u, registry.size());
+}
@@ -1,15 +1,206 @@
 
 #include <gmock/gmock.h>
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
 
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFace.h>
+#include <openll/FontFaceGenerator.h>
 #include <openll/FontLoader.h>
+#include <openll/FontWriter.h>
+#include <openll/GlyphSequence.h>
+#include <openll/NullRenderBackend.h>
+#include <openll/TrueTypeFont.h>
+
+#include "TemporaryDirectory.h"
+#include "TestFont.h"
 
 class FontLoader_test: public testing::Test
 {
 public:
+    FontLoader_test()
+    : m_filename(m_directory.file("openll-loader-test.fnt"))
+    {
+    }
+
+    // writes a face with the glyphs ' ', 'A', 'B' and 'O' of the test font
+    void SetUp() override
+    {
+        ASSERT_FALSE(m_directory.path().empty());
+        const auto font = gloperate_text::TrueTypeFont(testfont::testFont());
+        m_fontFace = gloperate_text::FontFaceGenerator(50.f, 4, 2).generate(font, font.codepoints());
+        ASSERT_NE(nullptr, m_fontFace.get());
+        ASSERT_TRUE(gloperate_text::FontWriter().save(*m_fontFace, m_filename));
+    }
+
+    void TearDown() override
+    {
+        const auto & extent = m_fontFace->glyphTextureExtent();
+        std::remove(m_filename.c_str());
+        std::remove(m_directory.file("openll-loader-test." + std::to_string(extent.x) + "." + std::to_string(extent.y) + ".r.ub.raw").c_str());
+    }
+
+    // the texels of the glyph's sub texture, bottom row first
+    static std::vector<unsigned char> texels(const gloperate_text::FontFace & fontFace, gloperate_text::GlyphIndex index)
+    {
+        const auto extent = glm::vec2(fontFace.glyphTextureExtent());
+        const auto & glyph = fontFace.glyph(index);
+        const auto origin = glm::ivec2(glyph.subTextureOrigin() * extent + 0.5f);
+        const auto size = glm::ivec2(glyph.subTextureExtent() * extent + 0.5f);
+
+        auto result = std::vector<unsigned char>();
+        const auto page = fontFace.glyphImage().begin() + glyph.page() * static_cast<size_t>(extent.x * extent.y);
+        for (auto y = 0; y < size.y; ++y)
+        {
+            const auto row = page + (origin.y + y) * static_cast<int>(extent.x) + origin.x;
+            result.insert(result.end(), row, row + size.x);
+        }
+        return result;
+    }
+
+protected:
+    TemporaryDirectory m_directory;
+    std::string m_filename;
+    globjects::ref_ptr<gloperate_text::FontFace> m_fontFace;
 };
 
 TEST_F(FontLoader_test, CheckSomeResults)
 {
     EXPECT_EQ(true, true);
 }
+
+TEST_F(FontLoader_test, LoadsAllGlyphs)
+{
+    const auto loaded = globjects::ref_ptr<gloperate_text::FontFace>(gloperate_text::FontLoader(false).load(m_filename));
+    ASSERT_NE(nullptr, loaded.get());
+
+    EXPECT_EQ(m_fontFace->glyphs().size(), loaded->glyphs().size());
+    EXPECT_FLOAT_EQ(-5.f, loaded->kerning('A', 'B'));
+    EXPECT_FLOAT_EQ(-2.5f, loaded->kerning('B', 'A'));
+}
+
+TEST_F(FontLoader_test, LoadsSubsetOfCodepoints)
+{
+    auto loader = gloperate_text::FontLoader(false);
+    loader.setSubset(std::set<gloperate_text::GlyphIndex>{ 'A', 'B' });
+
+    const auto loaded = globjects::ref_ptr<gloperate_text::FontFace>(loader.load(m_filename));
+    ASSERT_NE(nullptr, loaded.get());
+
+    EXPECT_EQ(2u, loaded->glyphs().size());
+    EXPECT_TRUE(loaded->hasGlyph('A'));
+    EXPECT_TRUE(loaded->hasGlyph('B'));
+    EXPECT_FALSE(loaded->hasGlyph('O'));
+    EXPECT_FLOAT_EQ(-5.f, loaded->kerning('A', 'B'));
+
+    // the atlas is kept
+    EXPECT_EQ(m_fontFace->glyphTextureExtent(), loaded->glyphTextureExtent());
+    EXPECT_EQ(m_fontFace->glyphImage(), loaded->glyphImage());
+}
+
+TEST_F(FontLoader_test, RepacksSubsetOfCorpus)
+{
+    auto sequence = gloperate_text::GlyphSequence();
+    sequence.setString(U"AA A");
+
+    auto loader = gloperate_text::FontLoader(false);
+    loader.setSubset(std::vector<gloperate_text::GlyphSequence>{ sequence });
+    loader.setRepackSubset(true);
+    EXPECT_EQ((std::set<gloperate_text::GlyphIndex>{ ' ', 'A' }), loader.subset());
+
+    const auto loaded = globjects::ref_ptr<gloperate_text::FontFace>(loader.load(m_filename));
+    ASSERT_NE(nullptr, loaded.get());
+
+    EXPECT_EQ(2u, loaded->glyphs().size());
+    EXPECT_FALSE(loaded->hasGlyph('B'));
+    EXPECT_FALSE(loaded->depictable(' '));
+
+    const auto & extent = loaded->glyphTextureExtent();
+    const auto & fullExtent = m_fontFace->glyphTextureExtent();
+    EXPECT_LT(extent.x * extent.y, fullExtent.x * fullExtent.y);
+    EXPECT_EQ(static_cast<size_t>(extent.x) * extent.y, loaded->glyphImage().size());
+
+    EXPECT_EQ(m_fontFace->glyph('A').extent(), loaded->glyph('A').extent());
+    EXPECT_EQ(texels(*m_fontFace, 'A'), texels(*loaded, 'A'));
+}
+
+TEST_F(FontLoader_test, LoadsNoGlyphsOfEmptyCorpus)
+{
+    auto loader = gloperate_text::FontLoader(false);
+    loader.setSubset(std::vector<gloperate_text::GlyphSequence>());
+    EXPECT_TRUE(loader.subset().empty());
+
+    const auto loaded = globjects::ref_ptr<gloperate_text::FontFace>(loader.load(m_filename));
+    ASSERT_NE(nullptr, loaded.get());
+    EXPECT_TRUE(loaded->glyphs().empty());
+
+    loader.setRepackSubset(true);
+    const auto repacked = globjects::ref_ptr<gloperate_text::FontFace>(loader.load(m_filename));
+    ASSERT_NE(nullptr, repacked.get());
+    EXPECT_TRUE(repacked->glyphs().empty());
+    EXPECT_LT(repacked->glyphImage().size(), m_fontFace->glyphImage().size());
+
+    // an empty set of code points still loads all glyphs
+    loader.setSubset(std::set<gloperate_text::GlyphIndex>());
+    const auto all = globjects::ref_ptr<gloperate_text::FontFace>(loader.load(m_filename));
+    ASSERT_NE(nullptr, all.get());
+    EXPECT_EQ(m_fontFace->glyphs().size(), all->glyphs().size());
+}
+
+TEST_F(FontLoader_test, ReleasesGlyphImageAfterUpload)
+{
+    auto loader = gloperate_text::FontLoader(new gloperate_text::NullRenderBackend);
+
+    const auto released = globjects::ref_ptr<gloperate_text::FontFace>(loader.load(m_filename));
+    ASSERT_NE(nullptr, released.get());
+    EXPECT_TRUE(released->glyphImage().empty());
+    EXPECT_EQ(m_fontFace->glyphTextureExtent(), released->glyphTextureExtent());
+
+    loader.setKeepGlyphImage(true);
+    const auto kept = globjects::ref_ptr<gloperate_text::FontFace>(loader.load(m_filename));
+    ASSERT_NE(nullptr, kept.get());
+    EXPECT_EQ(m_fontFace->glyphImage(), kept->glyphImage());
+}
+
+TEST_F(FontLoader_test, SkipsGlyphsOnMissingPages)
+{
+    {
+        std::ofstream out(m_filename, std::ios::out | std::ios::app);
+        out << "char id=90 x=0 y=0 width=4 height=4 xoffset=0 yoffset=0 xadvance=4 page=1 chnl=15\n";
+    }
+
+    const auto loaded = globjects::ref_ptr<gloperate_text::FontFace>(gloperate_text::FontLoader(false).load(m_filename));
+    ASSERT_NE(nullptr, loaded.get());
+    EXPECT_EQ(1u, loaded->glyphTexturePages());
+    EXPECT_TRUE(loaded->hasGlyph('A'));
+    EXPECT_FALSE(loaded->hasGlyph('Z'));
+}
+
+TEST_F(FontLoader_test, SkipsGlyphsOnListedPagesWithoutFile)
+{
+    // the common line lists a second page, but no page file is given for it
+    auto contents = std::string();
+    {
+        std::ifstream in(m_filename);
+        contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const auto pages = contents.find(" pages=1 ");
+    ASSERT_NE(std::string::npos, pages);
+    contents.replace(pages, 9, " pages=2 ");
+    {
+        std::ofstream out(m_filename, std::ios::out | std::ios::trunc);
+        out << contents << "char id=90 x=0 y=0 width=4 height=4 xoffset=0 yoffset=0 xadvance=4 page=1 chnl=15\n";
+    }
+
+    const auto loaded = globjects::ref_ptr<gloperate_text::FontFace>(gloperate_text::FontLoader(false).load(m_filename));
+    ASSERT_NE(nullptr, loaded.get());
+    EXPECT_EQ(2u, loaded->glyphTexturePages());
+    EXPECT_TRUE(loaded->hasGlyph('A'));
+    EXPECT_FALSE(loaded->hasGlyph('Z'));
+}
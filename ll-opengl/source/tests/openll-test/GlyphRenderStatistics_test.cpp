@@ -0,0 +1,52 @@
+
+#include <gmock/gmock.h>
+
+#include <openll/GlyphRenderStatistics.h>
+
+class GlyphRenderStatistics_test: public testing::Test
+{
+};
+
+// GPU timing requires an OpenGL context, the counting does not
+TEST_F(GlyphRenderStatistics_test, CountsPerFrame)
+{
+    gloperate_text::GlyphRenderStatistics statistics(false, 2);
+    EXPECT_EQ(nullptr, statistics.lastCompleteFrame());
+
+    statistics.beginDraw();
+    statistics.endDraw(10, 480);
+    statistics.beginDraw();
+    statistics.endDraw(5, 0);
+
+    const auto & current = statistics.currentFrame();
+    EXPECT_EQ(0u, current.index);
+    EXPECT_EQ(2u, current.drawCalls);
+    EXPECT_EQ(15u, current.glyphs);
+    EXPECT_EQ(480u, current.uploadedBytes);
+    EXPECT_TRUE(current.gpuTimes.empty());
+    EXPECT_EQ(0u, statistics.summary().frames);
+
+    statistics.beginFrame();
+    statistics.beginDraw();
+    statistics.endDraw(3, 0);
+    statistics.beginFrame();
+
+    ASSERT_NE(nullptr, statistics.lastCompleteFrame());
+    EXPECT_EQ(1u, statistics.lastCompleteFrame()->index);
+    EXPECT_EQ(3u, statistics.lastCompleteFrame()->glyphs);
+    // the history keeps the latest two frames
+    ASSERT_EQ(2u, statistics.frames().size());
+    EXPECT_EQ(1u, statistics.frames().front().index);
+    EXPECT_EQ(2u, statistics.currentFrame().index);
+
+    const auto & summary = statistics.summary();
+    EXPECT_EQ(2u, summary.frames);
+    EXPECT_EQ(3u, summary.drawCalls);
+    EXPECT_EQ(18u, summary.glyphs);
+    EXPECT_EQ(480u, summary.uploadedBytes);
+    EXPECT_EQ(0.0, summary.meanGpuTime);
+
+    statistics.reset();
+    EXPECT_EQ(0u, statistics.summary().frames);
+    EXPECT_EQ(0u, statistics.currentFrame().drawCalls);
+}
@@ -0,0 +1,85 @@
+
+#include <gmock/gmock.h>
+
+
+#include <openll/FontFace.h>
+#include <openll/Glyph.h>
+#include <openll/GlyphSequence.h>
+#include <openll/Typesetter.h>
+
+#include "LayoutTestFixture.h"
+
+class GlyphSequence_test: public testing::Test
+{
+public:
+    GlyphSequence_test()
+    {
+        layouttest::setMetrics(m_fontFace, 12.f);
+        layouttest::addGlyphs(m_fontFace, U"abc ", 5.f, glm::vec2(4.f, 8.f));
+    }
+
+protected:
+    gloperate_text::FontFace m_fontFace;
+};
+
+TEST_F(GlyphSequence_test, ExtentIsCachedAndInvalidated)
+{
+    gloperate_text::GlyphSequence sequence;
+    sequence.setFontFace(&m_fontFace);
+    sequence.setFontSize(10.f);
+    sequence.setString(U"abc");
+
+    EXPECT_FLOAT_EQ(15.f, sequence.extent().x);
+    EXPECT_FLOAT_EQ(12.f, sequence.extent().y);
+    EXPECT_EQ(&sequence.extent(), &sequence.extent());
+
+    sequence.setString(U"ab");
+    EXPECT_FLOAT_EQ(10.f, sequence.extent().x);
+
+    sequence.setFontSize(20.f);
+    EXPECT_FLOAT_EQ(20.f, sequence.extent().x);
+    EXPECT_FLOAT_EQ(24.f, sequence.extent().y);
+
+    sequence.setFontSize(10.f);
+    sequence.setString(U"ab ab");
+    sequence.setWordWrap(true);
+    sequence.setLineWidth(12.f);
+    EXPECT_FLOAT_EQ(10.f, sequence.extent().x);
+    EXPECT_FLOAT_EQ(24.f, sequence.extent().y);
+
+    sequence.setLineWidth(100.f);
+    EXPECT_FLOAT_EQ(23.f, sequence.extent().x);
+    EXPECT_FLOAT_EQ(12.f, sequence.extent().y);
+
+    sequence.setWordWrap(false);
+    EXPECT_FLOAT_EQ(23.f, sequence.extent().x);
+
+    const auto copy = sequence;
+    EXPECT_FLOAT_EQ(sequence.extent().x, copy.extent().x);
+    EXPECT_FLOAT_EQ(gloperate_text::Typesetter::extent(copy).x, copy.extent().x);
+}
+
+TEST_F(GlyphSequence_test, ExtentFollowsFontFaceChanges)
+{
+    gloperate_text::GlyphSequence sequence;
+    sequence.setFontFace(&m_fontFace);
+    sequence.setFontSize(10.f);
+    sequence.setString(U"abd");
+    EXPECT_FLOAT_EQ(10.f, sequence.extent().x);
+
+    // e.g., added by a DynamicGlyphAtlas
+    gloperate_text::Glyph glyph;
+    glyph.setIndex('d');
+    glyph.setAdvance(5.f);
+    glyph.setExtent(glm::vec2(4.f, 8.f));
+    glyph.setSubTextureExtent(glm::vec2(0.1f));
+    m_fontFace.addGlyph(glyph);
+    EXPECT_FLOAT_EQ(15.f, sequence.extent().x);
+
+    m_fontFace.setKerning('a', 'b', -1.f);
+    EXPECT_FLOAT_EQ(14.f, sequence.extent().x);
+
+    const auto revision = m_fontFace.revision();
+    sequence.extent();
+    EXPECT_EQ(revision, m_fontFace.revision());
+}
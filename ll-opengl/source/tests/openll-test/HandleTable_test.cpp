@@ -0,0 +1,62 @@
+#include <gmock/gmock.h>
+
+#include <openll/HandleTable.h>
+
+TEST(HandleTable_test, LooksUpInsertedObjects)
+{
+    gloperate_text::HandleTable<int> table;
+
+    const auto first = table.insert(1);
+    const auto second = table.insert(2);
+    EXPECT_NE(0u, first);
+    EXPECT_NE(0u, second);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(2u, table.size());
+
+    ASSERT_NE(nullptr, table.get(first));
+    ASSERT_NE(nullptr, table.get(second));
+    EXPECT_EQ(1, *table.get(first));
+    EXPECT_EQ(2, *table.get(second));
+
+    EXPECT_FALSE(table.contains(0));
+    EXPECT_EQ(nullptr, table.get(0));
+    EXPECT_EQ(nullptr, table.get(first + 2));
+    EXPECT_EQ(nullptr, table.get(first ^ 0x10000u));
+}
+
+TEST(HandleTable_test, RejectsStaleHandles)
+{
+    gloperate_text::HandleTable<int> table;
+
+    const auto first = table.insert(1);
+    EXPECT_TRUE(table.erase(first));
+    EXPECT_FALSE(table.erase(first));
+    EXPECT_FALSE(table.contains(first));
+    EXPECT_EQ(0u, table.size());
+
+    // the slot is reused with another generation
+    const auto second = table.insert(2);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(first & 0xffffu, second & 0xffffu);
+    EXPECT_EQ(nullptr, table.get(first));
+    ASSERT_NE(nullptr, table.get(second));
+    EXPECT_EQ(2, *table.get(second));
+
+    // the erased generation of the slot does not become valid
+    EXPECT_TRUE(table.erase(second));
+    EXPECT_FALSE(table.contains(second + 0x10000u));
+}
+
+TEST(HandleTable_test, LimitsNumberOfObjects)
+{
+    gloperate_text::HandleTable<int> table;
+
+    for (size_t i = 0; i < table.maxObjects; ++i)
+        ASSERT_NE(0u, table.insert(static_cast<int>(i)));
+    EXPECT_EQ(0u, table.insert(0));
+
+    const auto handle = table.insert(0);
+    EXPECT_FALSE(table.contains(handle));
+    EXPECT_TRUE(table.erase(1u | 0x10000u));
+    EXPECT_NE(0u, table.insert(0));
+}
@@ -0,0 +1,65 @@
+#include <gmock/gmock.h>
+
+#include <random>
+
+#include <openll/layout/LabelArea.h>
+#include <openll/layout/LabelAreaBlock.h>
+
+class LabelAreaBlock_test: public testing::Test
+{
+public:
+    static std::vector<gloperate_text::LabelArea> randomAreas(size_t count)
+    {
+        std::default_random_engine generator;
+        std::uniform_real_distribution<float> location(0.f, 100.f);
+        std::uniform_real_distribution<float> size(1.f, 20.f);
+        std::vector<gloperate_text::LabelArea> areas;
+        for (size_t i = 0; i < count; ++i)
+            areas.push_back({{location(generator), location(generator)}, {size(generator), size(generator)}});
+        return areas;
+    }
+};
+
+TEST_F(LabelAreaBlock_test, MatchesPairwiseTests)
+{
+    // not a multiple of the vector width, to cover the remainder as well
+    const auto areas = randomAreas(203);
+    for (const auto padding : { glm::vec2(0.f), glm::vec2(0.2f, 0.1f) })
+    {
+        gloperate_text::layout::LabelAreaBlock block(padding);
+        for (const auto & area : areas)
+            block.push_back(area);
+        ASSERT_EQ(areas.size(), block.size());
+
+        for (const auto & area : areas)
+        {
+            float overlapAreas[gloperate_text::layout::LabelAreaBlock::batchSize];
+            for (size_t first = 0; first < areas.size(); first += gloperate_text::layout::LabelAreaBlock::batchSize)
+            {
+                const auto mask = block.overlaps(area, first, overlapAreas);
+                for (size_t i = 0; i < gloperate_text::layout::LabelAreaBlock::batchSize && first + i < areas.size(); ++i)
+                {
+                    const auto & other = areas[first + i];
+                    EXPECT_EQ(area.paddedOverlaps(other, padding), (mask >> i) & 1);
+                    if (area.paddedOverlaps(other, padding))
+                    {
+                        EXPECT_EQ(area.paddedOverlapArea(other, padding), overlapAreas[i]);
+                    }
+                }
+            }
+
+            float expectedArea = 0.f;
+            int expectedCount = 0;
+            for (size_t i = 10; i < areas.size(); ++i)
+            {
+                if (!area.paddedOverlaps(areas[i], padding))
+                    continue;
+                expectedArea += area.paddedOverlapArea(areas[i], padding);
+                ++expectedCount;
+            }
+            int overlapCount = 0;
+            EXPECT_FLOAT_EQ(expectedArea, block.overlapArea(area, overlapCount, 10));
+            EXPECT_EQ(expectedCount, overlapCount);
+        }
+    }
+}
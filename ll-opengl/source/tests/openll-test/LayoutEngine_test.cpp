@@ -0,0 +1,173 @@
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+
+#include <openll/layout/algorithm.h>
+#include <openll/layout/LayoutEngine.h>
+#include <openll/layout/layoutbase.h>
+
+#include "LayoutTestFixture.h"
+
+class LayoutEngine_test: public testing::Test, public LayoutTestFixture
+{
+public:
+    // sorted (label, position, other label, other position) tuples of all collisions
+    static std::vector<std::tuple<size_t, size_t, size_t, size_t>> edges(const gloperate_text::layout::CollisionGraph & graph)
+    {
+        std::vector<std::tuple<size_t, size_t, size_t, size_t>> result;
+        for (size_t i = 0; i < graph.size(); ++i)
+            for (size_t position = 0; position < graph[i].size(); ++position)
+                for (const auto & collision : graph[i][position])
+                    result.emplace_back(i, position, collision.index, collision.position);
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+TEST_F(LayoutEngine_test, CollisionGraphMatchesFullRecompute)
+{
+    std::default_random_engine generator;
+    std::uniform_real_distribution<float> distribution(0.f, 200.f);
+
+    gloperate_text::layout::LayoutEngine engine(gloperate_text::layout::standard);
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 100; ++i)
+    {
+        labels.push_back(label({distribution(generator), distribution(generator)}));
+        engine.insert(labels.back());
+    }
+    // move some of the labels
+    for (size_t i = 0; i < labels.size(); i += 3)
+    {
+        labels[i].pointLocation = {distribution(generator), distribution(generator)};
+        engine.update(i, labels[i]);
+    }
+
+    const auto labelAreas = gloperate_text::layout::computeLabelAreas(labels, gloperate_text::layout::cornerPositions());
+    const auto expected = gloperate_text::layout::createCollisionGraph(labelAreas, glm::vec2(0.2f));
+    EXPECT_EQ(edges(expected), edges(engine.collisionGraph()));
+}
+
+TEST_F(LayoutEngine_test, CollisionGraphMatchesForMixedExtents)
+{
+    std::default_random_engine generator;
+    std::uniform_real_distribution<float> distribution(0.f, 400.f);
+
+    // the first label is much smaller than the others, the grid is rebuilt as the mean extent grows
+    gloperate_text::layout::LayoutEngine engine(gloperate_text::layout::standard);
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 60; ++i)
+    {
+        labels.push_back(label({distribution(generator), distribution(generator)}));
+        labels.back().sequence.setFontSize(i == 0 ? 1.f : (i % 10 == 0 ? 80.f : 10.f));
+        engine.insert(labels.back());
+    }
+    engine.erase(0);
+    labels[0].sequence.setString(U"");
+    engine.insert(labels[0]);
+
+    const auto labelAreas = gloperate_text::layout::computeLabelAreas(labels, gloperate_text::layout::cornerPositions());
+    const auto expected = gloperate_text::layout::createCollisionGraph(labelAreas, glm::vec2(0.2f));
+    EXPECT_EQ(edges(expected), edges(engine.collisionGraph()));
+}
+
+TEST_F(LayoutEngine_test, CollisionGraphMatchesForOversizedLabels)
+{
+    std::default_random_engine generator;
+    std::uniform_real_distribution<float> distribution(0.f, 400.f);
+
+    // two labels span the whole area and are tested outside of the grid of createCollisionGraph
+    gloperate_text::layout::LayoutEngine engine(gloperate_text::layout::standard);
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 80; ++i)
+    {
+        labels.push_back(label({distribution(generator), distribution(generator)}));
+        if (i == 5 || i == 50)
+            labels.back().sequence.setString(std::u32string(40, U'x'));
+        engine.insert(labels.back());
+    }
+
+    const auto labelAreas = gloperate_text::layout::computeLabelAreas(labels, gloperate_text::layout::cornerPositions());
+    const auto expected = gloperate_text::layout::createCollisionGraph(labelAreas, glm::vec2(0.2f));
+    EXPECT_EQ(edges(expected), edges(engine.collisionGraph()));
+
+    const auto neighbours = gloperate_text::layout::createNeighbourGraph(labelAreas, glm::vec2(0.2f));
+    EXPECT_LT(2u, neighbours[5].size());
+    for (const auto other : neighbours[5])
+        EXPECT_NE(neighbours[other].end(), std::find(neighbours[other].begin(), neighbours[other].end(), 5u));
+}
+
+TEST_F(LayoutEngine_test, ChangesOnlyAffectNeighbourhood)
+{
+    gloperate_text::layout::LayoutEngine engine(gloperate_text::layout::standard, true, glm::vec2(0.f));
+    for (int i = 0; i < 10; ++i)
+        engine.insert(label({i * 100.f, 0.f}));
+    EXPECT_TRUE(engine.layout());
+    EXPECT_EQ(0u, engine.pendingLabels());
+    const auto before = engine.labels();
+
+    // a new label at the same point as label 3 only affects label 3
+    const auto id = engine.insert(label({300.f, 0.f}));
+    EXPECT_EQ(10u, id);
+    EXPECT_EQ(2u, engine.pendingLabels());
+    EXPECT_TRUE(engine.layout());
+
+    const auto & a = engine.label(3).placement;
+    const auto & b = engine.label(id).placement;
+    EXPECT_TRUE(a.display && b.display);
+    EXPECT_TRUE(a.offset != b.offset);
+    for (size_t i = 0; i < before.size(); ++i)
+    {
+        if (i == 3) continue;
+        EXPECT_EQ(before[i].placement.offset, engine.label(i).placement.offset);
+    }
+
+    // moving the new label away and erasing it again
+    engine.update(id, label({1500.f, 0.f}));
+    EXPECT_TRUE(engine.layout());
+    engine.erase(id);
+    EXPECT_FALSE(engine.contains(id));
+    EXPECT_EQ(10u, engine.size());
+    EXPECT_TRUE(engine.layout());
+    EXPECT_EQ(before[3].placement.offset, engine.label(3).placement.offset);
+
+    // erased ids are reused
+    EXPECT_EQ(id, engine.insert(label({2000.f, 0.f})));
+}
+
+TEST_F(LayoutEngine_test, LayoutRespectsBudget)
+{
+    gloperate_text::layout::LayoutEngine engine(gloperate_text::layout::overlapArea, false, glm::vec2(0.f));
+    for (int i = 0; i < 64; ++i)
+        engine.insert(label({(i % 8) * 15.f, (i / 8) * 8.f}));
+
+    EXPECT_FALSE(engine.layout(gloperate_text::layout::LayoutBudget(gloperate_text::layout::LayoutBudget::Clock::duration::max(), 10)));
+    EXPECT_GT(engine.pendingLabels(), 0u);
+    while (!engine.layout(gloperate_text::layout::LayoutBudget(gloperate_text::layout::LayoutBudget::Clock::duration::max(), 10)));
+    EXPECT_EQ(0u, engine.pendingLabels());
+}
+
+TEST_F(LayoutEngine_test, LayoutContinuesDeferredLabels)
+{
+    gloperate_text::layout::LayoutEngine engine(gloperate_text::layout::overlapArea, false, glm::vec2(0.f));
+    engine.setMaxChangesPerLayout(1);
+    for (int i = 0; i < 64; ++i)
+        engine.insert(label({(i % 8) * 15.f, (i / 8) * 8.f}));
+
+    // labels that would change their position a second time are deferred to the next call
+    EXPECT_FALSE(engine.layout());
+    EXPECT_GT(engine.pendingLabels(), 0u);
+
+    const auto before = engine.labels();
+    engine.layout();
+    const auto after = engine.labels();
+    auto moved = false;
+    for (size_t i = 0; i < before.size(); ++i)
+        moved |= before[i].placement.offset != after[i].placement.offset;
+    EXPECT_TRUE(moved);
+
+    while (!engine.layout());
+    EXPECT_EQ(0u, engine.pendingLabels());
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string>
+
+#include <glm/vec2.hpp>
+
+#include <openll/FontFace.h>
+#include <openll/Glyph.h>
+#include <openll/GlyphSequence.h>
+#include <openll/layout/layoutbase.h>
+
+// font faces without font files and labels for the layout and typesetting tests and benchmarks
+namespace layouttest
+{
+
+// base and ascent of 8pt, descent of -2pt
+inline void setMetrics(gloperate_text::FontFace & fontFace, float lineHeight)
+{
+    fontFace.setBase(8.f);
+    fontFace.setAscent(8.f);
+    fontFace.setDescent(-2.f);
+    fontFace.setLineHeight(lineHeight);
+}
+
+// glyphs of the given advance and extent; spaces have no extent and an advance of 3pt
+inline void addGlyphs(gloperate_text::FontFace & fontFace, const std::u32string & characters, float advance, const glm::vec2 & extent
+    , const glm::vec2 & subTextureExtent = glm::vec2(0.1f))
+{
+    for (const auto character : characters)
+    {
+        const auto space = character == U' ';
+        gloperate_text::Glyph glyph;
+        glyph.setIndex(character);
+        glyph.setAdvance(space ? 3.f : advance);
+        glyph.setExtent(space ? glm::vec2(0.f) : extent);
+        glyph.setSubTextureExtent(space ? glm::vec2(0.f) : subTextureExtent);
+        fontFace.addGlyph(glyph);
+    }
+}
+
+inline gloperate_text::GlyphSequence sequence(gloperate_text::FontFace & fontFace, const std::u32string & string, float fontSize = 10.f)
+{
+    gloperate_text::GlyphSequence sequence;
+    sequence.setString(string);
+    sequence.setFontFace(&fontFace);
+    sequence.setFontSize(fontSize);
+    return sequence;
+}
+
+// displayed at the upper right of its point
+inline gloperate_text::Label label(const gloperate_text::GlyphSequence & sequence, const glm::vec2 & location, unsigned int priority = 1)
+{
+    return {sequence, location, priority, {{0.f, 0.f}, gloperate_text::Alignment::LeftAligned, gloperate_text::LineAnchor::Bottom, true}};
+}
+
+}
+
+// The font face of the layout tests, a single glyph 'x' of 10x10pt, so that label() creates labels of 20x10 units;
+// test fixtures derive from testing::Test and this class
+class LayoutTestFixture
+{
+public:
+    LayoutTestFixture()
+    {
+        layouttest::setMetrics(m_fontFace, 10.f);
+        layouttest::addGlyphs(m_fontFace, U"x", 10.f, glm::vec2(10.f));
+    }
+
+    gloperate_text::Label label(const glm::vec2 & location, unsigned int priority = 1)
+    {
+        return layouttest::label(layouttest::sequence(m_fontFace, U"xx"), location, priority);
+    }
+
+protected:
+    gloperate_text::FontFace m_fontFace;
+};
@@ -0,0 +1,77 @@
+#include <gmock/gmock.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFace.h>
+#include <openll/GlyphRenderStatistics.h>
+#include <openll/GlyphRenderer.h>
+#include <openll/GlyphVertexCloud.h>
+#include <openll/NullRenderBackend.h>
+
+class NullRenderBackend_test: public testing::Test
+{
+public:
+    NullRenderBackend_test()
+    : m_backend(new gloperate_text::NullRenderBackend)
+    {
+    }
+
+protected:
+    globjects::ref_ptr<gloperate_text::NullRenderBackend> m_backend;
+};
+
+TEST_F(NullRenderBackend_test, CountsGlyphTextures)
+{
+    globjects::ref_ptr<gloperate_text::FontFace> fontFace = new gloperate_text::FontFace;
+    fontFace->setGlyphTextureExtent({ 16, 8 });
+    fontFace->setGlyphImage(std::vector<unsigned char>(16 * 8));
+
+    m_backend->createGlyphTexture(*fontFace);
+
+    EXPECT_EQ(1u, m_backend->counters().textures);
+    EXPECT_EQ(128u, m_backend->counters().textureBytes);
+    EXPECT_EQ(nullptr, fontFace->glyphTexture());
+
+    fontFace->setGlyphTexturePages(3);
+    fontFace->setGlyphImage(std::vector<unsigned char>(16 * 8 * 3));
+    m_backend->createGlyphTexture(*fontFace);
+    EXPECT_EQ(2u, m_backend->counters().textures);
+    EXPECT_EQ(128u + 3 * 128u, m_backend->counters().textureBytes);
+}
+
+TEST_F(NullRenderBackend_test, CountsUploadsAndDrawsWithoutContext)
+{
+    const auto vertexBytes = sizeof(gloperate_text::GlyphVertexCloud::Vertex);
+
+    gloperate_text::GlyphVertexCloud cloud(m_backend);
+    cloud.vertices().resize(10);
+    cloud.update();
+    cloud.update(gloperate_text::GlyphVertexCloud::Vertices(4));
+
+    EXPECT_EQ(m_backend, cloud.backend());
+    EXPECT_EQ(nullptr, cloud.drawable());
+    EXPECT_EQ(4u, cloud.uploadedSize());
+    EXPECT_EQ(2u, m_backend->counters().uploads);
+    EXPECT_EQ(14 * vertexBytes, m_backend->counters().uploadedBytes);
+
+    gloperate_text::GlyphRenderStatistics statistics(false);
+    gloperate_text::GlyphRenderer renderer(m_backend);
+    renderer.setStatistics(&statistics);
+    EXPECT_EQ(nullptr, renderer.program());
+
+    renderer.render(cloud);
+    renderer.renderInWorld(cloud, glm::mat4());
+    renderer.render(gloperate_text::GlyphVertexCloud(m_backend));
+
+    // empty clouds are skipped, the last upload is drawn
+    EXPECT_EQ(2u, m_backend->counters().drawCalls);
+    EXPECT_EQ(8u, m_backend->counters().drawnGlyphs);
+    EXPECT_EQ(2u, statistics.currentFrame().drawCalls);
+    EXPECT_EQ(14 * vertexBytes, statistics.currentFrame().uploadedBytes);
+
+    m_backend->reset();
+    EXPECT_EQ(0u, m_backend->counters().uploads);
+    EXPECT_EQ(0u, m_backend->counters().drawCalls);
+}
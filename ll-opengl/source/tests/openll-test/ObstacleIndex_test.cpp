@@ -0,0 +1,126 @@
+#include <gmock/gmock.h>
+
+#include <random>
+
+#include <openll/layout/algorithm.h>
+#include <openll/layout/CandidateLayout.h>
+#include <openll/layout/CandidatePosition.h>
+#include <openll/layout/LabelArea.h>
+#include <openll/layout/layoutbase.h>
+#include <openll/layout/ObstacleIndex.h>
+
+#include "LayoutTestFixture.h"
+
+class ObstacleIndex_test: public testing::Test, public LayoutTestFixture
+{
+public:
+    // blocks the upper right and upper left placements of a label at location
+    static gloperate_text::layout::Obstacle panelAbove(const glm::vec2 & location)
+    {
+        return {{location + glm::vec2(-30.f, 2.f), {60.f, 20.f}}, gloperate_text::layout::Obstacle::noLabel};
+    }
+};
+
+TEST_F(ObstacleIndex_test, OverlapAreaMatchesPairwiseTests)
+{
+    std::default_random_engine generator;
+    std::uniform_real_distribution<float> coordinate(0.f, 200.f);
+    // not smaller than the labels, so that no obstacle is grown
+    std::uniform_real_distribution<float> size(10.f, 30.f);
+
+    std::vector<gloperate_text::layout::Obstacle> obstacles;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        const gloperate_text::LabelArea area {{coordinate(generator), coordinate(generator)}, {size(generator), size(generator)}};
+        obstacles.push_back({area, i % 10 == 0 ? i / 10 : gloperate_text::layout::Obstacle::noLabel});
+    }
+    // a panel covering many cells
+    obstacles.push_back({{{50.f, 50.f}, {120.f, 40.f}}, gloperate_text::layout::Obstacle::noLabel});
+    const gloperate_text::layout::ObstacleIndex index(obstacles);
+
+    const glm::vec2 padding(0.2f);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const gloperate_text::LabelArea area {{coordinate(generator), coordinate(generator)}, {20.f, 10.f}};
+        const gloperate_text::LabelArea padded {area.origin - area.extent * padding, area.extent * (1.f + 2.f * padding)};
+
+        auto expectedArea = 0.f;
+        auto expectedCount = 0;
+        for (const auto & obstacle : obstacles)
+        {
+            if (obstacle.label == i || !padded.overlaps(obstacle.area))
+                continue;
+            expectedArea += padded.overlapArea(obstacle.area);
+            ++expectedCount;
+        }
+
+        int count;
+        EXPECT_NEAR(expectedArea, index.overlapArea(area, padding, count, i), 1e-3f);
+        EXPECT_EQ(expectedCount, count);
+    }
+}
+
+TEST_F(ObstacleIndex_test, LayoutsAvoidObstacles)
+{
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 8; ++i)
+        labels.push_back(label({i * 100.f, 0.f}));
+
+    std::vector<gloperate_text::layout::Obstacle> obstacles;
+    for (const auto & label : labels)
+        obstacles.push_back(panelAbove(label.pointLocation));
+    // the icons at the labeled points do not hide their own labels
+    const auto icons = gloperate_text::layout::pointObstacles(labels, glm::vec2(4.f));
+    obstacles.insert(obstacles.end(), icons.begin(), icons.end());
+    const gloperate_text::layout::ObstacleIndex index(obstacles);
+
+    const auto expectBelow = [](const std::vector<gloperate_text::Label> & labels)
+    {
+        for (const auto & label : labels)
+        {
+            EXPECT_TRUE(label.placement.display);
+            EXPECT_LE(label.placement.offset.y + label.sequence.extent().y, 0.f);
+        }
+    };
+
+    auto annealed = labels;
+    gloperate_text::layout::simulatedAnnealing(annealed, gloperate_text::layout::standard, true, glm::vec2(0.f), gloperate_text::layout::LayoutBudget(), &index);
+    expectBelow(annealed);
+
+    auto sliding = labels;
+    gloperate_text::layout::slidingPlacement(sliding, gloperate_text::layout::standard, 2, true, glm::vec2(0.f), 0.3f, gloperate_text::layout::LayoutBudget(), &index);
+    expectBelow(sliding);
+}
+
+TEST_F(ObstacleIndex_test, PointsAddOverlapArea)
+{
+    const gloperate_text::layout::ObstacleIndex index({{{{10.f, 5.f}, {0.f, 0.f}}, gloperate_text::layout::Obstacle::noLabel}});
+
+    // counts as a 10x10 square
+    int count;
+    EXPECT_FLOAT_EQ(100.f, index.overlapArea({{0.f, 0.f}, {20.f, 10.f}}, glm::vec2(0.f), count));
+    EXPECT_EQ(1, count);
+    EXPECT_FLOAT_EQ(0.f, index.overlapArea({{-20.f, 0.f}, {20.f, 10.f}}, glm::vec2(0.f), count));
+    EXPECT_EQ(0, count);
+}
+
+TEST_F(ObstacleIndex_test, LayoutsAvoidPoints)
+{
+    auto labels = std::vector<gloperate_text::Label>{ label({0.f, 0.f}) };
+    const auto obstacle = glm::vec2(10.f, 5.f);
+    const gloperate_text::layout::ObstacleIndex index({{{obstacle, {0.f, 0.f}}, gloperate_text::layout::Obstacle::noLabel}});
+
+    // the point lies within the preferred upper right placement
+    auto unobstructed = labels;
+    gloperate_text::layout::simulatedAnnealing(unobstructed, gloperate_text::layout::standard, false, glm::vec2(0.f));
+    const auto & offset = unobstructed.front().placement.offset;
+    ASSERT_TRUE(gloperate_text::LabelArea({offset, unobstructed.front().sequence.extent()}).overlaps({obstacle, {0.f, 0.f}}));
+
+    for (const auto penaltyFunction : { gloperate_text::layout::standard, gloperate_text::layout::overlapArea })
+    {
+        auto annealed = labels;
+        gloperate_text::layout::simulatedAnnealing(annealed, penaltyFunction, false, glm::vec2(0.f), gloperate_text::layout::LayoutBudget(), &index);
+        const auto & placement = annealed.front().placement;
+        EXPECT_FALSE(gloperate_text::LabelArea({placement.offset, annealed.front().sequence.extent()}).overlaps({obstacle, {0.f, 0.f}}));
+    }
+}
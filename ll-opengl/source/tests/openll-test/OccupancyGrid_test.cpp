@@ -0,0 +1,62 @@
+#include <gmock/gmock.h>
+
+
+#include <openll/layout/LabelArea.h>
+#include <openll/layout/OccupancyGrid.h>
+
+class OccupancyGrid_test: public testing::Test
+{
+public:
+};
+
+TEST_F(OccupancyGrid_test, OccupyAndTest)
+{
+    // cells of 1x1 units, rows of two words
+    gloperate_text::layout::OccupancyGrid grid({0.f, 0.f}, {100.f, 10.f}, {100, 10});
+    EXPECT_FLOAT_EQ(1.f, grid.cellExtent().x);
+
+    const gloperate_text::LabelArea a {{60.f, 2.f}, {10.f, 2.f}};
+    EXPECT_FALSE(grid.occupied(a));
+    grid.occupy(a);
+    EXPECT_TRUE(grid.occupied(a));
+    EXPECT_EQ(20u, grid.occupiedCells(a));
+    EXPECT_FLOAT_EQ(20.f, grid.occupiedArea(a));
+
+    // touching at the border is no overlap, partially covered cells are
+    EXPECT_FALSE(grid.occupied({{70.f, 2.f}, {5.f, 2.f}}));
+    EXPECT_FALSE(grid.occupied({{50.f, 4.f}, {30.f, 2.f}}));
+    EXPECT_TRUE(grid.occupied({{69.5f, 3.5f}, {5.f, 2.f}}));
+    EXPECT_EQ(4u, grid.occupiedCells({{63.f, 0.f}, {2.f, 10.f}}));
+
+    grid.clear();
+    EXPECT_FALSE(grid.occupied(a));
+}
+
+TEST_F(OccupancyGrid_test, ClipsToBounds)
+{
+    gloperate_text::layout::OccupancyGrid grid({-1.f, -1.f}, {1.f, 1.f}, {64, 64});
+
+    grid.occupy({{0.9f, 0.9f}, {1.f, 1.f}});
+    EXPECT_TRUE(grid.occupied({{0.95f, 0.95f}, {0.01f, 0.01f}}));
+    EXPECT_FALSE(grid.occupied({{2.f, 2.f}, {1.f, 1.f}}));
+    EXPECT_FALSE(grid.occupied({{-3.f, -3.f}, {1.f, 1.f}}));
+    EXPECT_TRUE(grid.covers({{0.9f, 0.9f}, {1.f, 1.f}}));
+    EXPECT_FALSE(grid.covers({{2.f, 2.f}, {1.f, 1.f}}));
+
+    grid.reset({10.f, 10.f}, {12.f, 12.f});
+    EXPECT_FALSE(grid.occupied({{10.9f, 10.9f}, {1.f, 1.f}}));
+}
+
+TEST_F(OccupancyGrid_test, IgnoresEmptyBounds)
+{
+    gloperate_text::layout::OccupancyGrid grid({0.f, 0.f}, {0.f, 10.f}, {64, 64});
+
+    grid.occupy({{0.f, 0.f}, {1.f, 1.f}});
+    EXPECT_FALSE(grid.occupied({{0.f, 0.f}, {1.f, 1.f}}));
+    EXPECT_FLOAT_EQ(0.f, grid.occupiedArea({{0.f, 0.f}, {1.f, 1.f}}));
+    EXPECT_FALSE(grid.covers({{0.f, 0.f}, {1.f, 1.f}}));
+
+    grid.reset({0.f, 0.f}, {10.f, 10.f});
+    grid.occupy({{0.f, 0.f}, {1.f, 1.f}});
+    EXPECT_TRUE(grid.occupied({{0.f, 0.f}, {1.f, 1.f}}));
+}
@@ -0,0 +1,104 @@
+
+#include <gmock/gmock.h>
+
+#include <random>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/ShelfPacker.h>
+
+class ShelfPacker_test: public testing::Test
+{
+public:
+    static bool overlap(const glm::ivec2 & positionA, const glm::ivec2 & sizeA, const glm::ivec2 & positionB, const glm::ivec2 & sizeB)
+    {
+        return positionA.x < positionB.x + sizeB.x && positionB.x < positionA.x + sizeA.x
+            && positionA.y < positionB.y + sizeB.y && positionB.y < positionA.y + sizeA.y;
+    }
+};
+
+TEST_F(ShelfPacker_test, AllocatesAndReleasesWithoutOverlap)
+{
+    const auto extent = glm::ivec2(128, 128);
+    gloperate_text::ShelfPacker packer(extent);
+
+    std::default_random_engine generator(11);
+    std::uniform_int_distribution<int> size(4, 20);
+
+    std::vector<glm::ivec2> positions;
+    std::vector<glm::ivec2> sizes;
+    for (auto i = 0; i < 1000; ++i)
+    {
+        // release every third rectangle to fragment the shelves
+        if (i % 3 == 2 && !positions.empty())
+        {
+            const auto index = static_cast<size_t>(generator() % positions.size());
+            packer.release(positions[index], sizes[index]);
+            positions.erase(positions.begin() + index);
+            sizes.erase(sizes.begin() + index);
+            continue;
+        }
+
+        const auto rectangle = glm::ivec2(size(generator), size(generator));
+        auto position = glm::ivec2();
+        if (!packer.allocate(rectangle, position))
+            continue;
+        positions.push_back(position);
+        sizes.push_back(rectangle);
+    }
+
+    auto area = 0ll;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        EXPECT_GE(positions[i].x, 0);
+        EXPECT_GE(positions[i].y, 0);
+        EXPECT_LE(positions[i].x + sizes[i].x, extent.x);
+        EXPECT_LE(positions[i].y + sizes[i].y, extent.y);
+        area += static_cast<long long>(sizes[i].x) * sizes[i].y;
+
+        for (size_t j = 0; j < i; ++j)
+            EXPECT_FALSE(overlap(positions[i], sizes[i], positions[j], sizes[j]));
+    }
+    EXPECT_EQ(area, packer.allocatedArea());
+}
+
+TEST_F(ShelfPacker_test, ReusesReleasedSpace)
+{
+    gloperate_text::ShelfPacker packer({ 32, 16 });
+
+    auto a = glm::ivec2();
+    auto b = glm::ivec2();
+    auto c = glm::ivec2();
+    ASSERT_TRUE(packer.allocate({ 16, 16 }, a));
+    ASSERT_TRUE(packer.allocate({ 16, 16 }, b));
+    EXPECT_FALSE(packer.allocate({ 8, 8 }, c));
+
+    packer.release(a, { 16, 16 });
+    ASSERT_TRUE(packer.allocate({ 8, 12 }, c));
+    EXPECT_EQ(a, c);
+
+    // adjacent spans are merged
+    packer.release(c, { 8, 12 });
+    packer.release(b, { 16, 16 });
+    EXPECT_EQ(0, packer.allocatedArea());
+    ASSERT_TRUE(packer.allocate({ 32, 16 }, c));
+    EXPECT_EQ(glm::ivec2(0, 0), c);
+}
+
+TEST_F(ShelfPacker_test, ClosesEmptyShelves)
+{
+    gloperate_text::ShelfPacker packer({ 16, 32 });
+
+    auto low = glm::ivec2();
+    auto high = glm::ivec2();
+    ASSERT_TRUE(packer.allocate({ 16, 4 }, low));
+    ASSERT_TRUE(packer.allocate({ 16, 4 }, high));
+    EXPECT_EQ(4, high.y);
+
+    // the shelf of height 4 is closed, so the space above serves a taller rectangle
+    packer.release(high, { 16, 4 });
+    auto tall = glm::ivec2();
+    ASSERT_TRUE(packer.allocate({ 16, 28 }, tall));
+    EXPECT_EQ(4, tall.y);
+}
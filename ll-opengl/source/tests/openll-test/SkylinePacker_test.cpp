@@ -0,0 +1,74 @@
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/SkylinePacker.h>
+
+class SkylinePacker_test: public testing::Test
+{
+public:
+};
+
+TEST_F(SkylinePacker_test, PlacesWithoutOverlap)
+{
+    const auto extent = glm::ivec2(256, 128);
+    gloperate_text::SkylinePacker packer(extent);
+
+    std::default_random_engine generator(7);
+    std::uniform_int_distribution<int> size(1, 24);
+
+    std::vector<glm::ivec2> positions;
+    std::vector<glm::ivec2> sizes;
+    for (auto i = 0; i < 200; ++i)
+    {
+        const auto rectangle = glm::ivec2(size(generator), size(generator));
+        auto position = glm::ivec2();
+        if (!packer.pack(rectangle, position))
+            continue;
+        positions.push_back(position);
+        sizes.push_back(rectangle);
+    }
+
+    // most of the rectangles fit into the area of about twice their total size
+    EXPECT_GT(positions.size(), 100u);
+
+    auto height = 0;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        EXPECT_GE(positions[i].x, 0);
+        EXPECT_GE(positions[i].y, 0);
+        EXPECT_LE(positions[i].x + sizes[i].x, extent.x);
+        EXPECT_LE(positions[i].y + sizes[i].y, extent.y);
+        height = std::max(height, positions[i].y + sizes[i].y);
+
+        for (size_t j = 0; j < i; ++j)
+        {
+            const auto separate = positions[i].x + sizes[i].x <= positions[j].x || positions[j].x + sizes[j].x <= positions[i].x
+                || positions[i].y + sizes[i].y <= positions[j].y || positions[j].y + sizes[j].y <= positions[i].y;
+            EXPECT_TRUE(separate) << i << " overlaps " << j;
+        }
+    }
+    EXPECT_EQ(height, packer.height());
+}
+
+TEST_F(SkylinePacker_test, FillsRowsBottomUp)
+{
+    gloperate_text::SkylinePacker packer({ 4, 2 });
+
+    auto position = glm::ivec2();
+    for (const auto expected : { glm::ivec2(0, 0), glm::ivec2(2, 0), glm::ivec2(0, 1), glm::ivec2(2, 1) })
+    {
+        ASSERT_TRUE(packer.pack({ 2, 1 }, position));
+        EXPECT_EQ(expected, position);
+    }
+    EXPECT_FALSE(packer.pack({ 1, 1 }, position));
+
+    packer.clear();
+    EXPECT_TRUE(packer.pack({ 4, 2 }, position));
+    EXPECT_EQ(2, packer.height());
+}
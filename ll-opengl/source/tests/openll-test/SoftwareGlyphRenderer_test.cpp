@@ -0,0 +1,202 @@
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <glm/mat4x4.hpp>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFace.h>
+#include <openll/GlyphVertexCloud.h>
+#include <openll/RasterImage.h>
+#include <openll/SoftwareGlyphRenderer.h>
+#include <openll/SuperSampling.h>
+
+class SoftwareGlyphRenderer_test: public testing::Test
+{
+public:
+    SoftwareGlyphRenderer_test()
+    : m_fontFace(new gloperate_text::FontFace)
+    {
+    }
+
+    void setAtlas(const glm::uvec2 & extent, std::vector<unsigned char> texels)
+    {
+        m_fontFace->setGlyphTextureExtent(extent);
+        m_fontFace->setGlyphImage(std::move(texels));
+    }
+
+    static gloperate_text::GlyphVertexCloud::Vertex quad(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight, const glm::vec4 & color
+        , gloperate_text::SuperSampling superSampling = gloperate_text::SuperSampling::None)
+    {
+        gloperate_text::GlyphVertexCloud::Vertex vertex;
+        vertex.origin = glm::vec3(lowerLeft, 0.f);
+        vertex.vtan = glm::vec3(upperRight.x - lowerLeft.x, 0.f, 0.f);
+        vertex.vbitan = glm::vec3(0.f, upperRight.y - lowerLeft.y, 0.f);
+        vertex.uvRect = glm::vec4(0.f, 0.f, 1.f, 1.f);
+        vertex.fontColor = color;
+        vertex.superSampling = static_cast<unsigned int>(superSampling);
+        vertex.page = 0;
+        return vertex;
+    }
+
+    static glm::ivec4 pixel(const gloperate_text::RasterImage & image, int x, int y)
+    {
+        const auto rgba = image.pixel(x, y);
+        return glm::ivec4(rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
+
+protected:
+    globjects::ref_ptr<gloperate_text::FontFace> m_fontFace;
+};
+
+TEST_F(SoftwareGlyphRenderer_test, FillsPixelCentersInside)
+{
+    setAtlas({ 4, 4 }, std::vector<unsigned char>(16, 255));
+
+    gloperate_text::GlyphVertexCloud cloud;
+    cloud.vertices().push_back(quad({ -0.5f, -0.5f }, { 0.5f, 0.5f }, { 1.f, 0.f, 0.f, 1.f }));
+
+    gloperate_text::RasterImage image({ 8, 8 }, { 0.f, 0.f, 1.f, 1.f });
+    gloperate_text::SoftwareGlyphRenderer(1).render(cloud, *m_fontFace, image);
+
+    for (int y = 0; y < 8; ++y)
+    {
+        for (int x = 0; x < 8; ++x)
+        {
+            const auto covered = x >= 2 && x < 6 && y >= 2 && y < 6;
+            EXPECT_EQ(covered ? glm::ivec4(255, 0, 0, 255) : glm::ivec4(0, 0, 255, 255), pixel(image, x, y));
+        }
+    }
+}
+
+TEST_F(SoftwareGlyphRenderer_test, BlendsSharedEdgesOnce)
+{
+    setAtlas({ 4, 4 }, std::vector<unsigned char>(16, 255));
+
+    // the shared edge passes through the centers of the pixels in column 4
+    const auto color = glm::vec4(1.f, 1.f, 1.f, 0.5f);
+    gloperate_text::GlyphVertexCloud cloud;
+    cloud.vertices().push_back(quad({ -0.5f, -0.5f }, { 0.125f, 0.5f }, color));
+    cloud.vertices().push_back(quad({ 0.125f, -0.5f }, { 0.5f, 0.5f }, color));
+
+    gloperate_text::RasterImage image({ 8, 8 });
+    gloperate_text::SoftwareGlyphRenderer(1).render(cloud, *m_fontFace, image);
+
+    for (int x = 2; x < 6; ++x)
+        EXPECT_EQ(glm::ivec4(128, 128, 128, 64), pixel(image, x, 3));
+}
+
+TEST_F(SoftwareGlyphRenderer_test, ClampsAlpha)
+{
+    setAtlas({ 4, 4 }, std::vector<unsigned char>(16, 255));
+
+    // 3 quads take the vectorized path, the remaining pixel of each row the scalar one
+    gloperate_text::GlyphVertexCloud cloud;
+    cloud.vertices().push_back(quad({ -0.5f, -0.5f }, { 0.75f, 0.5f }, { 1.f, 0.f, 0.f, 2.f }));
+    cloud.vertices().push_back(quad({ -0.5f, -0.5f }, { 0.75f, 0.5f }, { 0.f, 1.f, 0.f, -1.f }));
+
+    gloperate_text::RasterImage image({ 8, 8 }, { 0.f, 0.f, 1.f, 1.f });
+    gloperate_text::SoftwareGlyphRenderer(1).render(cloud, *m_fontFace, image);
+
+    for (int x = 2; x < 7; ++x)
+        EXPECT_EQ(glm::ivec4(255, 0, 0, 255), pixel(image, x, 3));
+}
+
+TEST_F(SoftwareGlyphRenderer_test, SamplesPageOfVertex)
+{
+    // page 0 is outside the glyphs, page 1 inside
+    auto texels = std::vector<unsigned char>(16, 0);
+    texels.resize(32, 255);
+    setAtlas({ 4, 4 }, texels);
+    m_fontFace->setGlyphTexturePages(2);
+
+    gloperate_text::GlyphVertexCloud cloud;
+    cloud.vertices().push_back(quad({ -1.f, -1.f }, { 0.f, 1.f }, { 1.f, 0.f, 0.f, 1.f }));
+    cloud.vertices().push_back(quad({ 0.f, -1.f }, { 1.f, 1.f }, { 1.f, 0.f, 0.f, 1.f }));
+    cloud.vertices().back().page = 1;
+    // pages beyond the glyph texture are skipped
+    cloud.vertices().push_back(quad({ -1.f, -1.f }, { 1.f, 1.f }, { 0.f, 1.f, 0.f, 1.f }));
+    cloud.vertices().back().page = 2;
+
+    gloperate_text::RasterImage image({ 8, 8 }, { 0.f, 0.f, 1.f, 1.f });
+    gloperate_text::SoftwareGlyphRenderer(1).render(cloud, *m_fontFace, image);
+
+    EXPECT_EQ(glm::ivec4(0, 0, 255, 255), pixel(image, 2, 4));
+    EXPECT_EQ(glm::ivec4(255, 0, 0, 255), pixel(image, 6, 4));
+}
+
+TEST_F(SoftwareGlyphRenderer_test, ThresholdsDistanceField)
+{
+    // the distance increases by 4 per texel, one texel per pixel
+    std::vector<unsigned char> ramp(64);
+    for (size_t i = 0; i < ramp.size(); ++i)
+        ramp[i] = static_cast<unsigned char>(i * 4);
+    setAtlas({ 64, 1 }, ramp);
+
+    for (unsigned int mode = 0; mode <= static_cast<unsigned int>(gloperate_text::SuperSampling::Grid4x4); ++mode)
+    {
+        gloperate_text::GlyphVertexCloud cloud;
+        cloud.vertices().push_back(quad({ -1.f, -1.f }, { 1.f, 1.f }, { 0.f, 0.f, 0.f, 1.f }, static_cast<gloperate_text::SuperSampling>(mode)));
+
+        gloperate_text::RasterImage image({ 64, 1 }, { 1.f, 1.f, 1.f, 0.f });
+        gloperate_text::SoftwareGlyphRenderer(1).render(cloud, *m_fontFace, image);
+
+        // discarded below 0.3
+        EXPECT_EQ(glm::ivec4(255, 255, 255, 0), pixel(image, 10, 0)) << "mode " << mode;
+        EXPECT_EQ(glm::ivec4(0, 0, 0, 255), pixel(image, 60, 0)) << "mode " << mode;
+
+        // antialiased around 0.5, monotonic
+        const auto edge = pixel(image, 32, 0);
+        EXPECT_GT(edge.x, 0) << "mode " << mode;
+        EXPECT_LT(edge.x, 255) << "mode " << mode;
+        for (int x = 20; x < 63; ++x)
+            EXPECT_GE(pixel(image, x, 0).x, pixel(image, x + 1, 0).x) << "mode " << mode << ", x " << x;
+    }
+}
+
+TEST_F(SoftwareGlyphRenderer_test, IndependentOfThreadsAndTiles)
+{
+    // radial distance field
+    std::vector<unsigned char> field(32 * 32);
+    for (int y = 0; y < 32; ++y)
+    {
+        for (int x = 0; x < 32; ++x)
+        {
+            const auto distance = std::sqrt((x - 15.5f) * (x - 15.5f) + (y - 15.5f) * (y - 15.5f));
+            const auto value = std::min(std::max(0.5f + (8.f - distance) / 16.f, 0.f), 1.f);
+            field[y * 32 + x] = static_cast<unsigned char>(value * 255.f);
+        }
+    }
+    setAtlas({ 32, 32 }, field);
+
+    std::default_random_engine generator(5);
+    std::uniform_real_distribution<float> position(-1.2f, 1.f);
+    std::uniform_real_distribution<float> size(0.02f, 0.4f);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    gloperate_text::GlyphVertexCloud cloud;
+    for (int i = 0; i < 300; ++i)
+    {
+        const auto lowerLeft = glm::vec2(position(generator), position(generator));
+        const auto extent = glm::vec2(size(generator), size(generator));
+        const auto color = glm::vec4(unit(generator), unit(generator), unit(generator), unit(generator));
+        cloud.vertices().push_back(quad(lowerLeft, lowerLeft + extent, color, static_cast<gloperate_text::SuperSampling>(i % 8)));
+    }
+
+    // perspective, w depends on x
+    glm::mat4 viewProjection;
+    viewProjection[0][3] = 0.25f;
+
+    gloperate_text::RasterImage single({ 211, 157 }, { 1.f, 1.f, 1.f, 1.f });
+    gloperate_text::SoftwareGlyphRenderer(1, 1024).renderInWorld(cloud, *m_fontFace, viewProjection, single);
+
+    gloperate_text::RasterImage tiled({ 211, 157 }, { 1.f, 1.f, 1.f, 1.f });
+    gloperate_text::SoftwareGlyphRenderer(4, 16).renderInWorld(cloud, *m_fontFace, viewProjection, tiled);
+
+    const auto bytes = static_cast<size_t>(211 * 157 * 4);
+    EXPECT_TRUE(std::equal(single.data(), single.data() + bytes, tiled.data()));
+    EXPECT_FALSE(std::all_of(single.data(), single.data() + bytes, [](std::uint8_t value) { return value == 255; }));
+}
@@ -0,0 +1,44 @@
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <openll/TaskPool.h>
+
+TEST(TaskPool_test, RunsEveryIndexOnce)
+{
+    gloperate_text::TaskPool pool(4);
+    EXPECT_EQ(4u, pool.threads());
+
+    for (const size_t count : { 0u, 1u, 3u, 10000u })
+    {
+        std::vector<std::atomic<int>> calls(count);
+        for (auto & call : calls)
+            call = 0;
+
+        pool.run(count, [&calls](size_t index) { ++calls[index]; });
+
+        for (size_t i = 0; i < count; ++i)
+            EXPECT_EQ(1, calls[i].load()) << "count " << count << ", index " << i;
+    }
+}
+
+TEST(TaskPool_test, RethrowsAfterAllTasksFinished)
+{
+    gloperate_text::TaskPool pool(3);
+
+    std::atomic<int> calls(0);
+    EXPECT_THROW(pool.run(100, [&calls](size_t index)
+    {
+        ++calls;
+        if (index == 42)
+            throw std::runtime_error("task failed");
+    }), std::runtime_error);
+    EXPECT_EQ(100, calls.load());
+
+    // usable after a failed run
+    calls = 0;
+    pool.run(100, [&calls](size_t) { ++calls; });
+    EXPECT_EQ(100, calls.load());
+}
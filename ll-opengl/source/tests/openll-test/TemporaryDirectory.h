@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// a unique directory in the temporary directory of the system for the files written by a test,
+// so that tests neither depend on nor clutter the working directory
+class TemporaryDirectory
+{
+public:
+    TemporaryDirectory()
+    {
+#ifdef _WIN32
+        const auto base = std::getenv("TEMP");
+        auto pattern = std::string(base ? base : ".") + "\\openll-test-XXXXXX";
+        if (_mktemp_s(&pattern[0], pattern.size() + 1) == 0 && _mkdir(pattern.c_str()) == 0)
+            m_path = pattern;
+#else
+        const auto base = std::getenv("TMPDIR");
+        auto pattern = std::string(base ? base : "/tmp") + "/openll-test-XXXXXX";
+        auto buffer = std::vector<char>(pattern.begin(), pattern.end());
+        buffer.push_back('\0');
+        if (mkdtemp(buffer.data()))
+            m_path = buffer.data();
+#endif
+    }
+
+    // the files written into the directory have to be removed before
+    ~TemporaryDirectory()
+    {
+        if (m_path.empty())
+            return;
+#ifdef _WIN32
+        _rmdir(m_path.c_str());
+#else
+        rmdir(m_path.c_str());
+#endif
+    }
+
+    TemporaryDirectory(const TemporaryDirectory &) = delete;
+    TemporaryDirectory & operator=(const TemporaryDirectory &) = delete;
+
+    // empty if the directory could not be created
+    const std::string & path() const
+    {
+        return m_path;
+    }
+
+    std::string file(const std::string & name) const
+    {
+        return m_path + "/" + name;
+    }
+
+protected:
+    std::string m_path;
+};
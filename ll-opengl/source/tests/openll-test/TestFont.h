@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// builds a small TrueType font in memory for the font generation tests
+namespace testfont
+{
+
+// big endian table data
+class Table
+{
+public:
+    Table & u16(int value) { bytes.push_back(static_cast<std::uint8_t>(value >> 8)); bytes.push_back(static_cast<std::uint8_t>(value)); return *this; }
+    Table & u32(std::uint32_t value) { u16(static_cast<int>(value >> 16)); return u16(static_cast<int>(value & 0xFFFF)); }
+    Table & zeros(size_t count) { bytes.insert(bytes.end(), count, 0); return *this; }
+
+    std::vector<std::uint8_t> bytes;
+};
+
+// simple glyph with on-curve (1) and off-curve (0) points given as x, y, flag
+inline Table simpleGlyph(const std::vector<std::vector<int>> & contours)
+{
+    Table glyph;
+    glyph.u16(static_cast<int>(contours.size())).u16(0).u16(0).u16(1000).u16(1000);
+
+    auto end = -1;
+    for (const auto & contour : contours)
+    {
+        end += static_cast<int>(contour.size() / 3);
+        glyph.u16(end);
+    }
+    glyph.u16(0); // no instructions
+
+    for (const auto & contour : contours)
+        for (size_t i = 0; i < contour.size(); i += 3)
+            glyph.bytes.push_back(static_cast<std::uint8_t>(contour[i + 2]));
+
+    // 16 bit deltas
+    for (const auto axis : { 0, 1 })
+    {
+        auto previous = 0;
+        for (const auto & contour : contours)
+        {
+            for (size_t i = 0; i < contour.size(); i += 3)
+            {
+                glyph.u16((contour[i + axis] - previous) & 0xFFFF);
+                previous = contour[i + axis];
+            }
+        }
+    }
+    return glyph;
+}
+
+// glyphs: 1 'A' square with a square hole, 2 'B' composite of 'A' moved by 100, 3 'O' four off-curve points, 4 ' ' empty
+inline std::vector<std::uint8_t> testFont()
+{
+    std::vector<Table> glyphs(5);
+    glyphs[1] = simpleGlyph({
+        { 0, 0, 1,  0, 1000, 1,  1000, 1000, 1,  1000, 0, 1 },
+        { 250, 250, 1,  750, 250, 1,  750, 750, 1,  250, 750, 1 } });
+    glyphs[2].u16(0xFFFF).u16(100).u16(0).u16(1100).u16(1000).u16(0x0003).u16(1).u16(100).u16(0);
+    glyphs[3] = simpleGlyph({ { 0, 0, 0,  0, 1000, 0,  1000, 1000, 0,  1000, 0, 0 } });
+
+    Table glyf, loca;
+    for (const auto & glyph : glyphs)
+    {
+        loca.u32(static_cast<std::uint32_t>(glyf.bytes.size()));
+        glyf.bytes.insert(glyf.bytes.end(), glyph.bytes.begin(), glyph.bytes.end());
+    }
+    loca.u32(static_cast<std::uint32_t>(glyf.bytes.size()));
+
+    Table head;
+    head.u32(0x00010000).u32(0).u32(0).u32(0x5F0F3CF5).u16(0).u16(1000).zeros(16).zeros(8).u16(0).u16(8).u16(2).u16(1).u16(0);
+
+    Table hhea;
+    hhea.u32(0x00010000).u16(800).u16(0xFFFF & -200).u16(100).zeros(24).u16(5);
+
+    Table maxp;
+    maxp.u32(0x00005000).u16(5);
+
+    Table hmtx;
+    for (const auto advance : { 500, 1200, 1300, 1100, 300 })
+        hmtx.u16(advance).u16(0);
+
+    // format 4: ' ', 'A'-'B', 'O' and the final segment
+    Table cmap;
+    cmap.u16(0).u16(1).u16(3).u16(1).u32(12);
+    cmap.u16(4).u16(16 + 4 * 8).u16(0).u16(8).u16(8).u16(2).u16(0);
+    for (const auto end : { 32, 66, 79, 0xFFFF }) cmap.u16(end);
+    cmap.u16(0);
+    for (const auto start : { 32, 65, 79, 0xFFFF }) cmap.u16(start);
+    for (const auto delta : { 4 - 32, 1 - 65, 3 - 79, 1 }) cmap.u16(delta & 0xFFFF);
+    for (auto i = 0; i < 4; ++i) cmap.u16(0);
+
+    Table kern;
+    kern.u16(0).u16(1).u16(0).u16(14 + 2 * 6).u16(0x0001).u16(2).u16(12).u16(1).u16(0);
+    kern.u16(1).u16(2).u16(0xFFFF & -100);
+    kern.u16(2).u16(1).u16(0xFFFF & -50);
+
+    const std::vector<std::pair<const char *, Table *>> tables = {
+        { "cmap", &cmap }, { "glyf", &glyf }, { "head", &head }, { "hhea", &hhea },
+        { "hmtx", &hmtx }, { "kern", &kern }, { "loca", &loca }, { "maxp", &maxp } };
+
+    Table font;
+    font.u32(0x00010000).u16(static_cast<int>(tables.size())).u16(128).u16(3).u16(0);
+    auto offset = static_cast<std::uint32_t>(12 + 16 * tables.size());
+    for (const auto & table : tables)
+    {
+        const auto name = table.first;
+        font.u32((static_cast<std::uint32_t>(name[0]) << 24) | (name[1] << 16) | (name[2] << 8) | name[3]);
+        font.u32(0).u32(offset).u32(static_cast<std::uint32_t>(table.second->bytes.size()));
+        offset += static_cast<std::uint32_t>(table.second->bytes.size());
+    }
+    for (const auto & table : tables)
+        font.bytes.insert(font.bytes.end(), table.second->bytes.begin(), table.second->bytes.end());
+
+    return font.bytes;
+}
+
+} // namespace testfont
@@ -0,0 +1,139 @@
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <openll/FontFace.h>
+#include <openll/GlyphSequence.h>
+#include <openll/RasterImage.h>
+#include <openll/SoftwareGlyphRenderer.h>
+#include <openll/TaskPool.h>
+#include <openll/TilePipeline.h>
+#include <openll/layout/layoutbase.h>
+
+#include "LayoutTestFixture.h"
+
+class TilePipeline_test: public testing::Test
+{
+public:
+    TilePipeline_test()
+    : m_pool(3)
+    {
+        layouttest::setMetrics(m_fontFace, 12.f);
+
+        // solid glyphs
+        m_fontFace.setGlyphTextureExtent({ 4, 4 });
+        m_fontFace.setGlyphImage(std::vector<unsigned char>(16, 255));
+        layouttest::addGlyphs(m_fontFace, U"ab ", 6.f, glm::vec2(4.f, 8.f), glm::vec2(1.f));
+    }
+
+    gloperate_text::Label label(const std::u32string & string, const glm::vec2 & location, bool display = true)
+    {
+        auto label = layouttest::label(layouttest::sequence(m_fontFace, string, 12.f), location);
+        label.sequence.setAdditionalTransform(glm::translate(glm::mat4(), glm::vec3(location, 0.f)));
+        label.placement = { glm::vec2(0.f), gloperate_text::Alignment::LeftAligned, gloperate_text::LineAnchor::Baseline, display };
+        return label;
+    }
+
+protected:
+    gloperate_text::FontFace m_fontFace;
+    gloperate_text::TaskPool m_pool;
+};
+
+TEST_F(TilePipeline_test, PreparesDisplayedLabelsOnly)
+{
+    std::vector<gloperate_text::Label> labels { label(U"ab", { 10.f, 10.f }), label(U"aa", { 50.f, 50.f }, false) };
+
+    gloperate_text::TilePipeline pipeline({ 0.f, 0.f }, { 128.f, 128.f }, 64, 0, &m_pool);
+    auto layoutCalls = 0;
+    pipeline.prepare(labels, [&layoutCalls](std::vector<gloperate_text::Label> &) { ++layoutCalls; });
+
+    EXPECT_EQ(1, layoutCalls);
+    EXPECT_EQ(2u, pipeline.vertices().size());
+
+    // lower left world quadrant is tile (0, 1) of zoom level 1
+    const auto tiles = pipeline.tiles(1);
+    ASSERT_EQ(1u, tiles.size());
+    EXPECT_EQ(1u, tiles[0].z);
+    EXPECT_EQ(0u, tiles[0].x);
+    EXPECT_EQ(1u, tiles[0].y);
+}
+
+TEST_F(TilePipeline_test, CrossingLabelsAppearInNeighbourTiles)
+{
+    // the first glyph ends left of the tile border at x = 64, the second starts right of it
+    std::vector<gloperate_text::Label> labels { label(U"ab", { 58.f, 20.f }), label(U"b", { 20.f, 20.f }) };
+
+    gloperate_text::TilePipeline pipeline({ 0.f, 0.f }, { 128.f, 128.f }, 64, 8, &m_pool);
+    pipeline.prepare(labels);
+
+    std::mutex mutex;
+    std::vector<gloperate_text::TilePipeline::Tile> tiles;
+    pipeline.process(pipeline.tiles(1), [&](const gloperate_text::TilePipeline::Tile & tile)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tiles.push_back(tile);
+    });
+
+    ASSERT_EQ(2u, tiles.size());
+    std::sort(tiles.begin(), tiles.end(), [](const gloperate_text::TilePipeline::Tile & a, const gloperate_text::TilePipeline::Tile & b) { return a.id.x < b.id.x; });
+
+    // with halo, both tiles get both glyphs of the crossing label, in label order
+    ASSERT_EQ(3u, tiles[0].vertices.size());
+    EXPECT_EQ(pipeline.vertices()[0].origin, tiles[0].vertices[0].origin);
+    EXPECT_EQ(pipeline.vertices()[1].origin, tiles[0].vertices[1].origin);
+    EXPECT_EQ(pipeline.vertices()[2].origin, tiles[0].vertices[2].origin);
+    ASSERT_EQ(2u, tiles[1].vertices.size());
+    EXPECT_EQ(pipeline.vertices()[0].origin, tiles[1].vertices[0].origin);
+
+    EXPECT_EQ(glm::vec2(0.f, 0.f), tiles[0].lowerLeft);
+    EXPECT_EQ(glm::vec2(64.f, 64.f), tiles[0].upperRight);
+}
+
+TEST_F(TilePipeline_test, StitchedTilesMatchFullRender)
+{
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 40; ++i)
+        labels.push_back(label(i % 2 ? U"ab ba" : U"bab", { static_cast<float>((i * 37) % 120) - 10.f, static_cast<float>((i * 53) % 124) }));
+
+    const auto tileSize = 32;
+    gloperate_text::TilePipeline pipeline({ 0.f, 0.f }, { 128.f, 128.f }, tileSize, 4, &m_pool);
+    pipeline.prepare(labels);
+
+    // one pixel per world unit
+    gloperate_text::GlyphVertexCloud cloud;
+    cloud.vertices() = pipeline.vertices();
+    gloperate_text::RasterImage full({ 128, 128 });
+    gloperate_text::SoftwareGlyphRenderer(1).renderInWorld(cloud, m_fontFace, glm::ortho(0.f, 128.f, 0.f, 128.f), full);
+
+    gloperate_text::RasterImage stitched({ 128, 128 });
+    std::mutex mutex;
+    pipeline.render(pipeline.tiles(2), m_fontFace, [&](const gloperate_text::TilePipeline::Tile & tile, const gloperate_text::RasterImage & image)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto left = static_cast<int>(tile.id.x) * tileSize;
+        const auto bottom = (3 - static_cast<int>(tile.id.y)) * tileSize;
+        for (int y = 0; y < tileSize; ++y)
+        {
+            for (int x = 0; x < tileSize; ++x)
+                std::copy(image.pixel(x, y), image.pixel(x, y) + 4, stitched.pixel(left + x, bottom + y));
+        }
+    });
+
+    auto differences = 0;
+    auto covered = 0;
+    for (int y = 0; y < 128; ++y)
+    {
+        for (int x = 0; x < 128; ++x)
+        {
+            for (int c = 0; c < 4; ++c)
+                differences += std::abs(full.pixel(x, y)[c] - stitched.pixel(x, y)[c]) > 1 ? 1 : 0;
+            covered += full.pixel(x, y)[3] > 0 ? 1 : 0;
+        }
+    }
+    EXPECT_EQ(0, differences);
+    EXPECT_GT(covered, 1000);
+}
@@ -0,0 +1,57 @@
+
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <openll/Trace.h>
+
+class Trace_test: public testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        gloperate_text::Trace::stop();
+        gloperate_text::Trace::clear();
+    }
+};
+
+TEST_F(Trace_test, RecordsOnlyWhileRecording)
+{
+    gloperate_text::Trace::counter("ignored", 1.0);
+    {
+        const gloperate_text::TraceZone zone("ignored");
+    }
+    EXPECT_EQ(0u, gloperate_text::Trace::size());
+
+    gloperate_text::Trace::start();
+    {
+        const gloperate_text::TraceZone zone("zone");
+    }
+    gloperate_text::Trace::counter("glyphs", 42.0);
+    // zones and counters of other threads are recorded as well
+    std::thread([]() { gloperate_text::Trace::counter("glyphs", 7.0); }).join();
+    gloperate_text::Trace::stop();
+    gloperate_text::Trace::counter("ignored", 1.0);
+
+    EXPECT_EQ(3u, gloperate_text::Trace::size());
+}
+
+TEST_F(Trace_test, WritesTraceEvents)
+{
+    gloperate_text::Trace::start();
+    gloperate_text::Trace::zone("quoted \"zone\"", 1.0, 3.5);
+    gloperate_text::Trace::counter("glyphs", 42.0);
+    gloperate_text::Trace::stop();
+
+    std::ostringstream stream;
+    gloperate_text::Trace::write(stream);
+    const auto json = stream.str();
+
+    EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("{\"name\":\"quoted \\\"zone\\\"\",\"ph\":\"X\",\"ts\":1.000,\"pid\":1,\"tid\":"));
+    EXPECT_NE(std::string::npos, json.find(",\"dur\":2.500}"));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"C\""));
+    EXPECT_NE(std::string::npos, json.find(",\"args\":{\"glyphs\":42.000}}"));
+}
@@ -0,0 +1,47 @@
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/layout/UniformGrid.h>
+
+TEST(UniformGrid_test, VisitsEntriesOfOverlappedCells)
+{
+    gloperate_text::layout::UniformGrid<int> grid(10.f);
+    EXPECT_TRUE(grid.empty());
+    EXPECT_EQ(glm::ivec2(-1, 0), grid.cell(glm::vec2(-0.5f, 9.5f)));
+
+    // spans 3x1 cells
+    grid.insert(glm::vec2(5.f, 1.f), glm::vec2(25.f, 2.f), 1);
+    grid.insert(glm::vec2(-5.f, -5.f), glm::vec2(-1.f, -1.f), 2);
+
+    std::vector<int> visited;
+    grid.forEach(glm::vec2(12.f, 0.f), glm::vec2(28.f, 8.f), [&](const glm::ivec2 &, int entry) { visited.push_back(entry); });
+    EXPECT_EQ(std::vector<int>({ 1, 1 }), visited);
+
+    visited.clear();
+    grid.forEach(glm::ivec2(-1, -1), [&](int entry) { visited.push_back(entry); });
+    EXPECT_EQ(std::vector<int>({ 2 }), visited);
+}
+
+TEST(UniformGrid_test, ErasesMatchingEntries)
+{
+    gloperate_text::layout::UniformGrid<int> grid(10.f);
+    grid.insert(glm::vec2(0.f), glm::vec2(15.f), 1);
+    grid.insert(glm::vec2(0.f), glm::vec2(5.f), 2);
+
+    grid.erase(glm::vec2(0.f), glm::vec2(15.f), [](int entry) { return entry == 1; });
+    auto count = 0;
+    grid.forEach(glm::vec2(0.f), glm::vec2(15.f), [&](const glm::ivec2 &, int entry) { EXPECT_EQ(2, entry); ++count; });
+    EXPECT_EQ(1, count);
+
+    grid.erase(glm::vec2(0.f), glm::vec2(5.f), [](int) { return true; });
+    EXPECT_TRUE(grid.empty());
+
+    grid.insert(glm::ivec2(0), 3);
+    grid.reset(20.f);
+    EXPECT_TRUE(grid.empty());
+    EXPECT_FLOAT_EQ(20.f, grid.cellSize());
+}
@@ -0,0 +1,70 @@
+#include <gmock/gmock.h>
+
+#include <random>
+
+#include <openll/layout/LabelArea.h>
+#include <openll/layout/layoutbase.h>
+#include <openll/layout/VisibilityHierarchy.h>
+
+#include "LayoutTestFixture.h"
+
+class VisibilityHierarchy_test: public testing::Test, public LayoutTestFixture
+{
+};
+
+TEST_F(VisibilityHierarchy_test, NoOverlapsAtAnyZoom)
+{
+    std::default_random_engine generator;
+    std::uniform_real_distribution<float> location(0.f, 100.f);
+    std::uniform_int_distribution<unsigned int> priority(1, 10);
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 300; ++i)
+        labels.push_back(label({location(generator), location(generator)}, priority(generator)));
+
+    const gloperate_text::layout::VisibilityHierarchy hierarchy(labels, 0.5f, 8, glm::vec2(0.1f));
+    EXPECT_GT(hierarchy.visibleCount(0.f), 0u);
+    EXPECT_EQ(hierarchy.visibleCount(7.f), hierarchy.visibleCount(100.f));
+
+    size_t previousCount = 0;
+    for (float zoom = 0.f; zoom < 8.f; zoom += 0.125f)
+    {
+        // zooming in only adds labels
+        const auto visible = hierarchy.visibleLabels(zoom);
+        EXPECT_GE(visible.size(), previousCount);
+        previousCount = visible.size();
+
+        hierarchy.apply(labels, zoom);
+        const auto scale = hierarchy.scale(zoom);
+        std::vector<gloperate_text::LabelArea> areas;
+        for (const auto i : visible)
+        {
+            EXPECT_TRUE(labels[i].placement.display);
+            areas.push_back({labels[i].pointLocation * scale + labels[i].placement.offset, labels[i].sequence.extent()});
+        }
+        for (size_t a = 0; a < areas.size(); ++a)
+            for (size_t b = a + 1; b < areas.size(); ++b)
+                EXPECT_FALSE(areas[a].paddedOverlaps(areas[b], glm::vec2(0.1f))) << "zoom " << zoom;
+    }
+}
+
+TEST_F(VisibilityHierarchy_test, HigherPrioritiesFirst)
+{
+    // five labels at the same point: four fit around it at every zoom, the least important never
+    std::vector<gloperate_text::Label> labels;
+    for (unsigned int priority = 1; priority <= 5; ++priority)
+        labels.push_back(label({10.f, 10.f}, priority));
+    // a label that separates from the most important one when zooming in
+    labels.push_back(label({10.5f, 10.f}, 1));
+
+    const gloperate_text::layout::VisibilityHierarchy hierarchy(labels, 1.f, 8);
+    EXPECT_EQ(gloperate_text::RelativeLabelPosition::UpperRight, hierarchy.position(4));
+    for (size_t i = 1; i < 5; ++i)
+        EXPECT_EQ(0u, hierarchy.minLevel(i));
+    EXPECT_EQ(8u, hierarchy.minLevel(0));
+
+    // at scale 2^z, 0.5 world units are 20 screen units from level 6 on
+    EXPECT_EQ(6u, hierarchy.minLevel(5));
+    EXPECT_EQ(4u, hierarchy.visibleCount(5.9f));
+    EXPECT_EQ(5u, hierarchy.visibleCount(6.f));
+    EXPECT_EQ(5u, hierarchy.order()[4]);
+}
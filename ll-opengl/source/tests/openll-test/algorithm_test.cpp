@@ -0,0 +1,210 @@
+
+#include <gmock/gmock.h>
+
+
+#include <openll/layout/algorithm.h>
+#include <openll/layout/AnnealingSolver.h>
+#include <openll/layout/penalties.h>
+#include <openll/layout/layoutbase.h>
+#include <openll/layout/OccupancyGrid.h>
+
+#include "LayoutTestFixture.h"
+
+class algorithm_test: public testing::Test, public LayoutTestFixture
+{
+public:
+    static std::vector<gloperate_text::LabelPlacement> placements(const std::vector<gloperate_text::Label> & labels)
+    {
+        std::vector<gloperate_text::LabelPlacement> result;
+        for (const auto & label : labels)
+            result.push_back(label.placement);
+        return result;
+    }
+};
+
+TEST_F(algorithm_test, CoherentAnnealingKeepsStablePlacements)
+{
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 16; ++i)
+        labels.push_back(label({i * 100.f, (i % 4) * 100.f}));
+
+    gloperate_text::layout::simulatedAnnealing(labels, gloperate_text::layout::standard, false, glm::vec2(0.f));
+    const auto previous = placements(labels);
+
+    // pan the view: all labels move equally, nothing changes relative to each other
+    for (auto & label : labels)
+        label.pointLocation += glm::vec2(3.f, -7.f);
+
+    gloperate_text::layout::coherentAnnealing(labels, previous, gloperate_text::layout::standard, false, glm::vec2(0.f));
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        EXPECT_EQ(previous[i].display, labels[i].placement.display);
+        EXPECT_FLOAT_EQ(previous[i].offset.x, labels[i].placement.offset.x);
+        EXPECT_FLOAT_EQ(previous[i].offset.y, labels[i].placement.offset.y);
+    }
+}
+
+TEST_F(algorithm_test, CoherentAnnealingResolvesNewCollisions)
+{
+    std::vector<gloperate_text::Label> labels { label({0.f, 0.f}), label({500.f, 0.f}) };
+    labels[0].placement.offset = {0.f, 0.f};  // upper right
+    labels[1].placement.offset = {-20.f, 0.f};  // upper left
+    const auto previous = placements(labels);
+
+    // a new label at the same point is added, which collides with the first one
+    labels.push_back(label({0.f, 0.f}));
+
+    gloperate_text::layout::coherentAnnealing(labels, previous, gloperate_text::layout::overlapArea, false, glm::vec2(0.f));
+
+    EXPECT_FLOAT_EQ(-20.f, labels[1].placement.offset.x);
+    EXPECT_FLOAT_EQ(0.f, labels[1].placement.offset.y);
+
+    const auto a = labels[0].placement.offset;
+    const auto b = labels[2].placement.offset;
+    EXPECT_TRUE(a.x != b.x || a.y != b.y);
+}
+
+TEST_F(algorithm_test, CoherentAnnealingShowsHiddenLabelsAgain)
+{
+    std::vector<gloperate_text::Label> labels { label({0.f, 0.f}), label({500.f, 0.f}) };
+    labels[0].placement.offset = {0.f, 0.f};
+    // hidden in the last frame, e.g., by a label that was removed since
+    labels[1].placement.display = false;
+    const auto previous = placements(labels);
+
+    // pan the view
+    for (auto & label : labels)
+        label.pointLocation += glm::vec2(3.f, -7.f);
+
+    gloperate_text::layout::coherentAnnealing(labels, previous, gloperate_text::layout::standard, true, glm::vec2(0.f));
+
+    EXPECT_TRUE(labels[0].placement.display);
+    EXPECT_FLOAT_EQ(0.f, labels[0].placement.offset.x);
+    EXPECT_TRUE(labels[1].placement.display);
+}
+
+TEST_F(algorithm_test, AnnealingRespectsIterationBudget)
+{
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 64; ++i)
+        labels.push_back(label({(i % 8) * 15.f, (i / 8) * 8.f}));
+
+    gloperate_text::layout::AnnealingSolver solver(labels, gloperate_text::layout::standard, true, glm::vec2(0.f));
+    const auto initialPenalty = solver.penalty();
+
+    EXPECT_FALSE(solver.run(gloperate_text::layout::LayoutBudget(gloperate_text::layout::LayoutBudget::Clock::duration::max(), 100)));
+    EXPECT_EQ(100u, solver.steps());
+    EXPECT_LE(solver.penalty(), initialPenalty);
+
+    // resume across several "frames" until converged
+    auto frames = 0;
+    while (!solver.run(gloperate_text::layout::LayoutBudget(std::chrono::milliseconds(4))))
+        ++frames;
+    EXPECT_TRUE(solver.converged());
+    EXPECT_LE(solver.penalty(), initialPenalty);
+
+    solver.apply(labels);
+    EXPECT_GT(std::count_if(labels.begin(), labels.end(), [](const gloperate_text::Label & label) { return label.placement.display; }), 0);
+}
+
+TEST_F(algorithm_test, AnnealingDeadlineIncludesSetup)
+{
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 64; ++i)
+        labels.push_back(label({(i % 8) * 15.f, (i / 8) * 8.f}));
+
+    // the deadline expires while the solver is built
+    gloperate_text::layout::LayoutDeadline deadline(gloperate_text::layout::LayoutBudget(std::chrono::nanoseconds(1)));
+    gloperate_text::layout::AnnealingSolver solver(labels, gloperate_text::layout::standard, true, glm::vec2(0.f));
+
+    EXPECT_FALSE(solver.run(deadline));
+    EXPECT_EQ(0u, solver.steps());
+}
+
+TEST_F(algorithm_test, GradientDescentRespectsBudget)
+{
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 64; ++i)
+        labels.push_back(label({(i % 8) * 15.f, (i / 8) * 8.f}));
+
+    auto unbounded = labels;
+    gloperate_text::layout::discreteGradientDescent(unbounded, gloperate_text::layout::overlapArea);
+
+    // no iteration allowed: the random start placement is kept
+    gloperate_text::layout::discreteGradientDescent(labels, gloperate_text::layout::overlapArea,
+        gloperate_text::layout::LayoutBudget(gloperate_text::layout::LayoutBudget::Clock::duration::max(), 0));
+
+    auto differences = 0;
+    for (size_t i = 0; i < labels.size(); ++i)
+        differences += labels[i].placement.offset != unbounded[i].placement.offset ? 1 : 0;
+    EXPECT_GT(differences, 0);
+}
+
+TEST_F(algorithm_test, PenaltyFunctorsMatchFunctions)
+{
+    for (const auto position : { gloperate_text::RelativeLabelPosition::UpperRight, gloperate_text::RelativeLabelPosition::UpperLeft,
+        gloperate_text::RelativeLabelPosition::LowerLeft, gloperate_text::RelativeLabelPosition::LowerRight, gloperate_text::RelativeLabelPosition::Hidden })
+    {
+        EXPECT_FLOAT_EQ(gloperate_text::layout::standard(2, 0.3f, position, 4), gloperate_text::layout::StandardPenalty()(2, 0.3f, position, 4));
+        EXPECT_FLOAT_EQ(gloperate_text::layout::overlapArea(2, 0.3f, position, 4), gloperate_text::layout::OverlapAreaPenalty()(2, 0.3f, position, 4));
+        EXPECT_FLOAT_EQ(gloperate_text::layout::overlapCount(2, 0.3f, position, 4), gloperate_text::layout::OverlapCountPenalty()(2, 0.3f, position, 4));
+    }
+}
+
+TEST_F(algorithm_test, SpecializedAnnealingResolvesCollisions)
+{
+    // pairs of labels at the same point, each pair can be resolved
+    std::vector<gloperate_text::Label> labels;
+    for (int i = 0; i < 16; ++i)
+    {
+        labels.push_back(label({i * 100.f, 0.f}));
+        labels.push_back(label({i * 100.f, 0.f}));
+    }
+
+    gloperate_text::layout::BasicAnnealingSolver<gloperate_text::layout::OverlapAreaPenalty> solver(labels, {}, false, glm::vec2(0.f));
+    EXPECT_TRUE(solver.run());
+    EXPECT_FLOAT_EQ(0.f, solver.penalty());
+
+    solver.apply(labels);
+    for (size_t i = 0; i < labels.size(); i += 2)
+        EXPECT_TRUE(labels[i].placement.offset != labels[i + 1].placement.offset);
+}
+
+TEST_F(algorithm_test, PriorityPlacementPrefersHighPriorities)
+{
+    std::vector<gloperate_text::Label> labels;
+    for (unsigned int priority = 1; priority <= 5; ++priority)
+    {
+        labels.push_back(label({50.f, 50.f}));
+        labels.back().priority = priority;
+    }
+
+    gloperate_text::layout::OccupancyGrid grid({0.f, 0.f}, {100.f, 100.f}, {100, 100});
+    gloperate_text::layout::priorityPlacement(labels, gloperate_text::layout::standard, grid);
+
+    // the four corners go to the labels of highest priority, the upper right one to the most important
+    EXPECT_FALSE(labels[0].placement.display);
+    for (size_t i = 1; i < labels.size(); ++i)
+        EXPECT_TRUE(labels[i].placement.display);
+    EXPECT_FLOAT_EQ(0.f, labels[4].placement.offset.x);
+    EXPECT_FLOAT_EQ(0.f, labels[4].placement.offset.y);
+
+    // greedy using the grid avoids overlaps as well
+    std::vector<gloperate_text::Label> pair { label({50.f, 50.f}), label({50.f, 50.f}) };
+    grid.clear();
+    gloperate_text::layout::greedy(pair, gloperate_text::layout::overlapArea, &grid);
+    EXPECT_TRUE(pair[0].placement.offset != pair[1].placement.offset);
+}
+
+TEST_F(algorithm_test, PriorityPlacementHidesLabelsOutsideTheGrid)
+{
+    // the second label reaches into the grid with its lower left candidate only, the third one not at all
+    std::vector<gloperate_text::Label> labels { label({50.f, 50.f}), label({110.f, 105.f}), label({130.f, 50.f}) };
+
+    gloperate_text::layout::OccupancyGrid grid({0.f, 0.f}, {100.f, 100.f}, {100, 100});
+    gloperate_text::layout::priorityPlacement(labels, gloperate_text::layout::standard, grid);
+
+    EXPECT_TRUE(labels[0].placement.display);
+    EXPECT_TRUE(labels[1].placement.display);
+    EXPECT_FALSE(labels[2].placement.display);
+}
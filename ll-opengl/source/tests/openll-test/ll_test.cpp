@@ -0,0 +1,149 @@
+#include <gmock/gmock.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFace.h>
+#include <openll/FontFaceGenerator.h>
+#include <openll/FontWriter.h>
+#include <openll/TrueTypeFont.h>
+#include <openll/ll.h>
+
+#include "TemporaryDirectory.h"
+#include "TestFont.h"
+
+TEST(ll_test, CreatesAndDestroysFontFaces)
+{
+    EXPECT_GE(llGetMaxFontFaceObjects(), 1u);
+    EXPECT_LT(llGetMaxFontFaceObjects(), 1u << 16);
+
+    llFontFace fontFace = 0;
+    ASSERT_EQ(LL_SUCCESS, llCreateFontFace(&fontFace));
+    EXPECT_GT(fontFace, 0u);
+
+    llPointSize size;
+    EXPECT_EQ(LL_SUCCESS, llGetFontFaceSize(fontFace, &size));
+    EXPECT_EQ(LL_ERROR_INVALID_VALUE, llGetFontFaceSize(fontFace, nullptr));
+
+    EXPECT_EQ(LL_SUCCESS, llDestroyFontFace(fontFace));
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llDestroyFontFace(fontFace));
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llGetFontFaceSize(fontFace, &size));
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llDestroyFontFace(0));
+
+    // a new font face does not revive the old handle
+    llFontFace other = 0;
+    ASSERT_EQ(LL_SUCCESS, llCreateFontFace(&other));
+    EXPECT_NE(fontFace, other);
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llGetFontFaceSize(fontFace, &size));
+    EXPECT_EQ(LL_SUCCESS, llDestroyFontFace(other));
+
+    EXPECT_EQ(LL_ERROR_INVALID_VALUE, llCreateFontFace(nullptr));
+}
+
+TEST(ll_test, ReportsMissingFontFiles)
+{
+    llFontFace fontFace = 0;
+    ASSERT_EQ(LL_SUCCESS, llCreateFontFace(&fontFace));
+    EXPECT_EQ(LL_ERROR_LOADING_FAILED, llLoadFontFace(fontFace, "does-not-exist.fnt", LL_FALSE));
+    EXPECT_EQ(LL_ERROR_INVALID_VALUE, llLoadFontFace(fontFace, nullptr, LL_FALSE));
+    EXPECT_EQ(LL_SUCCESS, llDestroyFontFace(fontFace));
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llLoadFontFace(fontFace, "does-not-exist.fnt", LL_FALSE));
+}
+
+TEST(ll_test, ResolvesFontFacesOfSequencesOnUse)
+{
+    llFontFace fontFace = 0;
+    llGlyphSequence sequence = 0;
+    llGlyphVertexCloud vertexCloud = 0;
+    ASSERT_EQ(LL_SUCCESS, llCreateFontFace(&fontFace));
+    ASSERT_EQ(LL_SUCCESS, llCreateGlyphSequence(&sequence));
+    ASSERT_EQ(LL_SUCCESS, llCreateGlyphVertexCloud(&vertexCloud));
+
+    float extent[2];
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llGetGlyphSequenceExtent(sequence, extent));
+
+    const llUTF32 string[] = { U'a', U'b' };
+    const float color[] = { 1.f, 0.f, 0.f, 1.f };
+    const float transform[] = { 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f };
+    EXPECT_EQ(LL_SUCCESS, llSetGlyphSequenceFontFace(sequence, fontFace));
+    EXPECT_EQ(LL_SUCCESS, llSetGlyphSequenceString(sequence, string, 2));
+    EXPECT_EQ(LL_SUCCESS, llSetGlyphSequenceFontSize(sequence, 16.f));
+    EXPECT_EQ(LL_SUCCESS, llSetGlyphSequenceFontColor(sequence, color));
+    EXPECT_EQ(LL_SUCCESS, llSetGlyphSequenceTransform(sequence, transform));
+    EXPECT_EQ(LL_SUCCESS, llGetGlyphSequenceExtent(sequence, extent));
+
+    // the unconfigured font face has no glyphs to depict
+    llSize size = 1;
+    EXPECT_EQ(LL_SUCCESS, llUpdateGlyphVertexCloud(vertexCloud, &sequence, 1, LL_FALSE, LL_FALSE));
+    EXPECT_EQ(LL_SUCCESS, llGetGlyphVertexCloudSize(vertexCloud, &size));
+    EXPECT_EQ(0u, size);
+
+    // destroying the font face invalidates the sequence until another font face is set
+    EXPECT_EQ(LL_SUCCESS, llDestroyFontFace(fontFace));
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llGetGlyphSequenceExtent(sequence, extent));
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llUpdateGlyphVertexCloud(vertexCloud, &sequence, 1, LL_FALSE, LL_FALSE));
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llSetGlyphSequenceFontFace(sequence, fontFace));
+
+    EXPECT_EQ(LL_SUCCESS, llDestroyGlyphSequence(sequence));
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llSetGlyphSequenceFontSize(sequence, 16.f));
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llUpdateGlyphVertexCloud(vertexCloud, &sequence, 1, LL_FALSE, LL_FALSE));
+    EXPECT_EQ(LL_SUCCESS, llUpdateGlyphVertexCloud(vertexCloud, nullptr, 0, LL_FALSE, LL_FALSE));
+
+    EXPECT_EQ(LL_SUCCESS, llDestroyGlyphVertexCloud(vertexCloud));
+    EXPECT_EQ(LL_OBJECT_DOES_NOT_EXISTS, llGetGlyphVertexCloudSize(vertexCloud, &size));
+}
+
+TEST(ll_test, UpdatesVertexCloudsFromTheSameSequences)
+{
+    // a face with the glyphs ' ', 'A', 'B' and 'O' of the test font
+    TemporaryDirectory directory;
+    ASSERT_FALSE(directory.path().empty());
+    const auto font = gloperate_text::TrueTypeFont(testfont::testFont());
+    const auto generated = globjects::ref_ptr<gloperate_text::FontFace>(gloperate_text::FontFaceGenerator(50.f, 4, 2).generate(font, font.codepoints()));
+    ASSERT_NE(nullptr, generated.get());
+    const auto filename = directory.file("ll-test.fnt");
+    ASSERT_TRUE(gloperate_text::FontWriter().save(*generated, filename));
+
+    llFontFace fontFace = 0;
+    ASSERT_EQ(LL_SUCCESS, llCreateFontFace(&fontFace));
+    ASSERT_EQ(LL_SUCCESS, llLoadFontFace(fontFace, filename.c_str(), LL_FALSE));
+
+    llGlyphSequence sequences[2] = { 0, 0 };
+    const llUTF32 strings[2][3] = { { U'A', U'B', U'O' }, { U'O', U' ', U'A' } };
+    for (auto i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(LL_SUCCESS, llCreateGlyphSequence(&sequences[i]));
+        EXPECT_EQ(LL_SUCCESS, llSetGlyphSequenceFontFace(sequences[i], fontFace));
+        EXPECT_EQ(LL_SUCCESS, llSetGlyphSequenceString(sequences[i], strings[i], 3));
+    }
+
+    llGlyphVertexCloud vertexCloud = 0;
+    ASSERT_EQ(LL_SUCCESS, llCreateGlyphVertexCloud(&vertexCloud));
+
+    // the space is not depictable
+    llSize size = 0;
+    EXPECT_EQ(LL_SUCCESS, llUpdateGlyphVertexCloud(vertexCloud, sequences, 2, LL_TRUE, LL_FALSE));
+    EXPECT_EQ(LL_SUCCESS, llGetGlyphVertexCloudSize(vertexCloud, &size));
+    EXPECT_EQ(5u, size);
+
+    // the same handles again, with a changed sequence
+    EXPECT_EQ(LL_SUCCESS, llSetGlyphSequenceString(sequences[1], strings[1], 1));
+    EXPECT_EQ(LL_SUCCESS, llUpdateGlyphVertexCloud(vertexCloud, sequences, 2, LL_TRUE, LL_FALSE));
+    EXPECT_EQ(LL_SUCCESS, llGetGlyphVertexCloudSize(vertexCloud, &size));
+    EXPECT_EQ(4u, size);
+    EXPECT_EQ(LL_SUCCESS, llUpdateGlyphVertexCloud(vertexCloud, sequences, 2, LL_FALSE, LL_FALSE));
+    EXPECT_EQ(LL_SUCCESS, llGetGlyphVertexCloudSize(vertexCloud, &size));
+    EXPECT_EQ(4u, size);
+
+    EXPECT_EQ(LL_SUCCESS, llDestroyGlyphVertexCloud(vertexCloud));
+    for (const auto sequence : sequences)
+        EXPECT_EQ(LL_SUCCESS, llDestroyGlyphSequence(sequence));
+    EXPECT_EQ(LL_SUCCESS, llDestroyFontFace(fontFace));
+
+    const auto & extent = generated->glyphTextureExtent();
+    std::remove(filename.c_str());
+    std::remove(directory.file("ll-test." + std::to_string(extent.x) + "." + std::to_string(extent.y) + ".r.ub.raw").c_str());
+}
@@ -0,0 +1,213 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <openll/FontFace.h>
+#include <openll/FontFaceGenerator.h>
+#include <openll/FontWriter.h>
+#include <openll/TaskPool.h>
+#include <openll/Trace.h>
+#include <openll/TrueTypeFont.h>
+
+// Generates a distance field font face (.fnt and .raw, see FontLoader) from a TrueType font,
+// replacing the browser based fontface-generator in build pipelines.
+
+namespace
+{
+
+const char * usage =
+    "usage: openll-fontgen --font <file> --output <file> [options]\n"
+    "  --font <file>            TrueType font (.ttf, first font of a .ttc)\n"
+    "  --output <file>          .fnt file to write, the glyph image is written next to it\n"
+    "  --size <pixels>          ascent - descent of the font face (default 72)\n"
+    "  --padding <pixels>       distance field spread around each glyph (default 8)\n"
+    "  --oversampling <n>       samples per pixel and axis for the distance transform (default 4)\n"
+    "  --page-size <pixels>     maximum width and height of an atlas page, more pages if exceeded (default 16384)\n"
+    "  --charset <name>         ascii, latin1 or all code points of the font (default latin1)\n"
+    "  --codepoints <ranges>    code points or ranges, e.g., 32-126,0x4E00-0x9FFF (instead of --charset)\n"
+    "  --threads <n>            rasterization threads (default one per core)\n"
+    "  --trace <file>           write a Chrome trace (requires OPTION_ENABLE_TRACING)\n";
+
+std::vector<std::string> split(const std::string & string)
+{
+    std::vector<std::string> result;
+    std::istringstream stream(string);
+    std::string part;
+    while (std::getline(stream, part, ','))
+    {
+        if (!part.empty())
+            result.push_back(part);
+    }
+    return result;
+}
+
+bool parseRanges(const std::string & value, std::vector<gloperate_text::GlyphIndex> & codepoints)
+{
+    for (const auto & range : split(value))
+    {
+        const auto dash = range.find('-', 1);
+        const auto first = std::stoul(range.substr(0, dash), nullptr, 0);
+        const auto last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1), nullptr, 0);
+        if (last < first || last > 0x10FFFF)
+            return false;
+
+        for (auto codepoint = first; codepoint <= last; ++codepoint)
+            codepoints.push_back(static_cast<gloperate_text::GlyphIndex>(codepoint));
+    }
+    return !codepoints.empty();
+}
+
+double secondsSince(const std::chrono::steady_clock::time_point & start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main(int argc, char * argv[])
+{
+    std::string fontFile;
+    std::string outputFile;
+    auto size = 72.f;
+    auto padding = 8;
+    auto oversampling = 4;
+    auto pageSize = 16384;
+    std::string charset = "latin1";
+    std::vector<gloperate_text::GlyphIndex> codepoints;
+    unsigned int threads = 0;
+    std::string traceFile;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--help" || i + 1 == argc)
+        {
+            std::cerr << usage;
+            return argument == "--help" ? 0 : 1;
+        }
+
+        const std::string value = argv[++i];
+        auto valid = true;
+        if (argument == "--font")
+        {
+            fontFile = value;
+        }
+        else if (argument == "--output")
+        {
+            outputFile = value;
+        }
+        else if (argument == "--size")
+        {
+            size = std::stof(value);
+            valid = size > 0.f;
+        }
+        else if (argument == "--padding")
+        {
+            padding = std::stoi(value);
+            valid = padding > 0;
+        }
+        else if (argument == "--oversampling")
+        {
+            oversampling = std::stoi(value);
+            valid = oversampling > 0 && oversampling <= 16;
+        }
+        else if (argument == "--page-size")
+        {
+            pageSize = std::stoi(value);
+            valid = pageSize > 0 && pageSize <= 16384;
+        }
+        else if (argument == "--charset")
+        {
+            charset = value;
+            valid = value == "ascii" || value == "latin1" || value == "all";
+        }
+        else if (argument == "--codepoints")
+        {
+            codepoints.clear();
+            valid = parseRanges(value, codepoints);
+        }
+        else if (argument == "--threads")
+        {
+            threads = static_cast<unsigned int>(std::stoul(value));
+        }
+        else if (argument == "--trace")
+        {
+            traceFile = value;
+        }
+        else
+        {
+            valid = false;
+        }
+        if (!valid)
+        {
+            std::cerr << "invalid argument: " << argument << " " << value << std::endl << usage;
+            return 1;
+        }
+    }
+
+    if (fontFile.empty() || outputFile.empty())
+    {
+        std::cerr << usage;
+        return 1;
+    }
+
+    if (!traceFile.empty())
+        gloperate_text::Trace::start();
+
+    auto start = std::chrono::steady_clock::now();
+    const gloperate_text::TrueTypeFont font(fontFile);
+    if (!font.isValid())
+        return 1;
+    const auto loadTime = secondsSince(start);
+
+    if (codepoints.empty())
+    {
+        if (charset == "all")
+        {
+            codepoints = font.codepoints();
+        }
+        else
+        {
+            // printable characters
+            parseRanges(charset == "ascii" ? "32-126" : "32-126,160-255", codepoints);
+        }
+    }
+
+    start = std::chrono::steady_clock::now();
+    gloperate_text::TaskPool pool(threads);
+    const auto generator = gloperate_text::FontFaceGenerator(size, padding, oversampling, pageSize);
+    const auto fontFace = globjects::ref_ptr<gloperate_text::FontFace>(generator.generate(font, codepoints, &pool));
+    if (!fontFace)
+    {
+        std::cerr << "a glyph does not fit into an atlas page, reduce --size or increase --page-size" << std::endl;
+        return 1;
+    }
+    const auto generateTime = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    if (!gloperate_text::FontWriter().save(*fontFace, outputFile, font.familyName()))
+    {
+        std::cerr << "cannot write " << outputFile << std::endl;
+        return 1;
+    }
+    const auto writeTime = secondsSince(start);
+
+    const auto & extent = fontFace->glyphTextureExtent();
+    std::cout << fontFace->glyphs().size() << " glyphs, " << extent.x << " x " << extent.y << " atlas, "
+        << fontFace->glyphTexturePages() << (fontFace->glyphTexturePages() > 1 ? " pages, " : " page, ")
+        << pool.threads() << " threads" << std::endl
+        << "load " << loadTime << " s, generate " << generateTime << " s, write " << writeTime << " s" << std::endl;
+
+    if (!traceFile.empty() && !gloperate_text::Trace::write(traceFile))
+    {
+        std::cerr << "cannot write " << traceFile << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
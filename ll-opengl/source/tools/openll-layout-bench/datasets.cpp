@@ -0,0 +1,216 @@
+#include "datasets.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include <glm/common.hpp>
+
+#include <openll/FontFace.h>
+#include <openll/Glyph.h>
+#include <openll/GlyphSequence.h>
+#include <openll/layout/CounterRandom.h>
+
+namespace
+{
+
+const float pi = 3.14159265358979f;
+
+// standard normal distribution (Box-Muller)
+float gaussian(gloperate_text::layout::CounterRandom & random)
+{
+    const auto u = 1.f - random.uniformFloat();
+    const auto v = random.uniformFloat();
+    return std::sqrt(-2.f * std::log(u)) * std::cos(2.f * pi * v);
+}
+
+std::vector<glm::vec2> uniformPoints(gloperate_text::layout::CounterRandom & random, size_t numLabels, float size)
+{
+    std::vector<glm::vec2> points;
+    points.reserve(numLabels);
+    for (size_t i = 0; i < numLabels; ++i)
+    {
+        const auto x = random.uniformFloat() * size;
+        points.push_back({x, random.uniformFloat() * size});
+    }
+    return points;
+}
+
+std::vector<glm::vec2> clusteredPoints(gloperate_text::layout::CounterRandom & random, size_t numLabels, float size)
+{
+    const auto numClusters = std::max(static_cast<size_t>(1), static_cast<size_t>(std::sqrt(static_cast<float>(numLabels)) / 2.f));
+    const auto sigma = size / (4.f * std::sqrt(static_cast<float>(numClusters)));
+    const auto centers = uniformPoints(random, numClusters, size);
+
+    std::vector<glm::vec2> points;
+    points.reserve(numLabels);
+    for (size_t i = 0; i < numLabels; ++i)
+    {
+        const auto & center = centers[random.uniform(static_cast<std::uint32_t>(numClusters))];
+        const auto x = center.x + sigma * gaussian(random);
+        points.push_back({x, center.y + sigma * gaussian(random)});
+    }
+    return points;
+}
+
+std::vector<glm::vec2> roadPoints(gloperate_text::layout::CounterRandom & random, size_t numLabels, float size)
+{
+    // points every 10 units along the roads, with a little jitter
+    const auto spacing = 10.f;
+    const auto numRoads = std::max(static_cast<size_t>(1), static_cast<size_t>(std::sqrt(static_cast<float>(numLabels)) / 4.f));
+
+    std::vector<glm::vec2> points;
+    points.reserve(numLabels);
+    for (size_t road = 0; road < numRoads; ++road)
+    {
+        const auto count = numLabels / numRoads + (road < numLabels % numRoads ? 1 : 0);
+        auto position = glm::vec2(random.uniformFloat() * size, random.uniformFloat() * size);
+        auto heading = random.uniformFloat() * 2.f * pi;
+        for (size_t i = 0; i < count; ++i)
+        {
+            heading += 0.1f * gaussian(random);
+            position += spacing * glm::vec2(std::cos(heading), std::sin(heading));
+            // roads turn around at the border
+            if (position.x < 0.f || position.x > size || position.y < 0.f || position.y > size)
+            {
+                position = glm::clamp(position, glm::vec2(0.f), glm::vec2(size));
+                heading += pi;
+            }
+            const auto x = position.x + gaussian(random);
+            points.push_back({x, position.y + gaussian(random)});
+        }
+    }
+    return points;
+}
+
+// lengths 3 to 30, the probability of length 2 + k is proportional to 1 / k^1.1
+std::vector<float> zipfDistribution()
+{
+    std::vector<float> cumulative;
+    auto sum = 0.f;
+    for (int k = 1; k <= 28; ++k)
+    {
+        sum += 1.f / std::pow(static_cast<float>(k), 1.1f);
+        cumulative.push_back(sum);
+    }
+    for (auto & value : cumulative)
+        value /= sum;
+    return cumulative;
+}
+
+int labelLength(gloperate_text::layout::CounterRandom & random, LengthDistribution lengths)
+{
+    if (lengths == LengthDistribution::Uniform)
+        return 3 + static_cast<int>(random.uniform(10));
+
+    static const auto cumulative = zipfDistribution();
+    const auto k = std::upper_bound(cumulative.begin(), cumulative.end(), random.uniformFloat()) - cumulative.begin();
+    return 3 + static_cast<int>(std::min(k, static_cast<std::ptrdiff_t>(cumulative.size() - 1)));
+}
+
+}
+
+void prepareFont(gloperate_text::FontFace & fontFace)
+{
+    fontFace.setBase(8.f);
+    fontFace.setAscent(8.f);
+    fontFace.setDescent(-2.f);
+    fontFace.setLineHeight(10.f);
+
+    for (char32_t character = 'a'; character <= 'z'; ++character)
+    {
+        gloperate_text::Glyph glyph;
+        glyph.setIndex(character);
+        glyph.setAdvance(6.f);
+        glyph.setExtent(glm::vec2(6.f, 10.f));
+        glyph.setSubTextureExtent(glm::vec2(0.01f));
+        fontFace.addGlyph(glyph);
+    }
+}
+
+Dataset generateDataset(gloperate_text::FontFace * fontFace, PointDistribution points, LengthDistribution lengths, size_t numLabels, std::uint64_t seed)
+{
+    // separate streams, so that, e.g., the points do not depend on the label lengths
+    gloperate_text::layout::CounterRandom pointRandom(seed);
+    gloperate_text::layout::CounterRandom textRandom(seed ^ 0x5bd1e9955bd1e995ull);
+    gloperate_text::layout::CounterRandom priorityRandom(seed ^ 0xc2b2ae3d27d4eb4full);
+
+    const auto size = 40.f * std::sqrt(static_cast<float>(numLabels));
+    std::vector<glm::vec2> locations;
+    switch (points)
+    {
+    case PointDistribution::Uniform:  locations = uniformPoints(pointRandom, numLabels, size); break;
+    case PointDistribution::Clusters: locations = clusteredPoints(pointRandom, numLabels, size); break;
+    case PointDistribution::Roads:    locations = roadPoints(pointRandom, numLabels, size); break;
+    default: assert(false);
+    }
+
+    Dataset dataset;
+    dataset.name = name(points) + "/" + name(lengths);
+    dataset.lowerLeft = glm::vec2(std::numeric_limits<float>::max());
+    dataset.upperRight = glm::vec2(std::numeric_limits<float>::lowest());
+    dataset.labels.reserve(numLabels);
+    for (const auto & location : locations)
+    {
+        std::u32string string;
+        const auto length = labelLength(textRandom, lengths);
+        for (int c = 0; c < length; ++c)
+            string.push_back(static_cast<char32_t>('a' + textRandom.uniform(26)));
+
+        gloperate_text::GlyphSequence sequence;
+        sequence.setString(string);
+        sequence.setFontFace(fontFace);
+        sequence.setFontSize(10.f);
+
+        const auto priority = 1 + priorityRandom.uniform(10);
+        const auto placement = gloperate_text::LabelPlacement{ glm::vec2(0.f), gloperate_text::Alignment::LeftAligned, gloperate_text::LineAnchor::Bottom, true };
+        dataset.labels.push_back({sequence, location, priority, placement});
+        dataset.lowerLeft = glm::min(dataset.lowerLeft, location);
+        dataset.upperRight = glm::max(dataset.upperRight, location);
+    }
+    return dataset;
+}
+
+std::string name(PointDistribution points)
+{
+    switch (points)
+    {
+    case PointDistribution::Uniform:  return "uniform";
+    case PointDistribution::Clusters: return "clusters";
+    case PointDistribution::Roads:    return "roads";
+    default: assert(false);
+    }
+    return "";
+}
+
+std::string name(LengthDistribution lengths)
+{
+    return lengths == LengthDistribution::Uniform ? "uniform" : "zipf";
+}
+
+bool parse(const std::string & string, PointDistribution & points)
+{
+    for (const auto candidate : { PointDistribution::Uniform, PointDistribution::Clusters, PointDistribution::Roads })
+    {
+        if (string == name(candidate))
+        {
+            points = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse(const std::string & string, LengthDistribution & lengths)
+{
+    for (const auto candidate : { LengthDistribution::Uniform, LengthDistribution::Zipf })
+    {
+        if (string == name(candidate))
+        {
+            lengths = candidate;
+            return true;
+        }
+    }
+    return false;
+}
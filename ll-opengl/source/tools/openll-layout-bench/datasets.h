@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <openll/layout/layoutbase.h>
+
+namespace gloperate_text
+{
+class FontFace;
+}
+
+enum class PointDistribution
+{
+    Uniform, Clusters, Roads
+};
+
+enum class LengthDistribution
+{
+    Uniform, Zipf
+};
+
+struct Dataset
+{
+    std::string name;
+    std::vector<gloperate_text::Label> labels;
+    // bounds of the labeled points
+    glm::vec2 lowerLeft;
+    glm::vec2 upperRight;
+};
+
+// synthetic font face with the glyphs 'a' to 'z' of 6x10 units, which needs no OpenGL context
+void prepareFont(gloperate_text::FontFace & fontFace);
+
+// The datasets depend only on their parameters and the seed; they use CounterRandom instead of std distributions,
+// whose results differ between standard libraries.
+// The labeled points cover about 40x40 units per label:
+//   Uniform  - uniformly distributed points
+//   Clusters - points normally distributed around uniformly distributed centers, e.g., cities
+//   Roads    - points along random smooth polylines, e.g., points of interest along streets
+// The label lengths are uniformly distributed between 3 and 12 characters or Zipf-distributed between 3 and 30.
+Dataset generateDataset(gloperate_text::FontFace * fontFace, PointDistribution points, LengthDistribution lengths, size_t numLabels, std::uint64_t seed);
+
+std::string name(PointDistribution points);
+std::string name(LengthDistribution lengths);
+// return false for unknown names
+bool parse(const std::string & string, PointDistribution & points);
+bool parse(const std::string & string, LengthDistribution & lengths);
@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <openll/FontFace.h>
+#include <openll/Trace.h>
+#include <openll/layout/algorithm.h>
+#include <openll/layout/AnnealingSolver.h>
+#include <openll/layout/LayoutBudget.h>
+#include <openll/layout/OccupancyGrid.h>
+#include <openll/layout/penalties.h>
+
+#include "datasets.h"
+#include "metrics.h"
+
+// Runs the layout algorithms on synthetic datasets without an OpenGL context and reports
+// wall time, memory and placement quality as CSV or JSON, e.g., for choosing an algorithm or catching regressions.
+
+namespace
+{
+
+const char * usage =
+    "usage: openll-layout-bench [options]\n"
+    "  --sizes <n,...>          numbers of labels (default 100,1000,10000,100000,1000000)\n"
+    "  --points <name,...>      point distributions: uniform, clusters, roads (default all)\n"
+    "  --lengths <name,...>     label length distributions: uniform, zipf (default all)\n"
+    "  --algorithms <name,...>  algorithms to run (default all, see --list)\n"
+    "  --budget <seconds>       time budget of the iterative algorithms per run (default 10)\n"
+    "  --quadratic-limit <n>    skip algorithms with pairwise tests above n labels (default 20000)\n"
+    "  --seed <n>               seed of the datasets (default 0)\n"
+    "  --format <csv|json>      output format (default csv)\n"
+    "  --output <file>          output file (default standard output)\n"
+    "  --trace <file>           write a Chrome trace (requires OPTION_ENABLE_TRACING)\n"
+    "  --list                   list the algorithms\n";
+
+struct Algorithm
+{
+    std::string name;
+    std::function<void(std::vector<gloperate_text::Label> &, const Dataset &, const gloperate_text::layout::LayoutBudget &)> run;
+    // tests all pairs of labels, which takes too long for large datasets
+    bool quadratic;
+};
+
+std::vector<Algorithm> algorithms()
+{
+    using namespace gloperate_text::layout;
+    using Labels = std::vector<gloperate_text::Label>;
+
+    // cells of about 2x2 units, labels are at least 10 units high
+    const auto occupancyGrid = [](const Dataset & dataset)
+    {
+        const auto lowerLeft = dataset.lowerLeft - glm::vec2(200.f);
+        const auto upperRight = dataset.upperRight + glm::vec2(200.f);
+        return OccupancyGrid(lowerLeft, upperRight, glm::uvec2((upperRight - lowerLeft) / 2.f) + glm::uvec2(1));
+    };
+
+    return {
+        {"constant", [](Labels & labels, const Dataset &, const LayoutBudget &) { constant(labels); }, false},
+        {"random", [](Labels & labels, const Dataset &, const LayoutBudget &) { random(labels); }, false},
+        {"greedy", [](Labels & labels, const Dataset &, const LayoutBudget &) { greedy(labels, standard); }, true},
+        {"greedyOccupancy", [occupancyGrid](Labels & labels, const Dataset & dataset, const LayoutBudget &) {
+            auto occupancy = occupancyGrid(dataset);
+            greedy(labels, standard, &occupancy); }, false},
+        {"priorityPlacement", [occupancyGrid](Labels & labels, const Dataset & dataset, const LayoutBudget &) {
+            auto occupancy = occupancyGrid(dataset);
+            priorityPlacement(labels, standard, occupancy); }, false},
+        {"discreteGradientDescent", [](Labels & labels, const Dataset &, const LayoutBudget & budget) {
+            discreteGradientDescent(labels, standard, budget); }, false},
+        {"simulatedAnnealing", [](Labels & labels, const Dataset &, const LayoutBudget & budget) {
+            simulatedAnnealing(labels, standard, true, glm::vec2(0.2f), budget); }, false},
+        {"specializedAnnealing", [](Labels & labels, const Dataset &, const LayoutBudget & budget) {
+            specializedAnnealing<StandardPenalty>(labels, StandardPenalty(), true, glm::vec2(0.2f), budget); }, false},
+        {"slidingPlacement", [](Labels & labels, const Dataset &, const LayoutBudget & budget) {
+            slidingPlacement(labels, standard, 2, true, glm::vec2(0.2f), 0.3f, budget); }, false},
+    };
+}
+
+std::vector<std::string> split(const std::string & string)
+{
+    std::vector<std::string> result;
+    std::istringstream stream(string);
+    std::string part;
+    while (std::getline(stream, part, ','))
+    {
+        if (!part.empty())
+            result.push_back(part);
+    }
+    return result;
+}
+
+struct Result
+{
+    std::string dataset;
+    size_t labels;
+    std::string algorithm;
+    // ok, budget (the time budget was exceeded) or skipped
+    std::string status;
+    double seconds;
+    size_t peakMemory;
+    LayoutMetrics metrics;
+};
+
+class Writer
+{
+public:
+    Writer(std::ostream & stream, bool json)
+    : m_stream(stream)
+    , m_json(json)
+    , m_first(true)
+    {
+        if (m_json)
+            m_stream << "[" << std::endl;
+        else
+            m_stream << "dataset,labels,algorithm,status,seconds,peak_memory_bytes,hidden,overlaps,overlap_area,"
+                "upper_right,upper_left,lower_left,lower_right,desirability" << std::endl;
+    }
+
+    ~Writer()
+    {
+        if (m_json)
+            m_stream << std::endl << "]" << std::endl;
+    }
+
+    void write(const Result & result)
+    {
+        const auto & metrics = result.metrics;
+        if (!m_json)
+        {
+            m_stream << result.dataset << "," << result.labels << "," << result.algorithm << "," << result.status << ","
+                << result.seconds << "," << result.peakMemory << "," << metrics.hidden << "," << metrics.overlaps << ","
+                << metrics.overlapArea << "," << metrics.positions[0] << "," << metrics.positions[1] << ","
+                << metrics.positions[2] << "," << metrics.positions[3] << "," << metrics.desirability << std::endl;
+            return;
+        }
+
+        if (!m_first)
+            m_stream << "," << std::endl;
+        m_first = false;
+        m_stream << "  {\"dataset\": \"" << result.dataset << "\", \"labels\": " << result.labels
+            << ", \"algorithm\": \"" << result.algorithm << "\", \"status\": \"" << result.status
+            << "\", \"seconds\": " << result.seconds << ", \"peak_memory_bytes\": " << result.peakMemory
+            << ", \"hidden\": " << metrics.hidden << ", \"overlaps\": " << metrics.overlaps
+            << ", \"overlap_area\": " << metrics.overlapArea
+            << ", \"positions\": {\"upper_right\": " << metrics.positions[0] << ", \"upper_left\": " << metrics.positions[1]
+            << ", \"lower_left\": " << metrics.positions[2] << ", \"lower_right\": " << metrics.positions[3]
+            << "}, \"desirability\": " << metrics.desirability << "}";
+        m_stream.flush();
+    }
+
+protected:
+    std::ostream & m_stream;
+    bool m_json;
+    bool m_first;
+};
+
+Result run(const Algorithm & algorithm, const Dataset & dataset, const std::chrono::duration<double> & budget, size_t quadraticLimit)
+{
+    Result result {dataset.name, dataset.labels.size(), algorithm.name, "ok", 0.0, 0, LayoutMetrics()};
+    if (algorithm.quadratic && dataset.labels.size() > quadraticLimit)
+    {
+        result.status = "skipped";
+        return result;
+    }
+
+    auto labels = dataset.labels;
+    const auto baseline = currentMemory();
+    resetPeakMemory();
+
+    const auto layoutBudget = gloperate_text::layout::LayoutBudget(std::chrono::duration_cast<gloperate_text::layout::LayoutBudget::Clock::duration>(budget));
+    const auto start = std::chrono::steady_clock::now();
+    algorithm.run(labels, dataset, layoutBudget);
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto peak = peakMemory();
+    result.peakMemory = peak > baseline ? peak - baseline : 0;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    if (result.seconds >= budget.count())
+        result.status = "budget";
+    result.metrics = evaluate(labels);
+    return result;
+}
+
+}
+
+
+int main(int argc, char * argv[])
+{
+    std::vector<size_t> sizes { 100, 1000, 10000, 100000, 1000000 };
+    std::vector<PointDistribution> pointDistributions { PointDistribution::Uniform, PointDistribution::Clusters, PointDistribution::Roads };
+    std::vector<LengthDistribution> lengthDistributions { LengthDistribution::Uniform, LengthDistribution::Zipf };
+    auto allAlgorithms = algorithms();
+    auto selectedAlgorithms = allAlgorithms;
+    auto budget = std::chrono::duration<double>(10.0);
+    size_t quadraticLimit = 20000;
+    std::uint64_t seed = 0;
+    auto json = false;
+    std::string outputFile;
+    std::string traceFile;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--list")
+        {
+            for (const auto & algorithm : allAlgorithms)
+                std::cout << algorithm.name << std::endl;
+            return 0;
+        }
+        if (argument == "--help" || i + 1 == argc)
+        {
+            std::cerr << usage;
+            return argument == "--help" ? 0 : 1;
+        }
+
+        const std::string value = argv[++i];
+        auto valid = true;
+        if (argument == "--sizes")
+        {
+            sizes.clear();
+            for (const auto & size : split(value))
+                sizes.push_back(std::stoul(size));
+        }
+        else if (argument == "--points")
+        {
+            pointDistributions.clear();
+            for (const auto & name : split(value))
+            {
+                PointDistribution points;
+                valid = valid && parse(name, points);
+                pointDistributions.push_back(points);
+            }
+        }
+        else if (argument == "--lengths")
+        {
+            lengthDistributions.clear();
+            for (const auto & name : split(value))
+            {
+                LengthDistribution lengths;
+                valid = valid && parse(name, lengths);
+                lengthDistributions.push_back(lengths);
+            }
+        }
+        else if (argument == "--algorithms")
+        {
+            selectedAlgorithms.clear();
+            for (const auto & name : split(value))
+            {
+                const auto it = std::find_if(allAlgorithms.begin(), allAlgorithms.end(), [&name](const Algorithm & algorithm) { return algorithm.name == name; });
+                valid = valid && it != allAlgorithms.end();
+                if (it != allAlgorithms.end())
+                    selectedAlgorithms.push_back(*it);
+            }
+        }
+        else if (argument == "--budget")
+            budget = std::chrono::duration<double>(std::stod(value));
+        else if (argument == "--quadratic-limit")
+            quadraticLimit = std::stoul(value);
+        else if (argument == "--seed")
+            seed = std::stoull(value);
+        else if (argument == "--format")
+        {
+            valid = value == "csv" || value == "json";
+            json = value == "json";
+        }
+        else if (argument == "--output")
+            outputFile = value;
+        else if (argument == "--trace")
+            traceFile = value;
+        else
+            valid = false;
+
+        if (!valid)
+        {
+            std::cerr << "invalid argument: " << argument << " " << value << std::endl << usage;
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outputFile.empty())
+    {
+        file.open(outputFile);
+        if (!file)
+        {
+            std::cerr << "cannot write " << outputFile << std::endl;
+            return 1;
+        }
+    }
+
+    gloperate_text::FontFace fontFace;
+    prepareFont(fontFace);
+
+    if (!traceFile.empty())
+        gloperate_text::Trace::start();
+
+    Writer writer(outputFile.empty() ? std::cout : file, json);
+    for (const auto points : pointDistributions)
+    {
+        for (const auto lengths : lengthDistributions)
+        {
+            for (const auto size : sizes)
+            {
+                const auto dataset = generateDataset(&fontFace, points, lengths, size, seed);
+                for (const auto & algorithm : selectedAlgorithms)
+                    writer.write(run(algorithm, dataset, budget, quadraticLimit));
+            }
+        }
+    }
+
+    if (!traceFile.empty() && !gloperate_text::Trace::write(traceFile))
+    {
+        std::cerr << "cannot write " << traceFile << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <openll/GlyphSequence.h>
+#include <openll/layout/CollisionGraph.h>
+#include <openll/layout/LabelArea.h>
+#include <openll/layout/RelativeLabelPosition.h>
+
+namespace
+{
+
+std::atomic<size_t> allocatedBytes(0);
+std::atomic<size_t> peakBytes(0);
+
+// the size is stored in front of each allocation, aligned for any type
+const size_t headerSize = alignof(std::max_align_t) > sizeof(size_t) ? alignof(std::max_align_t) : sizeof(size_t);
+
+}
+
+void * operator new(size_t size)
+{
+    const auto memory = static_cast<char *>(std::malloc(size + headerSize));
+    if (!memory)
+        throw std::bad_alloc();
+    *reinterpret_cast<size_t *>(memory) = size;
+
+    const auto allocated = allocatedBytes += size;
+    auto peak = peakBytes.load();
+    while (allocated > peak && !peakBytes.compare_exchange_weak(peak, allocated));
+    return memory + headerSize;
+}
+
+void operator delete(void * pointer) noexcept
+{
+    if (!pointer)
+        return;
+    const auto memory = static_cast<char *>(pointer) - headerSize;
+    allocatedBytes -= *reinterpret_cast<size_t *>(memory);
+    std::free(memory);
+}
+
+void * operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void * pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+LayoutMetrics evaluate(const std::vector<gloperate_text::Label> & labels)
+{
+    LayoutMetrics metrics {0, 0, 0.f, {{0, 0, 0, 0}}, 0.f};
+
+    // a single candidate per displayed label, so that the collision graph contains the overlapping pairs twice
+    std::vector<std::vector<gloperate_text::LabelArea>> labelAreas(labels.size());
+    const auto & corners = gloperate_text::layout::cornerPositions();
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        const auto & label = labels[i];
+        if (!label.placement.display)
+        {
+            ++metrics.hidden;
+            continue;
+        }
+        const auto & extent = label.sequence.extent();
+        labelAreas[i].push_back({label.pointLocation + label.placement.offset, extent});
+
+        const auto position = gloperate_text::relativeLabelPosition(label.placement.offset, extent);
+        const auto corner = std::find(corners.begin(), corners.end(), position) - corners.begin();
+        ++metrics.positions[corner];
+        metrics.desirability += 1.f - corner / 3.f;
+    }
+
+    const auto displayed = labels.size() - metrics.hidden;
+    if (displayed > 0)
+        metrics.desirability /= displayed;
+
+    const auto collisionGraph = gloperate_text::layout::createCollisionGraph(labelAreas);
+    for (const auto & collisions : collisionGraph)
+    {
+        for (const auto & positionCollisions : collisions)
+        {
+            metrics.overlaps += positionCollisions.size();
+            for (const auto & collision : positionCollisions)
+                metrics.overlapArea += collision.overlapArea;
+        }
+    }
+    metrics.overlaps /= 2;
+    metrics.overlapArea /= 2.f;
+
+    return metrics;
+}
+
+size_t currentMemory()
+{
+    return allocatedBytes;
+}
+
+size_t peakMemory()
+{
+    return peakBytes;
+}
+
+void resetPeakMemory()
+{
+    peakBytes = allocatedBytes.load();
+}
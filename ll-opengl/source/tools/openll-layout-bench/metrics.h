@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <openll/layout/layoutbase.h>
+
+struct LayoutMetrics
+{
+    size_t hidden;
+    // pairs of displayed labels overlapping each other
+    size_t overlaps;
+    float overlapArea;
+    // displayed labels per corner (in the order of cornerPositions), sliding positions count for the nearest corner
+    std::array<size_t, 4> positions;
+    // mean desirability of the displayed positions, from 1 for upper right to 0 for lower right (see StandardPenalty)
+    float desirability;
+};
+
+// uses a spatial index, so that millions of labels can be evaluated
+LayoutMetrics evaluate(const std::vector<gloperate_text::Label> & labels);
+
+// Heap memory allocated by operator new in bytes. Resident memory is not used as it hides
+// allocations reusing memory freed earlier, e.g., by the previous run.
+size_t currentMemory();
+// peak since the last reset
+size_t peakMemory();
+void resetPeakMemory();
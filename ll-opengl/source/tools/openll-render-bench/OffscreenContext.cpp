@@ -0,0 +1,200 @@
+#include "OffscreenContext.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(OPENLL_OFFSCREEN_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#elif defined(OPENLL_OFFSCREEN_OSMESA)
+#include <GL/osmesa.h>
+#endif
+
+
+namespace
+{
+
+#if defined(OPENLL_OFFSCREEN_EGL)
+bool hasExtension(const char * extensions, const char * extension)
+{
+    if (!extensions)
+        return false;
+
+    const auto length = std::strlen(extension);
+    for (auto position = std::strstr(extensions, extension); position; position = std::strstr(position + length, extension))
+    {
+        const auto begins = position == extensions || position[-1] == ' ';
+        const auto ends = position[length] == ' ' || position[length] == '\0';
+        if (begins && ends)
+            return true;
+    }
+    return false;
+}
+
+std::string eglError(const std::string & message)
+{
+    char code[16];
+    std::snprintf(code, sizeof(code), "0x%04x", static_cast<unsigned int>(eglGetError()));
+    return message + " (EGL error " + code + ")";
+}
+#endif
+
+}
+
+
+struct OffscreenContext::Handles
+{
+#if defined(OPENLL_OFFSCREEN_EGL)
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLSurface surface = EGL_NO_SURFACE;
+    EGLContext context = EGL_NO_CONTEXT;
+#elif defined(OPENLL_OFFSCREEN_OSMESA)
+    OSMesaContext context = nullptr;
+    // OSMesa requires a color buffer to make the context current
+    std::vector<unsigned char> buffer = std::vector<unsigned char>(4);
+#endif
+};
+
+
+OffscreenContext::OffscreenContext()
+: m_handles(new Handles)
+{
+}
+
+OffscreenContext::~OffscreenContext()
+{
+#if defined(OPENLL_OFFSCREEN_EGL)
+    if (m_handles->display != EGL_NO_DISPLAY)
+    {
+        eglMakeCurrent(m_handles->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (m_handles->context != EGL_NO_CONTEXT)
+            eglDestroyContext(m_handles->display, m_handles->context);
+        if (m_handles->surface != EGL_NO_SURFACE)
+            eglDestroySurface(m_handles->display, m_handles->surface);
+        eglTerminate(m_handles->display);
+    }
+#elif defined(OPENLL_OFFSCREEN_OSMESA)
+    if (m_handles->context)
+        OSMesaDestroyContext(m_handles->context);
+#endif
+}
+
+std::unique_ptr<OffscreenContext> OffscreenContext::create(int majorVersion, int minorVersion, std::string & error)
+{
+    std::unique_ptr<OffscreenContext> context(new OffscreenContext);
+    auto & handles = *context->m_handles;
+
+#if defined(OPENLL_OFFSCREEN_EGL)
+    // the surfaceless platform of Mesa requires neither a display server nor a GPU
+    const auto clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay && hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+        handles.display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (handles.display == EGL_NO_DISPLAY)
+        handles.display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major, minor;
+    if (handles.display == EGL_NO_DISPLAY || !eglInitialize(handles.display, &major, &minor))
+    {
+        handles.display = EGL_NO_DISPLAY;
+        error = eglError("cannot initialize an EGL display");
+        return nullptr;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        error = eglError("EGL does not support OpenGL");
+        return nullptr;
+    }
+
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    eglChooseConfig(handles.display, configAttributes, &config, 1, &configCount);
+
+    const auto displayExtensions = eglQueryString(handles.display, EGL_EXTENSIONS);
+    if (configCount == 0 && !hasExtension(displayExtensions, "EGL_KHR_no_config_context"))
+    {
+        error = eglError("no EGL config supports OpenGL");
+        return nullptr;
+    }
+
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, majorVersion,
+        EGL_CONTEXT_MINOR_VERSION, minorVersion,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    handles.context = eglCreateContext(handles.display, configCount > 0 ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+    if (handles.context == EGL_NO_CONTEXT)
+    {
+        error = eglError("cannot create an OpenGL " + std::to_string(majorVersion) + "." + std::to_string(minorVersion) + " core context");
+        return nullptr;
+    }
+
+    // without surfaceless contexts, a minimal pbuffer is made current instead
+    if (!hasExtension(displayExtensions, "EGL_KHR_surfaceless_context"))
+    {
+        const EGLint surfaceAttributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        handles.surface = configCount > 0 ? eglCreatePbufferSurface(handles.display, config, surfaceAttributes) : EGL_NO_SURFACE;
+        if (handles.surface == EGL_NO_SURFACE)
+        {
+            error = eglError("cannot create an EGL pbuffer");
+            return nullptr;
+        }
+    }
+#elif defined(OPENLL_OFFSCREEN_OSMESA)
+    const int attributes[] = {
+        OSMESA_FORMAT, OSMESA_RGBA,
+        OSMESA_PROFILE, OSMESA_CORE_PROFILE,
+        OSMESA_CONTEXT_MAJOR_VERSION, majorVersion,
+        OSMESA_CONTEXT_MINOR_VERSION, minorVersion,
+        0
+    };
+    handles.context = OSMesaCreateContextAttribs(attributes, nullptr);
+    if (!handles.context)
+    {
+        error = "cannot create an OSMesa " + std::to_string(majorVersion) + "." + std::to_string(minorVersion) + " core context";
+        return nullptr;
+    }
+#else
+    (void)majorVersion;
+    (void)minorVersion;
+    error = "built without EGL and OSMesa";
+    return nullptr;
+#endif
+
+    if (!context->makeCurrent())
+    {
+        error = "cannot make the offscreen context current";
+        return nullptr;
+    }
+    return context;
+}
+
+bool OffscreenContext::makeCurrent()
+{
+#if defined(OPENLL_OFFSCREEN_EGL)
+    return eglMakeCurrent(m_handles->display, m_handles->surface, m_handles->surface, m_handles->context) == EGL_TRUE;
+#elif defined(OPENLL_OFFSCREEN_OSMESA)
+    return OSMesaMakeCurrent(m_handles->context, m_handles->buffer.data(), 0x1401 /* GL_UNSIGNED_BYTE */, 1, 1) == 1;
+#else
+    return false;
+#endif
+}
+
+const char * OffscreenContext::backend() const
+{
+#if defined(OPENLL_OFFSCREEN_EGL)
+    return "EGL";
+#elif defined(OPENLL_OFFSCREEN_OSMESA)
+    return "OSMesa";
+#else
+    return "none";
+#endif
+}
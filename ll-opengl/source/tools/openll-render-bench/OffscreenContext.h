@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+
+// OpenGL core context without window or display server, e.g., for Mesa llvmpipe on servers without GPU.
+// Uses EGL (surfaceless platform if available, otherwise the default display) or OSMesa, depending on
+// the library found at build time (OPENLL_OFFSCREEN_EGL or OPENLL_OFFSCREEN_OSMESA).
+// There is no default framebuffer, rendering has to target a framebuffer object.
+class OffscreenContext
+{
+public:
+    // creates a context and makes it current; returns nullptr and sets the error on failure
+    static std::unique_ptr<OffscreenContext> create(int majorVersion, int minorVersion, std::string & error);
+
+    ~OffscreenContext();
+
+    OffscreenContext(const OffscreenContext &) = delete;
+    OffscreenContext & operator=(const OffscreenContext &) = delete;
+
+    bool makeCurrent();
+    // EGL or OSMesa
+    const char * backend() const;
+
+protected:
+    OffscreenContext();
+
+protected:
+    struct Handles;
+    std::unique_ptr<Handles> m_handles;
+};
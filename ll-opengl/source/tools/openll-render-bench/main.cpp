@@ -0,0 +1,382 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <glbinding/gl/gl.h>
+#include <glbinding/ContextInfo.h>
+
+#include <globjects/globjects.h>
+#include <globjects/Framebuffer.h>
+#include <globjects/Program.h>
+#include <globjects/Renderbuffer.h>
+#include <globjects/Shader.h>
+
+#include <openll/FontFace.h>
+#include <openll/FontLoader.h>
+#include <openll/GlyphRenderer.h>
+#include <openll/GlyphRenderStatistics.h>
+#include <openll/GlyphSequence.h>
+#include <openll/GlyphVertexCloud.h>
+#include <openll/SuperSampling.h>
+#include <openll/stages/GlyphPreparationStage.h>
+
+#include "OffscreenContext.h"
+
+// Renders scripted label scenes into a framebuffer object of an offscreen context and reports
+// CPU and GPU frame times as CSV or JSON; runs on servers without GPU using Mesa llvmpipe.
+
+
+using namespace gl;
+
+
+namespace
+{
+
+const char * usage =
+    "usage: openll-render-bench [options]\n"
+    "  --glyphs <n,...>          glyphs per scene (default 1000,10000,100000)\n"
+    "  --supersampling <name,...> none, 1x3, 2x4, rgss, quincunx, 8rooks, 3x3, 4x4 (default none,rgss,4x4)\n"
+    "  --sizes <WxH,...>         framebuffer sizes (default 1280x720,1920x1080,3840x2160)\n"
+    "  --frames <n>              measured frames per scene (default 100)\n"
+    "  --warmup <n>              frames rendered before measuring (default 10)\n"
+    "  --font <name>             font of the data directory (default opensansr36)\n"
+    "  --format <csv|json>       output format (default csv)\n"
+    "  --output <file>           output file (default standard output)\n";
+
+struct SuperSamplingMode
+{
+    const char * name;
+    gloperate_text::SuperSampling mode;
+};
+
+const SuperSamplingMode superSamplingModes[] = {
+    {"none", gloperate_text::SuperSampling::None},
+    {"1x3", gloperate_text::SuperSampling::Grid1x3},
+    {"2x4", gloperate_text::SuperSampling::Grid2x4},
+    {"rgss", gloperate_text::SuperSampling::RGSS2x2},
+    {"quincunx", gloperate_text::SuperSampling::Quincunx},
+    {"8rooks", gloperate_text::SuperSampling::Rooks8},
+    {"3x3", gloperate_text::SuperSampling::Grid3x3},
+    {"4x4", gloperate_text::SuperSampling::Grid4x4},
+};
+
+const char * const words[] = {
+    "Berlin", "Potsdam", "Hauptbahnhof", "Museum", "Brandenburg", "Havel", "Spree", "Bridge",
+    "Station", "Park", "Library", "Harbour", "Cottbus", "Avenue", "Tower", "Market",
+};
+
+struct Result
+{
+    glm::ivec2 size;
+    size_t glyphs;
+    std::string superSampling;
+    size_t frames;
+    // milliseconds
+    double cpuMean;
+    double cpuPercentile95;
+    double gpuMean;
+    double gpuPercentile95;
+    double frameMean;
+};
+
+std::vector<std::string> split(const std::string & string)
+{
+    std::vector<std::string> result;
+    std::istringstream stream(string);
+    std::string part;
+    while (std::getline(stream, part, ','))
+    {
+        if (!part.empty())
+            result.push_back(part);
+    }
+    return result;
+}
+
+double mean(const std::vector<double> & values)
+{
+    auto sum = 0.0;
+    for (const auto value : values)
+        sum += value;
+    return values.empty() ? 0.0 : sum / values.size();
+}
+
+double percentile95(std::vector<double> values)
+{
+    if (values.empty())
+        return 0.0;
+    const auto index = std::min(values.size() - 1, values.size() * 95 / 100);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// labels of one to three words at random pixel positions, until the number of glyphs is reached
+std::vector<gloperate_text::GlyphSequence> scene(gloperate_text::FontFace * fontFace, size_t glyphs, gloperate_text::SuperSampling superSampling, const glm::ivec2 & size)
+{
+    std::mt19937 generator(static_cast<unsigned int>(glyphs));
+    std::uniform_real_distribution<float> x(0.f, static_cast<float>(size.x));
+    std::uniform_real_distribution<float> y(0.f, static_cast<float>(size.y));
+    std::uniform_int_distribution<size_t> word(0, sizeof(words) / sizeof(words[0]) - 1);
+    std::uniform_int_distribution<int> wordCount(1, 3);
+
+    // pixel to normalized device coordinates
+    auto toDevice = glm::translate(glm::mat4(), glm::vec3(-1.f, -1.f, 0.f));
+    toDevice = glm::scale(toDevice, glm::vec3(2.f / glm::vec2(size), 1.f));
+
+    std::vector<gloperate_text::GlyphSequence> sequences;
+    auto sceneGlyphs = size_t(0);
+    while (sceneGlyphs < glyphs)
+    {
+        std::string text = words[word(generator)];
+        for (auto i = wordCount(generator); i > 1; --i)
+            text += std::string(" ") + words[word(generator)];
+
+        gloperate_text::GlyphSequence sequence;
+        sequence.setString(std::u32string(text.begin(), text.end()));
+        sequence.setFontFace(fontFace);
+        sequence.setFontSize(16.f);
+        sequence.setFontColor(glm::vec4(0.f, 0.f, 0.f, 1.f));
+        sequence.setSuperSampling(superSampling);
+        sequence.setAdditionalTransform(glm::translate(toDevice, glm::vec3(x(generator), y(generator), 0.f)));
+
+        sceneGlyphs += sequence.depictableSize();
+        sequences.push_back(sequence);
+    }
+    return sequences;
+}
+
+Result run(gloperate_text::GlyphRenderer & renderer, gloperate_text::FontFace * fontFace, const glm::ivec2 & size,
+    size_t glyphs, const SuperSamplingMode & superSampling, size_t frames, size_t warmup)
+{
+    using Clock = std::chrono::steady_clock;
+
+    globjects::ref_ptr<globjects::Renderbuffer> color = new globjects::Renderbuffer;
+    color->storage(GL_RGBA8, size.x, size.y);
+    globjects::ref_ptr<globjects::Framebuffer> framebuffer = new globjects::Framebuffer;
+    framebuffer->attachRenderBuffer(GL_COLOR_ATTACHMENT0, color);
+    framebuffer->bind();
+    framebuffer->setDrawBuffer(GL_COLOR_ATTACHMENT0);
+
+    const auto sequences = scene(fontFace, glyphs, superSampling.mode, size);
+    const auto cloud = gloperate_text::prepareGlyphs(sequences, true);
+
+    // keeps all frames, including the last one still being recorded
+    gloperate_text::GlyphRenderStatistics statistics(true, warmup + frames + 2);
+    renderer.setStatistics(&statistics);
+
+    glViewport(0, 0, size.x, size.y);
+    glClearColor(1.f, 1.f, 1.f, 1.f);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    std::vector<double> cpuTimes;
+    auto measureStart = Clock::now();
+    for (size_t frame = 0; frame < warmup + frames; ++frame)
+    {
+        if (frame == warmup)
+        {
+            glFinish();
+            measureStart = Clock::now();
+        }
+
+        // CPU time of submitting the frame
+        const auto start = Clock::now();
+        glClear(GL_COLOR_BUFFER_BIT);
+        renderer.render(cloud);
+        const auto end = Clock::now();
+        statistics.beginFrame();
+
+        if (frame >= warmup)
+            cpuTimes.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    glFinish();
+    const auto measureEnd = Clock::now();
+
+    // all query results are available after glFinish
+    statistics.beginFrame();
+
+    std::vector<double> gpuTimes;
+    for (const auto & frame : statistics.frames())
+    {
+        if (frame.index >= warmup && frame.index < warmup + frames && frame.gpuTime() >= 0.0)
+            gpuTimes.push_back(frame.gpuTime());
+    }
+
+    renderer.setStatistics(nullptr);
+    glDisable(GL_BLEND);
+    glDepthMask(GL_TRUE);
+    framebuffer->unbind();
+
+    return {size, cloud.vertices().size(), superSampling.name, frames,
+        mean(cpuTimes), percentile95(cpuTimes), mean(gpuTimes), percentile95(gpuTimes),
+        std::chrono::duration<double, std::milli>(measureEnd - measureStart).count() / std::max(frames, size_t(1))};
+}
+
+void write(std::ostream & stream, const std::vector<Result> & results, bool json)
+{
+    if (!json)
+    {
+        stream << "width,height,glyphs,supersampling,frames,cpu_mean_ms,cpu_p95_ms,gpu_mean_ms,gpu_p95_ms,frame_mean_ms" << std::endl;
+        for (const auto & result : results)
+        {
+            stream << result.size.x << "," << result.size.y << "," << result.glyphs << "," << result.superSampling << ","
+                << result.frames << "," << result.cpuMean << "," << result.cpuPercentile95 << ","
+                << result.gpuMean << "," << result.gpuPercentile95 << "," << result.frameMean << std::endl;
+        }
+        return;
+    }
+
+    stream << "[" << std::endl;
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto & result = results[i];
+        stream << "  {\"width\": " << result.size.x << ", \"height\": " << result.size.y << ", \"glyphs\": " << result.glyphs
+            << ", \"supersampling\": \"" << result.superSampling << "\", \"frames\": " << result.frames
+            << ", \"cpu_mean_ms\": " << result.cpuMean << ", \"cpu_p95_ms\": " << result.cpuPercentile95
+            << ", \"gpu_mean_ms\": " << result.gpuMean << ", \"gpu_p95_ms\": " << result.gpuPercentile95
+            << ", \"frame_mean_ms\": " << result.frameMean << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    stream << "]" << std::endl;
+}
+
+}
+
+
+int main(int argc, char * argv[])
+{
+    std::vector<size_t> glyphCounts { 1000, 10000, 100000 };
+    std::vector<SuperSamplingMode> modes { superSamplingModes[0], superSamplingModes[3], superSamplingModes[7] };
+    std::vector<glm::ivec2> sizes { {1280, 720}, {1920, 1080}, {3840, 2160} };
+    size_t frames = 100;
+    size_t warmup = 10;
+    std::string font = "opensansr36";
+    auto json = false;
+    std::string outputFile;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--help" || i + 1 == argc)
+        {
+            std::cerr << usage;
+            return argument == "--help" ? 0 : 1;
+        }
+
+        const std::string value = argv[++i];
+        auto valid = true;
+        if (argument == "--glyphs")
+        {
+            glyphCounts.clear();
+            for (const auto & count : split(value))
+                glyphCounts.push_back(std::stoul(count));
+        }
+        else if (argument == "--supersampling")
+        {
+            modes.clear();
+            for (const auto & name : split(value))
+            {
+                const auto it = std::find_if(std::begin(superSamplingModes), std::end(superSamplingModes),
+                    [&name](const SuperSamplingMode & mode) { return name == mode.name; });
+                valid = valid && it != std::end(superSamplingModes);
+                if (it != std::end(superSamplingModes))
+                    modes.push_back(*it);
+            }
+        }
+        else if (argument == "--sizes")
+        {
+            sizes.clear();
+            for (const auto & size : split(value))
+            {
+                const auto separator = size.find('x');
+                valid = valid && separator != std::string::npos;
+                if (separator != std::string::npos)
+                    sizes.push_back({std::stoi(size.substr(0, separator)), std::stoi(size.substr(separator + 1))});
+            }
+        }
+        else if (argument == "--frames")
+            frames = std::stoul(value);
+        else if (argument == "--warmup")
+            warmup = std::stoul(value);
+        else if (argument == "--font")
+            font = value;
+        else if (argument == "--format")
+        {
+            valid = value == "csv" || value == "json";
+            json = value == "json";
+        }
+        else if (argument == "--output")
+            outputFile = value;
+        else
+            valid = false;
+
+        if (!valid)
+        {
+            std::cerr << "invalid argument: " << argument << " " << value << std::endl << usage;
+            return 1;
+        }
+    }
+
+    std::string error;
+    const auto context = OffscreenContext::create(3, 3, error);
+    if (!context)
+    {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    // Initialize globjects (internally initializes glbinding, and registers the current context)
+    globjects::init();
+
+    std::cerr << "Context: " << context->backend() << ", " << glbinding::ContextInfo::renderer()
+        << ", OpenGL " << glbinding::ContextInfo::version() << std::endl;
+
+    const std::string dataPath = OPENLL_DATA_PATH;
+    gloperate_text::FontLoader loader;
+    globjects::ref_ptr<gloperate_text::FontFace> fontFace = loader.load(dataPath + "/fonts/" + font + "/" + font + ".fnt");
+    if (!fontFace)
+    {
+        std::cerr << "cannot load font " << font << std::endl;
+        return 1;
+    }
+
+    // GlyphRenderer() expects the shaders relative to the working directory
+    auto program = new globjects::Program;
+    program->attach(
+        globjects::Shader::fromFile(GL_VERTEX_SHADER, dataPath + "/shaders/glyph.vert"),
+        globjects::Shader::fromFile(GL_GEOMETRY_SHADER, dataPath + "/shaders/glyph.geom"),
+        globjects::Shader::fromFile(GL_FRAGMENT_SHADER, dataPath + "/shaders/glyph.frag"));
+    gloperate_text::GlyphRenderer renderer(program);
+
+    std::vector<Result> results;
+    for (const auto & size : sizes)
+    {
+        for (const auto glyphs : glyphCounts)
+        {
+            for (const auto & mode : modes)
+                results.push_back(run(renderer, fontFace, size, glyphs, mode, frames, warmup));
+        }
+    }
+
+    if (outputFile.empty())
+    {
+        write(std::cout, results, json);
+        return 0;
+    }
+
+    std::ofstream file(outputFile);
+    if (!file)
+    {
+        std::cerr << "cannot write " << outputFile << std::endl;
+        return 1;
+    }
+    write(file, results, json);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <openll-vulkan/openll-vulkan_api.h>
+
+
+namespace gloperate_text
+{
+
+namespace vulkan
+{
+
+
+struct Allocation
+{
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    // persistently mapped address of host visible allocations, nullptr otherwise
+    void * mapped = nullptr;
+};
+
+
+/**
+*  @brief
+*   Device memory for the buffers and images of the Vulkan backend.
+*
+*   Implement this interface to suballocate from the memory allocator of
+*   the application; DeviceAllocator is a simple default.
+*/
+class OPENLL_VULKAN_API Allocator
+{
+public:
+    virtual ~Allocator();
+
+    // memory satisfying requirements with at least the given properties;
+    // host visible memory is requested coherent and has to be mapped persistently
+    virtual VkResult allocate(const VkMemoryRequirements & requirements, VkMemoryPropertyFlags properties, Allocation & allocation) = 0;
+    virtual void free(const Allocation & allocation) = 0;
+};
+
+
+// one vkAllocateMemory per allocation; fine for the few, long living objects of label rendering
+class OPENLL_VULKAN_API DeviceAllocator : public Allocator
+{
+public:
+    DeviceAllocator(VkPhysicalDevice physicalDevice, VkDevice device);
+    virtual ~DeviceAllocator();
+
+    virtual VkResult allocate(const VkMemoryRequirements & requirements, VkMemoryPropertyFlags properties, Allocation & allocation) override;
+    virtual void free(const Allocation & allocation) override;
+
+protected:
+    VkDevice m_device;
+    VkPhysicalDeviceMemoryProperties m_memoryProperties;
+};
+
+
+} // namespace vulkan
+
+} // namespace gloperate_text
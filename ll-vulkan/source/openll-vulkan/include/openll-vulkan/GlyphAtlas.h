@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <glm/vec2.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <openll-vulkan/Allocator.h>
+
+#include <openll-vulkan/openll-vulkan_api.h>
+
+
+namespace gloperate_text
+{
+
+class FontFace;
+
+namespace vulkan
+{
+
+class HostBuffer;
+
+
+/**
+*  @brief
+*   Glyph texture of a font face as sampled image, with the descriptor set
+*   used by GlyphRenderer.
+*
+*   The glyph image has to be kept by the font face, i.e., loaded by a
+*   FontLoader without uploadGlyphTexture, so that no OpenGL context is
+*   involved.
+*/
+class OPENLL_VULKAN_API GlyphAtlas
+{
+public:
+    // the descriptor set is allocated for layout, see GlyphRenderer::descriptorSetLayout
+    GlyphAtlas(VkDevice device, Allocator & allocator, VkDescriptorSetLayout layout);
+    virtual ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas &) = delete;
+    GlyphAtlas & operator=(const GlyphAtlas &) = delete;
+
+    // copies the glyph image into a staging buffer and records its upload into a command buffer
+    // of a graphics queue; the atlas must not be in use by pending command buffers
+    VkResult upload(VkCommandBuffer commandBuffer, const FontFace & fontFace);
+    // frees the staging buffer once the command buffer of upload has completed
+    void releaseStaging();
+
+    const glm::uvec2 & extent() const;
+    // the number of array layers, one per page of the font face
+    std::uint32_t pages() const;
+    VkImageView imageView() const;
+    VkSampler sampler() const;
+    VkDescriptorSet descriptorSet() const;
+
+protected:
+    VkResult createDescriptorSet();
+    VkResult createImage(const glm::uvec2 & extent, std::uint32_t pages);
+    void destroyImage();
+
+protected:
+    VkDevice m_device;
+    Allocator & m_allocator;
+    VkDescriptorSetLayout m_layout;
+
+    glm::uvec2 m_extent;
+    std::uint32_t m_pages;
+    VkImage m_image;
+    Allocation m_allocation;
+    VkImageView m_imageView;
+    VkSampler m_sampler;
+
+    VkDescriptorPool m_descriptorPool;
+    VkDescriptorSet m_descriptorSet;
+
+    std::unique_ptr<HostBuffer> m_staging;
+};
+
+
+} // namespace vulkan
+
+} // namespace gloperate_text
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include <openll/GlyphVertexCloud.h>
+#include <openll/SuperSampling.h>
+
+#include <openll-vulkan/openll-vulkan_api.h>
+
+
+namespace gloperate_text
+{
+
+namespace vulkan
+{
+
+class Allocator;
+class HostBuffer;
+
+
+/**
+*  @brief
+*   Instance buffers of glyph vertices (GlyphVertexCloud::Vertex) for
+*   several frames in flight.
+*
+*   Each frame has its own buffer in host coherent memory, so the vertices
+*   of the next frame can be written while the GPU still reads the previous
+*   ones. Typically, frame is the index of the frame in flight whose fence
+*   was just waited for.
+*/
+class OPENLL_VULKAN_API GlyphBuffer
+{
+public:
+    // consecutive vertices with the same super sampling mode, drawn with the pipeline of the mode
+    struct Run
+    {
+        SuperSampling superSampling;
+        std::uint32_t first;
+        std::uint32_t count;
+    };
+
+public:
+    GlyphBuffer(VkDevice device, Allocator & allocator, std::uint32_t framesInFlight = 2);
+    virtual ~GlyphBuffer();
+
+    GlyphBuffer(const GlyphBuffer &) = delete;
+    GlyphBuffer & operator=(const GlyphBuffer &) = delete;
+
+    std::uint32_t framesInFlight() const;
+
+    // copies the vertices into the buffer of frame; the command buffers reading
+    // the buffer of frame before have to be completed
+    VkResult update(std::uint32_t frame, const GlyphVertexCloud::Vertices & vertices);
+
+    VkBuffer buffer(std::uint32_t frame) const;
+    std::uint32_t size(std::uint32_t frame) const;
+    const std::vector<Run> & runs(std::uint32_t frame) const;
+
+    static std::vector<Run> computeRuns(const GlyphVertexCloud::Vertices & vertices);
+
+protected:
+    struct Frame
+    {
+        std::unique_ptr<HostBuffer> buffer;
+        std::uint32_t size;
+        std::vector<Run> runs;
+    };
+
+protected:
+    std::vector<Frame> m_frames;
+};
+
+
+} // namespace vulkan
+
+} // namespace gloperate_text
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <glm/fwd.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <openll/SuperSampling.h>
+
+#include <openll-vulkan/openll-vulkan_api.h>
+
+
+namespace gloperate_text
+{
+
+namespace vulkan
+{
+
+class GlyphAtlas;
+class GlyphBuffer;
+
+
+/**
+*  @brief
+*   Vulkan counterpart of gloperate_text::GlyphRenderer, recording into
+*   command buffers of the application.
+*
+*   There is one pipeline per super sampling mode, specialized by a
+*   specialization constant of the fragment shader; the glyphs are drawn as
+*   instanced triangle strips in the runs of GlyphBuffer. The pipelines
+*   blend like the OpenGL renderer expects (source alpha, one minus source
+*   alpha) and use dynamic viewport and scissor, which have to be set by the
+*   application.
+*/
+class OPENLL_VULKAN_API GlyphRenderer
+{
+public:
+    static const std::uint32_t superSamplingModes = static_cast<std::uint32_t>(SuperSampling::Grid4x4) + 1;
+
+public:
+    // with depthTest, the glyphs are tested against (but do not write) the depth attachment of the subpass
+    GlyphRenderer(VkDevice device, VkRenderPass renderPass, std::uint32_t subpass = 0
+        , VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT, bool depthTest = false, VkPipelineCache pipelineCache = VK_NULL_HANDLE);
+    virtual ~GlyphRenderer();
+
+    GlyphRenderer(const GlyphRenderer &) = delete;
+    GlyphRenderer & operator=(const GlyphRenderer &) = delete;
+
+    // VK_SUCCESS if all objects were created
+    VkResult result() const;
+
+    VkDescriptorSetLayout descriptorSetLayout() const;
+    VkPipelineLayout pipelineLayout() const;
+    VkPipeline pipeline(SuperSampling superSampling) const;
+
+    // records the draw calls for the vertices of frame within the active render pass
+    void render(VkCommandBuffer commandBuffer, const GlyphBuffer & buffer, std::uint32_t frame, const GlyphAtlas & atlas) const;
+    void renderInWorld(VkCommandBuffer commandBuffer, const GlyphBuffer & buffer, std::uint32_t frame, const GlyphAtlas & atlas
+        , const glm::mat4 & viewProjection) const;
+
+protected:
+    VkResult createLayouts();
+    VkResult createPipelines(VkRenderPass renderPass, std::uint32_t subpass, VkSampleCountFlagBits samples, bool depthTest, VkPipelineCache pipelineCache);
+    VkShaderModule createShaderModule(const std::uint32_t * code, size_t size) const;
+
+protected:
+    VkDevice m_device;
+    VkResult m_result;
+
+    VkDescriptorSetLayout m_descriptorSetLayout;
+    VkPipelineLayout m_pipelineLayout;
+    std::array<VkPipeline, superSamplingModes> m_pipelines;
+};
+
+
+} // namespace vulkan
+
+} // namespace gloperate_text
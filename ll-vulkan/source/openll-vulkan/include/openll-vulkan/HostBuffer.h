@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <openll-vulkan/Allocator.h>
+
+#include <openll-vulkan/openll-vulkan_api.h>
+
+
+namespace gloperate_text
+{
+
+namespace vulkan
+{
+
+
+// Buffer in persistently mapped, host coherent memory, e.g., for staging and per-frame instance data
+class OPENLL_VULKAN_API HostBuffer
+{
+public:
+    HostBuffer(VkDevice device, Allocator & allocator, VkBufferUsageFlags usage);
+    virtual ~HostBuffer();
+
+    HostBuffer(const HostBuffer &) = delete;
+    HostBuffer & operator=(const HostBuffer &) = delete;
+
+    // recreates the buffer with size bytes if its capacity is smaller; the contents are lost then
+    // and the buffer must not be used by pending command buffers
+    VkResult reserve(VkDeviceSize size);
+    void release();
+
+    VkBuffer buffer() const;
+    VkDeviceSize capacity() const;
+    void * data() const;
+
+protected:
+    VkDevice m_device;
+    Allocator & m_allocator;
+    VkBufferUsageFlags m_usage;
+
+    VkBuffer m_buffer;
+    Allocation m_allocation;
+    VkDeviceSize m_capacity;
+};
+
+
+} // namespace vulkan
+
+} // namespace gloperate_text
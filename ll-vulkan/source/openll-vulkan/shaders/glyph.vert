@@ -0,0 +1,48 @@
+#version 450
+
+// One instance per glyph (GlyphVertexCloud::Vertex), expanded to a triangle
+// strip of four vertices instead of the geometry shader of ll-opengl.
+
+layout (location = 0) in vec3 in_origin;
+layout (location = 1) in vec3 in_vtan;
+layout (location = 2) in vec3 in_vbitan;
+layout (location = 3) in vec4 in_uvRect;  // vec2 lowerLeft and vec2 upperRight in glyph texture (uv)
+layout (location = 4) in vec4 in_fontColor;
+layout (location = 5) in uint in_page;    // layer of the glyph texture array
+
+layout (push_constant) uniform PushConstants
+{
+    mat4 viewProjection;
+} pushConstants;
+
+layout (location = 0) out vec2 v_uv;
+layout (location = 1) out vec4 v_fontColor;
+layout (location = 2) flat out uint v_page;
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    // lower right, upper right, lower left, upper left
+    bool right = gl_VertexIndex < 2;
+    bool upper = (gl_VertexIndex & 1) == 1;
+
+    vec3 position = in_origin;
+    if (right)
+        position += in_vtan;
+    if (upper)
+        position += in_vbitan;
+
+    v_uv        = vec2(right ? in_uvRect.z : in_uvRect.x, upper ? in_uvRect.w : in_uvRect.y);
+    v_fontColor = in_fontColor;
+    v_page      = in_page;
+
+    gl_Position = pushConstants.viewProjection * vec4(position, 1.0);
+
+    // OpenGL conventions of the view projection: y up and depth in [-w, w]
+    gl_Position.y = -gl_Position.y;
+    gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;
+}
@@ -0,0 +1,72 @@
+#include <openll-vulkan/Allocator.h>
+
+
+namespace gloperate_text
+{
+
+namespace vulkan
+{
+
+
+Allocator::~Allocator()
+{
+}
+
+
+DeviceAllocator::DeviceAllocator(VkPhysicalDevice physicalDevice, VkDevice device)
+: m_device(device)
+{
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+}
+
+DeviceAllocator::~DeviceAllocator()
+{
+}
+
+VkResult DeviceAllocator::allocate(const VkMemoryRequirements & requirements, VkMemoryPropertyFlags properties, Allocation & allocation)
+{
+    allocation = Allocation();
+
+    auto memoryType = m_memoryProperties.memoryTypeCount;
+    for (uint32_t i = 0; i < m_memoryProperties.memoryTypeCount; ++i)
+    {
+        if ((requirements.memoryTypeBits & (1u << i)) && (m_memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+        {
+            memoryType = i;
+            break;
+        }
+    }
+    if (memoryType == m_memoryProperties.memoryTypeCount)
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+
+    VkMemoryAllocateInfo allocateInfo = {};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocateInfo.allocationSize = requirements.size;
+    allocateInfo.memoryTypeIndex = memoryType;
+
+    auto result = vkAllocateMemory(m_device, &allocateInfo, nullptr, &allocation.memory);
+    if (result != VK_SUCCESS)
+        return result;
+
+    if (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+    {
+        result = vkMapMemory(m_device, allocation.memory, 0, VK_WHOLE_SIZE, 0, &allocation.mapped);
+        if (result != VK_SUCCESS)
+        {
+            vkFreeMemory(m_device, allocation.memory, nullptr);
+            allocation = Allocation();
+        }
+    }
+    return result;
+}
+
+void DeviceAllocator::free(const Allocation & allocation)
+{
+    // freeing implicitly unmaps
+    vkFreeMemory(m_device, allocation.memory, nullptr);
+}
+
+
+} // namespace vulkan
+
+} // namespace gloperate_text
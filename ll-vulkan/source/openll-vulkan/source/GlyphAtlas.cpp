@@ -0,0 +1,278 @@
+#include <openll-vulkan/GlyphAtlas.h>
+
+#include <cstring>
+
+#include <openll/FontFace.h>
+
+#include <openll-vulkan/HostBuffer.h>
+
+
+namespace gloperate_text
+{
+
+namespace vulkan
+{
+
+
+GlyphAtlas::GlyphAtlas(VkDevice device, Allocator & allocator, VkDescriptorSetLayout layout)
+: m_device(device)
+, m_allocator(allocator)
+, m_layout(layout)
+, m_extent(0, 0)
+, m_pages(0)
+, m_image(VK_NULL_HANDLE)
+, m_imageView(VK_NULL_HANDLE)
+, m_sampler(VK_NULL_HANDLE)
+, m_descriptorPool(VK_NULL_HANDLE)
+, m_descriptorSet(VK_NULL_HANDLE)
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    releaseStaging();
+    destroyImage();
+
+    // destroying the pool frees the descriptor set
+    if (m_descriptorPool != VK_NULL_HANDLE)
+        vkDestroyDescriptorPool(m_device, m_descriptorPool, nullptr);
+    if (m_sampler != VK_NULL_HANDLE)
+        vkDestroySampler(m_device, m_sampler, nullptr);
+}
+
+VkResult GlyphAtlas::upload(VkCommandBuffer commandBuffer, const FontFace & fontFace)
+{
+    // one array layer per page, the pages follow each other in the glyph image
+    const auto & extent = fontFace.glyphTextureExtent();
+    const auto pages = static_cast<std::uint32_t>(fontFace.glyphTexturePages());
+    const auto & texels = fontFace.glyphImage();
+    const auto size = static_cast<size_t>(extent.x) * extent.y * pages;
+    if (size == 0 || texels.size() < size)
+        return VK_ERROR_INITIALIZATION_FAILED;
+
+    auto result = createDescriptorSet();
+    if (result != VK_SUCCESS)
+        return result;
+
+    if (m_image == VK_NULL_HANDLE || extent != m_extent || pages != m_pages)
+    {
+        destroyImage();
+        result = createImage(extent, pages);
+        if (result != VK_SUCCESS)
+            return result;
+    }
+
+    m_staging.reset(new HostBuffer(m_device, m_allocator, VK_BUFFER_USAGE_TRANSFER_SRC_BIT));
+    result = m_staging->reserve(size);
+    if (result != VK_SUCCESS)
+        return result;
+    std::memcpy(m_staging->data(), texels.data(), size);
+
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = m_image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = pages;
+
+    // the previous contents may still have been read by earlier, completed frames
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT
+        , 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    // the first row of the glyph image is v = 0, as in the OpenGL texture
+    VkBufferImageCopy region = {};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = pages;
+    region.imageExtent = { extent.x, extent.y, 1 };
+    vkCmdCopyBufferToImage(commandBuffer, m_staging->buffer(), m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+        , 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.sampler = m_sampler;
+    imageInfo.imageView = m_imageView;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = m_descriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+
+    return VK_SUCCESS;
+}
+
+void GlyphAtlas::releaseStaging()
+{
+    m_staging.reset();
+}
+
+const glm::uvec2 & GlyphAtlas::extent() const
+{
+    return m_extent;
+}
+
+std::uint32_t GlyphAtlas::pages() const
+{
+    return m_pages;
+}
+
+VkImageView GlyphAtlas::imageView() const
+{
+    return m_imageView;
+}
+
+VkSampler GlyphAtlas::sampler() const
+{
+    return m_sampler;
+}
+
+VkDescriptorSet GlyphAtlas::descriptorSet() const
+{
+    return m_descriptorSet;
+}
+
+VkResult GlyphAtlas::createDescriptorSet()
+{
+    if (m_descriptorSet != VK_NULL_HANDLE)
+        return VK_SUCCESS;
+
+    // filtering as the texture of FontLoader
+    VkSamplerCreateInfo samplerInfo = {};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_LINEAR;
+    samplerInfo.minFilter = VK_FILTER_LINEAR;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxAnisotropy = 1.f;
+    samplerInfo.compareOp = VK_COMPARE_OP_NEVER;
+    samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+
+    auto result = vkCreateSampler(m_device, &samplerInfo, nullptr, &m_sampler);
+    if (result != VK_SUCCESS)
+    {
+        m_sampler = VK_NULL_HANDLE;
+        return result;
+    }
+
+    VkDescriptorPoolSize poolSize = {};
+    poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSize.descriptorCount = 1;
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    result = vkCreateDescriptorPool(m_device, &poolInfo, nullptr, &m_descriptorPool);
+    if (result != VK_SUCCESS)
+    {
+        m_descriptorPool = VK_NULL_HANDLE;
+        return result;
+    }
+
+    VkDescriptorSetAllocateInfo allocateInfo = {};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorPool = m_descriptorPool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &m_layout;
+
+    result = vkAllocateDescriptorSets(m_device, &allocateInfo, &m_descriptorSet);
+    if (result != VK_SUCCESS)
+        m_descriptorSet = VK_NULL_HANDLE;
+    return result;
+}
+
+VkResult GlyphAtlas::createImage(const glm::uvec2 & extent, const std::uint32_t pages)
+{
+    VkImageCreateInfo imageInfo = {};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = VK_FORMAT_R8_UNORM;
+    imageInfo.extent = { extent.x, extent.y, 1 };
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = pages;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    auto result = vkCreateImage(m_device, &imageInfo, nullptr, &m_image);
+    if (result != VK_SUCCESS)
+    {
+        m_image = VK_NULL_HANDLE;
+        return result;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(m_device, m_image, &requirements);
+
+    result = m_allocator.allocate(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_allocation);
+    if (result == VK_SUCCESS)
+        result = vkBindImageMemory(m_device, m_image, m_allocation.memory, m_allocation.offset);
+
+    if (result == VK_SUCCESS)
+    {
+        VkImageViewCreateInfo viewInfo = {};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = m_image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        viewInfo.format = VK_FORMAT_R8_UNORM;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.layerCount = pages;
+
+        result = vkCreateImageView(m_device, &viewInfo, nullptr, &m_imageView);
+        if (result != VK_SUCCESS)
+            m_imageView = VK_NULL_HANDLE;
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        destroyImage();
+        return result;
+    }
+
+    m_extent = extent;
+    m_pages = pages;
+    return VK_SUCCESS;
+}
+
+void GlyphAtlas::destroyImage()
+{
+    if (m_imageView != VK_NULL_HANDLE)
+        vkDestroyImageView(m_device, m_imageView, nullptr);
+    if (m_image != VK_NULL_HANDLE)
+        vkDestroyImage(m_device, m_image, nullptr);
+    if (m_allocation.memory != VK_NULL_HANDLE)
+        m_allocator.free(m_allocation);
+
+    m_extent = glm::uvec2(0, 0);
+    m_pages = 0;
+    m_image = VK_NULL_HANDLE;
+    m_allocation = Allocation();
+    m_imageView = VK_NULL_HANDLE;
+}
+
+
+} // namespace vulkan
+
+} // namespace gloperate_text
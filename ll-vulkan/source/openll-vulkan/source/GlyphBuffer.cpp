@@ -0,0 +1,97 @@
+#include <openll-vulkan/GlyphBuffer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <openll-vulkan/HostBuffer.h>
+
+
+namespace gloperate_text
+{
+
+namespace vulkan
+{
+
+
+GlyphBuffer::GlyphBuffer(VkDevice device, Allocator & allocator, std::uint32_t framesInFlight)
+: m_frames(std::max(framesInFlight, 1u))
+{
+    for (auto & frame : m_frames)
+    {
+        frame.buffer.reset(new HostBuffer(device, allocator, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT));
+        frame.size = 0;
+    }
+}
+
+GlyphBuffer::~GlyphBuffer()
+{
+}
+
+std::uint32_t GlyphBuffer::framesInFlight() const
+{
+    return static_cast<std::uint32_t>(m_frames.size());
+}
+
+VkResult GlyphBuffer::update(std::uint32_t frame, const GlyphVertexCloud::Vertices & vertices)
+{
+    assert(frame < m_frames.size());
+    auto & current = m_frames[frame];
+    current.size = 0;
+    current.runs.clear();
+
+    if (vertices.empty())
+        return VK_SUCCESS;
+
+    // grow geometrically, so that slowly growing clouds do not reallocate every frame
+    const auto bytes = static_cast<VkDeviceSize>(vertices.size() * sizeof(GlyphVertexCloud::Vertex));
+    if (bytes > current.buffer->capacity())
+    {
+        const auto result = current.buffer->reserve(std::max(bytes, 2 * current.buffer->capacity()));
+        if (result != VK_SUCCESS)
+            return result;
+    }
+
+    std::memcpy(current.buffer->data(), vertices.data(), static_cast<size_t>(bytes));
+    current.size = static_cast<std::uint32_t>(vertices.size());
+    current.runs = computeRuns(vertices);
+    return VK_SUCCESS;
+}
+
+VkBuffer GlyphBuffer::buffer(std::uint32_t frame) const
+{
+    assert(frame < m_frames.size());
+    return m_frames[frame].buffer->buffer();
+}
+
+std::uint32_t GlyphBuffer::size(std::uint32_t frame) const
+{
+    assert(frame < m_frames.size());
+    return m_frames[frame].size;
+}
+
+const std::vector<GlyphBuffer::Run> & GlyphBuffer::runs(std::uint32_t frame) const
+{
+    assert(frame < m_frames.size());
+    return m_frames[frame].runs;
+}
+
+std::vector<GlyphBuffer::Run> GlyphBuffer::computeRuns(const GlyphVertexCloud::Vertices & vertices)
+{
+    // the draw order is kept, so blending gives the same result as a single draw call
+    std::vector<Run> runs;
+    for (std::uint32_t i = 0; i < vertices.size(); ++i)
+    {
+        const auto superSampling = static_cast<SuperSampling>(vertices[i].superSampling);
+        if (!runs.empty() && runs.back().superSampling == superSampling)
+            ++runs.back().count;
+        else
+            runs.push_back({ superSampling, i, 1 });
+    }
+    return runs;
+}
+
+
+} // namespace vulkan
+
+} // namespace gloperate_text
@@ -0,0 +1,315 @@
+#include <openll-vulkan/GlyphRenderer.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/mat4x4.hpp>
+
+#include <openll/GlyphVertexCloud.h>
+
+#include <openll-vulkan/GlyphAtlas.h>
+#include <openll-vulkan/GlyphBuffer.h>
+
+// SPIR-V of shaders/glyph.vert and shaders/glyph.frag, generated by glslangValidator
+#include "glyph.vert.h"
+#include "glyph.frag.h"
+
+
+namespace gloperate_text
+{
+
+namespace vulkan
+{
+
+
+const std::uint32_t GlyphRenderer::superSamplingModes;
+
+GlyphRenderer::GlyphRenderer(VkDevice device, VkRenderPass renderPass, std::uint32_t subpass
+    , VkSampleCountFlagBits samples, bool depthTest, VkPipelineCache pipelineCache)
+: m_device(device)
+, m_result(VK_SUCCESS)
+, m_descriptorSetLayout(VK_NULL_HANDLE)
+, m_pipelineLayout(VK_NULL_HANDLE)
+{
+    m_pipelines.fill(VK_NULL_HANDLE);
+
+    m_result = createLayouts();
+    if (m_result == VK_SUCCESS)
+        m_result = createPipelines(renderPass, subpass, samples, depthTest, pipelineCache);
+}
+
+GlyphRenderer::~GlyphRenderer()
+{
+    for (const auto pipeline : m_pipelines)
+    {
+        if (pipeline != VK_NULL_HANDLE)
+            vkDestroyPipeline(m_device, pipeline, nullptr);
+    }
+    if (m_pipelineLayout != VK_NULL_HANDLE)
+        vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+    if (m_descriptorSetLayout != VK_NULL_HANDLE)
+        vkDestroyDescriptorSetLayout(m_device, m_descriptorSetLayout, nullptr);
+}
+
+VkResult GlyphRenderer::result() const
+{
+    return m_result;
+}
+
+VkDescriptorSetLayout GlyphRenderer::descriptorSetLayout() const
+{
+    return m_descriptorSetLayout;
+}
+
+VkPipelineLayout GlyphRenderer::pipelineLayout() const
+{
+    return m_pipelineLayout;
+}
+
+VkPipeline GlyphRenderer::pipeline(SuperSampling superSampling) const
+{
+    const auto mode = static_cast<std::uint32_t>(superSampling);
+    return m_pipelines[mode < superSamplingModes ? mode : 0];
+}
+
+void GlyphRenderer::render(VkCommandBuffer commandBuffer, const GlyphBuffer & buffer, std::uint32_t frame, const GlyphAtlas & atlas) const
+{
+    renderInWorld(commandBuffer, buffer, frame, atlas, glm::mat4());
+}
+
+void GlyphRenderer::renderInWorld(VkCommandBuffer commandBuffer, const GlyphBuffer & buffer, std::uint32_t frame, const GlyphAtlas & atlas
+    , const glm::mat4 & viewProjection) const
+{
+    if (m_result != VK_SUCCESS || buffer.size(frame) == 0 || atlas.descriptorSet() == VK_NULL_HANDLE)
+        return;
+
+    // the layout is shared by all pipelines, so the bindings survive the pipeline changes
+    const auto descriptorSet = atlas.descriptorSet();
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+    vkCmdPushConstants(commandBuffer, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &viewProjection[0][0]);
+
+    const auto vertexBuffer = buffer.buffer(frame);
+    const VkDeviceSize vertexOffset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &vertexOffset);
+
+    VkPipeline bound = VK_NULL_HANDLE;
+    for (const auto & run : buffer.runs(frame))
+    {
+        const auto runPipeline = pipeline(run.superSampling);
+        if (runPipeline != bound)
+        {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, runPipeline);
+            bound = runPipeline;
+        }
+        vkCmdDraw(commandBuffer, 4, run.count, 0, run.first);
+    }
+}
+
+VkResult GlyphRenderer::createLayouts()
+{
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo = {};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = 1;
+    setLayoutInfo.pBindings = &binding;
+
+    auto result = vkCreateDescriptorSetLayout(m_device, &setLayoutInfo, nullptr, &m_descriptorSetLayout);
+    if (result != VK_SUCCESS)
+    {
+        m_descriptorSetLayout = VK_NULL_HANDLE;
+        return result;
+    }
+
+    // the view projection, 64 bytes fit into the guaranteed 128 bytes of push constants
+    VkPushConstantRange pushConstantRange = {};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(glm::mat4);
+
+    VkPipelineLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &m_descriptorSetLayout;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    result = vkCreatePipelineLayout(m_device, &layoutInfo, nullptr, &m_pipelineLayout);
+    if (result != VK_SUCCESS)
+        m_pipelineLayout = VK_NULL_HANDLE;
+    return result;
+}
+
+VkResult GlyphRenderer::createPipelines(VkRenderPass renderPass, std::uint32_t subpass, VkSampleCountFlagBits samples, bool depthTest, VkPipelineCache pipelineCache)
+{
+    const auto vertexShader = createShaderModule(glyph_vert, sizeof(glyph_vert));
+    const auto fragmentShader = createShaderModule(glyph_frag, sizeof(glyph_frag));
+    if (vertexShader == VK_NULL_HANDLE || fragmentShader == VK_NULL_HANDLE)
+    {
+        if (vertexShader != VK_NULL_HANDLE)
+            vkDestroyShaderModule(m_device, vertexShader, nullptr);
+        if (fragmentShader != VK_NULL_HANDLE)
+            vkDestroyShaderModule(m_device, fragmentShader, nullptr);
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    // one instance per glyph, superSampling selects the pipeline instead of being an attribute
+    using Vertex = GlyphVertexCloud::Vertex;
+    VkVertexInputBindingDescription binding = {};
+    binding.binding = 0;
+    binding.stride = sizeof(Vertex);
+    binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+    const VkVertexInputAttributeDescription attributes[] = {
+        { 0, 0, VK_FORMAT_R32G32B32_SFLOAT,    static_cast<std::uint32_t>(offsetof(Vertex, origin)) },
+        { 1, 0, VK_FORMAT_R32G32B32_SFLOAT,    static_cast<std::uint32_t>(offsetof(Vertex, vtan)) },
+        { 2, 0, VK_FORMAT_R32G32B32_SFLOAT,    static_cast<std::uint32_t>(offsetof(Vertex, vbitan)) },
+        { 3, 0, VK_FORMAT_R32G32B32A32_SFLOAT, static_cast<std::uint32_t>(offsetof(Vertex, uvRect)) },
+        { 4, 0, VK_FORMAT_R32G32B32A32_SFLOAT, static_cast<std::uint32_t>(offsetof(Vertex, fontColor)) },
+        { 5, 0, VK_FORMAT_R32_UINT,            static_cast<std::uint32_t>(offsetof(Vertex, page)) } };
+
+    VkPipelineVertexInputStateCreateInfo vertexInput = {};
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInput.vertexBindingDescriptionCount = 1;
+    vertexInput.pVertexBindingDescriptions = &binding;
+    vertexInput.vertexAttributeDescriptionCount = static_cast<std::uint32_t>(sizeof(attributes) / sizeof(attributes[0]));
+    vertexInput.pVertexAttributeDescriptions = attributes;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+
+    VkPipelineViewportStateCreateInfo viewport = {};
+    viewport.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport.viewportCount = 1;
+    viewport.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterization = {};
+    rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterization.cullMode = VK_CULL_MODE_NONE;
+    rasterization.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterization.lineWidth = 1.f;
+
+    VkPipelineMultisampleStateCreateInfo multisample = {};
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = samples;
+
+    VkPipelineDepthStencilStateCreateInfo depthStencil = {};
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable = depthTest ? VK_TRUE : VK_FALSE;
+    depthStencil.depthWriteEnable = VK_FALSE;
+    depthStencil.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+    VkPipelineColorBlendAttachmentState blendAttachment = {};
+    blendAttachment.blendEnable = VK_TRUE;
+    blendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    blendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineColorBlendStateCreateInfo colorBlend = {};
+    colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlend.attachmentCount = 1;
+    colorBlend.pAttachments = &blendAttachment;
+
+    const VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    VkPipelineDynamicStateCreateInfo dynamic = {};
+    dynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic.dynamicStateCount = 2;
+    dynamic.pDynamicStates = dynamicStates;
+
+    // the super sampling mode of each pipeline
+    std::array<std::uint32_t, superSamplingModes> modes;
+    std::array<VkSpecializationInfo, superSamplingModes> specializations;
+    std::array<std::array<VkPipelineShaderStageCreateInfo, 2>, superSamplingModes> stages;
+    std::array<VkGraphicsPipelineCreateInfo, superSamplingModes> pipelineInfos;
+
+    VkSpecializationMapEntry modeEntry = {};
+    modeEntry.constantID = 0;
+    modeEntry.offset = 0;
+    modeEntry.size = sizeof(std::uint32_t);
+
+    for (std::uint32_t mode = 0; mode < superSamplingModes; ++mode)
+    {
+        modes[mode] = mode;
+
+        auto & specialization = specializations[mode];
+        specialization = {};
+        specialization.mapEntryCount = 1;
+        specialization.pMapEntries = &modeEntry;
+        specialization.dataSize = sizeof(std::uint32_t);
+        specialization.pData = &modes[mode];
+
+        auto & stage = stages[mode];
+        stage[0] = {};
+        stage[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stage[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+        stage[0].module = vertexShader;
+        stage[0].pName = "main";
+        stage[1] = {};
+        stage[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stage[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        stage[1].module = fragmentShader;
+        stage[1].pName = "main";
+        stage[1].pSpecializationInfo = &specialization;
+
+        auto & pipelineInfo = pipelineInfos[mode];
+        pipelineInfo = {};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.stageCount = 2;
+        pipelineInfo.pStages = stage.data();
+        pipelineInfo.pVertexInputState = &vertexInput;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState = &viewport;
+        pipelineInfo.pRasterizationState = &rasterization;
+        pipelineInfo.pMultisampleState = &multisample;
+        pipelineInfo.pDepthStencilState = &depthStencil;
+        pipelineInfo.pColorBlendState = &colorBlend;
+        pipelineInfo.pDynamicState = &dynamic;
+        pipelineInfo.layout = m_pipelineLayout;
+        pipelineInfo.renderPass = renderPass;
+        pipelineInfo.subpass = subpass;
+        pipelineInfo.basePipelineIndex = -1;
+    }
+
+    const auto result = vkCreateGraphicsPipelines(m_device, pipelineCache, superSamplingModes, pipelineInfos.data(), nullptr, m_pipelines.data());
+    if (result != VK_SUCCESS)
+    {
+        for (auto & pipeline : m_pipelines)
+        {
+            if (pipeline != VK_NULL_HANDLE)
+                vkDestroyPipeline(m_device, pipeline, nullptr);
+            pipeline = VK_NULL_HANDLE;
+        }
+    }
+
+    vkDestroyShaderModule(m_device, vertexShader, nullptr);
+    vkDestroyShaderModule(m_device, fragmentShader, nullptr);
+    return result;
+}
+
+VkShaderModule GlyphRenderer::createShaderModule(const std::uint32_t * code, size_t size) const
+{
+    VkShaderModuleCreateInfo moduleInfo = {};
+    moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleInfo.codeSize = size;
+    moduleInfo.pCode = code;
+
+    VkShaderModule module = VK_NULL_HANDLE;
+    if (vkCreateShaderModule(m_device, &moduleInfo, nullptr, &module) != VK_SUCCESS)
+        return VK_NULL_HANDLE;
+    return module;
+}
+
+
+} // namespace vulkan
+
+} // namespace gloperate_text
@@ -0,0 +1,92 @@
+#include <openll-vulkan/HostBuffer.h>
+
+
+namespace gloperate_text
+{
+
+namespace vulkan
+{
+
+
+HostBuffer::HostBuffer(VkDevice device, Allocator & allocator, VkBufferUsageFlags usage)
+: m_device(device)
+, m_allocator(allocator)
+, m_usage(usage)
+, m_buffer(VK_NULL_HANDLE)
+, m_capacity(0)
+{
+}
+
+HostBuffer::~HostBuffer()
+{
+    release();
+}
+
+VkResult HostBuffer::reserve(VkDeviceSize size)
+{
+    if (size <= m_capacity)
+        return VK_SUCCESS;
+
+    release();
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = m_usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    auto result = vkCreateBuffer(m_device, &bufferInfo, nullptr, &m_buffer);
+    if (result != VK_SUCCESS)
+    {
+        m_buffer = VK_NULL_HANDLE;
+        return result;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(m_device, m_buffer, &requirements);
+
+    result = m_allocator.allocate(requirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, m_allocation);
+    if (result == VK_SUCCESS)
+        result = vkBindBufferMemory(m_device, m_buffer, m_allocation.memory, m_allocation.offset);
+
+    if (result != VK_SUCCESS)
+    {
+        release();
+        return result;
+    }
+
+    m_capacity = size;
+    return VK_SUCCESS;
+}
+
+void HostBuffer::release()
+{
+    if (m_buffer != VK_NULL_HANDLE)
+        vkDestroyBuffer(m_device, m_buffer, nullptr);
+    if (m_allocation.memory != VK_NULL_HANDLE)
+        m_allocator.free(m_allocation);
+
+    m_buffer = VK_NULL_HANDLE;
+    m_allocation = Allocation();
+    m_capacity = 0;
+}
+
+VkBuffer HostBuffer::buffer() const
+{
+    return m_buffer;
+}
+
+VkDeviceSize HostBuffer::capacity() const
+{
+    return m_capacity;
+}
+
+void * HostBuffer::data() const
+{
+    return m_allocation.mapped;
+}
+
+
+} // namespace vulkan
+
+} // namespace gloperate_text
@@ -0,0 +1,33 @@
+#include <gmock/gmock.h>
+
+#include <openll-vulkan/GlyphBuffer.h>
+
+TEST(GlyphBuffer_test, SplitsRunsBySuperSamplingInDrawOrder)
+{
+    const unsigned int modes[] = { 0, 0, 3, 3, 3, 0, 7 };
+
+    gloperate_text::GlyphVertexCloud::Vertices vertices;
+    for (const auto mode : modes)
+    {
+        gloperate_text::GlyphVertexCloud::Vertex vertex;
+        vertex.superSampling = mode;
+        vertices.push_back(vertex);
+    }
+
+    const auto runs = gloperate_text::vulkan::GlyphBuffer::computeRuns(vertices);
+    ASSERT_EQ(4u, runs.size());
+    EXPECT_EQ(gloperate_text::SuperSampling::None, runs[0].superSampling);
+    EXPECT_EQ(0u, runs[0].first);
+    EXPECT_EQ(2u, runs[0].count);
+    EXPECT_EQ(gloperate_text::SuperSampling::RGSS2x2, runs[1].superSampling);
+    EXPECT_EQ(2u, runs[1].first);
+    EXPECT_EQ(3u, runs[1].count);
+    EXPECT_EQ(gloperate_text::SuperSampling::None, runs[2].superSampling);
+    EXPECT_EQ(5u, runs[2].first);
+    EXPECT_EQ(1u, runs[2].count);
+    EXPECT_EQ(gloperate_text::SuperSampling::Grid4x4, runs[3].superSampling);
+    EXPECT_EQ(6u, runs[3].first);
+    EXPECT_EQ(1u, runs[3].count);
+
+    EXPECT_TRUE(gloperate_text::vulkan::GlyphBuffer::computeRuns({}).empty());
+}
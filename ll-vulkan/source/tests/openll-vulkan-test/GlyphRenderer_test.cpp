@@ -0,0 +1,477 @@
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+
+#include <vulkan/vulkan.h>
+
+#include <openll/FontFace.h>
+#include <openll/GlyphVertexCloud.h>
+#include <openll/RasterImage.h>
+#include <openll/SoftwareGlyphRenderer.h>
+#include <openll/SuperSampling.h>
+
+#include <openll-vulkan/Allocator.h>
+#include <openll-vulkan/GlyphAtlas.h>
+#include <openll-vulkan/GlyphBuffer.h>
+#include <openll-vulkan/GlyphRenderer.h>
+#include <openll-vulkan/HostBuffer.h>
+
+
+// googletest versions without GTEST_SKIP report the skip in the output and as a test property
+#ifdef GTEST_SKIP
+#define SKIP_TEST(message) GTEST_SKIP() << message
+#else
+#define SKIP_TEST(message) do { std::cout << "[  SKIPPED ] " << message << std::endl; RecordProperty("skipped", message); return; } while (false)
+#endif
+
+
+// Renders offscreen on the first Vulkan device, preferring CPU devices such as
+// Mesa lavapipe (e.g., VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json).
+// Without a Vulkan device, the tests are reported as skipped.
+class GlyphRenderer_test: public testing::Test
+{
+public:
+    static const int size = 64;
+
+    static void SetUpTestCase()
+    {
+        VkApplicationInfo applicationInfo = {};
+        applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        applicationInfo.pApplicationName = "openll-vulkan-test";
+        applicationInfo.apiVersion = VK_MAKE_VERSION(1, 0, 0);
+
+        VkInstanceCreateInfo instanceInfo = {};
+        instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        instanceInfo.pApplicationInfo = &applicationInfo;
+        if (vkCreateInstance(&instanceInfo, nullptr, &s_instance) != VK_SUCCESS)
+        {
+            s_instance = VK_NULL_HANDLE;
+            return;
+        }
+
+        uint32_t count = 0;
+        vkEnumeratePhysicalDevices(s_instance, &count, nullptr);
+        std::vector<VkPhysicalDevice> physicalDevices(count);
+        vkEnumeratePhysicalDevices(s_instance, &count, physicalDevices.data());
+
+        for (const auto physicalDevice : physicalDevices)
+        {
+            VkPhysicalDeviceProperties properties;
+            vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+            uint32_t familyCount = 0;
+            vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+            std::vector<VkQueueFamilyProperties> families(familyCount);
+            vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+
+            for (uint32_t family = 0; family < familyCount; ++family)
+            {
+                if (!(families[family].queueFlags & VK_QUEUE_GRAPHICS_BIT))
+                    continue;
+                if (s_physicalDevice == VK_NULL_HANDLE || properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU)
+                {
+                    s_physicalDevice = physicalDevice;
+                    s_queueFamily = family;
+                }
+                break;
+            }
+        }
+        if (s_physicalDevice == VK_NULL_HANDLE)
+            return;
+
+        const float priority = 1.f;
+        VkDeviceQueueCreateInfo queueInfo = {};
+        queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueInfo.queueFamilyIndex = s_queueFamily;
+        queueInfo.queueCount = 1;
+        queueInfo.pQueuePriorities = &priority;
+
+        VkDeviceCreateInfo deviceInfo = {};
+        deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        deviceInfo.queueCreateInfoCount = 1;
+        deviceInfo.pQueueCreateInfos = &queueInfo;
+        if (vkCreateDevice(s_physicalDevice, &deviceInfo, nullptr, &s_device) != VK_SUCCESS)
+        {
+            s_device = VK_NULL_HANDLE;
+            return;
+        }
+        vkGetDeviceQueue(s_device, s_queueFamily, 0, &s_queue);
+    }
+
+    static void TearDownTestCase()
+    {
+        if (s_device != VK_NULL_HANDLE)
+            vkDestroyDevice(s_device, nullptr);
+        if (s_instance != VK_NULL_HANDLE)
+            vkDestroyInstance(s_instance, nullptr);
+        s_device = VK_NULL_HANDLE;
+        s_physicalDevice = VK_NULL_HANDLE;
+        s_instance = VK_NULL_HANDLE;
+    }
+
+    GlyphRenderer_test()
+    : m_fontFace(new gloperate_text::FontFace)
+    , m_commandPool(VK_NULL_HANDLE)
+    , m_commandBuffer(VK_NULL_HANDLE)
+    , m_fence(VK_NULL_HANDLE)
+    , m_image(VK_NULL_HANDLE)
+    , m_imageView(VK_NULL_HANDLE)
+    , m_renderPass(VK_NULL_HANDLE)
+    , m_framebuffer(VK_NULL_HANDLE)
+    {
+    }
+
+    virtual void SetUp() override
+    {
+        if (!available())
+            SKIP_TEST("No Vulkan device");
+
+        m_allocator.reset(new gloperate_text::vulkan::DeviceAllocator(s_physicalDevice, s_device));
+
+        VkCommandPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = s_queueFamily;
+        ASSERT_EQ(VK_SUCCESS, vkCreateCommandPool(s_device, &poolInfo, nullptr, &m_commandPool));
+
+        VkCommandBufferAllocateInfo commandBufferInfo = {};
+        commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        commandBufferInfo.commandPool = m_commandPool;
+        commandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        commandBufferInfo.commandBufferCount = 1;
+        ASSERT_EQ(VK_SUCCESS, vkAllocateCommandBuffers(s_device, &commandBufferInfo, &m_commandBuffer));
+
+        VkFenceCreateInfo fenceInfo = {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        ASSERT_EQ(VK_SUCCESS, vkCreateFence(s_device, &fenceInfo, nullptr, &m_fence));
+
+        VkImageCreateInfo imageInfo = {};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+        imageInfo.extent = { size, size, 1 };
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        ASSERT_EQ(VK_SUCCESS, vkCreateImage(s_device, &imageInfo, nullptr, &m_image));
+
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(s_device, m_image, &requirements);
+        ASSERT_EQ(VK_SUCCESS, m_allocator->allocate(requirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_imageMemory));
+        ASSERT_EQ(VK_SUCCESS, vkBindImageMemory(s_device, m_image, m_imageMemory.memory, m_imageMemory.offset));
+
+        VkImageViewCreateInfo viewInfo = {};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = m_image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.layerCount = 1;
+        ASSERT_EQ(VK_SUCCESS, vkCreateImageView(s_device, &viewInfo, nullptr, &m_imageView));
+
+        VkAttachmentDescription attachment = {};
+        attachment.format = VK_FORMAT_R8G8B8A8_UNORM;
+        attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        attachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+        VkAttachmentReference colorReference = { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+        VkSubpassDescription subpass = {};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorReference;
+
+        VkRenderPassCreateInfo renderPassInfo = {};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = 1;
+        renderPassInfo.pAttachments = &attachment;
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+        ASSERT_EQ(VK_SUCCESS, vkCreateRenderPass(s_device, &renderPassInfo, nullptr, &m_renderPass));
+
+        VkFramebufferCreateInfo framebufferInfo = {};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = m_renderPass;
+        framebufferInfo.attachmentCount = 1;
+        framebufferInfo.pAttachments = &m_imageView;
+        framebufferInfo.width = size;
+        framebufferInfo.height = size;
+        framebufferInfo.layers = 1;
+        ASSERT_EQ(VK_SUCCESS, vkCreateFramebuffer(s_device, &framebufferInfo, nullptr, &m_framebuffer));
+
+        m_readback.reset(new gloperate_text::vulkan::HostBuffer(s_device, *m_allocator, VK_BUFFER_USAGE_TRANSFER_DST_BIT));
+        ASSERT_EQ(VK_SUCCESS, m_readback->reserve(size * size * 4));
+
+        m_renderer.reset(new gloperate_text::vulkan::GlyphRenderer(s_device, m_renderPass));
+        ASSERT_EQ(VK_SUCCESS, m_renderer->result());
+        m_atlas.reset(new gloperate_text::vulkan::GlyphAtlas(s_device, *m_allocator, m_renderer->descriptorSetLayout()));
+    }
+
+    virtual void TearDown() override
+    {
+        if (!available())
+            return;
+
+        vkDeviceWaitIdle(s_device);
+        m_atlas.reset();
+        m_renderer.reset();
+        m_readback.reset();
+
+        if (m_framebuffer != VK_NULL_HANDLE)
+            vkDestroyFramebuffer(s_device, m_framebuffer, nullptr);
+        if (m_renderPass != VK_NULL_HANDLE)
+            vkDestroyRenderPass(s_device, m_renderPass, nullptr);
+        if (m_imageView != VK_NULL_HANDLE)
+            vkDestroyImageView(s_device, m_imageView, nullptr);
+        if (m_image != VK_NULL_HANDLE)
+            vkDestroyImage(s_device, m_image, nullptr);
+        if (m_imageMemory.memory != VK_NULL_HANDLE)
+            m_allocator->free(m_imageMemory);
+        if (m_fence != VK_NULL_HANDLE)
+            vkDestroyFence(s_device, m_fence, nullptr);
+        if (m_commandPool != VK_NULL_HANDLE)
+            vkDestroyCommandPool(s_device, m_commandPool, nullptr);
+    }
+
+    static bool available()
+    {
+        return s_device != VK_NULL_HANDLE;
+    }
+
+    // radial distance field
+    void setAtlas()
+    {
+        std::vector<unsigned char> field(32 * 32);
+        for (int y = 0; y < 32; ++y)
+        {
+            for (int x = 0; x < 32; ++x)
+            {
+                const auto distance = std::sqrt((x - 15.5f) * (x - 15.5f) + (y - 15.5f) * (y - 15.5f));
+                const auto value = std::min(std::max(0.5f + (8.f - distance) / 16.f, 0.f), 1.f);
+                field[y * 32 + x] = static_cast<unsigned char>(value * 255.f);
+            }
+        }
+        m_fontFace->setGlyphTextureExtent({ 32, 32 });
+        m_fontFace->setGlyphImage(field);
+
+        begin();
+        ASSERT_EQ(VK_SUCCESS, m_atlas->upload(m_commandBuffer, *m_fontFace));
+        submit();
+        m_atlas->releaseStaging();
+    }
+
+    static gloperate_text::GlyphVertexCloud::Vertex quad(const glm::vec2 & lowerLeft, const glm::vec2 & upperRight, const glm::vec4 & color
+        , gloperate_text::SuperSampling superSampling = gloperate_text::SuperSampling::None)
+    {
+        gloperate_text::GlyphVertexCloud::Vertex vertex;
+        vertex.origin = glm::vec3(lowerLeft, 0.f);
+        vertex.vtan = glm::vec3(upperRight.x - lowerLeft.x, 0.f, 0.f);
+        vertex.vbitan = glm::vec3(0.f, upperRight.y - lowerLeft.y, 0.f);
+        vertex.uvRect = glm::vec4(0.f, 0.f, 1.f, 1.f);
+        vertex.fontColor = color;
+        vertex.superSampling = static_cast<unsigned int>(superSampling);
+        vertex.page = 0;
+        return vertex;
+    }
+
+    // renders the vertices of frame into a cleared image, with rows from bottom to top as RasterImage
+    gloperate_text::RasterImage render(const gloperate_text::vulkan::GlyphBuffer & buffer, std::uint32_t frame, const glm::mat4 & viewProjection)
+    {
+        begin();
+
+        VkClearValue clearValue = {};
+        VkRenderPassBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        beginInfo.renderPass = m_renderPass;
+        beginInfo.framebuffer = m_framebuffer;
+        beginInfo.renderArea.extent = { size, size };
+        beginInfo.clearValueCount = 1;
+        beginInfo.pClearValues = &clearValue;
+        vkCmdBeginRenderPass(m_commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+        VkViewport viewport = { 0.f, 0.f, static_cast<float>(size), static_cast<float>(size), 0.f, 1.f };
+        VkRect2D scissor = { { 0, 0 }, { size, size } };
+        vkCmdSetViewport(m_commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(m_commandBuffer, 0, 1, &scissor);
+
+        m_renderer->renderInWorld(m_commandBuffer, buffer, frame, *m_atlas, viewProjection);
+        vkCmdEndRenderPass(m_commandBuffer);
+
+        // the implicit dependency at the end of the render pass does not cover the copy
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = m_image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(m_commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0
+            , 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkBufferImageCopy region = {};
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = { size, size, 1 };
+        vkCmdCopyImageToBuffer(m_commandBuffer, m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_readback->buffer(), 1, &region);
+
+        VkMemoryBarrier hostBarrier = {};
+        hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(m_commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0
+            , 1, &hostBarrier, 0, nullptr, 0, nullptr);
+
+        submit();
+
+        gloperate_text::RasterImage image({ size, size });
+        const auto rows = static_cast<const std::uint8_t *>(m_readback->data());
+        for (int y = 0; y < size; ++y)
+            std::memcpy(image.pixel(0, size - 1 - y), rows + y * size * 4, size * 4);
+        return image;
+    }
+
+    void begin()
+    {
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(m_commandBuffer, &beginInfo);
+    }
+
+    void submit()
+    {
+        vkEndCommandBuffer(m_commandBuffer);
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &m_commandBuffer;
+        vkQueueSubmit(s_queue, 1, &submitInfo, m_fence);
+        vkWaitForFences(s_device, 1, &m_fence, VK_TRUE, UINT64_MAX);
+        vkResetFences(s_device, 1, &m_fence);
+    }
+
+protected:
+    static VkInstance s_instance;
+    static VkPhysicalDevice s_physicalDevice;
+    static uint32_t s_queueFamily;
+    static VkDevice s_device;
+    static VkQueue s_queue;
+
+    globjects::ref_ptr<gloperate_text::FontFace> m_fontFace;
+    std::unique_ptr<gloperate_text::vulkan::Allocator> m_allocator;
+
+    VkCommandPool m_commandPool;
+    VkCommandBuffer m_commandBuffer;
+    VkFence m_fence;
+
+    VkImage m_image;
+    gloperate_text::vulkan::Allocation m_imageMemory;
+    VkImageView m_imageView;
+    VkRenderPass m_renderPass;
+    VkFramebuffer m_framebuffer;
+    std::unique_ptr<gloperate_text::vulkan::HostBuffer> m_readback;
+
+    std::unique_ptr<gloperate_text::vulkan::GlyphRenderer> m_renderer;
+    std::unique_ptr<gloperate_text::vulkan::GlyphAtlas> m_atlas;
+};
+
+VkInstance GlyphRenderer_test::s_instance = VK_NULL_HANDLE;
+VkPhysicalDevice GlyphRenderer_test::s_physicalDevice = VK_NULL_HANDLE;
+uint32_t GlyphRenderer_test::s_queueFamily = 0;
+VkDevice GlyphRenderer_test::s_device = VK_NULL_HANDLE;
+VkQueue GlyphRenderer_test::s_queue = VK_NULL_HANDLE;
+
+TEST_F(GlyphRenderer_test, MatchesSoftwareRenderer)
+{
+    if (!available())
+        return;
+    setAtlas();
+
+    std::default_random_engine generator(5);
+    std::uniform_real_distribution<float> position(-1.2f, 1.f);
+    std::uniform_real_distribution<float> extent(0.05f, 0.6f);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    gloperate_text::GlyphVertexCloud cloud;
+    for (int i = 0; i < 80; ++i)
+    {
+        const auto lowerLeft = glm::vec2(position(generator), position(generator));
+        const auto upperRight = lowerLeft + glm::vec2(extent(generator), extent(generator));
+        const auto color = glm::vec4(unit(generator), unit(generator), unit(generator), unit(generator));
+        cloud.vertices().push_back(quad(lowerLeft, upperRight, color, static_cast<gloperate_text::SuperSampling>(i % 8)));
+    }
+
+    gloperate_text::vulkan::GlyphBuffer buffer(s_device, *m_allocator, 1);
+    ASSERT_EQ(VK_SUCCESS, buffer.update(0, cloud.vertices()));
+    const auto image = render(buffer, 0, glm::mat4());
+
+    gloperate_text::RasterImage expected({ size, size });
+    gloperate_text::SoftwareGlyphRenderer(1).render(cloud, *m_fontFace, expected);
+
+    // the software renderer emulates the OpenGL rasterization and derivatives
+    auto sum = 0;
+    auto outliers = 0;
+    for (int i = 0; i < size * size * 4; ++i)
+    {
+        const auto difference = std::abs(image.data()[i] - expected.data()[i]);
+        sum += difference;
+        outliers += difference > 8 ? 1 : 0;
+    }
+    EXPECT_LT(static_cast<float>(sum) / (size * size * 4), 1.f);
+    EXPECT_LT(outliers, size * size * 4 / 100);
+    EXPECT_GT(std::count_if(image.data(), image.data() + size * size * 4, [](std::uint8_t value) { return value > 0; }), size * size);
+}
+
+TEST_F(GlyphRenderer_test, KeepsFramesInFlightApart)
+{
+    if (!available())
+        return;
+    setAtlas();
+
+    gloperate_text::vulkan::GlyphBuffer buffer(s_device, *m_allocator, 2);
+    EXPECT_EQ(2u, buffer.framesInFlight());
+
+    // frame 0 has a red glyph on the left, frame 1 a blue one on the right
+    ASSERT_EQ(VK_SUCCESS, buffer.update(0, { quad({ -1.f, -0.5f }, { 0.f, 0.5f }, { 1.f, 0.f, 0.f, 1.f }) }));
+    ASSERT_EQ(VK_SUCCESS, buffer.update(1, { quad({ 0.f, -0.5f }, { 1.f, 0.5f }, { 0.f, 0.f, 1.f, 1.f }) }));
+    EXPECT_NE(buffer.buffer(0), buffer.buffer(1));
+
+    const auto first = render(buffer, 0, glm::mat4());
+    const auto second = render(buffer, 1, glm::mat4());
+
+    EXPECT_EQ(255, first.pixel(16, 32)[0]);
+    EXPECT_EQ(0, first.pixel(48, 32)[3]);
+    EXPECT_EQ(0, second.pixel(16, 32)[3]);
+    EXPECT_EQ(255, second.pixel(48, 32)[2]);
+
+    // growing the buffer of one frame keeps the other
+    gloperate_text::GlyphVertexCloud::Vertices many(100, quad({ -1.f, 0.5f }, { -0.5f, 1.f }, { 0.f, 1.f, 0.f, 1.f }));
+    ASSERT_EQ(VK_SUCCESS, buffer.update(0, many));
+    EXPECT_EQ(100u, buffer.size(0));
+    EXPECT_EQ(1u, buffer.size(1));
+    EXPECT_EQ(255, render(buffer, 1, glm::mat4()).pixel(48, 32)[2]);
+}